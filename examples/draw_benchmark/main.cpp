@@ -0,0 +1,203 @@
+/**
+ * Draw submission micro-benchmark
+ *
+ * Runs the MeshPass submission loop (BindGroupBinder::bind + buffer/draw calls) against a
+ * RecordingEncoder, so only the engine's CPU cost is measured - no driver, no GPU.
+ * Reports ns/draw, bind group sets/draw and heap allocations/draw in the measured frames.
+ *
+ * Usage: DrawBenchmark [--draws=N] [--materials=N] [--frames=N] [--fallback-adapter]
+ */
+#include "engine/EngineMain.h"
+// ^ This has to be on top to define SDL_MAIN_HANDLED ^
+#include "engine/rendering/BindGroupBinder.h"
+#include "engine/rendering/FrameCache.h"
+#include "engine/rendering/RecordingEncoder.h"
+#include "engine/rendering/ShaderRegistry.h"
+#include "engine/rendering/webgpu/WebGPUBindGroup.h"
+#include "engine/rendering/webgpu/WebGPUContext.h"
+#include "engine/rendering/webgpu/WebGPUShaderInfo.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+using namespace engine::rendering;
+
+namespace
+{
+std::atomic<size_t> g_allocationCount{0};
+
+struct DrawItem
+{
+	uint64_t objectId = 0;
+	uint32_t materialIndex = 0;
+	uint32_t indexCount = 0;
+};
+
+std::shared_ptr<webgpu::WebGPUBindGroup> makeBindGroup(const webgpu::WebGPUShaderInfo &shaderInfo, uint32_t groupIndex)
+{
+	// Handles stay null: the recording encoder never hands them to WebGPU
+	return std::make_shared<webgpu::WebGPUBindGroup>(
+		wgpu::BindGroup{},
+		shaderInfo.getBindGroupLayout(groupIndex),
+		std::vector<std::shared_ptr<webgpu::WebGPUBuffer>>{}
+	);
+}
+} // namespace
+
+// Count every heap allocation so the submission loop can be checked for allocation-free operation
+void *operator new(std::size_t size)
+{
+	g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+	if (void *ptr = std::malloc(size == 0 ? 1 : size))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+int main(int argc, char **argv)
+{
+	uint32_t drawCount = 10000;
+	uint32_t materialCount = 64;
+	uint32_t frameCount = 200;
+
+	engine::GameEngineOptions options;
+	options.headless = true;
+	options.windowWidth = 64;
+	options.windowHeight = 64;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string arg = argv[i];
+		if (arg.rfind("--draws=", 0) == 0)
+			drawCount = std::max(1u, static_cast<uint32_t>(std::stoul(arg.substr(8))));
+		else if (arg.rfind("--materials=", 0) == 0)
+			materialCount = std::max(1u, static_cast<uint32_t>(std::stoul(arg.substr(12))));
+		else if (arg.rfind("--frames=", 0) == 0)
+			frameCount = std::max(1u, static_cast<uint32_t>(std::stoul(arg.substr(9))));
+		else if (arg == "--fallback-adapter")
+			options.forceFallbackAdapter = true;
+	}
+
+	// A device is still needed for the shader's bind group layouts
+	engine::GameEngine engine;
+	if (!engine.initialize(options))
+	{
+		spdlog::error("DrawBenchmark: engine initialization failed");
+		return -1;
+	}
+
+	auto shaderInfo = engine.getContext()->shaderRegistry().getShader(shader::defaults::PBR);
+	if (!shaderInfo)
+	{
+		spdlog::error("DrawBenchmark: PBR shader not found");
+		return -1;
+	}
+
+	// Populate the frame cache the way FrameCache::prepareGPUResources would
+	const uint64_t cameraId = 1;
+	FrameCache frameCache;
+	BindGroupSet passGroups;
+	std::vector<std::shared_ptr<webgpu::WebGPUBindGroup>> passGroupStorage;
+	std::vector<std::shared_ptr<webgpu::WebGPUBindGroup>> materialGroups;
+
+	for (const auto &slot : shaderInfo->getBindGroupSlots())
+	{
+		switch (slot.type)
+		{
+			case BindGroupType::Frame:
+				frameCache.frameBindGroupCache[cameraId] = makeBindGroup(*shaderInfo, slot.groupIndex);
+				break;
+			case BindGroupType::Object:
+				for (uint64_t objectId = 0; objectId < drawCount; ++objectId)
+					frameCache.objectBindGroupCache[objectId] = makeBindGroup(*shaderInfo, slot.groupIndex);
+				break;
+			case BindGroupType::Material:
+				for (uint32_t material = 0; material < materialCount; ++material)
+					materialGroups.push_back(makeBindGroup(*shaderInfo, slot.groupIndex));
+				break;
+			case BindGroupType::Custom:
+			{
+				const uint64_t instances = slot.reuse == BindGroupReuse::PerObject	   ? drawCount
+										   : slot.reuse == BindGroupReuse::PerMaterial ? materialCount
+																					   : 0;
+				if (instances == 0)
+					frameCache.customBindGroupCache[FrameCache::createCustomBindGroupCacheKey(slot.customKey)] = makeBindGroup(*shaderInfo, slot.groupIndex);
+				for (uint64_t instance = 0; instance < instances; ++instance)
+					frameCache.customBindGroupCache[FrameCache::createCustomBindGroupCacheKey(slot.customKey, instance)] = makeBindGroup(*shaderInfo, slot.groupIndex);
+				break;
+			}
+			default:
+			{
+				// Pass-wide groups (lights, shadows, environment) are set once per pass
+				passGroupStorage.push_back(makeBindGroup(*shaderInfo, slot.groupIndex));
+				passGroups.set(slot.type, passGroupStorage.back());
+				break;
+			}
+		}
+	}
+
+	// Random objects and materials, sorted by material like the render collector does
+	std::vector<DrawItem> items(drawCount);
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<uint32_t> materialDist(0, materialCount - 1);
+	for (uint32_t i = 0; i < drawCount; ++i)
+		items[i] = {i, materialDist(rng), 36};
+	std::sort(items.begin(), items.end(), [](const DrawItem &a, const DrawItem &b)
+			  { return a.materialIndex < b.materialIndex; });
+
+	RecordingEncoder encoder(static_cast<size_t>(drawCount) * 8);
+	wgpu::RenderPipeline pipeline{};
+	wgpu::Buffer vertexBuffer{};
+	wgpu::Buffer indexBuffer{};
+	bool allBound = true;
+
+	auto submitFrame = [&]()
+	{
+		encoder.reset();
+		BindGroupBinder binder(&frameCache);
+		BindGroupSet bindGroups = passGroups;
+
+		encoder.setPipeline(pipeline);
+		for (const auto &item : items)
+		{
+			if (!materialGroups.empty())
+				bindGroups.set(BindGroupType::Material, materialGroups[item.materialIndex]);
+			allBound &= binder.bind(encoder, *shaderInfo, cameraId, bindGroups, item.objectId, item.materialIndex);
+			encoder.setVertexBuffer(0, vertexBuffer, 0, WGPU_WHOLE_SIZE);
+			encoder.setIndexBuffer(indexBuffer, wgpu::IndexFormat::Uint32, 0, WGPU_WHOLE_SIZE);
+			encoder.drawIndexed(item.indexCount, 1, 0, 0, 0);
+		}
+	};
+
+	// Warm-up grows the recording buffer to its final size
+	submitFrame();
+
+	const size_t allocationsBefore = g_allocationCount.load(std::memory_order_relaxed);
+	const auto start = std::chrono::steady_clock::now();
+	for (uint32_t frame = 0; frame < frameCount; ++frame)
+		submitFrame();
+	const auto end = std::chrono::steady_clock::now();
+	const size_t allocations = g_allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+	const double draws = static_cast<double>(drawCount) * frameCount;
+	const double nsPerDraw = std::chrono::duration<double, std::nano>(end - start).count() / draws;
+	const double bindsPerDraw = static_cast<double>(encoder.count(RecordingEncoder::CommandType::SetBindGroup)) / drawCount;
+
+	spdlog::info("DrawBenchmark: {} draws x {} frames, {} materials, {} bind group slots", drawCount, frameCount, materialCount, shaderInfo->getBindGroupSlots().size());
+	spdlog::info("DrawBenchmark: {:.1f} ns/draw, {:.2f} bind group sets/draw, {:.3f} allocations/draw", nsPerDraw, bindsPerDraw, allocations / draws);
+
+	if (!allBound)
+		spdlog::warn("DrawBenchmark: some bind groups were missing");
+	if (allocations > 0)
+	{
+		spdlog::error("DrawBenchmark: draw submission allocated {} times", allocations);
+		return 1;
+	}
+	return 0;
+}
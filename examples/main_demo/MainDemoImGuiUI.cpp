@@ -1,6 +1,7 @@
 #include "MainDemoImGuiUI.h"
 
 #include <imgui.h>
+#include "engine/core/Profiler.h"
 #include <spdlog/spdlog.h>
 
 namespace demo
@@ -47,6 +48,71 @@ void MainDemoImGuiUI::renderPerformanceWindow()
 	ImGui::Begin("Performance");
 	ImGui::Text("FPS: %.1f", m_engine.getFPS());
 	ImGui::Text("Frame Time: %.2f ms", m_engine.getFrameTime());
+
+	const auto pacing = m_engine.getFramePacingStats();
+	if (pacing.frameCount > 0)
+	{
+		ImGui::Separator();
+		ImGui::Text("Pacing Error: %.3f ms (mean %.3f, sd %.3f, max %.3f)", pacing.lastErrorMs, pacing.meanErrorMs, pacing.stdDevErrorMs, pacing.maxErrorMs);
+		ImGui::Text("Missed Deadlines: %u", pacing.missedDeadlines);
+		ImGui::Text("Predicted Work: %.2f ms", pacing.predictedWorkMs);
+	}
+
+	auto renderer = m_engine.getRenderer().lock();
+	if (renderer && ImGui::CollapsingHeader("GPU Passes"))
+	{
+		const auto timings = renderer->getGpuPassTimings();
+		if (timings.empty())
+			ImGui::TextUnformatted("No GPU timings (timestamp-query unsupported or disabled)");
+
+		float totalMs = 0.0f;
+		for (const auto &timing : timings)
+		{
+			ImGui::Text("%-14s %.3f ms (last %.3f, %u passes)", timing.name.c_str(), timing.averageMs, timing.lastMs, timing.passCount);
+			totalMs += timing.averageMs;
+		}
+		if (!timings.empty())
+			ImGui::Text("Total: %.3f ms", totalMs);
+	}
+
+	auto &profiler = engine::core::Profiler::instance();
+	if (ImGui::CollapsingHeader("CPU Profiler"))
+	{
+		if (!profiler.isCapturing())
+		{
+			if (ImGui::Button("Start Trace Capture"))
+				profiler.beginCapture();
+		}
+		else if (ImGui::Button("Stop & Save trace.json"))
+		{
+			profiler.endCapture("trace.json");
+		}
+
+		if (ImGui::BeginTable("ProfilerScopes", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+		{
+			ImGui::TableSetupColumn("Scope");
+			ImGui::TableSetupColumn("Frame");
+			ImGui::TableSetupColumn("p50");
+			ImGui::TableSetupColumn("p95");
+			ImGui::TableSetupColumn("p99");
+			ImGui::TableHeadersRow();
+			for (const auto &scope : profiler.getSummary())
+			{
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(scope.name.c_str());
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", scope.lastFrameMs);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", scope.p50Ms);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", scope.p95Ms);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", scope.p99Ms);
+			}
+			ImGui::EndTable();
+		}
+	}
 	ImGui::End();
 }
 
@@ -56,6 +122,10 @@ void MainDemoImGuiUI::renderShadowDebugWindow()
 	if (!renderer || !renderer->getShadowPass().isDebugMode())
 		return;
 
+	// Shadow textures grow with the shadow requests, pick up the current ones
+	m_debugShadowCubeArray = renderer->getShadowPass().DEBUG_SHADOW_CUBE_ARRAY;
+	m_debugShadow2DArray = renderer->getShadowPass().DEBUG_SHADOW_2D_ARRAY;
+
 	ImGui::Begin("Shadow Map Debug");
 
 	const int thumbSize = 128;
@@ -6,6 +6,7 @@
 // ^ This has to be on top to define SDL_MAIN_HANDLED ^
 
 #include <set>
+#include <string>
 
 #include "DayNightCycle.h"
 #include "MainDemoImGuiUI.h"
@@ -184,6 +185,7 @@ bool setupScene1(std::shared_ptr<engine::scene::Scene> scene)
 	auto floorNode = std::make_shared<engine::scene::nodes::ModelRenderNode>(maybeModelPlane.value());
 	floorNode->getTransform().setLocalPosition(glm::vec3(0.0f, 0.0f, 0.0f));
 	floorNode->getTransform().setLocalScale(glm::vec3(10.0f, 1.0f, 10.0f));
+	floorNode->setStatic(true);
 
 	// Load textures for PBR material
 	auto floorPBRProperties = engine::rendering::PBRProperties();
@@ -191,7 +193,9 @@ bool setupScene1(std::shared_ptr<engine::scene::Scene> scene)
 		PathProvider::getResource("cobblestone_floor_08_diff_2k.jpg")
 	);
 	auto normalTexture = resourceManager->m_textureManager->createTextureFromFile(
-		PathProvider::getResource("cobblestone_floor_08_nor_gl_2k.png")
+		PathProvider::getResource("cobblestone_floor_08_nor_gl_2k.png"),
+		false,
+		engine::rendering::ColorSpace::Linear
 	);
 
 	// Create material with both diffuse and normal maps
@@ -222,6 +226,7 @@ bool setupScene2(std::shared_ptr<engine::scene::Scene> scene)
 	);
 	modelNodeSeaKeep->getTransform().setLocalPosition(glm::vec3(0.0f, -3.0f, 0.0f));
 	modelNodeSeaKeep->getTransform().setLocalScale(glm::vec3(0.025f, 0.025f, 0.025f));
+	modelNodeSeaKeep->setStatic(true);
 	rootNode->addChild(modelNodeSeaKeep);
 
 	return true;
@@ -300,6 +305,20 @@ int main(int argc, char **argv)
 	options.windowHeight = 648;
 	options.enableVSync = false;
 
+	// Headless benchmark: main_demo --headless [--frames=N] [--capture-every=N] [--fallback-adapter]
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string arg = argv[i];
+		if (arg == "--headless")
+			options.headless = true;
+		else if (arg.rfind("--frames=", 0) == 0)
+			options.headlessFrameCount = static_cast<uint32_t>(std::stoul(arg.substr(9)));
+		else if (arg.rfind("--capture-every=", 0) == 0)
+			options.headlessCaptureInterval = static_cast<uint32_t>(std::stoul(arg.substr(16)));
+		else if (arg == "--fallback-adapter")
+			options.forceFallbackAdapter = true;
+	}
+
 	engine::GameEngine engine;
 	engine.initialize(options);
 
@@ -352,8 +371,11 @@ int main(int argc, char **argv)
 	// Load demo scene first (async) and wait for it to complete
 	auto load = sceneManager->loadScene("Demo");
 
-	auto mainDemoUI = std::make_shared<demo::MainDemoImGuiUI>(engine);
-	setupImGui(imguiManager, mainDemoUI, dayNightCycle);
+	if (imguiManager)
+	{
+		auto mainDemoUI = std::make_shared<demo::MainDemoImGuiUI>(engine);
+		setupImGui(imguiManager, mainDemoUI, dayNightCycle);
+	}
 	
 	// Run engine
 	engine.run();
@@ -0,0 +1,77 @@
+/**
+ * Offline texture cooker
+ *
+ * Writes "<image>.ktx2" next to each source image: the full mip chain, block-compressed when the
+ * size allows it. TextureManager picks the cooked file up instead of the source while it is newer.
+ * Format and color space follow the material slot the image is bound to: normal maps become
+ * linear BC5, color slots (diffuse, emissive, ...) sRGB, data slots (roughness, metallic, ...)
+ * linear. A --slot argument applies to the images after it.
+ *
+ * Usage: TextureCooker [--no-compress] [--no-mips] [--slot=<slot>] <image>... [--slot=<slot>] <image>...
+ * Example: TextureCooker --slot=diffuse albedo.png --slot=normal normal.png --slot=roughness rough.png
+ */
+#include "engine/rendering/Material.h"
+#include "engine/resources/TextureCooker.h"
+#include "engine/resources/TextureManager.h"
+#include "engine/resources/loaders/ImageLoader.h"
+
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+int main(int argc, char **argv)
+{
+	using namespace engine::resources;
+
+	auto textureManager = std::make_shared<TextureManager>(std::make_shared<loaders::ImageLoader>(std::filesystem::current_path()));
+
+	std::string slot = engine::rendering::MaterialTextureSlots::DIFFUSE;
+	bool compress = true;
+	bool generateMips = true;
+	int cooked = 0;
+	int failed = 0;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string arg = argv[i];
+		if (arg.rfind("--slot=", 0) == 0)
+		{
+			slot = arg.substr(7);
+			continue;
+		}
+		if (arg == "--no-compress")
+		{
+			compress = false;
+			continue;
+		}
+		if (arg == "--no-mips")
+		{
+			generateMips = false;
+			continue;
+		}
+
+		auto options = TextureCooker::optionsForSlot(slot);
+		options.compress = compress;
+		options.generateMips = generateMips;
+		if (textureManager->cookTextureFile(arg, options))
+		{
+			spdlog::info("TextureCooker: {} ({}) -> {}", arg, slot, TextureCooker::getCookedPath(arg).string());
+			++cooked;
+		}
+		else
+		{
+			spdlog::error("TextureCooker: failed to cook {}", arg);
+			++failed;
+		}
+	}
+
+	if (cooked + failed == 0)
+	{
+		spdlog::info("Usage: TextureCooker [--no-compress] [--no-mips] [--slot=<slot>] <image>...");
+		return 1;
+	}
+	spdlog::info("TextureCooker: {} cooked, {} failed", cooked, failed);
+	return failed > 0 ? 1 : 0;
+}
@@ -2,13 +2,16 @@
 
 #include <SDL3/SDL.h>
 #include <atomic>
+#include <filesystem>
 #include <memory>
 #include <thread>
 #include <unordered_map>
 
 #include "engine/EngineContext.h"
+#include "engine/core/FramePacer.h"
 #include "engine/input/InputManager.h"
 #include "engine/physics/PhysicsEngine.h"
+#include "engine/physics/PhysicsStateExchange.h"
 #include "engine/rendering/RenderCollector.h"
 #include "engine/rendering/Renderer.h"
 #include "engine/rendering/webgpu/WebGPUContext.h"
@@ -28,11 +31,15 @@ struct GameEngineOptions
 	float targetFrameRate = 60.0f;		 //< Desired framerate (used for vsync or sleeping)
 	bool enableVSync = true;			 //< If true, rely on GPU vsync
 	bool limitFrameRate = false;		 //< If true, manually cap frame rate
+	bool lowLatencyMode = false;		 //< Delay input sampling by the predicted frame work time
+	float frameSpinThresholdMs = 1.5f;	 //< Time before a pacing deadline spent spinning instead of sleeping
 
 	int maxSubSteps = 5;	//< Max fixed steps per frame to prevent spiral of death
 	bool runPhysics = true; //< Enable/disable physics updates (for testing)
 
 	bool showFrameStats = false;	//< Print/log delta time, FPS, etc.
+	bool enableProfiler = true;		//< Record CPU profiler scopes (only if built with ENGINE_ENABLE_PROFILER)
+	bool enableGpuTiming = true;	//< Time render passes on the GPU (only if timestamp queries are supported)
 	bool logSubsystemErrors = true; //< Log issues in update/render/physics
 	bool enableHotReload = false;	//< Watch files & reload (e.g. shaders/scripts)
 	int windowWidth = 1280;			//< Initial window width
@@ -42,6 +49,20 @@ struct GameEngineOptions
 	bool enableAudio = true;		//< Enable audio subsystem (not implemented yet)
 	float masterVolume = 1.0f;		//< Master volume (0.0 = silent, 1.0 = full volume)
 	int msaaSampleCount = 4;		//< Number of MSAA samples (1 = no MSAA)
+	bool enableDepthPrepass = false; //< Lay down opaque depth before shading (helps overdraw-heavy scenes)
+	bool enableMaterialTextureArrays = false; //< Pack same-size material textures into texture array pages so materials share bind groups (initialization only)
+	uint64_t gpuMemoryBudgetBytes = 0;		  //< VRAM budget for scene textures and meshes; least recently used ones are evicted above it (0 = unlimited)
+
+	bool headless = false;						   //< Render offscreen at windowWidth x windowHeight without a window (benchmarks, CI)
+	uint32_t headlessFrameCount = 300;			   //< Frames rendered by run() in headless mode (0 = until stop())
+	uint32_t headlessCaptureInterval = 0;		   //< Save every N-th headless frame as PNG (0 = never)
+	bool forceFallbackAdapter = false;			   //< Request the software/fallback WebGPU adapter
+	std::filesystem::path headlessOutputDirectory; //< Headless timings and captures (empty = logs/headless)
+
+	bool enablePipelineCache = true;		//< Pre-create pipelines recorded in the previous session and save the manifest on shutdown
+	std::filesystem::path pipelineCacheFile; //< Pipeline manifest location (empty = configs/pipeline_manifest.txt)
+
+	std::filesystem::path environmentCacheDirectory; //< Preprocessed environment lighting (empty = configs/environment_cache)
 
 	std::optional<engine::rendering::webgpu::DeviceLimitsConfig> overrideDeviceLimits; //< Optional override for WebGPU device limits (for testing or compatibility)
 
@@ -64,6 +85,7 @@ class GameEngine
 	void setOptions(const GameEngineOptions &options);
 
 	// Initialize the engine (creates window, WebGPU context, renderer, ImGui)
+	// In headless mode no window or ImGui is created and frames render into an offscreen target
 	// Call this before run() if you need to access ImGuiManager or other subsystems
 	// @param opts Optional engine options. If not provided, uses previously set options via setOptions()
 	bool initialize(std::optional<GameEngineOptions> opts = std::nullopt);
@@ -77,7 +99,7 @@ class GameEngine
 	// Access the resource manager for loading assets
 	std::shared_ptr<engine::resources::ResourceManager> getResourceManager();
 
-	// Access the window for UI initialization
+	// Access the window for UI initialization (nullptr in headless mode)
 	SDL_Window *getWindow();
 
 	// Access the ImGui manager for UI setup (available after initialize() is called)
@@ -97,6 +119,9 @@ class GameEngine
 	// Get current frame time in milliseconds
 	float getFrameTime() const;
 
+	// Get frame pacing error statistics of the main loop
+	engine::core::FramePacingStats getFramePacingStats() const;
+
 	// Start the game engine (blocks until stopped or window closed)
 	// Automatically calls initialize() if not already called
 	void run();
@@ -109,13 +134,19 @@ class GameEngine
 
 	void physicsLoop();
 
+	bool createWindow();
 	void gameLoop();
+	void headlessLoop();
+	bool captureHeadlessFrame(const std::filesystem::path &path);
+	void writeHeadlessReport(const std::filesystem::path &path, const std::vector<float> &frameTimesMs) const;
 	void processEvents();
 	void onWindowResize(int width, int height);
 	void updateScene(float deltaTime);
+	void dispatchFixedSteps(engine::scene::Scene *scene);
 	void renderFrame(float deltaTime);
 	void updateFrameStats(float frameDelta);
-	void limitFrameRate(double frameStartTime);
+	void configureFramePacer();
+	std::filesystem::path getPipelineCacheFile() const;
 
 	std::function<void(wgpu::RenderPassEncoder)> createUICallback();
 
@@ -136,6 +167,10 @@ class GameEngine
 	engine::input::InputManager m_inputManager;
 	engine::physics::PhysicsEngine m_physicsEngine;
 
+	// Lock-free handoff from the physics thread to the game thread
+	engine::physics::PhysicsStateExchange m_physicsExchange;
+	uint64_t m_lastConsumedPhysicsStep = 0;
+
 	// Context for node system access
 	EngineContext m_engineContext;
 
@@ -147,6 +182,10 @@ class GameEngine
 	float m_currentFPS = 0.0f;
 	float m_currentFrameTime = 0.0f;
 
+	// Frame pacing (main loop and physics thread each own their pacer)
+	engine::core::FramePacer m_framePacer;
+	engine::core::FramePacer m_physicsPacer;
+
 	// Threading
 	std::atomic<bool> running = false;
 	std::thread physicsThread;
@@ -155,6 +194,9 @@ class GameEngine
 	GameEngineOptions options;
 	float accumulatedTime = 0.0f;
 	bool m_initialized = false;
+
+	// Headless mode: simulated time
+	double m_headlessTime = 0.0;
 };
 
 } // namespace engine
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace engine::core
+{
+class Versioned;
+
+/**
+ * @class ChangeJournal
+ * @brief Process-wide log of version bumps on tracked Versioned objects.
+ *
+ * Objects are untracked by default and their version bumps cost a single atomic load.
+ * Once tracked, every incrementVersion() appends the object's change token to the journal,
+ * from any thread. One consumer (the render thread) drains the journal once per frame and
+ * maps the tokens to whatever depends on the changed objects.
+ *
+ * Tokens are never reused, so a token drained after its object was destroyed simply has
+ * no dependents left.
+ */
+class ChangeJournal
+{
+  public:
+	using token_t = uint64_t;
+
+	static ChangeJournal &instance();
+
+	/**
+	 * @brief Start tracking an object's version bumps.
+	 * @param object Object to track (tracking lasts for its lifetime).
+	 * @return The object's change token (the existing one if already tracked).
+	 */
+	token_t track(const Versioned &object);
+
+	/**
+	 * @brief Record a version bump (called by Versioned::incrementVersion()).
+	 * @param token Change token of the bumped object.
+	 */
+	void record(token_t token);
+
+	/**
+	 * @brief Move all tokens recorded since the last drain into outTokens.
+	 * @param outTokens Receives the tokens (cleared first; may contain duplicates).
+	 */
+	void drain(std::vector<token_t> &outTokens);
+
+  private:
+	ChangeJournal() = default;
+
+	std::mutex m_mutex;
+	std::vector<token_t> m_pending;
+	std::atomic<token_t> m_nextToken{1};
+};
+
+} // namespace engine::core
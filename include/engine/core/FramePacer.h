@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace engine::core
+{
+/**
+ * @brief Rolling statistics about how precisely frames hit their pacing deadlines.
+ *
+ * Error is the signed difference between the actual wake-up time and the deadline
+ * (positive = late). Values are aggregated over the last FramePacer::STATS_WINDOW frames.
+ */
+struct FramePacingStats
+{
+	uint64_t frameCount = 0;	   ///< Total paced frames since the last reset
+	uint32_t missedDeadlines = 0;  ///< Frames that finished their work after the deadline (total)
+	float lastErrorMs = 0.0f;	   ///< Error of the most recent frame
+	float meanErrorMs = 0.0f;	   ///< Mean error over the window
+	float maxErrorMs = 0.0f;	   ///< Largest absolute error over the window
+	float stdDevErrorMs = 0.0f;	   ///< Standard deviation of the error over the window
+	float predictedWorkMs = 0.0f;  ///< Predicted frame work time (used by low-latency mode)
+};
+
+/**
+ * @class FramePacer
+ * @brief Paces a loop to absolute steady_clock deadlines using hybrid sleep-then-spin waiting.
+ *
+ * Deadlines advance by a fixed interval (not by "remaining duration"), so rounding error does
+ * not accumulate over time. The OS sleep is used until `spinThreshold` before the deadline and
+ * the remainder is spent yielding in a spin loop, which avoids the 1-2 ms wake-up jitter of
+ * coarse sleeps.
+ *
+ * Usage per frame:
+ * @code
+ *   pacer.beginFrame(); // low-latency mode waits here, right before input sampling
+ *   ... poll input, update, render, present ...
+ *   pacer.endFrame();   // normal mode waits here
+ * @endcode
+ *
+ * In low-latency mode the pacer predicts how long the frame's work (CPU + GPU submission and
+ * present) takes and delays the start of the frame so the work finishes just before the
+ * deadline. Input is then sampled as late as possible.
+ */
+class FramePacer
+{
+  public:
+	using Clock = std::chrono::steady_clock;
+
+	/** @brief Number of frames the rolling statistics are computed over. */
+	static constexpr size_t STATS_WINDOW = 120;
+
+	struct Settings
+	{
+		double targetRate = 60.0;			///< Frames (or steps) per second, <= 0 disables pacing
+		double spinThresholdMs = 1.5;		///< Time before the deadline at which sleeping switches to spinning
+		bool lowLatency = false;			///< Delay the frame start by the predicted work time
+		double latencySafetyMarginMs = 1.0; ///< Extra headroom subtracted from the low-latency start time
+		bool anchorToFrameEnd = false;		///< Re-anchor deadlines to the end of each frame (vsync: present returns at vblank)
+	};
+
+	FramePacer() = default;
+	explicit FramePacer(const Settings &settings) { configure(settings); }
+
+	/**
+	 * @brief Apply new pacing settings. Resets the deadline but keeps statistics.
+	 */
+	void configure(const Settings &settings);
+
+	/** @brief Get the active settings. */
+	[[nodiscard]] const Settings &getSettings() const { return m_settings; }
+
+	/** @brief Check if pacing is active (targetRate > 0). */
+	[[nodiscard]] bool isEnabled() const { return m_settings.targetRate > 0.0; }
+
+	/**
+	 * @brief Start of a frame. In low-latency mode waits until `deadline - predictedWork`.
+	 */
+	void beginFrame();
+
+	/**
+	 * @brief End of a frame. Records the work time and, outside low-latency mode, waits for the deadline.
+	 */
+	void endFrame();
+
+	/**
+	 * @brief Clear statistics and re-anchor the next deadline to now.
+	 */
+	void reset();
+
+	/** @brief Compute the current pacing statistics. */
+	[[nodiscard]] FramePacingStats getStats() const;
+
+	/**
+	 * @brief Wait until an absolute deadline, sleeping first and spinning for the last part.
+	 * @param deadline Absolute time point to wake up at.
+	 * @param spinThreshold Portion before the deadline that is spent spinning instead of sleeping.
+	 */
+	static void sleepUntil(Clock::time_point deadline, Clock::duration spinThreshold);
+
+  private:
+	void recordError(Clock::time_point target, Clock::time_point actual);
+	void advanceDeadline(Clock::time_point now);
+
+	Settings m_settings{};
+	Clock::duration m_interval{};
+	Clock::duration m_spinThreshold{};
+	Clock::time_point m_deadline{};
+	Clock::time_point m_workStart{};
+	bool m_anchored = false;
+
+	// Exponential moving average of the frame work time, in seconds
+	double m_predictedWork = 0.0;
+
+	std::array<float, STATS_WINDOW> m_errorsMs{};
+	uint64_t m_frameCount = 0;
+	uint32_t m_missedDeadlines = 0;
+};
+
+} // namespace engine::core
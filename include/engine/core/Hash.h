@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace engine::core
+{
+
+/** @brief FNV-1a 64-bit offset basis (hash of the empty input). */
+constexpr uint64_t FNV1A_64_OFFSET = 14695981039346656037ull;
+/** @brief FNV-1a 64-bit prime. */
+constexpr uint64_t FNV1A_64_PRIME = 1099511628211ull;
+
+/**
+ * @brief FNV-1a 64-bit hash of a byte range.
+ * @param data Bytes to hash.
+ * @param size Number of bytes.
+ * @param seed Running hash to continue from (FNV1A_64_OFFSET to start fresh).
+ */
+constexpr uint64_t fnv1a64Bytes(const char *data, size_t size, uint64_t seed = FNV1A_64_OFFSET)
+{
+	uint64_t hash = seed;
+	for (size_t i = 0; i < size; ++i)
+	{
+		hash ^= static_cast<uint8_t>(data[i]);
+		hash *= FNV1A_64_PRIME;
+	}
+	return hash;
+}
+
+/** @brief FNV-1a 64-bit hash of a string. Usable at compile time. */
+constexpr uint64_t fnv1a64(std::string_view text, uint64_t seed = FNV1A_64_OFFSET)
+{
+	return fnv1a64Bytes(text.data(), text.size(), seed);
+}
+
+/**
+ * @brief Mix a 64-bit value into a running hash (boost-style combine with a 64-bit constant).
+ * @param seed Running hash.
+ * @param value Value to mix in.
+ * @return The combined hash.
+ */
+constexpr uint64_t hashCombine(uint64_t seed, uint64_t value)
+{
+	return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+}
+
+namespace detail
+{
+constexpr uint64_t XXH64_PRIME1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t XXH64_PRIME2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t XXH64_PRIME3 = 0x165667B19E3779F9ull;
+constexpr uint64_t XXH64_PRIME4 = 0x85EBCA77C2B2AE63ull;
+constexpr uint64_t XXH64_PRIME5 = 0x27D4EB2F165667C5ull;
+
+constexpr uint64_t rotl64(uint64_t value, int bits) { return (value << bits) | (value >> (64 - bits)); }
+
+inline uint64_t read64(const uint8_t *p)
+{
+	uint64_t value;
+	std::memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+inline uint32_t read32(const uint8_t *p)
+{
+	uint32_t value;
+	std::memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+constexpr uint64_t xxh64Round(uint64_t acc, uint64_t input)
+{
+	return rotl64(acc + input * XXH64_PRIME2, 31) * XXH64_PRIME1;
+}
+
+constexpr uint64_t xxh64MergeRound(uint64_t acc, uint64_t value)
+{
+	return (acc ^ xxh64Round(0, value)) * XXH64_PRIME1 + XXH64_PRIME4;
+}
+} // namespace detail
+
+/**
+ * @brief XXH64 hash of a byte range (little-endian hosts).
+ *
+ * Processes 32 bytes per iteration, so unlike fnv1a64Bytes() it is suited to large
+ * buffers such as pixel data.
+ * @param data Bytes to hash.
+ * @param size Number of bytes.
+ * @param seed Seed, 0 for the reference XXH64 value.
+ */
+inline uint64_t xxHash64(const void *data, size_t size, uint64_t seed = 0)
+{
+	using namespace detail;
+	const auto *p = static_cast<const uint8_t *>(data);
+	const uint8_t *const end = p + size;
+	uint64_t hash;
+
+	if (size >= 32)
+	{
+		uint64_t v1 = seed + XXH64_PRIME1 + XXH64_PRIME2;
+		uint64_t v2 = seed + XXH64_PRIME2;
+		uint64_t v3 = seed;
+		uint64_t v4 = seed - XXH64_PRIME1;
+		const uint8_t *const limit = end - 32;
+		do
+		{
+			v1 = xxh64Round(v1, read64(p));
+			v2 = xxh64Round(v2, read64(p + 8));
+			v3 = xxh64Round(v3, read64(p + 16));
+			v4 = xxh64Round(v4, read64(p + 24));
+			p += 32;
+		} while (p <= limit);
+
+		hash = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+		hash = xxh64MergeRound(hash, v1);
+		hash = xxh64MergeRound(hash, v2);
+		hash = xxh64MergeRound(hash, v3);
+		hash = xxh64MergeRound(hash, v4);
+	}
+	else
+	{
+		hash = seed + XXH64_PRIME5;
+	}
+	hash += static_cast<uint64_t>(size);
+
+	for (; p + 8 <= end; p += 8)
+		hash = rotl64(hash ^ xxh64Round(0, read64(p)), 27) * XXH64_PRIME1 + XXH64_PRIME4;
+	if (p + 4 <= end)
+	{
+		hash = rotl64(hash ^ (static_cast<uint64_t>(read32(p)) * XXH64_PRIME1), 23) * XXH64_PRIME2 + XXH64_PRIME3;
+		p += 4;
+	}
+	for (; p < end; ++p)
+		hash = rotl64(hash ^ (*p * XXH64_PRIME5), 11) * XXH64_PRIME1;
+
+	hash ^= hash >> 33;
+	hash *= XXH64_PRIME2;
+	hash ^= hash >> 29;
+	hash *= XXH64_PRIME3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+} // namespace engine::core
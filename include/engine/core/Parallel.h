@@ -0,0 +1,50 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "engine/core/WorkerPool.h"
+
+namespace engine::core
+{
+/**
+ * @brief Run rangeFn(first, last) over [0, count) on the shared WorkerPool.
+ *
+ * The range is cut into fixed chunks that the pool's workers and the calling thread take in turn,
+ * so uneven items (e.g. crowded light cluster slices) still balance. When the work is below
+ * minParallelWork, waking workers costs more than it saves and everything runs on the calling
+ * thread in one call.
+ *
+ * @param count Number of items (rows, slices, ...).
+ * @param work Estimated cost of all items, in the unit of minParallelWork.
+ * @param minParallelWork Smallest work worth spreading over threads.
+ * @param rangeFn Callable taking (uint32_t first, uint32_t last); called concurrently on disjoint ranges.
+ */
+template <typename RangeFn>
+void parallelFor(uint32_t count, size_t work, size_t minParallelWork, RangeFn &&rangeFn)
+{
+	if (count == 0)
+		return;
+
+	auto &pool = WorkerPool::shared();
+	const uint32_t workers = work < minParallelWork ? 1u : std::min(pool.getThreadCount() + 1, count);
+	if (workers <= 1)
+	{
+		rangeFn(0u, count);
+		return;
+	}
+
+	using Fn = std::remove_reference_t<RangeFn>;
+	const uint32_t chunk = std::max(1u, count / (workers * 4));
+	pool.run(
+		count,
+		chunk,
+		[](void *context, uint32_t first, uint32_t last)
+		{ (*static_cast<Fn *>(context))(first, last); },
+		const_cast<void *>(static_cast<const void *>(&rangeFn))
+	);
+}
+
+} // namespace engine::core
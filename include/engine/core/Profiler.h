@@ -0,0 +1,279 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::core
+{
+
+/**
+ * @brief A single completed profiler scope.
+ * @note `name` must point to storage with static lifetime (string literals).
+ */
+struct ProfileEvent
+{
+	const char *name = nullptr;
+	int64_t startNs = 0; ///< Start relative to the profiler epoch
+	int64_t endNs = 0;	 ///< End relative to the profiler epoch
+	uint32_t threadId = 0;
+	uint32_t depth = 0; ///< Nesting depth on its thread
+};
+
+/**
+ * @brief Rolling per-scope timing summary.
+ */
+struct ProfileScopeStats
+{
+	std::string name;
+	uint32_t sampleCount = 0; ///< Samples in the rolling window
+	float p50Ms = 0.0f;
+	float p95Ms = 0.0f;
+	float p99Ms = 0.0f;
+	float maxMs = 0.0f;
+	float lastFrameMs = 0.0f; ///< Total time spent in this scope during the last collected frame
+};
+
+/**
+ * @class ProfileThreadBuffer
+ * @brief Fixed-size ring of profiler events written by exactly one thread.
+ *
+ * The owning thread writes without locks; the profiler reads behind the published head.
+ * Every slot carries a sequence number (seqlock): the reader discards a slot the writer
+ * overwrote while it was being copied. If the reader falls more than half of CAPACITY behind,
+ * the oldest events are dropped.
+ *
+ * Buffers are recycled: when the owning thread exits, the profiler drains the buffer and
+ * hands it to the next thread that registers.
+ */
+class ProfileThreadBuffer
+{
+  public:
+	static constexpr size_t CAPACITY = 1 << 14;
+
+	explicit ProfileThreadBuffer(uint32_t threadId) : m_threadId(threadId) {}
+
+	/** @brief Append an event (owning thread only). */
+	void push(const ProfileEvent &event)
+	{
+		const uint64_t head = m_head.load(std::memory_order_relaxed);
+		Slot &slot = m_slots[head & (CAPACITY - 1)];
+		slot.sequence.store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		slot.name.store(event.name, std::memory_order_relaxed);
+		slot.startNs.store(event.startNs, std::memory_order_relaxed);
+		slot.endNs.store(event.endNs, std::memory_order_relaxed);
+		slot.depth.store(event.depth, std::memory_order_relaxed);
+		slot.sequence.store(head + 1, std::memory_order_release);
+		m_head.store(head + 1, std::memory_order_release);
+	}
+
+	[[nodiscard]] uint32_t getThreadId() const { return m_threadId; }
+
+	// Nesting depth of currently open scopes (owning thread only)
+	uint32_t depth = 0;
+
+  private:
+	friend class Profiler;
+
+	/**
+	 * @brief One event; fields are relaxed atomics so a concurrent overwrite is not a data race.
+	 */
+	struct Slot
+	{
+		std::atomic<uint64_t> sequence{0}; ///< Event index + 1 once written, 0 while being written
+		std::atomic<const char *> name{nullptr};
+		std::atomic<int64_t> startNs{0};
+		std::atomic<int64_t> endNs{0};
+		std::atomic<uint32_t> depth{0};
+	};
+
+	/**
+	 * @brief Copy the event with the given index (reader side).
+	 * @return False if the slot no longer (or not yet) holds that event.
+	 */
+	bool read(uint64_t index, ProfileEvent &outEvent) const
+	{
+		const Slot &slot = m_slots[index & (CAPACITY - 1)];
+		const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+		if (sequence != index + 1)
+			return false;
+
+		outEvent.name = slot.name.load(std::memory_order_relaxed);
+		outEvent.startNs = slot.startNs.load(std::memory_order_relaxed);
+		outEvent.endNs = slot.endNs.load(std::memory_order_relaxed);
+		outEvent.depth = slot.depth.load(std::memory_order_relaxed);
+		outEvent.threadId = m_threadId;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return slot.sequence.load(std::memory_order_relaxed) == sequence;
+	}
+
+	std::unique_ptr<Slot[]> m_slots{new Slot[CAPACITY]};
+	std::atomic<uint64_t> m_head{0};
+	uint64_t m_readCursor = 0; ///< Consumer side, only touched under the profiler mutex
+	uint32_t m_threadId;	   ///< Reassigned under the profiler mutex when the buffer is recycled
+	bool m_retired = false;	   ///< Owning thread exited; recycled once drained (profiler mutex)
+};
+
+/**
+ * @class Profiler
+ * @brief Low-overhead hierarchical CPU profiler with Chrome trace export.
+ *
+ * Scopes are recorded through the ENGINE_PROFILE_* macros into per-thread ring buffers
+ * (no locks on the recording path). Once per frame, endFrame() drains all buffers, feeds
+ * the rolling per-scope summary and, while a capture is active, appends the events to it.
+ * The capture can be written as Chrome trace JSON (chrome://tracing, Perfetto). It is a ring of
+ * MAX_CAPTURE_EVENTS: a capture left running keeps the most recent events instead of growing.
+ *
+ * All macros compile to nothing unless ENGINE_ENABLE_PROFILER is defined.
+ */
+class Profiler
+{
+  public:
+	using Clock = std::chrono::steady_clock;
+
+	/** @brief Number of samples kept per scope for the percentile summary. */
+	static constexpr size_t SUMMARY_WINDOW = 256;
+
+	/** @brief Most events a capture holds (about 32 MiB); older events are overwritten. */
+	static constexpr size_t MAX_CAPTURE_EVENTS = 1 << 20;
+
+	/** @brief Get the process-wide profiler. */
+	static Profiler &instance();
+
+	/** @brief Nanoseconds since the profiler epoch. */
+	static int64_t now()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - s_epoch).count();
+	}
+
+	/** @brief Get (and lazily register) the calling thread's event buffer. */
+	static ProfileThreadBuffer &threadBuffer();
+
+	/** @brief Enable or disable recording at runtime. */
+	void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+
+	/** @brief Check if recording is enabled. */
+	[[nodiscard]] bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Drain all thread buffers and update the rolling summary.
+	 * Call once per frame from the main thread.
+	 */
+	void endFrame();
+
+	/** @brief Start collecting events for a Chrome trace. */
+	void beginCapture();
+
+	/**
+	 * @brief Stop collecting and write the captured events as Chrome trace JSON.
+	 * @param path Output file path.
+	 * @return True if the file was written.
+	 */
+	bool endCapture(const std::filesystem::path &path);
+
+	/** @brief Check if a capture is active. */
+	[[nodiscard]] bool isCapturing() const { return m_capturing; }
+
+	/**
+	 * @brief Get the rolling p50/p95/p99 summary for every scope seen so far.
+	 * @return Scope statistics, sorted by p95 descending.
+	 */
+	std::vector<ProfileScopeStats> getSummary() const;
+
+	/** @brief Forget all summary data and captured events. */
+	void reset();
+
+	/** @brief Number of thread buffers allocated (live threads plus buffers waiting for reuse). */
+	[[nodiscard]] size_t getThreadBufferCount() const;
+
+  private:
+	Profiler() = default;
+
+	struct ScopeHistory
+	{
+		float samplesMs[SUMMARY_WINDOW]{};
+		uint32_t count = 0;
+		uint32_t next = 0;
+		float frameAccumMs = 0.0f;
+		float lastFrameMs = 0.0f;
+	};
+
+	static const Clock::time_point s_epoch;
+
+	/** @brief Called when the owning thread exits: recycle the buffer once it is drained. */
+	void retireThreadBuffer(ProfileThreadBuffer &buffer);
+	void drain(ProfileThreadBuffer &buffer);
+
+	std::atomic<bool> m_enabled{true};
+	mutable std::mutex m_mutex; ///< Guards registration, draining and summary (never the record path)
+	std::vector<std::unique_ptr<ProfileThreadBuffer>> m_buffers;
+	std::vector<ProfileThreadBuffer *> m_freeBuffers; ///< Drained buffers of exited threads
+	uint32_t m_nextThreadId = 1;
+	std::unordered_map<std::string_view, ScopeHistory> m_history; ///< Keyed by name (literals may not be pooled across TUs)
+	std::vector<ProfileEvent> m_capture; ///< Ring of up to MAX_CAPTURE_EVENTS
+	size_t m_captureNext = 0;			 ///< Oldest event once the ring is full
+	uint64_t m_captureDropped = 0;		 ///< Events overwritten during the current capture
+	bool m_capturing = false;
+};
+
+/**
+ * @class ProfileScope
+ * @brief RAII helper that records one event from construction to destruction.
+ */
+class ProfileScope
+{
+  public:
+	explicit ProfileScope(const char *name)
+	{
+		if (!Profiler::instance().isEnabled())
+			return;
+		m_buffer = &Profiler::threadBuffer();
+		m_name = name;
+		m_depth = m_buffer->depth++;
+		m_start = Profiler::now();
+	}
+
+	~ProfileScope()
+	{
+		if (!m_buffer)
+			return;
+		const int64_t end = Profiler::now();
+		m_buffer->depth--;
+		m_buffer->push({m_name, m_start, end, m_buffer->getThreadId(), m_depth});
+	}
+
+	ProfileScope(const ProfileScope &) = delete;
+	ProfileScope &operator=(const ProfileScope &) = delete;
+
+  private:
+	ProfileThreadBuffer *m_buffer = nullptr;
+	const char *m_name = nullptr;
+	int64_t m_start = 0;
+	uint32_t m_depth = 0;
+};
+
+} // namespace engine::core
+
+#define ENGINE_PROFILE_CONCAT_INNER(a, b) a##b
+#define ENGINE_PROFILE_CONCAT(a, b) ENGINE_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef ENGINE_ENABLE_PROFILER
+/** @brief Profile the enclosing scope under a static name. */
+#define ENGINE_PROFILE_SCOPE(name) ::engine::core::ProfileScope ENGINE_PROFILE_CONCAT(_engineProfileScope, __LINE__)(name)
+/** @brief Profile the enclosing function. */
+#define ENGINE_PROFILE_FUNCTION() ENGINE_PROFILE_SCOPE(__func__)
+/** @brief Mark the end of a frame (drains buffers, updates the summary). */
+#define ENGINE_PROFILE_END_FRAME() ::engine::core::Profiler::instance().endFrame()
+#else
+#define ENGINE_PROFILE_SCOPE(name) ((void)0)
+#define ENGINE_PROFILE_FUNCTION() ((void)0)
+#define ENGINE_PROFILE_END_FRAME() ((void)0)
+#endif
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+
+namespace engine::core
+{
+/**
+ * @class SpscQueue
+ * @brief Bounded lock-free single-producer/single-consumer ring buffer.
+ *
+ * One thread may call tryPush(), one other thread may call tryPop(). No allocation
+ * happens after construction, so it is safe to use on hot paths between threads.
+ *
+ * @tparam T Trivially copyable element type.
+ * @tparam Capacity Number of slots, must be a power of two.
+ */
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+	static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+	static_assert(std::is_trivially_copyable_v<T>, "SpscQueue elements must be trivially copyable");
+
+  public:
+	SpscQueue() = default;
+
+	// No copy, no move (atomics are pinned)
+	SpscQueue(const SpscQueue &) = delete;
+	SpscQueue &operator=(const SpscQueue &) = delete;
+
+	/**
+	 * @brief Push an element (producer thread only).
+	 * @return False if the queue is full.
+	 */
+	bool tryPush(const T &value)
+	{
+		const size_t head = m_head.load(std::memory_order_relaxed);
+		const size_t tail = m_tail.load(std::memory_order_acquire);
+		if (head - tail >= Capacity)
+			return false;
+
+		m_slots[head & (Capacity - 1)] = value;
+		m_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Pop an element (consumer thread only).
+	 * @return The element, or std::nullopt if the queue is empty.
+	 */
+	std::optional<T> tryPop()
+	{
+		const size_t tail = m_tail.load(std::memory_order_relaxed);
+		const size_t head = m_head.load(std::memory_order_acquire);
+		if (tail == head)
+			return std::nullopt;
+
+		T value = m_slots[tail & (Capacity - 1)];
+		m_tail.store(tail + 1, std::memory_order_release);
+		return value;
+	}
+
+	/**
+	 * @brief Approximate number of queued elements (exact only when both sides are idle).
+	 */
+	[[nodiscard]] size_t size() const
+	{
+		return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+	}
+
+	[[nodiscard]] bool empty() const { return size() == 0; }
+
+	/**
+	 * @brief Check for a free slot (producer thread only).
+	 * Only the consumer frees slots, so a false result guarantees the next tryPush() succeeds.
+	 */
+	[[nodiscard]] bool full() const
+	{
+		return m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_acquire) >= Capacity;
+	}
+
+	static constexpr size_t capacity() { return Capacity; }
+
+  private:
+	std::array<T, Capacity> m_slots{};
+	alignas(64) std::atomic<size_t> m_head{0}; ///< Next slot to write (producer)
+	alignas(64) std::atomic<size_t> m_tail{0}; ///< Next slot to read (consumer)
+};
+
+} // namespace engine::core
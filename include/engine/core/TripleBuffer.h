@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace engine::core
+{
+/**
+ * @class TripleBuffer
+ * @brief Lock-free latest-value exchange between one writer and one reader thread.
+ *
+ * The writer fills a private back slot and publishes it with an atomic swap, the reader
+ * swaps the most recently published slot into its private front slot. Neither side ever
+ * blocks, and the reader always sees a complete value (never a torn write).
+ *
+ * @tparam T Value type exchanged between the threads.
+ */
+template <typename T>
+class TripleBuffer
+{
+  public:
+	TripleBuffer() = default;
+
+	// No copy, no move (atomics are pinned)
+	TripleBuffer(const TripleBuffer &) = delete;
+	TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+	/**
+	 * @brief Access the writer's back slot (writer thread only).
+	 */
+	T &back() { return m_slots[m_backIndex]; }
+
+	/**
+	 * @brief Publish the back slot as the latest value (writer thread only).
+	 */
+	void publish()
+	{
+		const uint8_t previous = m_shared.exchange(static_cast<uint8_t>(m_backIndex | FRESH_BIT), std::memory_order_acq_rel);
+		m_backIndex = previous & INDEX_MASK;
+	}
+
+	/**
+	 * @brief Convenience: copy a value into the back slot and publish it.
+	 */
+	void write(const T &value)
+	{
+		back() = value;
+		publish();
+	}
+
+	/**
+	 * @brief Fetch the latest published value if a new one is available (reader thread only).
+	 * @return True if the front slot was updated.
+	 */
+	bool update()
+	{
+		if ((m_shared.load(std::memory_order_relaxed) & FRESH_BIT) == 0)
+			return false;
+
+		const uint8_t previous = m_shared.exchange(m_frontIndex, std::memory_order_acq_rel);
+		m_frontIndex = previous & INDEX_MASK;
+		return true;
+	}
+
+	/**
+	 * @brief Access the reader's front slot (reader thread only).
+	 */
+	const T &front() const { return m_slots[m_frontIndex]; }
+
+  private:
+	static constexpr uint8_t FRESH_BIT = 0x4;
+	static constexpr uint8_t INDEX_MASK = 0x3;
+
+	std::array<T, 3> m_slots{};
+	uint8_t m_backIndex = 0;				///< Owned by the writer
+	uint8_t m_frontIndex = 1;				///< Owned by the reader
+	alignas(64) std::atomic<uint8_t> m_shared{2}; ///< Middle slot index plus fresh flag
+};
+
+} // namespace engine::core
@@ -3,6 +3,8 @@
 #include <atomic>
 #include <cstdint>
 
+#include "engine/core/ChangeJournal.h"
+
 namespace engine::core
 {
 /**
@@ -11,6 +13,8 @@ namespace engine::core
  *
  * Objects inheriting from this class maintain a version number that
  * increments when their state changes, allowing efficient change detection.
+ * Objects tracked by the ChangeJournal additionally report every bump to it,
+ * so consumers can react to changes instead of polling versions.
  */
 class Versioned
 {
@@ -26,14 +30,18 @@ class Versioned
 
 	// Allow move
 	Versioned(Versioned &&other) noexcept
-		: m_version(other.m_version.load())
+		: m_version(other.m_version.load()),
+		  m_changeToken(other.m_changeToken.load())
 	{
 	}
 
 	Versioned &operator=(Versioned &&other) noexcept
 	{
 		if (this != &other)
+		{
 			m_version.store(other.m_version.load());
+			m_changeToken.store(other.m_changeToken.load());
+		}
 		return *this;
 	}
 
@@ -47,10 +55,18 @@ class Versioned
 	/**
 	 * @brief Increment the version number when properties change.
 	 */
-	void incrementVersion() { ++m_version; }
+	void incrementVersion()
+	{
+		++m_version;
+		if (const auto token = m_changeToken.load(std::memory_order_acquire))
+			ChangeJournal::instance().record(token);
+	}
 
   private:
+	friend class ChangeJournal;
+
 	std::atomic<version_t> m_version{0};
+	mutable std::atomic<ChangeJournal::token_t> m_changeToken{0}; ///< 0 = not tracked by the ChangeJournal
 };
 
 } // namespace engine::core
\ No newline at end of file
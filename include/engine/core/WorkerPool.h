@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine::core
+{
+/**
+ * @class WorkerPool
+ * @brief Persistent worker threads running one chunked range job at a time.
+ *
+ * The threads are started once and sleep on a condition variable between jobs, so dispatching
+ * costs a wake-up instead of creating threads. A job splits [0, count) into fixed chunks that the
+ * workers and the calling thread take from a shared counter until the range is exhausted.
+ *
+ * run() blocks until the whole range is done. Jobs do not queue: when the pool is busy with
+ * another caller's job, or run() is called from a worker (nested parallelism), the range runs on
+ * the calling thread instead.
+ *
+ * Usage (see parallelFor() for the typed wrapper):
+ * @code
+ *   WorkerPool::shared().run(count, chunk, [](void *ctx, uint32_t first, uint32_t last) { ... }, &data);
+ * @endcode
+ */
+class WorkerPool
+{
+  public:
+	using RangeFn = void (*)(void *context, uint32_t first, uint32_t last);
+
+	/**
+	 * @brief Start the worker threads.
+	 * @param threadCount Number of workers besides the calling thread (0 runs everything inline).
+	 */
+	explicit WorkerPool(uint32_t threadCount);
+	~WorkerPool();
+
+	WorkerPool(const WorkerPool &) = delete;
+	WorkerPool &operator=(const WorkerPool &) = delete;
+
+	/**
+	 * @brief Process-wide pool with one worker per hardware thread besides the caller.
+	 * Created on first use and joined at exit.
+	 */
+	static WorkerPool &shared();
+
+	/**
+	 * @brief Run fn(context, first, last) over [0, count) in chunks of chunkSize and wait for it.
+	 * @param count Number of items.
+	 * @param chunkSize Items per chunk (at least 1).
+	 * @param fn Called concurrently on disjoint ranges.
+	 * @param context Passed through to fn.
+	 */
+	void run(uint32_t count, uint32_t chunkSize, RangeFn fn, void *context);
+
+	/** @brief Number of worker threads (excluding the calling thread). */
+	[[nodiscard]] uint32_t getThreadCount() const { return static_cast<uint32_t>(m_threads.size()); }
+
+  private:
+	void workerLoop();
+	void runChunks();
+
+	std::vector<std::thread> m_threads;
+	std::mutex m_submitMutex; ///< Held by the caller whose job the workers are running
+
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_done;
+	uint64_t m_generation = 0; ///< Bumped per job; workers run each generation once
+	uint32_t m_pending = 0;	   ///< Workers still busy with the current job
+	bool m_stop = false;
+
+	// Current job, written under m_mutex before the generation is bumped
+	RangeFn m_fn = nullptr;
+	void *m_context = nullptr;
+	uint32_t m_count = 0;
+	uint32_t m_chunkSize = 1;
+	std::atomic<uint32_t> m_next{0};
+};
+
+} // namespace engine::core
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cfloat>
+#include <cmath>
 #include <vector>
 
 #include <glm/glm.hpp>
@@ -96,6 +99,14 @@ struct Frustum
 	 * @param cameraFar Camera far plane distance
 	 * @param cascadeCount Number of cascades
 	 * @param lambda Split lambda (0=uniform, 1=logarithmic)
+	 * @param shadowMapSizes Shadow map resolution per cascade; non-empty stabilizes the cascades
+	 *                       (missing entries use the last one)
+	 * @param padding Stabilized cascades only: extra radius per cascade as a fraction of the
+	 *                slice radius (missing entries = no padding)
+	 *
+	 * Stabilized cascades bound the camera slice with a sphere instead of a light-space AABB, so
+	 * their size does not change when the camera rotates, and snap their center to whole shadow
+	 * map texels in light space, so the rasterized depth does not shimmer when the camera moves.
 	 */
 	struct CascadeData
 	{
@@ -103,6 +114,10 @@ struct Frustum
 		float near;
 		float far;
 		float cascadeSplit;
+		glm::vec2 boundsMin;		///< Light-view XY rectangle covered by the cascade
+		glm::vec2 boundsMax;
+		glm::vec2 sliceCenter{0.0f}; ///< Light-view XY center of the camera slice (stabilized only)
+		float sliceRadius = 0.0f;	 ///< Radius the cascade must cover around sliceCenter (stabilized only)
 	};
 
 	static std::vector<CascadeData> computeCascades(
@@ -113,7 +128,9 @@ struct Frustum
 		float cameraFar,
 		float lightRange,
 		uint32_t cascadeCount,
-		float lambda
+		float lambda,
+		const std::vector<uint32_t> &shadowMapSizes = {},
+		const std::vector<float> &padding = {}
 	)
 	{
 		std::vector<CascadeData> result;
@@ -167,17 +184,47 @@ struct Frustum
 				cascadeCorners[i + 4] = glm::mix(cameraCorners[i], cameraCorners[i + 4], t_far);
 			}
 
-			// Compute AABB of cascade corners in light space
 			glm::vec3 minLS(FLT_MAX), maxLS(-FLT_MAX);
-			for (auto &p : cascadeCorners)
+			if (!shadowMapSizes.empty())
 			{
-				glm::vec3 ls = glm::vec3(lightView * glm::vec4(p, 1.f));
-				minLS = glm::min(minLS, ls);
-				maxLS = glm::max(maxLS, ls);
+				// Bounding sphere of the slice, radius rounded so float noise does not resize it
+				glm::vec3 center(0.0f);
+				for (auto &p : cascadeCorners)
+					center += p;
+				center /= 8.0f;
+
+				float radius = 0.0f;
+				for (auto &p : cascadeCorners)
+					radius = std::max(radius, glm::length(p - center));
+				radius = std::ceil(radius * 16.0f) / 16.0f;
+
+				const glm::vec3 centerLS = glm::vec3(lightView * glm::vec4(center, 1.f));
+				data.sliceCenter = glm::vec2(centerLS);
+				data.sliceRadius = radius;
+
+				// Snap the center to whole texels of the (padded) cascade
+				const float halfSize = radius * (1.0f + (c < padding.size() ? padding[c] : 0.0f));
+				const uint32_t shadowMapSize = std::max(shadowMapSizes[std::min<size_t>(c, shadowMapSizes.size() - 1)], 1u);
+				const float texel = 2.0f * halfSize / static_cast<float>(shadowMapSize);
+				const glm::vec2 snapped = glm::floor(glm::vec2(centerLS) / texel) * texel;
+				minLS = glm::vec3(snapped - halfSize, 0.0f);
+				maxLS = glm::vec3(snapped + halfSize, 0.0f);
+			}
+			else
+			{
+				// Compute AABB of cascade corners in light space
+				for (auto &p : cascadeCorners)
+				{
+					glm::vec3 ls = glm::vec3(lightView * glm::vec4(p, 1.f));
+					minLS = glm::min(minLS, ls);
+					maxLS = glm::max(maxLS, ls);
+				}
 			}
 
-			// Create ortho projection from AABB
+			// Create ortho projection from the light-space bounds
 			glm::mat4 proj = glm::ortho(minLS.x, maxLS.x, minLS.y, maxLS.y, -lightRange, lightRange * 2.0f);
+			data.boundsMin = glm::vec2(minLS);
+			data.boundsMax = glm::vec2(maxLS);
 			data.viewProj = proj * lightView;
 
 			data.near = cascadeNear;
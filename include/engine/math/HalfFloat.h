@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine::math
+{
+
+/**
+ * @class HalfFloat
+ * @brief IEEE 754 binary16 conversion, vectorized where the CPU allows it.
+ *
+ * Bulk conversions use F16C on x86 (selected at runtime) and the NEON conversion
+ * instructions on AArch64; other targets use the scalar path. All paths round to
+ * nearest-even, keep subnormals and map NaN/Inf like the hardware does, so results
+ * are bit-identical whichever path runs.
+ */
+class HalfFloat
+{
+  public:
+	/** @brief Convert one float to half (round to nearest-even). */
+	[[nodiscard]] static uint16_t fromFloat(float value);
+
+	/** @brief Convert one half to float (exact). */
+	[[nodiscard]] static float toFloat(uint16_t value);
+
+	/** @brief Convert count floats to halves. */
+	static void fromFloat(const float *src, uint16_t *dst, size_t count);
+
+	/** @brief Convert count halves to floats. */
+	static void toFloat(const uint16_t *src, float *dst, size_t count);
+
+	/**
+	 * @brief Convert RGB float pixels to RGBA half pixels in one pass, alpha set to 1.
+	 * @param src pixelCount * 3 floats.
+	 * @param dst pixelCount * 4 halves.
+	 */
+	static void fromFloatRGBToRGBA(const float *src, uint16_t *dst, size_t pixelCount);
+
+	/**
+	 * @brief Convert a float image to half floats, spreading rows over worker threads for large images.
+	 * @param src width * height * channels floats.
+	 * @param width Image width in pixels.
+	 * @param height Image height in pixels.
+	 * @param channels Channels per source pixel (1-4).
+	 * @param expandRGBToRGBA Write RGBA (alpha 1) when channels is 3.
+	 * @return The half-float pixels.
+	 */
+	[[nodiscard]] static std::vector<uint16_t> fromFloatImage(
+		const float *src,
+		uint32_t width,
+		uint32_t height,
+		uint32_t channels,
+		bool expandRGBToRGBA = true
+	);
+};
+
+} // namespace engine::math
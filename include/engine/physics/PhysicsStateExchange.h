@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "engine/core/SpscQueue.h"
+#include "engine/core/TripleBuffer.h"
+
+namespace engine::physics
+{
+
+/**
+ * @brief Command emitted by the physics thread for every completed fixed step.
+ */
+struct PhysicsStepCommand
+{
+	uint64_t stepIndex = 0;		 ///< Monotonic index of the fixed step
+	float fixedDeltaTime = 0.0f; ///< Timestep the physics engine advanced by
+};
+
+/**
+ * @brief Timing state published by the physics thread after each loop iteration.
+ */
+struct PhysicsFrameState
+{
+	uint64_t lastStepIndex = 0; ///< Index of the most recent completed step (0 = none yet)
+	float alpha = 0.0f;			///< Accumulator remainder / fixedDeltaTime, in [0, 1)
+};
+
+/**
+ * @class PhysicsStateExchange
+ * @brief Lock-free handoff between the physics thread (producer) and the game thread (consumer).
+ *
+ * The physics thread owns the fixed-step clock and the physics engine. It never touches the
+ * scene graph; instead it pushes one PhysicsStepCommand per step and publishes the current
+ * interpolation alpha. The game thread drains the commands, dispatches PhysicsNode::fixedUpdate
+ * on the scene it owns, and interpolates rendered transforms with the published alpha.
+ */
+class PhysicsStateExchange
+{
+  public:
+	static constexpr size_t COMMAND_CAPACITY = 64;
+
+	// --- Physics thread ---
+
+	/**
+	 * @brief Record a completed fixed step.
+	 * @return False if the game thread fell too far behind and the step was dropped.
+	 */
+	bool pushStep(const PhysicsStepCommand &command) { return m_commands.tryPush(command); }
+
+	/**
+	 * @brief Check whether a step can be recorded. Call before stepping the physics engine,
+	 * so a step is never simulated without being handed to the game thread.
+	 */
+	[[nodiscard]] bool canPushStep() const { return !m_commands.full(); }
+
+	/** @brief Publish the latest timing state. */
+	void publishState(const PhysicsFrameState &state) { m_state.write(state); }
+
+	// --- Game thread ---
+
+	/** @brief Pop the next pending fixed step, if any. */
+	std::optional<PhysicsStepCommand> popStep() { return m_commands.tryPop(); }
+
+	/**
+	 * @brief Get the most recently published timing state.
+	 * @note Only valid on the consumer thread; refreshes from the producer if a newer state exists.
+	 */
+	const PhysicsFrameState &latestState()
+	{
+		m_state.update();
+		return m_state.front();
+	}
+
+  private:
+	engine::core::SpscQueue<PhysicsStepCommand, COMMAND_CAPACITY> m_commands;
+	engine::core::TripleBuffer<PhysicsFrameState> m_state;
+};
+
+} // namespace engine::physics
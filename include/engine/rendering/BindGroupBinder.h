@@ -1,9 +1,8 @@
 #pragma once
 
+#include <array>
 #include <memory>
 #include <optional>
-#include <string>
-#include <unordered_map>
 #include <webgpu/webgpu.hpp>
 
 #include "engine/rendering/BindGroupEnums.h"
@@ -19,8 +18,37 @@ namespace webgpu
 class WebGPUBindGroup;
 class WebGPUBindGroupLayoutInfo;
 class WebGPUPipeline;
+class WebGPUShaderInfo;
+struct BindGroupSlot;
 } // namespace webgpu
 
+/**
+ * @brief Explicit bind groups for a draw, indexed by BindGroupType.
+ *
+ * Holds non-owning pointers in a fixed-size array so building and passing it
+ * per draw never allocates. The referenced bind groups must outlive the bind() call.
+ */
+struct BindGroupSet
+{
+	std::array<const webgpu::WebGPUBindGroup *, BIND_GROUP_TYPE_COUNT> groups{};
+
+	BindGroupSet &set(BindGroupType type, const webgpu::WebGPUBindGroup *bindGroup)
+	{
+		groups[static_cast<size_t>(type)] = bindGroup;
+		return *this;
+	}
+
+	BindGroupSet &set(BindGroupType type, const std::shared_ptr<webgpu::WebGPUBindGroup> &bindGroup)
+	{
+		return set(type, bindGroup.get());
+	}
+
+	[[nodiscard]] const webgpu::WebGPUBindGroup *get(BindGroupType type) const
+	{
+		return groups[static_cast<size_t>(type)];
+	}
+};
+
 /**
  * @brief Centralized bind group binding for render passes.
  *
@@ -34,6 +62,10 @@ class WebGPUPipeline;
  *
  * No manual reset() needed - fully automatic.
  *
+ * The per-draw path does not allocate: bind groups are resolved from the shader's
+ * precomputed BindGroupSlots, explicit groups come from a fixed-size BindGroupSet
+ * and custom groups are looked up by integer key.
+ *
  * Usage:
  * @code
  *   BindGroupBinder binder(&frameCache);
@@ -42,14 +74,21 @@ class WebGPUPipeline;
  *   binder.bind(renderPass, pipeline, cameraId, {}, objectId);
  *   
  *   // With explicit material bind group
- *   binder.bind(renderPass, pipeline, cameraId, 
- *               {{BindGroupType::Material, materialBG}}, 
- *               objectId, materialId);
+ *   BindGroupSet groups;
+ *   groups.set(BindGroupType::Material, materialBG);
+ *   binder.bind(renderPass, pipeline, cameraId, groups, objectId, materialId);
  * @endcode
+ *
+ * bind() is templated on the encoder so draw submission can also run against a
+ * RecordingEncoder (see examples/draw_benchmark). It is instantiated in
+ * BindGroupBinder.cpp for wgpu::RenderPassEncoder and RecordingEncoder.
  */
 class BindGroupBinder
 {
   public:
+	/** @brief Highest number of bind groups a pipeline can use (WebGPU maxBindGroups upper bound). */
+	static constexpr uint32_t MAX_BIND_GROUPS = 8;
+
 	explicit BindGroupBinder(FrameCache *frameCache) : m_frameCache(frameCache) {}
 
 	/**
@@ -60,7 +99,7 @@ class BindGroupBinder
 	 * 2. FrameCache (Frame, Object caches based on IDs)
 	 * 3. Custom bind group cache (for user-defined bind groups)
 	 *
-	 * @param renderPass WebGPU render pass encoder
+	 * @param renderPass Render pass encoder (wgpu::RenderPassEncoder or RecordingEncoder)
 	 * @param pipeline Pipeline containing shader info and layout
 	 * @param cameraId Camera ID for Frame bind group lookup
 	 * @param bindGroups Explicit bind groups to use (overrides cache lookup)
@@ -68,11 +107,25 @@ class BindGroupBinder
 	 * @param materialId Material ID for Material bind group lookup (optional)
 	 * @return true if all required bind groups were bound successfully
 	 */
+	template <typename Encoder>
 	bool bind(
-		wgpu::RenderPassEncoder &renderPass,
+		Encoder &renderPass,
 		const std::shared_ptr<webgpu::WebGPUPipeline> &pipeline,
 		uint64_t cameraId,
-		const std::unordered_map<BindGroupType, std::shared_ptr<webgpu::WebGPUBindGroup>> &bindGroups = {},
+		const BindGroupSet &bindGroups = {},
+		std::optional<uint64_t> objectId = std::nullopt,
+		std::optional<uint64_t> materialId = std::nullopt
+	);
+
+	/**
+	 * @brief Binds all bind groups declared by shaderInfo; same as the pipeline overload.
+	 */
+	template <typename Encoder>
+	bool bind(
+		Encoder &renderPass,
+		const webgpu::WebGPUShaderInfo &shaderInfo,
+		uint64_t cameraId,
+		const BindGroupSet &bindGroups = {},
 		std::optional<uint64_t> objectId = std::nullopt,
 		std::optional<uint64_t> materialId = std::nullopt
 	);
@@ -86,10 +139,9 @@ class BindGroupBinder
 	 * 2. Explicit bindGroups parameter
 	 * 3. Type-specific caches (frameBindGroupCache, objectBindGroupCache)
 	 */
-	std::shared_ptr<webgpu::WebGPUBindGroup> findBindGroup(
-		const std::shared_ptr<webgpu::WebGPUBindGroupLayoutInfo> &layoutInfo,
-		const std::string &shaderName,
-		const std::unordered_map<BindGroupType, std::shared_ptr<webgpu::WebGPUBindGroup>> &bindGroups,
+	const webgpu::WebGPUBindGroup *findBindGroup(
+		const webgpu::BindGroupSlot &slot,
+		const BindGroupSet &bindGroups,
 		uint64_t cameraId,
 		std::optional<uint64_t> objectId,
 		std::optional<uint64_t> materialId
@@ -99,23 +151,24 @@ class BindGroupBinder
 	 * @brief Binds a bind group if it differs from the currently bound group.
 	 * @return true if bound or already bound with same group
 	 */
+	template <typename Encoder>
 	bool bindGroupAtIndex(
-		wgpu::RenderPassEncoder &renderPass,
+		Encoder &renderPass,
 		uint32_t groupIndex,
-		const std::shared_ptr<webgpu::WebGPUBindGroup> &bindGroup
+		const webgpu::WebGPUBindGroup *bindGroup
 	);
 
 	// Dependencies
 	FrameCache *m_frameCache = nullptr;
 
 	// State tracking for automatic rebinding detection
-	WGPURenderPassEncoder m_lastRenderPassHandle = nullptr;
+	const void *m_lastEncoder = nullptr; ///< WGPU handle for real passes, object address for recording encoders
 	uint64_t m_lastCameraId = 0;
 	std::optional<uint64_t> m_lastObjectId;
 	std::optional<uint64_t> m_lastMaterialId;
 
 	// Currently bound bind groups (group index → bind group pointer)
-	std::unordered_map<uint32_t, const webgpu::WebGPUBindGroup *> m_boundBindGroups;
+	std::array<const webgpu::WebGPUBindGroup *, MAX_BIND_GROUPS> m_boundBindGroups{};
 };
 
 } // namespace engine::rendering
\ No newline at end of file
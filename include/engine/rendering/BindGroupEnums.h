@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 namespace engine::rendering
 {
 /**
@@ -31,6 +33,9 @@ enum class BindGroupType
 	Custom,
 };
 
+/** @brief Number of BindGroupType values, for arrays indexed by type. */
+constexpr size_t BIND_GROUP_TYPE_COUNT = static_cast<size_t>(BindGroupType::Custom) + 1;
+
 /**
  * @brief Type of a single binding inside a bind group.
  */
@@ -62,12 +62,15 @@ class CompositePass : public RenderPass
 
   private:
 	/**
-	 * @brief Get or create a bind group for the given texture.
+	 * @brief Get or create the bind group of a render target.
+	 * Rebuilt only when the target's texture, its view (e.g. after a resize) or the pipeline generation changed.
+	 * @param targetId Render target (camera) id.
 	 * @param texture The texture to create a bind group for.
 	 * @param layerIndex Optional array layer index for array or cube map textures. Default is -1 (entire texture).
 	 * @return Cached or newly created bind group.
 	 */
 	std::shared_ptr<webgpu::WebGPUBindGroup> getOrCreateBindGroup(
+		uint64_t targetId,
 		const std::shared_ptr<webgpu::WebGPUTexture> &texture,
 		int layerIndex = -1
 	);
@@ -79,8 +82,14 @@ class CompositePass : public RenderPass
 	// External dependencies (set via setters)
 	std::shared_ptr<webgpu::WebGPURenderPassContext> m_renderPassContext;
 
-	// Bind group cache by texture pointer
-	std::unordered_map<uint64_t, std::shared_ptr<webgpu::WebGPUBindGroup>> m_bindGroupCache;
+	struct CachedBindGroup
+	{
+		std::shared_ptr<webgpu::WebGPUBindGroup> bindGroup;
+		std::weak_ptr<webgpu::WebGPUTexture> texture; ///< Expired or different texture forces a rebuild
+		WGPUTextureView view = nullptr;				  ///< View the bind group references
+		uint64_t generation = 0;					  ///< Pipeline generation (bumped on shader reload)
+	};
+	std::unordered_map<uint64_t, CachedBindGroup> m_bindGroupCache; ///< Key: render target id
 };
 
 } // namespace engine::rendering
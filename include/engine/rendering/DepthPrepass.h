@@ -0,0 +1,123 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <webgpu/webgpu.hpp>
+
+#include <glm/glm.hpp>
+
+#include "engine/rendering/Mesh.h"
+#include "engine/rendering/RenderPass.h"
+
+namespace engine::rendering
+{
+struct FrameCache;
+
+namespace webgpu
+{
+class WebGPUBindGroup;
+class WebGPUContext;
+class WebGPUMaterial;
+class WebGPUPipeline;
+class WebGPURenderPassContext;
+} // namespace webgpu
+
+/**
+ * @class DepthPrepass
+ * @brief Depth-only pass that lays down camera depth before the MeshPass.
+ *
+ * Renders the visible opaque items with the depth-only shadow shader, using the camera
+ * view-projection in place of a light's. The MeshPass then draws those items with
+ * depthCompare = Equal and depth writes disabled, so the PBR fragment shader runs at most
+ * once per pixel regardless of overdraw.
+ *
+ * Alpha-tested and transparent materials are skipped: their depth depends on the fragment
+ * shader, so they keep regular depth testing in the MeshPass.
+ */
+class DepthPrepass : public RenderPass
+{
+  public:
+	explicit DepthPrepass(std::shared_ptr<webgpu::WebGPUContext> context);
+
+	~DepthPrepass() override = default;
+
+	/**
+	 * @brief Initialize the pass bind group (camera view-projection).
+	 * @return True if initialization succeeded.
+	 */
+	bool initialize() override;
+
+	/**
+	 * @brief Set the depth-only render pass context (clears and writes the camera depth buffer).
+	 * @param context Render pass context with a depth attachment and no color attachment.
+	 */
+	void setRenderPassContext(const std::shared_ptr<webgpu::WebGPURenderPassContext> &context)
+	{
+		m_renderPassContext = context;
+	}
+
+	/**
+	 * @brief Set the camera the depth is rendered for.
+	 * @param viewProjection Camera view-projection matrix.
+	 * @param cameraPosition Camera world position.
+	 * @param farPlane Camera far plane distance.
+	 */
+	void setCamera(const glm::mat4 &viewProjection, const glm::vec3 &cameraPosition, float farPlane)
+	{
+		m_viewProjection = viewProjection;
+		m_cameraPosition = cameraPosition;
+		m_farPlane = farPlane;
+	}
+
+	/**
+	 * @brief Set visible indices for this render pass (same as the MeshPass).
+	 * @param indices Indices of items visible to the camera.
+	 */
+	void setVisibleIndices(const std::vector<size_t> &indices)
+	{
+		m_visibleIndices = indices;
+	}
+
+	/**
+	 * @brief Render the depth of all eligible visible items.
+	 * @param frameCache Frame data holding the GPU render items.
+	 */
+	void render(FrameCache &frameCache) override;
+
+	/**
+	 * @brief Release cached resources.
+	 */
+	void cleanup() override;
+
+	/**
+	 * @brief Check if a material's depth is written by the pre-pass.
+	 * @param material GPU material of the item.
+	 * @return True for opaque materials without alpha test.
+	 */
+	static bool isEligible(const webgpu::WebGPUMaterial &material);
+
+	/** @brief Number of items drawn by the last render() call. */
+	[[nodiscard]] size_t getLastDrawCount() const { return m_lastDrawCount; }
+
+  private:
+	/**
+	 * @brief Get the depth-only pipeline for a topology and cull mode.
+	 * Cull mode follows the material so double-sided surfaces are pre-passed too.
+	 */
+	std::shared_ptr<webgpu::WebGPUPipeline> getOrCreatePipeline(
+		Topology::Type topology,
+		wgpu::CullMode cullMode,
+		wgpu::TextureFormat depthFormat
+	);
+
+	std::shared_ptr<webgpu::WebGPURenderPassContext> m_renderPassContext;
+	std::vector<size_t> m_visibleIndices;
+	glm::mat4 m_viewProjection{1.0f};
+	glm::vec3 m_cameraPosition{0.0f};
+	float m_farPlane = 100.0f;
+
+	std::shared_ptr<webgpu::WebGPUBindGroup> m_passBindGroup; ///< Camera view-projection (shadow pass 2D layout)
+	size_t m_lastDrawCount = 0;
+};
+
+} // namespace engine::rendering
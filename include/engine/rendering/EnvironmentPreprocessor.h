@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "engine/resources/Image.h"
+
+namespace engine::rendering
+{
+
+/**
+ * @brief Image-based lighting derived from an equirectangular environment map.
+ */
+struct EnvironmentLighting
+{
+	uint64_t contentHash = 0;						 ///< Hash of the source image and the preprocessing version
+	std::array<glm::vec4, 9> irradianceSH{};		 ///< L2 SH of the diffuse irradiance over pi (rgb), ready to evaluate
+	std::vector<std::vector<uint16_t>> specularMips; ///< RGBA16F equirect levels, level i prefiltered for roughness i / (count - 1)
+};
+
+/**
+ * @class EnvironmentPreprocessor
+ * @brief Turns an equirectangular environment map into diffuse SH and prefiltered specular levels.
+ *
+ * The diffuse irradiance is projected to 9 L2 spherical harmonics coefficients with the cosine
+ * lobe and 1/pi already applied, so the shader evaluates a short polynomial in the normal instead
+ * of sampling the map. The specular chain is a fixed-size equirect whose mips are GGX-prefiltered
+ * for increasing roughness (filtered importance sampling from a box-filtered source pyramid).
+ * Together with the BRDF lookup table this is the split-sum approximation.
+ *
+ * Both run on the CPU, rows spread over worker threads. Results are cached on disk keyed by the
+ * content hash of the source image, so an environment is only processed once.
+ */
+class EnvironmentPreprocessor
+{
+  public:
+	/** @brief Width of specular mip 0 (the height is half). */
+	static constexpr uint32_t SPECULAR_WIDTH = 512;
+	/** @brief Specular levels, roughness 0 to 1 (512x256 down to 8x4). */
+	static constexpr uint32_t SPECULAR_MIP_COUNT = 7;
+	/** @brief Width and height of the BRDF lookup table. */
+	static constexpr uint32_t BRDF_LUT_SIZE = 64;
+
+	/**
+	 * @brief Get the lighting of an environment map, from the disk cache if present.
+	 * @param environment Equirectangular map (LDR, HDR or BC-compressed).
+	 * @param cacheDirectory Directory of cached results (empty = no disk cache).
+	 * @return The lighting, std::nullopt if the image cannot be read.
+	 */
+	[[nodiscard]] static std::optional<EnvironmentLighting> process(
+		const engine::resources::Image &environment,
+		const std::filesystem::path &cacheDirectory = {}
+	);
+
+	/**
+	 * @brief Compute the lighting of an environment map (no caching).
+	 * @param environment Equirectangular map (LDR, HDR or BC-compressed).
+	 * @return The lighting without contentHash, std::nullopt if the image cannot be read.
+	 */
+	[[nodiscard]] static std::optional<EnvironmentLighting> compute(const engine::resources::Image &environment);
+
+	/**
+	 * @brief Split-sum BRDF lookup table, computed once per process.
+	 * @return RG16F texels (scale and bias applied to F0), x = N.V, y = roughness, row-major.
+	 */
+	[[nodiscard]] static const std::vector<uint16_t> &getBRDFLut();
+
+	/** @brief Cache file of a content hash in a cache directory. */
+	[[nodiscard]] static std::filesystem::path getCachePath(const std::filesystem::path &cacheDirectory, uint64_t contentHash);
+
+  private:
+	static std::optional<EnvironmentLighting> loadCache(const std::filesystem::path &path, uint64_t contentHash);
+	static bool saveCache(const std::filesystem::path &path, const EnvironmentLighting &lighting);
+};
+
+} // namespace engine::rendering
@@ -0,0 +1,14 @@
+#pragma once
+#include <glm/glm.hpp>
+
+namespace engine::rendering
+{
+
+struct EnvironmentUniforms
+{
+	glm::vec4 params;		   // x: image-based lighting enabled, y: intensity, z: skybox enabled, w: specular max lod
+	glm::vec4 irradianceSH[9]; // L2 SH of the diffuse irradiance over pi (rgb)
+};
+static_assert(sizeof(EnvironmentUniforms) % 16 == 0, "EnvironmentUniforms must match shader layout");
+
+} // namespace engine::rendering
@@ -3,9 +3,11 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
+#include "engine/core/Hash.h"
 #include "engine/rendering/Light.h"
 #include "engine/rendering/RenderItemGPU.h"
 #include "engine/rendering/RenderTarget.h"
@@ -37,7 +39,7 @@ struct BindGroupDataProvider;
  * Caches:
  * - frameBindGroupCache: Frame bind groups per camera (key: cameraId)
  * - objectBindGroupCache: Object bind groups per object (key: objectId)
- * - customBindGroupCache: Custom user bind groups (key: "ShaderName:BindGroupName[:InstanceId]")
+ * - customBindGroupCache: Custom user bind groups (key: hash of "ShaderName:BindGroupName" [+ InstanceId])
  *
  * Lifecycle:
  * @code
@@ -60,9 +62,9 @@ struct FrameCache
 
 	/**
 	 * @brief Cache for custom user-defined bind groups.
-	 * Key format:
-	 *   - Shared (instanceId=nullopt): "ShaderName:BindGroupName" (for Global/PerFrame reuse)
-	 *   - Per-instance (instanceId=value): "ShaderName:BindGroupName:InstanceId" (for PerObject/PerMaterial reuse)
+	 * Key format (64-bit, see createCustomBindGroupCacheKey()):
+	 *   - Shared (instanceId=nullopt): hash of "ShaderName:BindGroupName" (for Global/PerFrame reuse)
+	 *   - Per-instance (instanceId=value): that hash combined with InstanceId (for PerObject/PerMaterial reuse)
 	 *
 	 * The BindGroupReuse policy from the shader's bind group layout determines caching behavior:
 	 *   - Global/PerFrame: instanceId should be nullopt (shared across all objects)
@@ -82,40 +84,53 @@ struct FrameCache
 	 *
 	 * Renderer automatically calls processBindGroupProviders() which creates/updates the bind group.
 	 */
-	std::unordered_map<std::string, std::shared_ptr<webgpu::WebGPUBindGroup>> customBindGroupCache;
+	std::unordered_map<uint64_t, std::shared_ptr<webgpu::WebGPUBindGroup>> customBindGroupCache;
 
 	float time = 0.0f; ///< Current frame time
 
+	/**
+	 * @brief Creates the shared part of a custom bind group cache key.
+	 * Equal to the FNV-1a hash of "ShaderName:BindGroupName". Shader infos precompute
+	 * this per bind group (see webgpu::BindGroupSlot) so draws never hash strings.
+	 *
+	 * @param shaderName Name of the shader
+	 * @param bindGroupName Name of the bind group
+	 * @return Base cache key
+	 */
+	static constexpr uint64_t createCustomBindGroupBaseKey(std::string_view shaderName, std::string_view bindGroupName)
+	{
+		return core::fnv1a64(bindGroupName, core::fnv1a64(":", core::fnv1a64(shaderName)));
+	}
+
+	/**
+	 * @brief Creates a cache key for custom bind groups from a precomputed base key.
+	 * @param baseKey Result of createCustomBindGroupBaseKey()
+	 * @param instanceId Optional instance ID for per-object/material bind groups
+	 * @return Cache key
+	 */
+	static constexpr uint64_t createCustomBindGroupCacheKey(uint64_t baseKey, std::optional<uint64_t> instanceId = std::nullopt)
+	{
+		return instanceId.has_value() ? core::hashCombine(baseKey, instanceId.value()) : baseKey;
+	}
+
 	/**
 	 * @brief Creates a cache key for custom bind groups.
 	 * Key format:
-	 *   - Shared (no instanceId): "ShaderName:BindGroupName"
-	 *   - Per-instance (with instanceId): "ShaderName:BindGroupName:InstanceId"
+	 *   - Shared (no instanceId): hash of "ShaderName:BindGroupName"
+	 *   - Per-instance (with instanceId): that hash combined with InstanceId
 	 *
 	 * @param shaderName Name of the shader
 	 * @param bindGroupName Name of the bind group
 	 * @param instanceId Optional instance ID for per-object/material bind groups
-	 * @return Cache key string
+	 * @return Cache key
 	 */
-	static std::string createCustomBindGroupCacheKey(
-		const std::string &shaderName,
-		const std::string &bindGroupName,
+	static constexpr uint64_t createCustomBindGroupCacheKey(
+		std::string_view shaderName,
+		std::string_view bindGroupName,
 		std::optional<uint64_t> instanceId = std::nullopt
 	)
 	{
-		std::string cacheKey;
-		cacheKey.reserve(shaderName.size() + bindGroupName.size() + 20);
-		cacheKey = shaderName;
-		cacheKey += ':';
-		cacheKey += bindGroupName;
-
-		if (instanceId.has_value())
-		{
-			cacheKey += ':';
-			cacheKey += std::to_string(instanceId.value());
-		}
-
-		return cacheKey;
+		return createCustomBindGroupCacheKey(createCustomBindGroupBaseKey(shaderName, bindGroupName), instanceId);
 	}
 
 	/**
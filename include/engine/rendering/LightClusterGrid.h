@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "engine/rendering/LightUniforms.h"
+#include "engine/rendering/RenderingConstants.h"
+
+namespace engine::rendering
+{
+
+/**
+ * @class LightClusterGrid
+ * @brief Bins lights into a per-camera froxel grid for clustered forward shading.
+ *
+ * The view frustum is split into LIGHT_CLUSTER_GRID_X x LIGHT_CLUSTER_GRID_Y screen tiles and
+ * LIGHT_CLUSTER_GRID_Z depth slices distributed exponentially between the near and far plane.
+ * Point and spot lights are bounded by a sphere of their range and listed in every cluster the
+ * sphere overlaps; ambient and directional lights go to a global list that shades every fragment.
+ * The fragment shader looks up its cluster and only iterates the lights listed there.
+ *
+ * Depth slices own disjoint clusters, so with many lights the slices are binned on the shared
+ * core::WorkerPool (persistent threads, no per-frame thread creation); with few lights binning
+ * stays serial on the calling thread.
+ * All buffers are reused across frames.
+ *
+ * Usage:
+ * @code
+ *   grid.build(lights, view, projection, nearPlane, farPlane);
+ *   upload(grid.getHeader(), grid.getClusters(), grid.getLightIndices());
+ * @endcode
+ */
+class LightClusterGrid
+{
+  public:
+	LightClusterGrid();
+
+	/**
+	 * @brief Rebuild the grid for a camera.
+	 * @param lights Lights of the frame (at most MAX_LIGHTS are used).
+	 * @param viewMatrix Camera view matrix.
+	 * @param projectionMatrix Camera projection matrix.
+	 * @param nearPlane Camera near plane distance.
+	 * @param farPlane Camera far plane distance.
+	 */
+	void build(
+		const std::vector<LightStruct> &lights,
+		const glm::mat4 &viewMatrix,
+		const glm::mat4 &projectionMatrix,
+		float nearPlane,
+		float farPlane
+	);
+
+	/** @brief Light buffer header describing the grid (upload before the light array). */
+	[[nodiscard]] const LightsBuffer &getHeader() const { return m_header; }
+
+	/** @brief Offset/count into the light index list per cluster, LIGHT_CLUSTER_COUNT entries. */
+	[[nodiscard]] const std::vector<LightCluster> &getClusters() const { return m_clusters; }
+
+	/** @brief Light index list: global lights first, then the lights of each cluster. */
+	[[nodiscard]] const std::vector<uint32_t> &getLightIndices() const { return m_lightIndices; }
+
+	/** @brief Number of point/spot lights that touched at least one cluster in the last build. */
+	[[nodiscard]] size_t getVisibleLocalLightCount() const { return m_bounds.size(); }
+
+  private:
+	static constexpr uint32_t TILES_PER_SLICE = constants::LIGHT_CLUSTER_GRID_X * constants::LIGHT_CLUSTER_GRID_Y;
+	static constexpr size_t PARALLEL_BINNING_THRESHOLD = 256; ///< Local lights before binning wakes the worker pool
+
+	/**
+	 * @brief Cluster range covered by one local light.
+	 */
+	struct LightBounds
+	{
+		uint32_t lightIndex = 0;
+		uint32_t minX = 0, maxX = 0;
+		uint32_t minY = 0, maxY = 0;
+		uint32_t minZ = 0, maxZ = 0;
+	};
+
+	/**
+	 * @brief Per depth slice binning state, written by one worker only.
+	 */
+	struct Slice
+	{
+		std::vector<uint32_t> bounds;  ///< Indices into m_bounds overlapping this slice
+		std::vector<uint32_t> counts;  ///< Lights per tile, then write cursor (tile end once binned)
+		std::vector<uint32_t> offsets; ///< Start of each tile in indices
+		std::vector<uint32_t> indices; ///< Light indices of all tiles, tile after tile
+	};
+
+	bool computeBounds(const LightStruct &light, uint32_t lightIndex, LightBounds &outBounds) const;
+	[[nodiscard]] uint32_t depthToSlice(float viewDepth) const;
+	void binSlice(uint32_t z);
+
+	glm::mat4 m_viewMatrix{1.0f};
+	glm::mat4 m_projectionMatrix{1.0f};
+	float m_nearPlane = 0.1f;
+	float m_farPlane = 100.0f;
+
+	LightsBuffer m_header;
+	std::vector<LightCluster> m_clusters;
+	std::vector<uint32_t> m_lightIndices;
+	std::vector<LightBounds> m_bounds;
+	std::vector<Slice> m_slices;
+	bool m_overflowWarned = false;
+};
+
+} // namespace engine::rendering
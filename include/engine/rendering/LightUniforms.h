@@ -23,11 +23,22 @@ static_assert(sizeof(LightStruct) % 16 == 0, "LightStruct must match WGSL layout
 
 struct LightsBuffer
 {
-	uint32_t count = 0;
-	float _pad1 = 0.0f;
-	float _pad2 = 0.0f;
-	float _pad3 = 0.0f;
+	uint32_t count = 0;				 //< Lights in the array
+	uint32_t globalCount = 0;		 //< Ambient/directional lights, listed first in the light index list
+	uint32_t clusterCountX = 0;		 //< Cluster grid dimensions
+	uint32_t clusterCountY = 0;
+	uint32_t clusterCountZ = 0;
+	float clusterDepthScale = 0.0f;	 //< slice = log(viewDepth) * scale + bias
+	float clusterDepthBias = 0.0f;
+	float _pad1 = 0.0f;				 //< (total: 32 bytes)
 };
 static_assert(sizeof(LightsBuffer) % 16 == 0, "LightsBuffer must match WGSL layout");
 
+struct LightCluster
+{
+	uint32_t offset = 0; //< First entry in the light index list
+	uint32_t count = 0;	 //< Number of lights affecting the cluster
+};
+static_assert(sizeof(LightCluster) == 8, "LightCluster must match WGSL layout");
+
 } // namespace engine::rendering
@@ -96,6 +96,16 @@ struct PBRProperties
 };
 static_assert(sizeof(PBRProperties) % 16 == 0, "PBRProperties must be 16-byte aligned");
 
+/**
+ * @brief Array layer of each material texture binding, in binding order.
+ * Selects the material's layer when its textures are bound as texture_2d_array pages.
+ */
+struct MaterialTextureLayers
+{
+	uint32_t layers[8] = {};
+};
+static_assert(sizeof(MaterialTextureLayers) % 16 == 0, "MaterialTextureLayers must be 16-byte aligned");
+
 struct UnlitProperties
 {
 	glm::vec4 color{1.f, 1.f, 1.f, 1.f}; // rgb + opacity
@@ -7,9 +7,11 @@
 
 #include "engine/core/Handle.h"
 #include "engine/rendering/FrameUniforms.h"
+#include "engine/rendering/LightClusterGrid.h"
 #include "engine/rendering/LightUniforms.h"
 #include "engine/rendering/Model.h"
 #include "engine/rendering/RenderPass.h"
+#include "engine/rendering/StaticDrawCache.h"
 #include "engine/rendering/webgpu/WebGPUBindGroup.h"
 #include "engine/rendering/webgpu/WebGPUBindGroupLayoutInfo.h"
 #include "engine/rendering/webgpu/WebGPUMaterial.h"
@@ -73,6 +75,27 @@ class MeshPass : public RenderPass
 		m_cameraId = id;
 	}
 
+	/**
+	 * @brief Set the camera the lights are clustered for.
+	 * @param viewMatrix Camera view matrix.
+	 * @param projectionMatrix Camera projection matrix.
+	 * @param nearPlane Camera near plane distance.
+	 * @param farPlane Camera far plane distance.
+	 */
+	void setCameraView(const glm::mat4 &viewMatrix, const glm::mat4 &projectionMatrix, float nearPlane, float farPlane)
+	{
+		m_viewMatrix = viewMatrix;
+		m_projectionMatrix = projectionMatrix;
+		m_nearPlane = nearPlane;
+		m_farPlane = farPlane;
+	}
+
+	/**
+	 * @brief Access the light cluster grid of the last rendered camera (statistics).
+	 * @return Reference to the light cluster grid.
+	 */
+	const LightClusterGrid &getLightClusterGrid() const { return m_lightClusters; }
+
 	/**
 	 * @brief Set visible indices for this render pass.
 	 * @param indices Indices of items visible to the camera.
@@ -100,6 +123,36 @@ class MeshPass : public RenderPass
 		m_environmentBindGroup = bindGroup;
 	}
 
+	/**
+	 * @brief Declare whether a DepthPrepass wrote this camera's depth before the pass.
+	 * Eligible items are then drawn with depthCompare = Equal and depth writes disabled;
+	 * the render pass context must load (not clear) the depth buffer.
+	 * @param prepassed True if the depth pre-pass ran for the current camera.
+	 */
+	void setDepthPrepassed(bool prepassed)
+	{
+		m_depthPrepassed = prepassed;
+	}
+
+	/**
+	 * @brief Enable or disable the static draw cache.
+	 * When enabled, visible static items are replayed from cached draw packets / render bundles
+	 * before the remaining items are drawn the regular way.
+	 * @param enabled True to use the cache.
+	 */
+	void setStaticDrawCacheEnabled(bool enabled)
+	{
+		m_staticDrawCacheEnabled = enabled;
+		if (!enabled)
+			m_staticDrawCache.clear();
+	}
+
+	/**
+	 * @brief Access the static draw cache (statistics, bundle toggle).
+	 * @return Reference to the static draw cache.
+	 */
+	StaticDrawCache &getStaticDrawCache() { return m_staticDrawCache; }
+
 	/**
 	 * @brief Render meshes using data from FrameCache.
 	 * Accesses: frameCache.gpuRenderItems, frameCache.lightUniforms
@@ -116,8 +169,8 @@ class MeshPass : public RenderPass
 
   private:
 	/**
-	 * @brief Update light uniforms.
-	 * @param frameCache The frame cache containing light bind groups.
+	 * @brief Cluster the frame's lights for the current camera and upload them.
+	 * @param frameCache The frame cache containing the light uniforms.
 	 * @return True if update succeeded.
 	 */
 	bool updateLightUniforms(FrameCache &frameCache);
@@ -153,14 +206,28 @@ class MeshPass : public RenderPass
 	std::shared_ptr<webgpu::WebGPURenderPassContext> m_renderPassContext;
 	uint64_t m_cameraId = 0;
 	std::vector<size_t> m_visibleIndices;
+	bool m_depthPrepassed = false;
+	glm::mat4 m_viewMatrix{1.0f};
+	glm::mat4 m_projectionMatrix{1.0f};
+	float m_nearPlane = 0.1f;
+	float m_farPlane = 100.0f;
 
 	// Bind group layouts
 	std::shared_ptr<webgpu::WebGPUBindGroupLayoutInfo> m_lightBindGroupLayout;
 
+	// Clustered lighting
+	LightClusterGrid m_lightClusters;
+	bool m_lightLimitWarned = false;
+
 	// Cached bind groups
 	std::shared_ptr<webgpu::WebGPUBindGroup> m_shadowBindGroup;
 	std::shared_ptr<webgpu::WebGPUBindGroup> m_lightBindGroup;
 	std::shared_ptr<webgpu::WebGPUBindGroup> m_environmentBindGroup;
+
+	// Static geometry
+	StaticDrawCache m_staticDrawCache;
+	bool m_staticDrawCacheEnabled = true;
+	std::vector<size_t> m_dynamicIndices; ///< Scratch: visible items not drawn by the static cache
 };
 
 } // namespace engine::rendering
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <webgpu/webgpu.hpp>
+
+namespace engine::rendering
+{
+
+/**
+ * @brief Render pass encoder stand-in that records commands instead of submitting them.
+ *
+ * Mirrors the subset of wgpu::RenderPassEncoder used by draw submission, so code templated
+ * on the encoder (e.g. BindGroupBinder::bind) can be measured without GPU or driver cost.
+ * Commands go into a vector that keeps its capacity across reset(); after the first frame
+ * recording does not allocate.
+ */
+class RecordingEncoder
+{
+  public:
+	enum class CommandType : uint8_t
+	{
+		SetPipeline,
+		SetBindGroup,
+		SetVertexBuffer,
+		SetIndexBuffer,
+		Draw,
+		DrawIndexed,
+		Count
+	};
+
+	struct Command
+	{
+		CommandType type = CommandType::Draw;
+		uint32_t index = 0;			  ///< Group/slot index, or vertex/index count for draws
+		const void *handle = nullptr; ///< Underlying WebGPU handle (may be null)
+	};
+
+	explicit RecordingEncoder(size_t reserveCommands = 0) { m_commands.reserve(reserveCommands); }
+
+	void setPipeline(wgpu::RenderPipeline pipeline)
+	{
+		record(CommandType::SetPipeline, 0, static_cast<WGPURenderPipeline>(pipeline));
+	}
+
+	void setBindGroup(uint32_t groupIndex, wgpu::BindGroup group, size_t /*dynamicOffsetCount*/, const uint32_t * /*dynamicOffsets*/)
+	{
+		record(CommandType::SetBindGroup, groupIndex, static_cast<WGPUBindGroup>(group));
+	}
+
+	void setVertexBuffer(uint32_t slot, wgpu::Buffer buffer, uint64_t /*offset*/, uint64_t /*size*/)
+	{
+		record(CommandType::SetVertexBuffer, slot, static_cast<WGPUBuffer>(buffer));
+	}
+
+	void setIndexBuffer(wgpu::Buffer buffer, wgpu::IndexFormat /*format*/, uint64_t /*offset*/, uint64_t /*size*/)
+	{
+		record(CommandType::SetIndexBuffer, 0, static_cast<WGPUBuffer>(buffer));
+	}
+
+	void draw(uint32_t vertexCount, uint32_t /*instanceCount*/, uint32_t /*firstVertex*/, uint32_t /*firstInstance*/)
+	{
+		record(CommandType::Draw, vertexCount, nullptr);
+	}
+
+	void drawIndexed(uint32_t indexCount, uint32_t /*instanceCount*/, uint32_t /*firstIndex*/, int32_t /*baseVertex*/, uint32_t /*firstInstance*/)
+	{
+		record(CommandType::DrawIndexed, indexCount, nullptr);
+	}
+
+	/** @brief Drops recorded commands but keeps the storage. */
+	void reset()
+	{
+		m_commands.clear();
+		m_counts.fill(0);
+	}
+
+	[[nodiscard]] const std::vector<Command> &getCommands() const { return m_commands; }
+
+	/** @brief Number of recorded commands of the given type since the last reset(). */
+	[[nodiscard]] size_t count(CommandType type) const { return m_counts[static_cast<size_t>(type)]; }
+
+  private:
+	void record(CommandType type, uint32_t index, const void *handle)
+	{
+		m_commands.push_back({type, index, handle});
+		++m_counts[static_cast<size_t>(type)];
+	}
+
+	std::vector<Command> m_commands;
+	std::array<size_t, static_cast<size_t>(CommandType::Count)> m_counts{};
+};
+
+} // namespace engine::rendering
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <glm/glm.hpp>
 #include <memory>
 #include <unordered_map>
@@ -34,12 +35,17 @@ struct RenderItemCPU
 	uint64_t objectID = 0; // Unique object ID for bind group caching
 	std::weak_ptr<engine::scene::nodes::Node> renderNode; // Source node for preRender() callback
 	bool isTransparent = false; // Cached transparency flag for efficient sorting
+	bool isStatic = false; // Never moves or changes model/material; eligible for the static draw cache
+	uint32_t depthBucket = 0; // Coarse view depth for front-to-back opaque ordering (set by RenderCollector::sort)
 
 	bool operator<(const RenderItemCPU &other) const
 	{
 		if (renderLayer != other.renderLayer)
 			return renderLayer < other.renderLayer;
 
+		if (depthBucket != other.depthBucket)
+			return depthBucket < other.depthBucket;
+
 		auto aMatId = submesh.material.id();
 		auto bMatId = other.submesh.material.id();
 		if (aMatId != bMatId)
@@ -74,13 +80,15 @@ class RenderCollector
 	 * @param layer Render layer for sorting.
 	 * @param objectID Unique ID for bind group caching (e.g., node ID).
 	 * @param node Source node for preRender() callbacks (can be nullptr).
+	 * @param isStatic Whether the model is static scenery (see RenderItemCPU::isStatic).
 	 */
 	void addModel(
 		const engine::core::Handle<engine::rendering::Model> &model,
 		const glm::mat4 &transform,
 		uint32_t layer,
 		uint64_t objectID,
-		std::shared_ptr<engine::scene::nodes::Node> node = nullptr
+		std::shared_ptr<engine::scene::nodes::Node> node = nullptr,
+		bool isStatic = false
 	);
 
 	/**
@@ -90,12 +98,14 @@ class RenderCollector
 	void addLight(const Light &light);
 
 	/**
-	 * @brief Sorts render items by layer, then by material for batching.
-	 * Opaque objects are rendered front-to-back (for depth culling efficiency).
+	 * @brief Sorts render items for drawing.
+	 * Opaque objects are sorted by layer, then coarse view depth bucket (front-to-back, for early
+	 * depth rejection), then material and model (for batching within a bucket).
 	 * Transparent objects are rendered back-to-front (for correct alpha blending).
-	 * @param cameraPosition Camera position for distance-based sorting of transparent objects.
+	 * @param cameraPosition Camera position for distance-based sorting.
+	 * @param cameraForward Camera view direction; zero falls back to the distance to the camera.
 	 */
-	void sort(const glm::vec3 &cameraPosition = glm::vec3(0.0f));
+	void sort(const glm::vec3 &cameraPosition = glm::vec3(0.0f), const glm::vec3 &cameraForward = glm::vec3(0.0f));
 
 	/**
 	 * @brief Clears all collected items.
@@ -124,6 +134,42 @@ class RenderCollector
 	 */
 	[[nodiscard]] std::vector<size_t> extractForPointLight(const glm::vec3 &lightPosition, float lightRange) const;
 
+	/**
+	 * @brief Extracts the shadow casters of all cascades of a directional light in one pass.
+	 * Each item's bounds are moved to light view space once and then tested against the
+	 * light-view rectangle of every cascade, instead of culling the full list per cascade.
+	 * @param lightView Light view matrix shared by the cascades.
+	 * @param cascades Cascades (boundsMin/boundsMax are used).
+	 * @param zNear Near plane of the cascade projections (light view space, as passed to glm::ortho).
+	 * @param zFar Far plane of the cascade projections.
+	 * @param outIndices Receives the item indices per cascade (resized to the cascade count).
+	 */
+	void extractForCascades(
+		const glm::mat4 &lightView,
+		const std::vector<engine::math::Frustum::CascadeData> &cascades,
+		float zNear,
+		float zFar,
+		std::vector<std::vector<size_t>> &outIndices
+	) const;
+
+	/**
+	 * @brief Extracts the shadow casters of a point light and assigns them to the cube faces they touch.
+	 * A face covers the 90 degree pyramid around its axis; an item is kept for a face if its bounds
+	 * can reach into that pyramid, so it is drawn only into the faces that may see it.
+	 * @param lightPosition Light's world position.
+	 * @param lightRange Light's maximum range.
+	 * @param faceDirections Axis-aligned view direction of each face (in cube layer order).
+	 * @param outIndices Receives all items inside the light range.
+	 * @param outFaceIndices Receives the item indices per face.
+	 */
+	void extractForPointLightFaces(
+		const glm::vec3 &lightPosition,
+		float lightRange,
+		const std::array<glm::vec3, 6> &faceDirections,
+		std::vector<size_t> &outIndices,
+		std::array<std::vector<size_t>, 6> &outFaceIndices
+	) const;
+
 	/**
 	 * @brief Extracts lights and creates shadow requests (camera-independent).
 	 * @details Does NOT compute shadow matrices - those are computed by ShadowPass per-camera.
@@ -159,6 +205,8 @@ class RenderCollector
 	[[nodiscard]] size_t getLightCount() const { return m_lights.size(); }
 
   private:
+	static constexpr float DEPTH_BUCKETS_PER_OCTAVE = 2.0f; ///< Opaque depth buckets per doubling of view depth
+
 	/**
 	 * @brief Tests if an AABB is visible in a frustum.
 	 */
@@ -35,6 +35,7 @@ struct RenderItemGPU
 	glm::mat4 worldTransform;								  ///< World transformation matrix
 	uint32_t renderLayer;									  ///< Render layer for sorting
 	uint64_t objectID;										  ///< Unique object identifier
+	bool isStatic = false;									  ///< Static scenery, drawn through the StaticDrawCache
 };
 
 } // namespace engine::rendering
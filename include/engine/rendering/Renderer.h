@@ -1,13 +1,17 @@
 #pragma once
 
+#include <array>
+#include <filesystem>
 #include <functional>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <webgpu/webgpu.hpp>
 
 #include "engine/rendering/ClearFlags.h"
 #include "engine/rendering/CompositePass.h"
 #include "engine/rendering/DebugPass.h"
+#include "engine/rendering/DepthPrepass.h"
 #include "engine/rendering/DebugRenderCollector.h"
 #include "engine/rendering/FrameCache.h"
 #include "engine/rendering/FrameUniforms.h"
@@ -105,12 +109,43 @@ class Renderer
 	 */
 	MeshPass &getMeshPass() { return *m_meshPass; }
 
+	/**
+	 * @brief Get the DepthPrepass instance.
+	 * @return Reference to DepthPrepass.
+	 */
+	DepthPrepass &getDepthPrepass() { return *m_depthPrepass; }
+
+	/**
+	 * @brief Enable or disable the depth pre-pass before the MeshPass.
+	 * Trades an extra depth-only geometry pass for at most one PBR shading per pixel;
+	 * worth it for scenes with heavy overdraw.
+	 * @param enabled True to lay down opaque depth first and shade with depthCompare = Equal.
+	 */
+	void setDepthPrepassEnabled(bool enabled) { m_depthPrepassEnabled = enabled; }
+
+	/**
+	 * @brief Check if the depth pre-pass is enabled.
+	 */
+	[[nodiscard]] bool isDepthPrepassEnabled() const { return m_depthPrepassEnabled; }
+
+	/**
+	 * @brief Set where preprocessed environment lighting is cached (see EnvironmentPreprocessor).
+	 * @param directory Cache directory, empty to preprocess every environment on each run.
+	 */
+	void setEnvironmentCacheDirectory(const std::filesystem::path &directory) { m_environmentCacheDirectory = directory; }
+
 	/**
 	 * @brief Get the CompositePass instance.
 	 * @return Reference to CompositePass.
 	 */
 	CompositePass &getCompositePass() { return *m_compositePass; }
 
+	/**
+	 * @brief Get the GPU time of each render pass, averaged over the pass timer's window.
+	 * @return Per-pass timings, empty if timestamp queries are unsupported.
+	 */
+	std::vector<webgpu::GpuPassTiming> getGpuPassTimings() const;
+
   private:
 	// ========================================
 	// Frame Orchestration (High-Level Flow)
@@ -158,10 +193,28 @@ class Renderer
 
 	/**
 	 * @brief Updates per-camera environment bind group (irradiance texture/uniforms).
+	 * The bind group is rebuilt only when the environment texture, its version or the pipeline
+	 * generation changed; otherwise only a changed parameter uniform is written.
 	 * @param target Camera render target containing environment settings.
 	 */
 	void updateEnvironmentBindGroup(const RenderTarget &target);
 
+	struct EnvironmentMaps;
+
+	/**
+	 * @brief Get the preprocessed lighting of an environment texture, preprocessing it on first use
+	 * or when its version changed.
+	 * @param handle Environment texture.
+	 * @param version CPU texture version.
+	 * @return The lighting (zero SH and a black specular map if preprocessing failed).
+	 */
+	const EnvironmentMaps &prepareEnvironmentMaps(const Texture::Handle &handle, uint64_t version);
+
+	/**
+	 * @brief Drop the preprocessed lighting of environment textures no camera binding uses anymore.
+	 */
+	void releaseUnusedEnvironmentMaps();
+
 	/**
 	 * @brief Creates or resizes render target textures.
 	 * Handles both CPU-backed textures and dynamic viewport-sized targets.
@@ -186,8 +239,10 @@ class Renderer
 	// std::unique_ptr<RenderPassManager> m_renderPassManager; // ToDo: future use
 	std::unique_ptr<ShadowPass> m_shadowPass;
 	std::unique_ptr<SkyboxPass> m_skyboxPass;
+	std::unique_ptr<DepthPrepass> m_depthPrepass;
 	std::unique_ptr<MeshPass> m_meshPass;
 	std::unique_ptr<DebugPass> m_debugPass;
+	bool m_depthPrepassEnabled = false;
 	std::unique_ptr<CompositePass> m_compositePass;
 	std::unique_ptr<PostProcessingPass> m_postProcessingPass;
 
@@ -201,14 +256,37 @@ class Renderer
 		std::shared_ptr<webgpu::WebGPUTexture> b;
 	};
 	std::unordered_map<uint64_t, std::shared_ptr<webgpu::WebGPUTexture>> m_postProcessTextures; ///< Cache of intermediate textures for post-processing per camera (key: cameraId)
-	std::unordered_map<uint64_t, std::shared_ptr<webgpu::WebGPUBindGroup>> m_environmentBindGroups;
+	struct EnvironmentBinding // Per camera environment bind group and the inputs it was built from
+	{
+		std::shared_ptr<webgpu::WebGPUBindGroup> bindGroup;
+		uint64_t textureId = 0;		 ///< Environment texture handle id (0 = default texture)
+		uint64_t textureVersion = 0; ///< CPU texture version the bind group was built from
+		uint64_t generation = 0;	 ///< Pipeline generation (bumped on shader reload)
+		bool hasTexture = false;
+		float specularMaxLod = 0.0f; ///< Last mip of the prefiltered specular map
+		glm::vec4 params{0.0f}; ///< Last uploaded environment parameters
+		bool paramsWritten = false;
+	};
+	std::unordered_map<uint64_t, EnvironmentBinding> m_environmentBindGroups; ///< Key: cameraId
+	struct EnvironmentMaps // Preprocessed lighting of one environment texture, shared by the cameras using it
+	{
+		uint64_t textureVersion = 0;			 ///< CPU texture version the maps were built from
+		std::array<glm::vec4, 9> irradianceSH{}; ///< Diffuse irradiance SH (see EnvironmentUniforms)
+		std::shared_ptr<webgpu::WebGPUTexture> specular;
+	};
+	std::unordered_map<uint64_t, EnvironmentMaps> m_environmentMaps; ///< Key: environment texture handle id
+	std::filesystem::path m_environmentCacheDirectory;
 
 	std::unordered_map<uint64_t, RenderTarget> m_renderTargets;
 
+	/// CPU targets with a readback in flight (shared with the readback callbacks, which may outlive the renderer)
+	std::shared_ptr<std::unordered_set<const Texture *>> m_readbacksInFlight = std::make_shared<std::unordered_set<const Texture *>>();
+
 	std::shared_ptr<webgpu::WebGPUBindGroupLayoutInfo> m_frameBindGroupLayout;
-	// Note: m_environmentBindGroupLayout is not cached. It's fetched fresh from the PBR shader in updateEnvironmentBindGroup()
-	// to ensure we always use the current shader state.
+	// Note: the environment bind group layout is not cached. It's fetched from the PBR shader whenever
+	// updateEnvironmentBindGroup() rebuilds a bind group, so it always reflects the current shader state.
 	std::shared_ptr<webgpu::WebGPUTexture> m_defaultEnvironmentTexture;
+	std::shared_ptr<webgpu::WebGPUTexture> m_brdfLut;
 };
 
 } // namespace engine::rendering
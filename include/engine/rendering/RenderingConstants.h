@@ -16,7 +16,29 @@ constexpr uint32_t MAX_SHADOW_MAPS_CUBE = 4; // Max point light shadows
 constexpr uint32_t DEFAULT_SHADOW_MAP_SIZE = 2048;
 constexpr uint32_t DEFAULT_CUBE_SHADOW_MAP_SIZE = 1024;
 
+// Shadow atlas: directional/spot shadows are packed as power-of-two tiles into square atlas pages.
+// A page is the unit of re-rendering, so full-size tiles (e.g. cascades) get a page each and are cached independently.
+constexpr uint32_t SHADOW_ATLAS_SIZE = 2048;		 // Page resolution (one texture_depth_2d_array layer per page)
+constexpr uint32_t SHADOW_ATLAS_MIN_TILE_SIZE = 256; // Smallest tile, used when a page runs out of space
+constexpr uint32_t MAX_SHADOW_ATLAS_PAGES = 16;		 // Pages are added on demand up to this count
+
 // Light configuration
-constexpr uint32_t MAX_LIGHTS = 16;
+constexpr uint32_t MAX_LIGHTS = 4096;
+
+// Clustered forward lighting: screen tiles x exponential depth slices per camera
+constexpr uint32_t LIGHT_CLUSTER_GRID_X = 16;
+constexpr uint32_t LIGHT_CLUSTER_GRID_Y = 9;
+constexpr uint32_t LIGHT_CLUSTER_GRID_Z = 24;
+constexpr uint32_t LIGHT_CLUSTER_COUNT = LIGHT_CLUSTER_GRID_X * LIGHT_CLUSTER_GRID_Y * LIGHT_CLUSTER_GRID_Z;
+constexpr uint32_t MAX_LIGHT_CLUSTER_INDICES = LIGHT_CLUSTER_COUNT * 64; // Capacity of the per-cluster light index list
+
+// Materials sharing one material bind group (must match the array size in PBR_Lit_Shader.wgsl)
+constexpr uint32_t MAX_MATERIALS_PER_BATCH = 128;
+
+// Material texture arrays: layers per texture_2d_array page, bounded by a memory budget per page.
+// Pages start small and double on demand up to the limit.
+constexpr uint32_t MATERIAL_TEXTURE_ARRAY_INITIAL_LAYERS = 4;
+constexpr uint32_t MAX_MATERIAL_TEXTURE_ARRAY_LAYERS = 64;
+constexpr uint64_t MATERIAL_TEXTURE_ARRAY_PAGE_BYTES = 64ull * 1024 * 1024;
 
 } // namespace engine::rendering::constants
@@ -3,6 +3,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <webgpu/webgpu.hpp>
 
@@ -49,6 +50,7 @@ constexpr const char *VIGNETTE = "Vignette_BindGroup";
 namespace bindgroup::entry::defaults
 {
 constexpr const char *MATERIAL_PROPERTIES = "materialProperties";
+constexpr const char *MATERIAL_LAYERS = "materialLayers";
 } // namespace bindgroup::entry::defaults
 
 /**
@@ -57,6 +59,14 @@ constexpr const char *MATERIAL_PROPERTIES = "materialProperties";
  *
  * Shaders are created once during initialization and can be retrieved by type.
  * Custom shaders can be registered dynamically at runtime.
+ *
+ * Every shader name is mapped to a stable ShaderId. The ID survives hot-reloads
+ * (replacing a shader) and unregistration, so caches keyed by ShaderId stay valid.
+ *
+ * Shaders that declare material variant features (see WebGPUShaderBuilder::setMaterialVariants)
+ * get one compiled permutation per distinct feature subset. Variants are named
+ * "<base>#<hex mask>", receive their ID when a material resolves them and are compiled
+ * the first time a pipeline needs them (acquireShader).
  */
 class ShaderRegistry
 {
@@ -91,6 +101,37 @@ class ShaderRegistry
 	 */
 	[[nodiscard]] std::shared_ptr<webgpu::WebGPUShaderInfo> getShader(const std::string &name) const;
 
+	/**
+	 * @brief Get a shader by ID (no string hashing).
+	 * @param id The shader ID.
+	 * @return Shared pointer to shader info, or nullptr if no shader is registered under this ID.
+	 */
+	[[nodiscard]] std::shared_ptr<webgpu::WebGPUShaderInfo> getShader(webgpu::ShaderId id) const;
+
+	/**
+	 * @brief Get the stable ID for a shader name, assigning a new one if the name is unknown.
+	 * Names may be resolved before the shader itself is registered.
+	 * @param name The shader name.
+	 * @return The shader ID (never INVALID_SHADER_ID).
+	 */
+	webgpu::ShaderId resolveShaderId(const std::string &name);
+
+	/**
+	 * @brief Get the ID of the permutation of a shader matching a material's features.
+	 * Does not compile anything; the variant is built lazily by acquireShader().
+	 * @param baseName The shader the material uses.
+	 * @param materialFeatures The material's feature mask.
+	 * @return ID of the variant, or of the base shader if it has no variants or all its features are used.
+	 */
+	webgpu::ShaderId resolveVariantId(const std::string &baseName, MaterialFeature::Flag materialFeatures);
+
+	/**
+	 * @brief Get a shader by ID, compiling and registering it first if it is a not yet built variant.
+	 * @param id The shader ID.
+	 * @return Shared pointer to shader info, or nullptr if not found or compilation failed.
+	 */
+	std::shared_ptr<webgpu::WebGPUShaderInfo> acquireShader(webgpu::ShaderId id);
+
 	/**
 	 * @brief Register a shader with its name. Names must be unique.
 	 * @param shaderInfo The shader to register.
@@ -124,6 +165,17 @@ class ShaderRegistry
 	// Custom shaders indexed by name
 	std::unordered_map<std::string, std::shared_ptr<webgpu::WebGPUShaderInfo>> m_shaders;
 
+	// Stable name -> ID mapping, never shrinks
+	std::unordered_map<std::string, webgpu::ShaderId> m_shaderIds;
+
+	// Registered shaders indexed by ID (slot 0 is INVALID_SHADER_ID)
+	std::vector<std::shared_ptr<webgpu::WebGPUShaderInfo>> m_shadersById;
+
+	// Shader names indexed by ID
+	std::vector<std::string> m_shaderNames;
+
+	static std::string makeVariantName(const std::string &baseName, MaterialFeature::Flag enabledFeatures);
+
 	// Helper methods to create specific default shaders
 	std::shared_ptr<webgpu::WebGPUShaderInfo> createPBRShader();
 	std::shared_ptr<webgpu::WebGPUShaderInfo> createDebugShader();
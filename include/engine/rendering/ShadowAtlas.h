@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/rendering/RenderingConstants.h"
+
+namespace engine::rendering
+{
+
+/**
+ * @brief A square region of a shadow atlas page, in texels.
+ */
+struct ShadowAtlasTile
+{
+	uint32_t page = 0; ///< Atlas page (texture array layer)
+	uint32_t x = 0;
+	uint32_t y = 0;
+	uint32_t size = 0;
+
+	bool operator==(const ShadowAtlasTile &other) const
+	{
+		return page == other.page && x == other.x && y == other.y && size == other.size;
+	}
+	bool operator!=(const ShadowAtlasTile &other) const { return !(*this == other); }
+};
+
+/**
+ * @class ShadowAtlas
+ * @brief Quadtree allocator packing power-of-two shadow tiles into square atlas pages.
+ *
+ * CPU-only: the ShadowPass owns the depth texture the pages map to. Tiles are keyed by the
+ * caller (e.g. the shadow slot of a light/cascade) and stay in place across frames as long as the
+ * key is acquired every frame with the same requested size, so cached shadow maps remain valid.
+ * Keys not acquired between beginFrame() and endFrame() release their tiles.
+ *
+ * When no page has room, a page is added (up to the page limit), then the tile size is halved
+ * down to the minimum tile size. Acquire large tiles first to keep fragmentation low.
+ *
+ * Pages belong to the owner of their first tile until they are empty again: tiles of different
+ * owners (e.g. cameras) never share a page, so clearing one owner's page leaves the others intact.
+ *
+ * Usage:
+ * @code
+ *   atlas.beginFrame();
+ *   auto tile = atlas.acquire(slot, 2048);
+ *   atlas.endFrame();
+ * @endcode
+ */
+class ShadowAtlas
+{
+  public:
+	/**
+	 * @brief Construct an empty atlas.
+	 * @param pageSize Page resolution (power of two).
+	 * @param minTileSize Smallest tile (power of two, at most pageSize).
+	 * @param maxPages Maximum number of pages.
+	 */
+	explicit ShadowAtlas(
+		uint32_t pageSize = constants::SHADOW_ATLAS_SIZE,
+		uint32_t minTileSize = constants::SHADOW_ATLAS_MIN_TILE_SIZE,
+		uint32_t maxPages = constants::MAX_SHADOW_ATLAS_PAGES
+	);
+
+	/**
+	 * @brief Start a frame: all tiles become unused until acquired again.
+	 */
+	void beginFrame();
+
+	/**
+	 * @brief Get the tile for a key, allocating it if the key is new or its requested size changed.
+	 * @param key Caller-defined stable key.
+	 * @param requestedSize Requested resolution, rounded up to a power of two and clamped to the page.
+	 * @param outAllocated Set to true if the tile was (re)allocated and holds no valid content.
+	 * @param owner Owner of the tile; new tiles only go to pages of the same owner or empty pages.
+	 * @return The tile, or std::nullopt if the atlas is full even at the minimum tile size.
+	 */
+	std::optional<ShadowAtlasTile> acquire(uint64_t key, uint32_t requestedSize, bool &outAllocated, uint64_t owner = 0);
+
+	/**
+	 * @brief End a frame: release the tiles of all keys not acquired since beginFrame().
+	 */
+	void endFrame();
+
+	/**
+	 * @brief Release all tiles and pages.
+	 */
+	void clear();
+
+	/** @brief Number of pages holding at least one tile (index of the highest used page + 1). */
+	[[nodiscard]] uint32_t getPageCount() const;
+
+	/** @brief Page resolution in texels. */
+	[[nodiscard]] uint32_t getPageSize() const { return m_pageSize; }
+
+	/**
+	 * @brief Current tile of a key, without marking it used.
+	 * @return The tile, or std::nullopt if the key holds none.
+	 */
+	[[nodiscard]] std::optional<ShadowAtlasTile> findTile(uint64_t key) const;
+
+	/** @brief Number of allocated tiles. */
+	[[nodiscard]] size_t getTileCount() const { return m_entries.size(); }
+
+	/**
+	 * @brief Round a requested resolution to the tile size the atlas would use.
+	 * @param requestedSize Requested resolution in texels.
+	 * @return Next power of two, clamped to [minTileSize, pageSize].
+	 */
+	[[nodiscard]] uint32_t roundTileSize(uint32_t requestedSize) const;
+
+  private:
+	enum class NodeState : uint8_t
+	{
+		Free,
+		Split,
+		Used
+	};
+
+	/**
+	 * @brief One page: implicit quadtree, children of node n are 4n+1 .. 4n+4.
+	 */
+	struct Page
+	{
+		std::vector<NodeState> nodes;
+		uint64_t owner = 0; ///< Owner of the tiles on this page; meaningless while the page is empty
+	};
+
+	struct Entry
+	{
+		ShadowAtlasTile tile;
+		uint32_t requestedSize = 0; ///< Size asked for; the tile may be smaller if space was short
+		uint32_t node = 0;
+		bool used = false;
+	};
+
+	std::optional<ShadowAtlasTile> allocate(uint32_t size, uint64_t owner, uint32_t &outNode);
+	bool allocateInNode(Page &page, uint32_t node, uint32_t level, uint32_t x, uint32_t y, uint32_t targetLevel, ShadowAtlasTile &outTile, uint32_t &outNode);
+	void release(const Entry &entry);
+	[[nodiscard]] uint32_t levelForSize(uint32_t size) const;
+
+	uint32_t m_pageSize;
+	uint32_t m_minTileSize;
+	uint32_t m_maxPages;
+	uint32_t m_levelCount = 1; ///< Quadtree depth: level 0 is the whole page, the last level the minimum tile
+	std::vector<Page> m_pages;
+	std::unordered_map<uint64_t, Entry> m_entries;
+};
+
+} // namespace engine::rendering
@@ -1,12 +1,16 @@
 #pragma once
 
+#include <array>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 #include <webgpu/webgpu.hpp>
 
+#include "engine/math/Frustum.h"
 #include "engine/rendering/Mesh.h"
 #include "engine/rendering/RenderPass.h"
+#include "engine/rendering/ShadowAtlas.h"
 
 namespace engine::rendering
 {
@@ -30,26 +34,53 @@ class WebGPUTexture;
  * @brief Renders shadow maps for directional, spot, and point lights.
  *
  * Computes shadow matrices per camera (CSM cascades, perspective projections, cube face matrices)
- * and renders depth passes into shadow map texture arrays.
+ * and renders depth passes into a shadow atlas (directional/spot) and a cube map array (point).
+ *
+ * Each 2D shadow (spot light or CSM cascade) gets a power-of-two tile of the light's shadowMapSize
+ * in the ShadowAtlas; spot light tiles shrink with the light's screen coverage. Atlas pages and
+ * cube maps are allocated on demand, so memory follows the lights actually casting shadows.
+ *
+ * Shadow caching: a signature of the light matrices and of the casters found by culling (object,
+ * transform, model/mesh version) is kept per tile and per cube. Atlas pages whose tiles all kept
+ * their signature, and cubes whose signature held, are not rendered again. Depth can only be
+ * cleared per page, so a changed tile re-renders the tiles sharing its page.
+ *
+ * Multiple cameras: 2D shadows depend on the camera (cascade fits, spot tile sizes), so atlas
+ * tiles, cached signatures and cascade fits are keyed by camera and slot. Each camera packs its
+ * tiles into pages of its own, so re-rendering one camera's page does not invalidate another's.
+ * Cube maps do not depend on the camera and are shared. Tiles of cameras not rendered in a frame
+ * are released in endFrame().
+ *
+ * CSM: cascades are stabilized (sphere-fit, texel-snapped) so they do not shimmer and keep their
+ * matrices while the camera only rotates. Far cascades are padded and refit at a reduced rate
+ * (cascade c >= 2 every 2^(c-1) frames, staggered); in between they keep their previous matrix as
+ * long as it still covers the camera slice, which lets the cache skip them. Casters are culled
+ * once per directional light and assigned to every cascade they overlap.
+ *
+ * Point lights: casters are assigned to the cube faces their bounds reach, so an object is only
+ * drawn into the faces that can see it.
  *
  * RESPONSIBILITIES:
  * - Creates pipelines for shadow rendering
  * - Manages bind groups and uniform buffers
- * - Records render commands into provided depth textures
+ * - Owns the shadow atlas and cube map textures and the shadow bind group sampling them
+ * - Culls casters per light and skips shadows whose inputs did not change
  *
  * DOES NOT:
- * - Iterate over multiple lights (single-light per call)
- * - Own or allocate shadow map textures (textures provided by caller)
- * - Perform light-specific culling (caller provides filtered items)
- * - Cache per-light resources (pipelines cached by mesh properties only)
+ * - Decide which lights cast shadows (RenderCollector emits ShadowRequests)
  *
  * Designed for use in render graphs and flexible rendering pipelines.
  *
  * Usage:
  * @code
  *   shadowPass.setRenderCollector(&collector);
- *   shadowPass.setCameraId(cameraId);
- *   shadowPass.render(frameCache);
+ *   shadowPass.beginFrame();
+ *   for (camera : cameras)
+ *   {
+ *       shadowPass.setCameraId(camera.id);
+ *       shadowPass.render(frameCache);
+ *   }
+ *   shadowPass.endFrame();
  * @endcode
  */
 class ShadowPass : public RenderPass
@@ -82,6 +113,16 @@ class ShadowPass : public RenderPass
 	 */
 	void render(FrameCache &frameCache) override;
 
+	/**
+	 * @brief Start a frame; call once before rendering the shadows of all cameras.
+	 */
+	void beginFrame();
+
+	/**
+	 * @brief End a frame: release the atlas tiles and cached state of cameras not rendered since beginFrame().
+	 */
+	void endFrame();
+
 	/**
 	 * @brief Clean up GPU resources.
 	 */
@@ -117,35 +158,169 @@ class ShadowPass : public RenderPass
 	 */
 	[[nodiscard]] bool isDebugMode() const { return m_isDebugMode; }
 
+	/**
+	 * @brief Enable or disable shadow caching (re-render every shadow every frame when disabled).
+	 * @param enabled True to skip shadows whose light and casters did not change
+	 */
+	void setCachingEnabled(bool enabled) { m_cachingEnabled = enabled; }
+
+	/**
+	 * @brief Enable or disable sizing spot light tiles by screen coverage.
+	 * @param enabled True to shrink the tiles of lights covering a small part of the screen
+	 */
+	void setScreenCoverageSizing(bool enabled) { m_screenCoverageSizing = enabled; }
+
+	/**
+	 * @brief Enable or disable cascade stabilization (sphere-fit, texel-snapped cascades).
+	 * @param enabled True to stabilize; false fits each cascade to its slice AABB every frame
+	 */
+	void setCascadeStabilization(bool enabled) { m_stabilizeCascades = enabled; }
+
+	/**
+	 * @brief Enable or disable refitting far cascades at a reduced rate (needs stabilization).
+	 * @param enabled True to refit cascades 2+ every 2nd/4th/... frame
+	 */
+	void setFarCascadeRateReduction(bool enabled) { m_reduceFarCascadeRate = enabled; }
+
+	/** @brief Shadow atlas allocator (directional/spot tiles). */
+	[[nodiscard]] const ShadowAtlas &getAtlas() const { return m_atlas; }
+
+	/** @brief Number of 2D tiles and cube maps rendered by the last render() call. */
+	[[nodiscard]] size_t getLastRenderedShadowCount() const { return m_lastRenderedCount; }
+
+	/** @brief Number of 2D tiles and cube maps reused from cache by the last render() call. */
+	[[nodiscard]] size_t getLastCachedShadowCount() const { return m_lastCachedCount; }
+
   private:
 	/**
-	 * @brief Render a 2D shadow map (directional or spot light).
+	 * @brief A directional cascade or spot light shadow placed in the atlas.
+	 */
+	struct AtlasJob
+	{
+		size_t uniformIndex = 0;			 ///< Index into FrameCache::shadowUniforms
+		uint32_t slot = 0;					 ///< 2D shadow slot (request index + cascade)
+		uint64_t key = 0;					 ///< Atlas and cache key (camera + slot), see tileKey()
+		uint32_t requestedSize = 0;			 ///< Requested tile resolution
+		std::optional<ShadowAtlasTile> tile; ///< Assigned tile, none if the atlas is full
+		std::vector<size_t> casters;		 ///< Items inside the light frustum
+		uint64_t signature = 0;				 ///< Light matrices + casters, compared with the cached signature
+		bool dirty = true;					 ///< Tile content must be rendered
+		bool culled = false;				 ///< Casters already assigned (CSM cascades)
+	};
+
+	/**
+	 * @brief Last fit of a CSM cascade, reused while the cascade is not due for an update.
+	 */
+	struct CascadeState
+	{
+		glm::mat4 lightView{1.0f};
+		uint32_t tileSize = 0; ///< Atlas tile size the fit was snapped to
+		engine::math::Frustum::CascadeData cascade{};
+	};
+
+	/**
+	 * @brief A point light shadow rendered into the cube map array.
+	 */
+	struct CubeJob
+	{
+		size_t uniformIndex = 0;	 ///< Index into FrameCache::shadowUniforms
+		uint32_t cubeIndex = 0;		 ///< Cube in the cube map array
+		float range = 0.0f;			 ///< Light range, bounds the culling sphere
+		std::vector<size_t> casters; ///< Items inside the light range
+		std::array<std::vector<size_t>, 6> faceCasters; ///< Casters per cube face (layer order)
+	};
+
+	/**
+	 * @brief Decide whether a CSM cascade keeps its previous fit this frame.
+	 *
+	 * Cascades 0 and 1 are refit every frame, cascade c >= 2 every 2^(c-1) frames (staggered by c).
+	 * A cascade that is not due keeps its previous fit if the camera, light, split and tile size are
+	 * unchanged and the previous bounds still contain the current slice; otherwise it is refit immediately.
+	 *
+	 * @param key Tile key of the cascade (camera + slot)
+	 * @param cascadeIndex Cascade index within the light
+	 * @param lightView Light view matrix the cascade was computed with
+	 * @param tileSize Atlas tile size the cascade was snapped to
+	 * @param cascade Freshly computed cascade, replaced by the previous fit when reused
+	 * @return True if the previous fit was reused
+	 */
+	bool reuseCascade(uint64_t key, uint32_t cascadeIndex, const glm::mat4 &lightView, uint32_t tileSize, engine::math::Frustum::CascadeData &cascade);
+
+	/**
+	 * @brief Render all tiles of an atlas page in one depth pass (the page is cleared first).
 	 * @param frameCache Frame data containing GPU render items
-	 * @param indicesToRender Indices of visible items to render
-	 * @param arrayLayer Target texture array layer
-	 * @param shadowUniform Shadow parameters (view-projection matrix, bias, etc.)
+	 * @param page Atlas page (texture array layer)
+	 * @param jobs Jobs whose tiles lie on this page
+	 * @return True if every caster was drawn
 	 */
-	void renderShadow2D(
+	bool renderAtlasPage(
 		FrameCache &frameCache,
-		const std::vector<size_t> &indicesToRender,
-		uint32_t arrayLayer,
-		const ShadowUniform &shadowUniform
+		uint32_t page,
+		const std::vector<const AtlasJob *> &jobs
 	);
 
 	/**
 	 * @brief Render a cube shadow map (point light, 6 faces).
+	 *
+	 * All face matrices are uploaded once; each face's draws select theirs through the first
+	 * instance. Faces still render in separate passes (WebGPU has no layered rendering).
+	 *
 	 * @param frameCache Frame data containing GPU render items
-	 * @param indicesToRender Indices of visible items to render
+	 * @param faceIndices Indices of the items touching each face
 	 * @param cubeIndex Target cube array index (6 layers per cube)
 	 * @param shadowUniform Shadow parameters (light position, range, bias, etc.)
+	 * @return True if every caster was drawn
 	 */
-	void renderShadowCube(
+	bool renderShadowCube(
 		FrameCache &frameCache,
-		const std::vector<size_t> &indicesToRender,
+		const std::array<std::vector<size_t>, 6> &faceIndices,
 		uint32_t cubeIndex,
 		const ShadowUniform &shadowUniform
 	);
 
+	/**
+	 * @brief Requested atlas tile size for a 2D shadow request.
+	 *
+	 * Directional cascades use the light's shadowMapSize. Spot lights scale it by the
+	 * projected size of their range sphere when screen coverage sizing is enabled.
+	 */
+	[[nodiscard]] uint32_t computeTileSize(const ShadowRequest &request, const RenderTarget &renderTarget) const;
+
+	/**
+	 * @brief Atlas and cache key of a 2D shadow slot for the active camera.
+	 */
+	[[nodiscard]] uint64_t tileKey(uint32_t slot) const;
+
+	/**
+	 * @brief Hash the casters of a shadow (object, transform, model; model/mesh versions if not static).
+	 * @param seed Hash of the light parameters
+	 * @param indices Culled caster indices
+	 */
+	[[nodiscard]] uint64_t computeCasterSignature(uint64_t seed, const std::vector<size_t> &indices) const;
+
+	/**
+	 * @brief Grow the atlas texture to hold a number of pages (never shrinks).
+	 * @return True if the texture was recreated (all cached tiles are lost).
+	 */
+	bool ensureAtlasCapacity(uint32_t pageCount);
+
+	/**
+	 * @brief Grow the cube map array to a cube count and face size (never shrinks).
+	 * @return True if the texture was recreated (all cached cubes are lost).
+	 */
+	bool ensureCubeCapacity(uint32_t cubeCount, uint32_t faceSize);
+
+	/**
+	 * @brief Create the debug color textures matching the current shadow textures.
+	 */
+	void ensureDebugTextures();
+
+	/**
+	 * @brief Recreate the shadow bind group after a shadow texture changed.
+	 * @return True on success
+	 */
+	bool createShadowBindGroup();
+
 	/**
 	 * @brief Compute shadow uniforms from a shadow request.
 	 *
@@ -157,12 +332,16 @@ class ShadowPass : public RenderPass
 	 * @param request Shadow request from render collector
 	 * @param renderTarget Camera render target (provides frustum for CSM)
 	 * @param splitLambda CSM split weight (0=uniform, 1=logarithmic)
+	 * @param tileSizes Allocated atlas tile size per cascade; stabilized cascades snap to its texels
+	 * @param outCascades If set, receives the cascade fits of a cascaded directional light
 	 * @return Vector of shadow uniforms (1 for spot/point, N for cascaded directional)
 	 */
 	std::vector<ShadowUniform> computeShadowUniforms(
 		const ShadowRequest &request,
 		const RenderTarget &renderTarget,
-		float splitLambda = 0.5f
+		float splitLambda = 0.5f,
+		const std::vector<uint32_t> &tileSizes = {},
+		std::vector<engine::math::Frustum::CascadeData> *outCascades = nullptr
 	);
 
 	/**
@@ -185,30 +364,50 @@ class ShadowPass : public RenderPass
 	 * @param frameCache Frame data for bind group lookup
 	 * @param indicesToRender Indices of items to render
 	 * @param isCubeShadow True if rendering to cube shadow map
-	 * @param faceIndex Cube face index (0-5), ignored for 2D shadows
+	 * @param passBindGroup Shadow pass bind group holding the light matrices
+	 * @param firstInstance First instance of every draw (cube face index for cube shadows)
+	 * @return True if every item was drawn (false if GPU resources or pipelines were missing)
 	 */
-	void renderItems(
+	bool renderItems(
 		wgpu::RenderPassEncoder &renderPass,
 		FrameCache &frameCache,
 		const std::vector<size_t> &indicesToRender,
 		bool isCubeShadow,
-		uint32_t faceIndex = 0
+		const std::shared_ptr<webgpu::WebGPUBindGroup> &passBindGroup,
+		uint32_t firstInstance = 0
 	);
 
 	const RenderCollector *m_collector = nullptr; ///< Scene geometry and light provider
 	size_t m_cameraId = 0;						  ///< Active camera for shadow matrix computation
 	bool m_isDebugMode = false;					  ///< Enable debug visualization
+	bool m_cachingEnabled = true;				  ///< Skip shadows whose signature did not change
+	bool m_screenCoverageSizing = true;			  ///< Size spot light tiles by screen coverage
+	bool m_stabilizeCascades = true;			  ///< Sphere-fit, texel-snapped CSM cascades
+	bool m_reduceFarCascadeRate = true;			  ///< Refit far cascades every 2^(c-1) frames
+	uint64_t m_frameIndex = 0;					  ///< beginFrame() calls, drives the far cascade schedule
 
-	std::shared_ptr<webgpu::WebGPUTexture> m_shadow2DArray;		///< 2D shadow map texture array
+	ShadowAtlas m_atlas;										///< Tile allocator for directional/spot shadows
+	std::shared_ptr<webgpu::WebGPUTexture> m_shadowAtlasTexture; ///< Atlas pages (one array layer per page)
 	std::shared_ptr<webgpu::WebGPUTexture> m_shadowCubeArray;	///< Cube shadow map texture array
+	uint32_t m_cubeCapacity = 0;								///< Cubes in m_shadowCubeArray
 	wgpu::Sampler m_shadowSampler = nullptr;					///< Shadow comparison sampler
+	std::shared_ptr<webgpu::WebGPUBindGroupLayoutInfo> m_shadowLayout; ///< Shadow bind group layout (material shaders)
 	std::shared_ptr<webgpu::WebGPUBindGroup> m_shadowBindGroup; ///< Shadow maps bind group for material shaders
 
 	std::shared_ptr<webgpu::WebGPUBindGroupLayoutInfo> m_shadowPass2DBindGroupLayout;	///< 2D shadow pass layout
 	std::shared_ptr<webgpu::WebGPUBindGroupLayoutInfo> m_shadowPassCubeBindGroupLayout; ///< Cube shadow pass layout
 
-	std::shared_ptr<webgpu::WebGPUBindGroup> m_shadowPass2DBindGroup;	   ///< Reusable 2D shadow pass bind group
-	std::shared_ptr<webgpu::WebGPUBindGroup> m_shadowPassCubeBindGroup[6]; ///< Reusable cube face bind groups
+	std::vector<std::shared_ptr<webgpu::WebGPUBindGroup>> m_shadowPass2DBindGroups; ///< One per 2D shadow slot (tiles of a page share a pass)
+	std::shared_ptr<webgpu::WebGPUBindGroup> m_shadowPassCubeBindGroup;				///< Cube pass bind group (all six face matrices)
+
+	std::vector<AtlasJob> m_atlasJobs;					  ///< Reused per render() call
+	std::vector<CubeJob> m_cubeJobs;					  ///< Reused per render() call
+	std::unordered_map<uint64_t, uint64_t> m_tileSignatures; ///< Cached signature per tile key (camera + slot)
+	std::vector<uint64_t> m_cubeSignatures;				  ///< Cached signature per cube index
+	std::unordered_map<uint64_t, CascadeState> m_cascadeStates; ///< Last cascade fit per tile key (camera + slot)
+	std::vector<std::vector<size_t>> m_cascadeCasters;		  ///< Per-cascade casters, reused per light
+	size_t m_lastRenderedCount = 0;
+	size_t m_lastCachedCount = 0;
 
 	std::unordered_map<int, std::weak_ptr<webgpu::WebGPUPipeline>> m_pipelineCache;		///< 2D shadow pipeline cache
 	std::unordered_map<int, std::weak_ptr<webgpu::WebGPUPipeline>> m_cubePipelineCache; ///< Cube shadow pipeline cache
@@ -22,6 +22,7 @@ struct ShadowUniform
 	uint32_t shadowType = 0;			  //< 4 bytes (0 = 2D shadow, 1 = cube shadow)
 	uint32_t textureIndex = 0;			  //< 4 bytes - layer in correct texture array (total: 108 bytes)
 	float cascadeSplit = 1.0f;			  //< 4 bytes - far plane distance for this cascade (CSM only) (total: 112 bytes)
+	glm::vec4 atlasRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f); //< 16 bytes - 2D only: atlas tile offset (xy) and scale (zw) in UV, zero scale = no tile (total: 128 bytes)
 };
 static_assert(sizeof(ShadowUniform) % 16 == 0, "ShadowUniform must match WGSL layout");
 
@@ -34,10 +35,11 @@ struct ShadowPass2DUniforms
 };
 static_assert(sizeof(ShadowPass2DUniforms) % 16 == 0, "ShadowPassUniforms2D must match WGSL layout");
 
-// Shadow pass specific uniforms for cube shadow maps (point lights)
+// Shadow pass specific uniforms for cube shadow maps (point lights).
+// All six faces share one buffer; each face's draws pass the face index as first instance.
 struct ShadowPassCubeUniforms
 {
-	glm::mat4 lightViewProjectionMatrix = glm::mat4(1.0f);
+	glm::mat4 faceViewProjection[6] = {glm::mat4(1.0f), glm::mat4(1.0f), glm::mat4(1.0f), glm::mat4(1.0f), glm::mat4(1.0f), glm::mat4(1.0f)};
 	glm::vec3 lightPos = glm::vec3(0.0f);
 	float farPlane = 100.0f;
 };
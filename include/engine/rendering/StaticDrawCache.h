@@ -0,0 +1,192 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include <webgpu/webgpu.hpp>
+
+#include "engine/rendering/BindGroupBinder.h"
+#include "engine/rendering/BindGroupEnums.h"
+
+namespace engine::rendering
+{
+struct FrameCache;
+struct RenderItemGPU;
+
+namespace webgpu
+{
+class WebGPUContext;
+class WebGPUMaterial;
+class WebGPUMesh;
+class WebGPUPipeline;
+class WebGPURenderPassContext;
+} // namespace webgpu
+
+/**
+ * @class StaticDrawCache
+ * @brief Caches compiled draw commands for static render items across frames.
+ *
+ * Visible items flagged as static are compiled once into compact draw packets holding
+ * the pipeline, the per-item bind groups and the vertex/index buffers. Later frames replay
+ * the packets without resolving CPU handles or looking up pipelines. When the set of visible
+ * static packets and the pass-wide bind groups stay unchanged between frames, the packets
+ * are additionally recorded into a WebGPU render bundle that is executed as a whole.
+ *
+ * A packet is recompiled when its mesh or material was resynced (Versioned counters), when
+ * its object/material bind group was replaced, or when the pipeline manager reloaded
+ * pipelines. Compiling or dropping any packet releases the camera's bundle, which is then
+ * recorded again once the visible set held still for a frame. All packets of a camera are dropped after the residency manager evicted GPU
+ * resources, as packets hold raw pointers and handles that may refer to evicted objects. Items using Custom bind groups or blending are left to the regular draw path.
+ *
+ * Usage:
+ * @code
+ *   std::vector<size_t> dynamicIndices;
+ *   staticDrawCache.draw(renderPass, frameCache, passContext, cameraId, passGroups, visibleIndices, dynamicIndices);
+ *   // draw dynamicIndices the regular way
+ * @endcode
+ */
+class StaticDrawCache
+{
+  public:
+	explicit StaticDrawCache(std::shared_ptr<webgpu::WebGPUContext> context);
+	~StaticDrawCache();
+
+	StaticDrawCache(const StaticDrawCache &) = delete;
+	StaticDrawCache &operator=(const StaticDrawCache &) = delete;
+
+	/**
+	 * @brief Draw the static items among the visible indices.
+	 *
+	 * Must be called before any other draw in the render pass: executing a render bundle
+	 * resets the pass state (pipeline, bind groups, buffers).
+	 *
+	 * @param renderPass Render pass to draw into.
+	 * @param frameCache Frame cache holding the GPU render items and frame bind groups.
+	 * @param passContext Render pass context (target formats for pipelines and bundles).
+	 * @param cameraId Camera the pass renders for; caches are kept per camera.
+	 * @param passGroups Pass-wide bind groups (Light, Shadow, Environment, ...).
+	 * @param visibleIndices Visible item indices in draw order.
+	 * @param outDynamicIndices Receives the indices that were not drawn (not static or not cacheable).
+	 * @param depthPrepassed True if a depth pre-pass wrote the depth of eligible items (Equal-test pipelines).
+	 */
+	void draw(
+		wgpu::RenderPassEncoder &renderPass,
+		FrameCache &frameCache,
+		const std::shared_ptr<webgpu::WebGPURenderPassContext> &passContext,
+		uint64_t cameraId,
+		const BindGroupSet &passGroups,
+		const std::vector<size_t> &visibleIndices,
+		std::vector<size_t> &outDynamicIndices,
+		bool depthPrepassed = false
+	);
+
+	/**
+	 * @brief Drop all packets and bundles.
+	 */
+	void clear();
+
+	/** @brief Enable or disable recording render bundles (packets are still replayed directly). */
+	void setBundlesEnabled(bool enabled) { m_bundlesEnabled = enabled; }
+
+	/** @brief Check if render bundles are recorded. */
+	[[nodiscard]] bool areBundlesEnabled() const { return m_bundlesEnabled; }
+
+	/** @brief Number of static items drawn by the last draw() call. */
+	[[nodiscard]] size_t getLastDrawCount() const { return m_lastDrawCount; }
+
+	/** @brief Number of packets compiled by the last draw() call. */
+	[[nodiscard]] size_t getLastCompileCount() const { return m_lastCompileCount; }
+
+	/** @brief Whether the last draw() call executed a render bundle. */
+	[[nodiscard]] bool wasBundleUsed() const { return m_lastBundleUsed; }
+
+	/** @brief Whether the last draw() call recorded a new render bundle. */
+	[[nodiscard]] bool wasBundleRecorded() const { return m_lastBundleRecorded; }
+
+	/** @brief Number of render bundles recorded since construction. */
+	[[nodiscard]] size_t getBundleRecordCount() const { return m_bundleRecordCount; }
+
+  private:
+	static constexpr uint8_t NO_SLOT = 0xFF;
+	static constexpr uint64_t EVICT_AFTER_FRAMES = 256; ///< Packets unused this long are dropped
+	static constexpr uint64_t EVICT_INTERVAL = 128;	 ///< Frames between eviction sweeps
+
+	/**
+	 * @brief Fully resolved draw of one static submesh.
+	 */
+	struct DrawPacket
+	{
+		std::shared_ptr<webgpu::WebGPUPipeline> pipeline;
+		wgpu::BindGroup objectGroup = nullptr;
+		wgpu::BindGroup materialGroup = nullptr;
+		uint8_t objectSlot = NO_SLOT;	///< Group index of the Object bind group
+		uint8_t materialSlot = NO_SLOT; ///< Group index of the Material bind group
+		wgpu::Buffer vertexBuffer = nullptr;
+		uint64_t vertexBufferSize = 0;
+		wgpu::Buffer indexBuffer = nullptr; ///< nullptr for non-indexed meshes
+		uint64_t indexBufferSize = 0;
+		uint32_t indexCount = 0;
+		uint32_t indexOffset = 0;
+		uint32_t firstInstance = 0; ///< Material entry in the shared material bind group
+
+		// Validation against the current render item
+		const webgpu::WebGPUMesh *mesh = nullptr;
+		const webgpu::WebGPUMaterial *material = nullptr;
+		const webgpu::WebGPUBindGroup *objectBindGroup = nullptr;
+		const webgpu::WebGPUBindGroup *materialBindGroup = nullptr;
+		uint64_t meshVersion = 0;
+		uint64_t materialVersion = 0;
+		uint64_t lastUsedFrame = 0;
+	};
+
+	/** @brief Pass-wide bind group handles indexed by BindGroupType. */
+	using PassGroupHandles = std::array<wgpu::BindGroup, BIND_GROUP_TYPE_COUNT>;
+
+	/**
+	 * @brief Packets and bundle state of one camera.
+	 */
+	struct CameraCache
+	{
+		std::unordered_map<uint64_t, DrawPacket> packets;
+		std::vector<const DrawPacket *> visible; ///< Scratch: packets drawn this frame, in order
+		wgpu::TextureFormat colorFormat = wgpu::TextureFormat::Undefined;
+		wgpu::TextureFormat depthFormat = wgpu::TextureFormat::Undefined;
+		bool depthPrepassed = false;
+		uint64_t pipelineGeneration = 0;
+		uint64_t residencyGeneration = 0;
+		uint64_t frame = 0;
+		uint64_t lastSignature = 0;
+		wgpu::RenderBundle bundle = nullptr;
+		uint64_t bundleSignature = 0;
+	};
+
+	static uint64_t packetKey(const RenderItemGPU &item);
+	static bool isPacketValid(const DrawPacket &packet, const RenderItemGPU &item);
+
+	std::optional<DrawPacket> compile(
+		const RenderItemGPU &item,
+		const std::shared_ptr<webgpu::WebGPURenderPassContext> &passContext,
+		bool depthPrepassed
+	);
+
+	template <typename Encoder>
+	static void replay(Encoder &encoder, const std::vector<const DrawPacket *> &packets, const PassGroupHandles &passGroups);
+
+	void recordBundle(CameraCache &cache, const PassGroupHandles &passGroups, uint64_t signature);
+	static void releaseBundle(CameraCache &cache);
+	static void evict(CameraCache &cache);
+
+	std::shared_ptr<webgpu::WebGPUContext> m_context;
+	std::unordered_map<uint64_t, CameraCache> m_cameras;
+	bool m_bundlesEnabled = true;
+
+	size_t m_lastDrawCount = 0;
+	size_t m_lastCompileCount = 0;
+	bool m_lastBundleUsed = false;
+	bool m_lastBundleRecorded = false;
+	size_t m_bundleRecordCount = 0;
+};
+
+} // namespace engine::rendering
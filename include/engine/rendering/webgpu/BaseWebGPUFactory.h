@@ -2,6 +2,7 @@
 #include <memory>
 #include <stdexcept>
 #include <type_traits>
+#include <unordered_map>
 
 #include "engine/core/Identifiable.h"
 
@@ -100,6 +101,41 @@ class BaseWebGPUFactory
 		return product;
 	}
 
+	/**
+	 * @brief Drop the cached GPU resource of a source handle.
+	 * The resource is freed once no one else references it; the next createFromHandle() recreates it.
+	 * @param handle Handle to the source object.
+	 * @return True if a resource was cached for the handle.
+	 */
+	bool evict(const typename SourceT::Handle &handle)
+	{
+		return m_cache.erase(handle) > 0;
+	}
+
+	/**
+	 * @brief Drop all cached GPU resources matching a predicate.
+	 * @param predicate Called with each cached resource, returns true to evict it.
+	 * @return Number of evicted resources.
+	 */
+	template <typename Predicate>
+	size_t evictIf(Predicate &&predicate)
+	{
+		size_t count = 0;
+		for (auto it = m_cache.begin(); it != m_cache.end();)
+		{
+			if (it->second && predicate(static_cast<const ProductT &>(*it->second)))
+			{
+				it = m_cache.erase(it);
+				++count;
+			}
+			else
+			{
+				++it;
+			}
+		}
+		return count;
+	}
+
 	/**
 	 * @brief Clear the internal cache of created resources.
 	 * Careful: this does not delete the resources themselves if they are still referenced elsewhere.
@@ -13,12 +13,17 @@
 #include "engine/rendering/webgpu/WebGPUMaterialFactory.h"
 #include "engine/rendering/webgpu/WebGPUMeshFactory.h"
 #include "engine/rendering/webgpu/WebGPUModelFactory.h"
+#include "engine/rendering/webgpu/WebGPUPassTimer.h"
 #include "engine/rendering/webgpu/WebGPUPipelineManager.h"
+#include "engine/rendering/webgpu/WebGPUReadbackService.h"
 #include "engine/rendering/webgpu/WebGPURenderPassFactory.h"
+#include "engine/rendering/webgpu/WebGPUResidencyManager.h"
 #include "engine/rendering/webgpu/WebGPUSamplerFactory.h"
 #include "engine/rendering/webgpu/WebGPUShaderFactory.h"
 #include "engine/rendering/webgpu/WebGPUSurfaceManager.h"
+#include "engine/rendering/webgpu/WebGPUSyncTracker.h"
 #include "engine/rendering/webgpu/WebGPUTextureFactory.h"
+#include "engine/resources/Image.h"
 
 #define SDL_MAIN_HANDLED
 #include <SDL3/SDL.h>
@@ -47,6 +52,26 @@ class WebGPUContext
 	 */
 	void initialize(void *windowHandle, bool enableVSync = true, const std::optional<DeviceLimitsConfig> &limits = std::nullopt);
 
+	/**
+	 * @brief Initialize the WebGPU context without a window or surface.
+	 * Frames are rendered into an offscreen texture owned by the surface manager.
+	 * @param width Offscreen target width in pixels.
+	 * @param height Offscreen target height in pixels.
+	 * @param limits Device limits configuration. If not provided, standard limits will be used.
+	 * @param forceFallbackAdapter Request the software/fallback adapter. If false, it is still
+	 *        used when no hardware adapter is available.
+	 */
+	void initializeHeadless(uint32_t width, uint32_t height, const std::optional<DeviceLimitsConfig> &limits = std::nullopt, bool forceFallbackAdapter = false);
+
+	/** @brief Returns true if the context renders offscreen without a surface. */
+	[[nodiscard]] bool isHeadless() const { return m_headless; }
+
+	/**
+	 * @brief Process pending device callbacks (e.g. buffer maps).
+	 * @param wait If true, block until queued work has completed.
+	 */
+	void pollDevice(bool wait = false);
+
 	/**
 	 * @brief Update the present mode (VSync setting) at runtime.
 	 * @param enableVSync If true, use Fifo present mode (VSync), otherwise use Immediate
@@ -77,6 +102,12 @@ class WebGPUContext
 	[[nodiscard]] const wgpu::Limits &resolvedLimits() const { return m_resolvedLimits; }
 	/** @brief Returns the device limits configuration. */
 	[[nodiscard]] const DeviceLimitsConfig &limitsConfig() const { return m_limitsConfig; }
+	/** @brief Returns true if the device was created with the timestamp-query feature. */
+	[[nodiscard]] bool supportsTimestampQuery() const { return m_timestampQuerySupported; }
+	/** @brief Returns true if the device can sample the given block-compressed format. */
+	[[nodiscard]] bool supportsBlockCompression(engine::resources::BlockCompression::Type compression) const;
+	/** @brief Returns every block-compressed format the device can sample. */
+	[[nodiscard]] std::vector<engine::resources::BlockCompression::Type> getSupportedBlockCompression() const;
 
 	/** @brief Returns the surface manager. */
 	[[nodiscard]] WebGPUSurfaceManager &surfaceManager();
@@ -107,6 +138,14 @@ class WebGPUContext
 	[[nodiscard]] ShaderRegistry &shaderRegistry();
 	/** @brief Returns the pipeline manager. */
 	[[nodiscard]] WebGPUPipelineManager &pipelineManager();
+	/** @brief Returns the GPU pass timer (a no-op if timestamp queries are unsupported). */
+	[[nodiscard]] WebGPUPassTimer &passTimer();
+	/** @brief Returns the tracker that flags GPU objects whose CPU sources changed. */
+	[[nodiscard]] WebGPUSyncTracker &syncTracker();
+	/** @brief Returns the asynchronous texture readback service. */
+	[[nodiscard]] WebGPUReadbackService &readbackService();
+	/** @brief Returns the manager keeping scene textures and meshes within the VRAM budget. */
+	[[nodiscard]] WebGPUResidencyManager &residencyManager();
 
 	/**
 	 * @brief Create a command encoder with an optional label.
@@ -136,9 +175,11 @@ class WebGPUContext
 	}
 
   private:
+	void initFactories();
 	void initSurface(void *windowHandle);
-	void initAdapter();
+	void initAdapter(bool forceFallbackAdapter = false);
 	void initDevice(const std::optional<DeviceLimitsConfig> &limits);
+	void initDeviceServices();
 
 	template <typename T>
 	static T clampLimit(const char *name, T requested, T supported);
@@ -153,8 +194,13 @@ class WebGPUContext
 
 	wgpu::Limits m_resolvedLimits{};
 	DeviceLimitsConfig m_limitsConfig{};
+	bool m_timestampQuerySupported = false;
+	bool m_textureCompressionBCSupported = false;
+	bool m_textureCompressionETC2Supported = false;
+	bool m_textureCompressionASTCSupported = false;
 
 	void *m_lastWindowHandle = nullptr;
+	bool m_headless = false;
 
 	// Surface manager
 	std::unique_ptr<WebGPUSurfaceManager> m_surfaceManager;
@@ -174,6 +220,10 @@ class WebGPUContext
 	std::unique_ptr<WebGPUShaderFactory> m_shaderFactory;
 	std::unique_ptr<ShaderRegistry> m_shaderRegistry;
 	std::unique_ptr<WebGPUPipelineManager> m_pipelineManager;
+	std::unique_ptr<WebGPUPassTimer> m_passTimer;
+	std::unique_ptr<WebGPUSyncTracker> m_syncTracker;
+	std::unique_ptr<WebGPUReadbackService> m_readbackService;
+	std::unique_ptr<WebGPUResidencyManager> m_residencyManager;
 };
 
 } // namespace engine::rendering::webgpu
@@ -5,15 +5,46 @@
 #include <vector>
 #include <webgpu/webgpu.hpp>
 
+#include "engine/core/ChangeJournal.h"
 #include "engine/core/Handle.h"
+#include "engine/core/Hash.h"
 #include "engine/rendering/Material.h"
 #include "engine/rendering/webgpu/WebGPUBindGroup.h"
 #include "engine/rendering/webgpu/WebGPUPipeline.h"
+#include "engine/rendering/webgpu/WebGPUShaderInfo.h"
 #include "engine/rendering/webgpu/WebGPUSyncObject.h"
 
 namespace engine::rendering::webgpu
 {
+class WebGPUMaterial;
 class WebGPUTexture;
+struct WebGPUTextureArrayLayer;
+
+/**
+ * @brief Material bind group shared by materials that bind the same textures.
+ *
+ * The properties binding (and the optional layer binding) hold one entry per material;
+ * a material's entry index is passed to the shader as the draw's first instance.
+ */
+struct WebGPUMaterialBatch
+{
+	std::shared_ptr<WebGPUBindGroupLayoutInfo> layout;
+	std::shared_ptr<WebGPUBindGroup> bindGroup;
+	std::vector<std::shared_ptr<WebGPUTexture>> textures; ///< Bound texture (or array page) per texture binding, in layout order
+	std::vector<std::weak_ptr<WebGPUMaterial>> owners;	  ///< Material per entry, expired entries are free
+	uint32_t capacity = 1;
+};
+
+/**
+ * @brief Entry of a material in a WebGPUMaterialBatch.
+ */
+struct WebGPUMaterialBatchSlot
+{
+	std::shared_ptr<WebGPUMaterialBatch> batch;
+	uint32_t index = 0;			  ///< Entry in the batch's properties and layer tables
+	MaterialTextureLayers layers; ///< Array layer per texture binding (0 unless packed)
+	std::vector<std::shared_ptr<WebGPUTextureArrayLayer>> packedLayers; ///< Keeps the material's texture array layers allocated
+};
 
 /**
  * @brief Options for a WebGPUMaterial.
@@ -22,12 +53,42 @@ struct WebGPUMaterialOptions
 {
 };
 
+/**
+ * @brief Pipeline-relevant state of a material, resolved once per material sync.
+ *
+ * Lets the pipeline manager build pipeline keys without resolving the CPU material
+ * or looking up the shader by name.
+ */
+struct WebGPUMaterialPipelineState
+{
+	ShaderId shaderId = INVALID_SHADER_ID;		///< Stable shader ID from the ShaderRegistry
+	wgpu::CullMode cullMode = wgpu::CullMode::Back; ///< None for double-sided materials
+	bool blendEnabled = false;					///< True for transparent materials
+	uint64_t hash = 0;							///< Precomputed hash of the fields above
+	bool depthPrepassEligible = false;			///< Depth depends on geometry only (no alpha test, no blending); not hashed
+
+	/**
+	 * @brief Hash the material part of a pipeline key.
+	 * Used as the seed for PipelineKey hashes.
+	 */
+	static constexpr uint64_t computeHash(ShaderId shaderId, wgpu::CullMode cullMode, bool blendEnabled)
+	{
+		uint64_t h = core::hashCombine(core::FNV1A_64_OFFSET, shaderId);
+		h = core::hashCombine(h, static_cast<uint64_t>(cullMode));
+		return core::hashCombine(h, blendEnabled ? 1u : 0u);
+	}
+};
+
 /**
  * @class WebGPUMaterial
  * @brief GPU-side material: wraps bind groups and layout setup, maintains a handle to the CPU-side Material.
  *
  * Uses a dictionary-based texture system that matches texture slot names from the CPU Material
  * to GPU WebGPUTexture instances. This allows flexible, modular material definitions.
+ *
+ * The material bind group is shared with other materials binding the same textures (see
+ * WebGPUMaterialFactory::acquireBatchSlot); draws select this material's entry through
+ * getMaterialIndex() passed as first instance.
  */
 class WebGPUMaterial : public WebGPUSyncObject<engine::rendering::Material>, public std::enable_shared_from_this<WebGPUMaterial>
 {
@@ -52,7 +113,13 @@ class WebGPUMaterial : public WebGPUSyncObject<engine::rendering::Material>, pub
 	 * @brief Get the material bind group.
 	 * @return Shared pointer to the bind group.
 	 */
-	[[nodiscard]] std::shared_ptr<WebGPUBindGroup> getBindGroup() const { return m_materialBindGroup; }
+	[[nodiscard]] const std::shared_ptr<WebGPUBindGroup> &getBindGroup() const { return m_materialBindGroup; }
+
+	/**
+	 * @brief Get the entry of this material in its bind group's properties table.
+	 * @return Index to pass as first instance of the material's draws.
+	 */
+	[[nodiscard]] uint32_t getMaterialIndex() const { return m_batchSlot.index; }
 
 	/**
 	 * @brief Get the material textures dictionary.
@@ -81,6 +148,12 @@ class WebGPUMaterial : public WebGPUSyncObject<engine::rendering::Material>, pub
 		m_textures[slotName] = texture;
 	}
 
+	/**
+	 * @brief Drop the texture of a slot, e.g. once it was copied into a texture array page.
+	 * @param slotName Name of the texture slot.
+	 */
+	void releaseTexture(const std::string &slotName) { m_textures.erase(slotName); }
+
 	/**
 	 * @brief Get the material options used for this WebGPUMaterial.
 	 * @return Reference to the options struct.
@@ -93,34 +166,36 @@ class WebGPUMaterial : public WebGPUSyncObject<engine::rendering::Material>, pub
 	 */
 	const std::string &getShaderName() const { return m_shaderName; }
 
-  protected:
 	/**
-	 * @brief Check if synchronization is needed.
-	 * Checks material version and all texture versions.
+	 * @brief Get the cached pipeline state (shader ID, culling, blending and its hash).
+	 * @return Pipeline state as of the last sync.
 	 */
-	bool needsSync(const Material &cpuMaterial) const override;
+	const WebGPUMaterialPipelineState &getPipelineState() const { return m_pipelineState; }
 
+  protected:
 	/**
 	 * @brief Sync GPU resources from CPU material.
 	 * Updates material properties and recreates bind groups if textures changed.
+	 * Only runs after the WebGPUSyncTracker reported a change of the material or one of its textures.
 	 */
 	void syncFromCPU(const Material &cpuMaterial) override;
 
   private:
 	/**
-	 * @brief Cache texture versions for dependency tracking.
+	 * @brief Register the material and its current textures with the WebGPUSyncTracker.
+	 * Textures the material no longer uses are unregistered.
 	 */
-	void cacheTextureVersions(const Material &cpuMaterial);
+	void watchSources(const Material &cpuMaterial);
 
 	/**
-	 * @brief Texture dictionary mapping slot names to GPU textures.
+	 * @brief Resolve the shader ID and feature flags into the cached pipeline state.
 	 */
-	std::unordered_map<std::string, std::shared_ptr<WebGPUTexture>> m_textures;
+	void updatePipelineState(const Material &cpuMaterial);
 
 	/**
-	 * @brief Cached texture versions for dependency tracking.
+	 * @brief Texture dictionary mapping slot names to GPU textures.
 	 */
-	std::unordered_map<std::string, uint64_t> m_textureVersions;
+	std::unordered_map<std::string, std::shared_ptr<WebGPUTexture>> m_textures;
 
 	/**
 	 * @brief Options used for this WebGPUMaterial.
@@ -133,9 +208,24 @@ class WebGPUMaterial : public WebGPUSyncObject<engine::rendering::Material>, pub
 	std::string m_shaderName;
 
 	/**
-	 * @brief The material bind group.
+	 * @brief Pipeline state derived from the CPU material.
+	 */
+	WebGPUMaterialPipelineState m_pipelineState;
+
+	/**
+	 * @brief The material bind group (shared by the batch).
 	 */
 	std::shared_ptr<WebGPUBindGroup> m_materialBindGroup;
+
+	/**
+	 * @brief Batch and table entry of this material.
+	 */
+	WebGPUMaterialBatchSlot m_batchSlot;
+
+	/**
+	 * @brief Change tokens of the textures registered by the last watchSources().
+	 */
+	std::vector<core::ChangeJournal::token_t> m_watchedTextures;
 };
 
 } // namespace engine::rendering::webgpu
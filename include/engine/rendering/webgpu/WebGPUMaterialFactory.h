@@ -5,12 +5,25 @@
 #include "engine/rendering/webgpu/WebGPUBindGroupLayoutInfo.h"
 #include "engine/rendering/webgpu/WebGPUMaterial.h"
 #include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 namespace engine::rendering::webgpu
 {
 class WebGPUContext;
 class WebGPUPipeline;
 
+/**
+ * @class WebGPUMaterialFactory
+ * @brief Creates GPU materials and assigns them to shared material bind groups.
+ *
+ * Materials resolving to the same textures share one bind group. With texture arrays enabled,
+ * textures of texture_2d_array bindings are packed into WebGPUTextureArrayPool pages first, so
+ * materials with different textures of the same size and format share a bind group as well.
+ * A packed texture is released from the material and the texture cache after the copy; the
+ * material's batch slot holds its layer instead, found again by texture, color space and version.
+ */
 class WebGPUMaterialFactory : public BaseWebGPUFactory<engine::rendering::Material, WebGPUMaterial>
 {
   public:
@@ -18,6 +31,47 @@ class WebGPUMaterialFactory : public BaseWebGPUFactory<engine::rendering::Materi
 
 	explicit WebGPUMaterialFactory(WebGPUContext &context);
 
+	/**
+	 * @brief Pack material textures into texture array pages (applies to materials synced afterwards).
+	 * @param enabled True to pack, false to bind each texture as a single-layer array.
+	 */
+	void setTextureArraysEnabled(bool enabled) { m_textureArraysEnabled = enabled; }
+
+	/** @brief Whether material textures are packed into texture array pages. */
+	[[nodiscard]] bool isTextureArraysEnabled() const { return m_textureArraysEnabled; }
+
+	/**
+	 * @brief Find or create the batch for a material's textures and claim an entry in it.
+	 * Keeps the current entry if the material still resolves to the same batch.
+	 * @param material GPU material to place.
+	 * @param cpuMaterial CPU material the textures and properties are resolved from.
+	 * @param layout Material bind group layout of the material's shader.
+	 * @param current Slot the material holds now (released if the batch changes).
+	 * @return The material's slot, or std::nullopt if a texture is missing or the bind group failed.
+	 */
+	std::optional<WebGPUMaterialBatchSlot> acquireBatchSlot(
+		const std::shared_ptr<WebGPUMaterial> &material,
+		const Material &cpuMaterial,
+		const std::shared_ptr<WebGPUBindGroupLayoutInfo> &layout,
+		const WebGPUMaterialBatchSlot &current
+	);
+
+	/** @brief Number of live material batches (material bind groups). */
+	[[nodiscard]] size_t getBatchCount() const;
+
+	/**
+	 * @brief Release batches no material holds anymore, with their bind groups and textures.
+	 * Batches are otherwise only released when their bucket is visited by acquireBatchSlot().
+	 * @return Number of released batches.
+	 */
+	size_t pruneBatches();
+
+	void cleanup() override
+	{
+		m_batches.clear();
+		BaseWebGPUFactory::cleanup();
+	}
+
   protected:
 	/**
 	 * @brief Create a WebGPUMaterial from a Material handle with options.
@@ -51,6 +105,38 @@ class WebGPUMaterialFactory : public BaseWebGPUFactory<engine::rendering::Materi
 	std::shared_ptr<WebGPUMaterial> createFromHandleUncached(const engine::rendering::Material::Handle &handle) override;
 
   private:
+	/**
+	 * @brief Texture and layer bound for one texture binding of a material.
+	 */
+	struct ResolvedTexture
+	{
+		std::shared_ptr<WebGPUTexture> texture;
+		uint32_t layer = 0;
+		std::shared_ptr<WebGPUTextureArrayLayer> packed; ///< Set if the texture is a layer of an array page
+	};
+
+	bool resolveTextures(
+		WebGPUMaterial &material,
+		const Material &cpuMaterial,
+		const WebGPUBindGroupLayoutInfo &layout,
+		std::vector<ResolvedTexture> &outTextures
+	);
+	std::shared_ptr<WebGPUTextureArrayLayer> packTexture(
+		const WebGPUMaterial &material,
+		const std::shared_ptr<WebGPUTexture> &texture,
+		uint64_t key
+	);
+	std::shared_ptr<WebGPUMaterialBatch> createBatch(
+		const std::shared_ptr<WebGPUMaterial> &material,
+		const std::shared_ptr<WebGPUBindGroupLayoutInfo> &layout,
+		const std::vector<ResolvedTexture> &textures,
+		uint32_t capacity
+	);
+	static bool matches(const WebGPUMaterialBatch &batch, const WebGPUBindGroupLayoutInfo *layout, const std::vector<ResolvedTexture> &textures);
+
 	std::shared_ptr<WebGPUBindGroupLayoutInfo> m_bindGroupLayoutInfo = nullptr;
+	std::unordered_map<uint64_t, std::vector<std::shared_ptr<WebGPUMaterialBatch>>> m_batches; ///< By hash of layout and bound textures
+	std::vector<ResolvedTexture> m_resolvedScratch;
+	bool m_textureArraysEnabled = false;
 };
 } // namespace engine::rendering::webgpu
@@ -27,7 +27,7 @@ class WebGPUMesh : public WebGPUSyncObject<engine::rendering::Mesh>
 	{
 		uint32_t indexOffset;
 		uint32_t indexCount;
-		std::shared_ptr<WebGPUMaterial> material; // Can be null if no material
+		std::weak_ptr<WebGPUMaterial> material; // Can be null if no material; the material factory owns it
 	};
 	struct VertexBufferEntry
 	{
@@ -58,7 +58,8 @@ class WebGPUMesh : public WebGPUSyncObject<engine::rendering::Mesh>
 		m_vertexCount(vertexCount),
 		m_indexCount(indexCount),
 		m_submeshes(std::move(submeshes)),
-		m_options(std::move(options))
+		m_options(std::move(options)),
+		m_topology(getCPUObject().getTopology())
 	{
 	}
 
@@ -109,12 +110,30 @@ class WebGPUMesh : public WebGPUSyncObject<engine::rendering::Mesh>
 	 */
 	uint32_t getIndexCount() const { return m_indexCount; }
 
+	/**
+	 * @brief Get the index buffer.
+	 * @return The index buffer, or nullptr for non-indexed meshes.
+	 */
+	wgpu::Buffer getIndexBuffer() const { return m_indexBuffer; }
+
 	/**
 	 * @brief Check if the mesh is indexed.
 	 * @return True if the mesh has an index buffer.
 	 */
 	bool isIndexed() const { return m_indexCount > 0; }
 
+	/**
+	 * @brief Get the GPU memory of the vertex buffers created so far and the index buffer.
+	 * @return Size in bytes.
+	 */
+	uint64_t getGPUMemoryBytes() const;
+
+	/**
+	 * @brief Get the primitive topology, cached from the CPU mesh on sync.
+	 * @return The topology type.
+	 */
+	Topology::Type getTopology() const { return m_topology; }
+
 	/**
 	 * @brief Get the submeshes.
 	 * @return The list of submeshes.
@@ -150,6 +169,7 @@ class WebGPUMesh : public WebGPUSyncObject<engine::rendering::Mesh>
 	uint32_t m_vertexCount;
 	std::vector<WebGPUSubmesh> m_submeshes;
 	WebGPUMeshOptions m_options;
+	Topology::Type m_topology;
 };
 
 } // namespace engine::rendering::webgpu
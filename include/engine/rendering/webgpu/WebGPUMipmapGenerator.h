@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <webgpu/webgpu.hpp>
+
+#include "engine/rendering/webgpu/WebGPUPipeline.h"
+
+namespace engine::rendering::webgpu
+{
+class WebGPUContext;
+
+/**
+ * @class WebGPUMipmapGenerator
+ * @brief Batched mip chain generation for 2D textures.
+ *
+ * enqueue() only records the request; flush() builds the mips of every pending texture in one
+ * command encoder and one submit. Textures are written by a compute downsampler that produces
+ * up to MAX_LEVELS_PER_DISPATCH levels per dispatch from workgroup memory, so a 2048² texture
+ * needs three dispatches instead of eleven render passes.
+ *
+ * - RGBA8Unorm, RGBA16Float, RGBA32Float: written in place through storage views.
+ * - RGBA8UnormSrgb (not storage-capable): mip 0 is copied into a scratch RGBA8Unorm texture,
+ *   filtered in linear space (decoded/encoded in the shader) and the levels are copied back.
+ * - Other formats (R8, RG8, R16F, ...): fallback render-pass blit per level.
+ *
+ * Pending work must be flushed before the mips are read, i.e. before any submit sampling or
+ * copying the texture. Textures must carry StorageBinding (compute formats), CopySrc (sRGB)
+ * or RenderAttachment (fallback) usage; see getRequiredUsage().
+ */
+class WebGPUMipmapGenerator
+{
+  public:
+	/** @brief Number of storage views bound per dispatch (the WebGPU default per-stage limit). */
+	static constexpr uint32_t MAX_LEVELS_PER_DISPATCH = 4;
+
+	explicit WebGPUMipmapGenerator(WebGPUContext &context);
+	~WebGPUMipmapGenerator();
+
+	WebGPUMipmapGenerator(const WebGPUMipmapGenerator &) = delete;
+	WebGPUMipmapGenerator &operator=(const WebGPUMipmapGenerator &) = delete;
+
+	/**
+	 * @brief Queue generation of mips 1..mipLevelCount-1 from mip 0.
+	 * @param texture Texture whose base level is (or will be, before flush()) uploaded.
+	 * @param format Texture format.
+	 * @param width Width of the base mip level.
+	 * @param height Height of the base mip level.
+	 * @param mipLevelCount Total number of mip levels of the texture.
+	 */
+	void enqueue(wgpu::Texture texture, wgpu::TextureFormat format, uint32_t width, uint32_t height, uint32_t mipLevelCount);
+
+	/**
+	 * @brief Record all pending mip chains into one command encoder and submit it.
+	 * @return Number of textures processed.
+	 */
+	size_t flush();
+
+	/** @brief True if mip generation for this texture is queued but not yet submitted. */
+	[[nodiscard]] bool isPending(const wgpu::Texture &texture) const;
+
+	/** @brief Number of textures waiting for flush(). */
+	[[nodiscard]] size_t getPendingCount() const { return m_pending.size(); }
+
+	/**
+	 * @brief Usage a texture of this format needs (besides CopyDst/TextureBinding) to get its mips generated.
+	 * @param format Texture format.
+	 * @return StorageBinding, CopySrc or RenderAttachment.
+	 */
+	[[nodiscard]] static wgpu::TextureUsage getRequiredUsage(wgpu::TextureFormat format);
+
+	/** @brief Drop pending jobs and release pipelines and helper resources. */
+	void cleanup();
+
+  private:
+	struct Job
+	{
+		wgpu::Texture texture = nullptr;
+		wgpu::TextureFormat format = wgpu::TextureFormat::Undefined;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t mipLevelCount = 1;
+	};
+
+	struct ComputePipeline
+	{
+		wgpu::ComputePipeline pipeline = nullptr;
+		wgpu::BindGroupLayout bindGroupLayout = nullptr;
+		wgpu::Texture dummyTexture = nullptr; ///< 1x1 target for unused level slots
+		wgpu::TextureView dummyView = nullptr;
+	};
+
+	/** @brief Format the compute path writes, Undefined if the format needs the render fallback. */
+	static wgpu::TextureFormat storageFormatFor(wgpu::TextureFormat format);
+
+	ComputePipeline *getOrCreateComputePipeline(wgpu::TextureFormat storageFormat);
+	bool ensureParamsBuffer();
+	void recordCompute(wgpu::ComputePassEncoder pass, const Job &job, wgpu::Texture target, wgpu::TextureFormat storageFormat, bool decodeSrgb, std::vector<wgpu::BindGroup> &bindGroups, std::vector<wgpu::TextureView> &views);
+	void recordBlit(wgpu::CommandEncoder encoder, const Job &job, std::vector<wgpu::BindGroup> &bindGroups, std::vector<wgpu::TextureView> &views);
+	std::shared_ptr<WebGPUPipeline> getOrCreateBlitPipeline(wgpu::TextureFormat format);
+
+	WebGPUContext &m_context;
+	std::vector<Job> m_pending;
+	std::unordered_map<uint32_t, ComputePipeline> m_computePipelines; ///< Keyed by storage format
+	wgpu::Buffer m_paramsBuffer = nullptr; ///< One MipmapParams slot per (levelCount, decodeSrgb) pair
+	uint32_t m_paramsStride = 256;
+};
+
+} // namespace engine::rendering::webgpu
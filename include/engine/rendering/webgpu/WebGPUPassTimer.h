@@ -0,0 +1,150 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <webgpu/webgpu.hpp>
+
+namespace engine::rendering::webgpu
+{
+class WebGPUContext;
+
+/**
+ * @brief Averaged GPU time of one labelled render pass.
+ */
+struct GpuPassTiming
+{
+	std::string name;
+	float averageMs = 0.0f; ///< Mean over the last WebGPUPassTimer::getAveragingFrames() resolved frames
+	float lastMs = 0.0f;	///< Most recent resolved frame
+	uint32_t passCount = 0; ///< Passes with this label in the most recent resolved frame
+};
+
+/**
+ * @class WebGPUPassTimer
+ * @brief Measures per-pass GPU time with timestamp queries written at render pass begin and end.
+ *
+ * Each frame owns a slice of one query set and one MapRead readback buffer out of a small ring.
+ * endFrame() resolves the slice and starts an async map; the results are consumed when the ring
+ * wraps back to that slot. If the GPU has not finished with the slot by then, timing is skipped
+ * for that frame instead of waiting, so the timer never stalls the CPU.
+ *
+ * When the device lacks the `timestamp-query` feature (or timing is disabled) every call is a
+ * no-op and render passes are created without timestamp writes.
+ */
+class WebGPUPassTimer
+{
+  public:
+	/** @brief Maximum number of timed passes per frame. Further passes are not timed. */
+	static constexpr uint32_t MAX_PASSES_PER_FRAME = 64;
+	/** @brief Number of frames whose results can be in flight at once. */
+	static constexpr uint32_t FRAMES_IN_FLIGHT = 3;
+	/** @brief Upper bound for setAveragingFrames(). */
+	static constexpr uint32_t MAX_AVERAGING_FRAMES = 240;
+
+	explicit WebGPUPassTimer(WebGPUContext &context);
+	~WebGPUPassTimer();
+
+	WebGPUPassTimer(const WebGPUPassTimer &) = delete;
+	WebGPUPassTimer &operator=(const WebGPUPassTimer &) = delete;
+
+	/**
+	 * @brief Create the query set and readback ring.
+	 * @param supported Whether the device was created with the timestamp-query feature.
+	 * @return True if GPU timing is available.
+	 */
+	bool initialize(bool supported);
+
+	/** @brief Check if the device supports GPU timing at all. */
+	[[nodiscard]] bool isAvailable() const { return m_querySet != nullptr; }
+
+	/** @brief Check if timing is available and switched on. */
+	[[nodiscard]] bool isEnabled() const { return isAvailable() && m_enabled; }
+
+	/** @brief Switch timing on or off at runtime. Has no effect if unavailable. */
+	void setEnabled(bool enabled) { m_enabled = enabled; }
+
+	/** @brief Set how many resolved frames the per-pass average covers (clamped to 1..MAX_AVERAGING_FRAMES). */
+	void setAveragingFrames(uint32_t frames);
+
+	/** @brief Get the number of frames the per-pass average covers. */
+	[[nodiscard]] uint32_t getAveragingFrames() const { return m_averagingFrames; }
+
+	/**
+	 * @brief Start a frame. Consumes the results of the ring slot being reused, if ready.
+	 */
+	void beginFrame();
+
+	/**
+	 * @brief Reserve a begin/end query pair for a render pass of the current frame.
+	 * @param label Name the pass time is accumulated under. Passes sharing a label are summed.
+	 * @param outWrites Filled with the query set and indices on success.
+	 * @return False if timing is inactive for this frame or the frame ran out of queries.
+	 */
+	bool allocate(const std::string &label, wgpu::RenderPassTimestampWrites &outWrites);
+
+	/**
+	 * @brief Resolve the frame's queries into its readback buffer and start mapping it.
+	 * Call after the last timed pass of the frame was submitted.
+	 */
+	void endFrame();
+
+	/**
+	 * @brief Get the averaged per-pass GPU times.
+	 * @return Timings in the order the passes first appeared.
+	 */
+	[[nodiscard]] std::vector<GpuPassTiming> getTimings() const;
+
+	/** @brief Sum of the averaged times of all passes. */
+	[[nodiscard]] float getTotalMs() const;
+
+  private:
+	enum class SlotState
+	{
+		Idle,	   ///< Free for recording
+		Recording, ///< Owned by the current frame
+		Mapping	   ///< Resolved, waiting for the map callback
+	};
+
+	struct FrameSlot
+	{
+		wgpu::Buffer readback = nullptr;
+		std::vector<uint32_t> labelIds; ///< Label id per allocated pass, query pair i = (2i, 2i + 1)
+		SlotState state = SlotState::Idle;
+		bool mapped = false;
+		bool mapSuccess = false;
+		std::unique_ptr<wgpu::BufferMapCallback> mapCallback;
+	};
+
+	struct PassHistory
+	{
+		std::string name;
+		std::array<float, MAX_AVERAGING_FRAMES> samplesMs{};
+		uint32_t count = 0;
+		uint32_t next = 0;
+		float lastMs = 0.0f;
+		uint32_t lastPassCount = 0;
+		float frameAccumMs = 0.0f;
+		uint32_t framePassCount = 0;
+	};
+
+	void consume(FrameSlot &slot);
+	uint32_t labelId(const std::string &label);
+
+	WebGPUContext &m_context;
+	wgpu::QuerySet m_querySet = nullptr;
+	wgpu::Buffer m_resolveBuffer = nullptr;
+	std::array<FrameSlot, FRAMES_IN_FLIGHT> m_slots;
+	uint32_t m_currentSlot = 0;
+	bool m_frameActive = false;
+	bool m_enabled = true;
+	uint32_t m_averagingFrames = 60;
+
+	std::vector<PassHistory> m_history;
+	std::unordered_map<std::string, uint32_t> m_labelIds;
+};
+
+} // namespace engine::rendering::webgpu
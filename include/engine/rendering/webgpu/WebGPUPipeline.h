@@ -173,7 +173,7 @@ class WebGPUPipeline
 	 * @brief Gets the shader info associated with this pipeline.
 	 * @return The shader info.
 	 */
-	[[nodiscard]] std::shared_ptr<WebGPUShaderInfo> getShaderInfo() const { return m_shaderInfo; }
+	[[nodiscard]] const std::shared_ptr<WebGPUShaderInfo> &getShaderInfo() const { return m_shaderInfo; }
 
 	/**
 	 * @brief Implicit conversion to wgpu::RenderPipeline for convenience.
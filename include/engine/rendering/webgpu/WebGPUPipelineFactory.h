@@ -22,7 +22,8 @@ class WebGPUPipelineFactory
 		engine::rendering::Topology::Type topology = engine::rendering::Topology::Type::Triangles,
 		wgpu::CullMode cullMode = wgpu::CullMode::Back,
 		bool blendEnabled = false,
-		uint32_t sampleCount = 1
+		uint32_t sampleCount = 1,
+		bool depthPrepassed = false // Depth already written by a pre-pass: test Equal, no depth writes
 	);
 
 	// Helper to create a pipeline layout from bind group layouts
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <filesystem>
+#include <limits>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 #include <webgpu/webgpu.hpp>
 
+#include "engine/core/Hash.h"
 #include "engine/rendering/Mesh.h"
 #include "engine/rendering/webgpu/WebGPUBindGroupLayoutInfo.h"
 #include "engine/rendering/webgpu/WebGPUMaterial.h"
@@ -18,32 +22,77 @@ namespace engine::rendering::webgpu
 {
 
 class WebGPUContext;
+class WebGPUMesh;
 class WebGPUPipelineFactory;
 
 /**
  * @brief Configuration for creating a WebGPU pipeline.
  * Contains all parameters needed to define a pipeline.
- * Uses shader NAME as key, not shader pointer (shaders are immutable).
+ * Uses the stable shader ID as key, not the shader pointer (shaders are swapped on reload).
+ * The hash is computed once on construction; use PipelineKey::create().
  */
 struct PipelineKey
 {
-	std::string shaderName;						// shader identifier (immutable after creation)
+	ShaderId shaderId;							// stable shader identifier (survives reloads)
 	wgpu::TextureFormat colorFormat;			// from RenderTarget
 	wgpu::TextureFormat depthFormat;			// from RenderTarget
 	engine::rendering::Topology::Type topology; // from Mesh
 	wgpu::CullMode cullMode;					// from Material / Default
 	bool blendEnabled;							// from Material / Default
 	uint32_t sampleCount;						// MSAA, from RenderTarget / global
+	bool depthPrepassed;						// depth laid down by the depth pre-pass: Equal test, no depth writes
+	uint64_t hash;								// precomputed hash of all fields above
+
+	/**
+	 * @brief Build a key from material pipeline state and target state.
+	 * The material part of the hash is taken from the precomputed state.
+	 */
+	static PipelineKey create(
+		const WebGPUMaterialPipelineState &material,
+		wgpu::TextureFormat colorFormat,
+		wgpu::TextureFormat depthFormat,
+		engine::rendering::Topology::Type topology,
+		uint32_t sampleCount,
+		bool depthPrepassed = false
+	)
+	{
+		uint64_t h = core::hashCombine(material.hash, static_cast<uint64_t>(colorFormat));
+		h = core::hashCombine(h, static_cast<uint64_t>(depthFormat));
+		h = core::hashCombine(h, static_cast<uint64_t>(topology));
+		h = core::hashCombine(h, sampleCount);
+		h = core::hashCombine(h, depthPrepassed ? 1u : 0u);
+		return {material.shaderId, colorFormat, depthFormat, topology, material.cullMode, material.blendEnabled, sampleCount, depthPrepassed, h};
+	}
+
+	/**
+	 * @brief Build a key from explicit parameters.
+	 */
+	static PipelineKey create(
+		ShaderId shaderId,
+		wgpu::TextureFormat colorFormat,
+		wgpu::TextureFormat depthFormat,
+		engine::rendering::Topology::Type topology,
+		wgpu::CullMode cullMode,
+		bool blendEnabled,
+		uint32_t sampleCount,
+		bool depthPrepassed = false
+	)
+	{
+		WebGPUMaterialPipelineState material{shaderId, cullMode, blendEnabled, WebGPUMaterialPipelineState::computeHash(shaderId, cullMode, blendEnabled)};
+		return create(material, colorFormat, depthFormat, topology, sampleCount, depthPrepassed);
+	}
 
 	bool operator==(const PipelineKey &other) const
 	{
-		return shaderName == other.shaderName
+		return hash == other.hash
+			   && shaderId == other.shaderId
 			   && colorFormat == other.colorFormat
 			   && depthFormat == other.depthFormat
 			   && topology == other.topology
 			   && cullMode == other.cullMode
 			   && blendEnabled == other.blendEnabled
-			   && sampleCount == other.sampleCount;
+			   && sampleCount == other.sampleCount
+			   && depthPrepassed == other.depthPrepassed;
 	}
 };
 
@@ -54,17 +103,26 @@ struct PipelineKeyHasher
 {
 	std::size_t operator()(const PipelineKey &key) const
 	{
-		std::size_t h = std::hash<std::string>{}(key.shaderName);
-		h ^= std::hash<int>{}(static_cast<int>(key.colorFormat)) + 0x9e3779b9 + (h << 6) + (h >> 2);
-		h ^= std::hash<int>{}(static_cast<int>(key.depthFormat)) + 0x9e3779b9 + (h << 6) + (h >> 2);
-		h ^= std::hash<int>{}(static_cast<int>(key.topology)) + 0x9e3779b9 + (h << 6) + (h >> 2);
-		h ^= std::hash<int>{}(static_cast<int>(key.cullMode)) + 0x9e3779b9 + (h << 6) + (h >> 2);
-		h ^= std::hash<bool>{}(key.blendEnabled) + 0x9e3779b9 + (h << 6) + (h >> 2);
-		h ^= std::hash<uint32_t>{}(key.sampleCount) + 0x9e3779b9 + (h << 6) + (h >> 2);
-		return h;
+		return static_cast<std::size_t>(key.hash);
 	}
 };
 
+/**
+ * @brief Persistent form of a PipelineKey.
+ * Refers to the shader by name since shader IDs are only stable within a session.
+ */
+struct PipelineManifestEntry
+{
+	std::string shaderName;
+	wgpu::TextureFormat colorFormat = wgpu::TextureFormat::Undefined;
+	wgpu::TextureFormat depthFormat = wgpu::TextureFormat::Undefined;
+	engine::rendering::Topology::Type topology = engine::rendering::Topology::Default;
+	wgpu::CullMode cullMode = wgpu::CullMode::Back;
+	bool blendEnabled = false;
+	uint32_t sampleCount = 1;
+	bool depthPrepassed = false;
+};
+
 /**
  * @brief Manages render pipelines with hot-reloading support.
  *
@@ -78,6 +136,12 @@ struct PipelineKeyHasher
  * - Reloads are deferred to frame boundaries (processPendingReloads called after frame presentation)
  * - Avoids global invalidation: only affected pipelines are reloaded
  * - Internal factory is not publicly accessible (used only by manager)
+ *
+ * Warm-up:
+ * The keys of all pipelines created during a session can be saved to a manifest
+ * (saveManifest). On the next launch the manifest is loaded (loadManifest) and the
+ * pipelines are pre-created during loading (warmUp), so the first frame that uses a
+ * material/topology/format combination does not stall on pipeline compilation.
  */
 class WebGPUPipelineManager
 {
@@ -102,6 +166,26 @@ class WebGPUPipelineManager
 		const std::shared_ptr<engine::rendering::webgpu::WebGPURenderPassContext> &renderPass
 	);
 
+	/**
+	 * @brief Get or create a pipeline for a GPU mesh and material (hot path).
+	 *
+	 * Uses the pipeline state cached on the GPU objects (shader ID, culling, blending,
+	 * topology and the precomputed hash), so no CPU handles are resolved and no
+	 * shader name is looked up when the pipeline already exists.
+	 *
+	 * @param mesh The GPU mesh providing the topology.
+	 * @param material The GPU material providing shader and render state.
+	 * @param renderPass The render pass defining target formats.
+	 * @param depthPrepassed True if the depth pre-pass already wrote this item's depth (Equal test, no writes).
+	 * @return Valid pipeline or nullptr on failure.
+	 */
+	std::shared_ptr<WebGPUPipeline> getOrCreatePipeline(
+		const WebGPUMesh &mesh,
+		const WebGPUMaterial &material,
+		const std::shared_ptr<engine::rendering::webgpu::WebGPURenderPassContext> &renderPass,
+		bool depthPrepassed = false
+	);
+
 	/**
 	 * @brief Get or create a pipeline with explicit parameters (no mesh/material required).
 	 *
@@ -159,6 +243,44 @@ class WebGPUPipelineManager
 	 */
 	void cleanup();
 
+	/**
+	 * @brief Get the pipeline generation.
+	 * Incremented whenever cached pipelines are replaced (reload) or dropped (cleanup),
+	 * so callers holding on to pipelines can detect that they are stale.
+	 * @return Current generation.
+	 */
+	[[nodiscard]] uint64_t getGeneration() const { return m_generation; }
+
+	/**
+	 * @brief Load a pipeline manifest and queue its entries for warm-up.
+	 * @param path Manifest file written by saveManifest().
+	 * @return True if the manifest was read (a missing file is not an error but returns false).
+	 */
+	bool loadManifest(const std::filesystem::path &path);
+
+	/**
+	 * @brief Write the keys of all cached pipelines (and queued entries whose shader never appeared) to a manifest.
+	 * @param path Manifest file to write; parent directories are created.
+	 * @return True on success.
+	 */
+	bool saveManifest(const std::filesystem::path &path) const;
+
+	/**
+	 * @brief Pre-create queued manifest pipelines.
+	 *
+	 * Can be called repeatedly with a budget to spread the work over loading-screen frames.
+	 * Entries whose shader is not registered are kept for the next saveManifest().
+	 *
+	 * @param maxPipelines Maximum number of entries to process in this call.
+	 * @return Number of entries still queued.
+	 */
+	size_t warmUp(size_t maxPipelines = std::numeric_limits<size_t>::max());
+
+	/**
+	 * @brief Number of manifest entries still waiting for warmUp().
+	 */
+	[[nodiscard]] size_t getPendingWarmUpCount() const { return m_warmUpQueue.size() - m_warmUpCursor; }
+
   private:
 	WebGPUContext &m_context;
 	std::unique_ptr<WebGPUPipelineFactory> m_pipelineFactory;
@@ -170,6 +292,16 @@ class WebGPUPipelineManager
 	// Pipelines marked for reload after current frame finishes
 	std::unordered_set<std::shared_ptr<WebGPUPipeline>> m_pendingReloads;
 
+	// Bumped whenever pipelines in the cache are replaced or dropped
+	uint64_t m_generation = 0;
+
+	// Manifest entries queued for warm-up, processed from m_warmUpCursor on
+	std::vector<PipelineManifestEntry> m_warmUpQueue;
+	size_t m_warmUpCursor = 0;
+
+	// Manifest entries whose shader was not registered at warm-up; written back on save
+	std::vector<PipelineManifestEntry> m_unresolvedManifestEntries;
+
 	/**
 	 * @brief Internal: Create a new pipeline object (no caching, no registration).
 	 *
@@ -184,6 +316,17 @@ class WebGPUPipelineManager
 		const std::shared_ptr<WebGPUShaderInfo> &shaderInfo,
 		std::shared_ptr<WebGPUPipeline> &outPipeline
 	);
+
+	/**
+	 * @brief Internal: Look up a key, creating and caching the pipeline on a miss.
+	 * @param key Pipeline key.
+	 * @param shaderInfo Shader to create the pipeline with; resolved by ID if null.
+	 * @return Cached or newly created pipeline, or nullptr on failure.
+	 */
+	std::shared_ptr<WebGPUPipeline> findOrCreate(
+		const PipelineKey &key,
+		std::shared_ptr<WebGPUShaderInfo> shaderInfo
+	);
 };
 
 } // namespace engine::rendering::webgpu
\ No newline at end of file
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <webgpu/webgpu.hpp>
+
+#include "engine/resources/Image.h"
+
+namespace engine::rendering::webgpu
+{
+class WebGPUContext;
+class WebGPUTexture;
+
+/**
+ * @brief Receives the result of a texture readback: an LDR RGBA8 image, or nullptr on failure.
+ */
+using ReadbackCallback = std::function<void(engine::resources::Image::Ptr)>;
+
+/**
+ * @class WebGPUReadbackService
+ * @brief Asynchronous GPU-to-CPU texture readback with pooled staging buffers.
+ *
+ * readTexture() records a copy into a MapRead staging buffer taken from a pool and starts mapping
+ * it; several readbacks (of the same or different textures) can be in flight at once. update(),
+ * called once per frame on the render thread, hands mapped buffers to a worker thread that strips
+ * the row padding and converts to 8-bit sRGB (HDR formats) straight from the mapped memory. The
+ * buffer is unmapped and returned to the pool on a later update(), so the render thread never
+ * waits on the GPU or touches pixels. Results typically arrive one to three frames later.
+ *
+ * Callbacks run on the render thread inside update(); futures are fulfilled on the worker thread.
+ * Staging buffers unused for STAGING_IDLE_FRAMES updates are released.
+ */
+class WebGPUReadbackService
+{
+  public:
+	/** @brief Maximum number of readbacks in flight. Further requests are rejected. */
+	static constexpr uint32_t MAX_IN_FLIGHT = 16;
+	/** @brief Updates a free staging buffer is kept before it is released. */
+	static constexpr uint32_t STAGING_IDLE_FRAMES = 120;
+
+	explicit WebGPUReadbackService(WebGPUContext &context);
+	~WebGPUReadbackService();
+
+	WebGPUReadbackService(const WebGPUReadbackService &) = delete;
+	WebGPUReadbackService &operator=(const WebGPUReadbackService &) = delete;
+
+	/**
+	 * @brief Start reading back mip 0 of a 2D texture.
+	 * @param texture Source texture (RGBA8/BGRA8, RGBA16Float or RGBA32Float, with CopySrc usage).
+	 * @param callback Called on the render thread from update() with the image (nullptr on failure).
+	 * @return False if the format is unsupported or too many readbacks are in flight
+	 *         (the callback is not called).
+	 */
+	bool readTexture(const WebGPUTexture &texture, ReadbackCallback callback);
+
+	/**
+	 * @brief Start reading back mip 0 of a 2D texture, delivering the image through a future.
+	 *
+	 * The future becomes ready on the worker thread, but only after update() handed the mapped
+	 * buffer over; callers waiting on it must keep the render loop (or pollDevice() + update()) going.
+	 *
+	 * @param texture Source texture.
+	 * @return Future holding the image, or nullptr if the readback failed or could not be started.
+	 */
+	std::future<engine::resources::Image::Ptr> readTexture(const WebGPUTexture &texture);
+
+	/**
+	 * @brief Advance readbacks: dispatch mapped buffers, recycle converted ones, deliver callbacks.
+	 * Call once per frame on the render thread.
+	 */
+	void update();
+
+	/** @brief Number of readbacks not yet delivered. */
+	[[nodiscard]] size_t getInFlightCount() const { return m_readbacks.size(); }
+
+	/** @brief Number of staging buffers owned by the pool (free and in use). */
+	[[nodiscard]] size_t getStagingBufferCount() const { return m_freeStaging.size() + m_readbacks.size(); }
+
+  private:
+	struct Staging
+	{
+		wgpu::Buffer buffer = nullptr;
+		uint64_t size = 0;
+		uint64_t lastUsedFrame = 0;
+	};
+
+	enum class State
+	{
+		Mapping,	///< Copy submitted, waiting for the map callback
+		Converting, ///< Mapped, owned by the worker
+		Done		///< Converted, waiting for update() to unmap and deliver
+	};
+
+	struct Readback
+	{
+		Staging staging;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t bytesPerRow = 0;
+		wgpu::TextureFormat format = wgpu::TextureFormat::Undefined;
+		ReadbackCallback callback;
+		std::shared_ptr<std::promise<engine::resources::Image::Ptr>> promise;
+
+		State state = State::Mapping;
+		bool mapped = false;
+		bool mapSuccess = false;
+		std::unique_ptr<wgpu::BufferMapCallback> mapCallback;
+
+		const uint8_t *mappedData = nullptr;	///< Valid while Converting (read by the worker)
+		std::atomic<bool> converted{false};		///< Set by the worker when image is final
+		engine::resources::Image::Ptr image;	///< Written by the worker
+	};
+
+	bool startReadback(const WebGPUTexture &texture, ReadbackCallback callback, std::shared_ptr<std::promise<engine::resources::Image::Ptr>> promise);
+	Staging acquireStaging(uint64_t size);
+	void releaseStaging(Staging staging);
+	void ensureWorker();
+	void workerLoop();
+	static engine::resources::Image::Ptr convert(const Readback &readback);
+
+	WebGPUContext &m_context;
+	uint64_t m_frame = 0;
+	std::vector<std::unique_ptr<Readback>> m_readbacks; ///< In submission order
+	std::vector<Staging> m_freeStaging;
+
+	std::thread m_worker;
+	std::mutex m_queueMutex;
+	std::condition_variable m_queueCondition;
+	std::deque<Readback *> m_queue; ///< Mapped readbacks waiting for conversion
+	bool m_stopWorker = false;
+};
+
+} // namespace engine::rendering::webgpu
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "engine/core/Identifiable.h"
+#include "engine/rendering/webgpu/WebGPUPassTimer.h"
 #include "engine/rendering/webgpu/WebGPUTexture.h"
 #include <memory>
 #include <optional>
+#include <string>
 #include <webgpu/webgpu.hpp>
 
 namespace engine::rendering::webgpu
@@ -26,6 +28,10 @@ struct WebGPURenderPassContext : public engine::core::Identifiable<WebGPURenderP
 	std::optional<wgpu::RenderPassDepthStencilAttachment> m_depthAttachmentCopy;
 	wgpu::RenderPassDescriptor m_renderPassDesc;
 
+	WebGPUPassTimer *m_passTimer = nullptr;
+	std::string m_timingLabel;
+	wgpu::RenderPassTimestampWrites m_timestampWrites{};
+
   public:
 	/**
 	 * @brief Default constructor. Creates an empty render pass buffer.
@@ -88,13 +94,34 @@ struct WebGPURenderPassContext : public engine::core::Identifiable<WebGPURenderP
 	 */
 	const wgpu::RenderPassDescriptor &getRenderPassDescriptor() const { return m_renderPassDesc; }
 
+	/**
+	 * @brief Sets the timer used to measure this pass on the GPU.
+	 * @param timer Pass timer, or nullptr to disable timing.
+	 */
+	void setPassTimer(WebGPUPassTimer *timer) { m_passTimer = timer; }
+
+	/**
+	 * @brief Sets the name GPU time of this pass is reported under. Empty disables timing.
+	 * @param label Timing label (passes sharing a label are summed per frame).
+	 */
+	void setTimingLabel(std::string label) { m_timingLabel = std::move(label); }
+
+	/**
+	 * @brief Returns the timing label of this pass.
+	 */
+	const std::string &getTimingLabel() const { return m_timingLabel; }
+
 	/**
 	 * @brief Begins a render pass using the provided encoder.
+	 * Writes begin/end timestamps if a timing label is set and the pass timer is active.
 	 * @param encoder Command encoder to use.
 	 * @return The created RenderPassEncoder.
 	 */
 	wgpu::RenderPassEncoder begin(wgpu::CommandEncoder &encoder)
 	{
+		m_renderPassDesc.timestampWrites = nullptr;
+		if (m_passTimer && !m_timingLabel.empty() && m_passTimer->allocate(m_timingLabel, m_timestampWrites))
+			m_renderPassDesc.timestampWrites = &m_timestampWrites;
 		return encoder.beginRenderPass(m_renderPassDesc);
 	}
 
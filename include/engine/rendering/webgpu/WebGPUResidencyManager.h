@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <webgpu/webgpu.hpp>
+
+#include "engine/rendering/Mesh.h"
+#include "engine/rendering/Texture.h"
+
+namespace engine::rendering::webgpu
+{
+class WebGPUContext;
+class WebGPUMaterial;
+class WebGPUMesh;
+class WebGPUTexture;
+
+/**
+ * @class WebGPUResidencyManager
+ * @brief Keeps the scene's GPU textures and meshes within a VRAM budget.
+ *
+ * The renderer marks the meshes, materials and textures of every prepared render item as used,
+ * which records the frame and the resource's GPU size. When the tracked total exceeds the budget,
+ * evictToBudget() drops the least recently used resources from the factory caches (materials and
+ * models referencing them go with them), so their memory is freed once the last reference is gone.
+ * An evicted resource is recreated from its CPU object by the factory the next time it is needed.
+ *
+ * Only resources idle for at least the minimum idle frames are evicted. Every eviction bumps the
+ * generation; caches holding raw GPU handles (StaticDrawCache) drop their contents when it changes,
+ * since a camera that did not render for a while still holds packets of evicted resources.
+ */
+class WebGPUResidencyManager
+{
+  public:
+	/** @brief Default frames a resource must be unused before it can be evicted. */
+	static constexpr uint64_t DEFAULT_MIN_IDLE_FRAMES = 600;
+
+	explicit WebGPUResidencyManager(WebGPUContext &context);
+
+	WebGPUResidencyManager(const WebGPUResidencyManager &) = delete;
+	WebGPUResidencyManager &operator=(const WebGPUResidencyManager &) = delete;
+
+	/**
+	 * @brief Set the VRAM budget for tracked textures and meshes.
+	 * @param bytes Budget in bytes (0 = unlimited, nothing is evicted).
+	 */
+	void setBudget(uint64_t bytes) { m_budget = bytes; }
+
+	/** @brief VRAM budget in bytes (0 = unlimited). */
+	[[nodiscard]] uint64_t getBudget() const { return m_budget; }
+
+	/** @brief Set the frames a resource must be unused before it can be evicted. */
+	void setMinIdleFrames(uint64_t frames) { m_minIdleFrames = frames; }
+
+	/** @brief Frames a resource must be unused before it can be evicted. */
+	[[nodiscard]] uint64_t getMinIdleFrames() const { return m_minIdleFrames; }
+
+	/** @brief Advance the frame counter. Call once per frame before resources are marked. */
+	void beginFrame() { ++m_frame; }
+
+	/** @brief Record that a mesh is drawn this frame. */
+	void markUsed(const WebGPUMesh &mesh);
+
+	/** @brief Record that a material and its textures are drawn this frame. */
+	void markUsed(const WebGPUMaterial &material);
+
+	/** @brief Record that a texture is sampled this frame (textures without a CPU handle are ignored). */
+	void markUsed(const WebGPUTexture &texture);
+
+	/**
+	 * @brief Evict least recently used resources until the tracked total fits the budget.
+	 * Call after the frame's GPU render items were released.
+	 * @return Number of evicted resources.
+	 */
+	size_t evictToBudget();
+
+	/** @brief Bytes of all tracked resources. */
+	[[nodiscard]] uint64_t getResidentBytes() const { return m_textureBytes + m_meshBytes; }
+
+	/** @brief Bytes of tracked textures. */
+	[[nodiscard]] uint64_t getTextureBytes() const { return m_textureBytes; }
+
+	/** @brief Bytes of tracked mesh buffers. */
+	[[nodiscard]] uint64_t getMeshBytes() const { return m_meshBytes; }
+
+	/** @brief Counter bumped by every evictToBudget() call that evicted something. */
+	[[nodiscard]] uint64_t getGeneration() const { return m_generation; }
+
+	/** @brief Number of resources evicted so far. */
+	[[nodiscard]] size_t getEvictionCount() const { return m_evictionCount; }
+
+	/** @brief Bytes evicted so far. */
+	[[nodiscard]] uint64_t getEvictedBytes() const { return m_evictedBytes; }
+
+	/** @brief Forget all tracked resources (e.g. after the factories were cleaned up). */
+	void clear();
+
+	/**
+	 * @brief Estimate the VRAM size of a texture from its descriptor, including mips and layers.
+	 * Block-compressed formats are sized per 4x4 block.
+	 */
+	[[nodiscard]] static uint64_t estimateTextureBytes(const wgpu::TextureDescriptor &descriptor);
+
+  private:
+	/**
+	 * @brief Accounting for one tracked resource.
+	 */
+	struct Entry
+	{
+		uint64_t bytes = 0;			///< GPU memory of the resource
+		uint64_t lastUsedFrame = 0; ///< Frame the resource was last marked used
+	};
+
+	WebGPUContext &m_context;
+	std::unordered_map<Texture::Handle, Entry> m_textures;
+	std::unordered_map<Mesh::Handle, Entry> m_meshes;
+	uint64_t m_textureBytes = 0;
+	uint64_t m_meshBytes = 0;
+	uint64_t m_budget = 0;
+	uint64_t m_minIdleFrames = DEFAULT_MIN_IDLE_FRAMES;
+	uint64_t m_frame = 0;
+	uint64_t m_generation = 0;
+	size_t m_evictionCount = 0;
+	uint64_t m_evictedBytes = 0;
+};
+
+} // namespace engine::rendering::webgpu
@@ -6,6 +6,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <glm/glm.hpp>
@@ -14,6 +15,7 @@
 #include "engine/rendering/FrameUniforms.h"
 #include "engine/rendering/BindGroupEnums.h"
 #include "engine/rendering/LightUniforms.h"
+#include "engine/rendering/MaterialFeatureMask.h"
 #include "engine/rendering/ObjectUniforms.h"
 #include "engine/rendering/ShaderType.h"
 #include "engine/rendering/Vertex.h"
@@ -63,6 +65,14 @@ class WebGPUShaderFactory
 	 */
 	explicit WebGPUShaderFactory(WebGPUContext &context);
 
+	/**
+	 * @brief Releases the cached shader modules.
+	 */
+	~WebGPUShaderFactory();
+
+	WebGPUShaderFactory(const WebGPUShaderFactory &) = delete;
+	WebGPUShaderFactory &operator=(const WebGPUShaderFactory &) = delete;
+
 	struct BindGroupBuilder
 	{
 		std::string name;								  ///< User-provided name for the bind group (also used as cache key)
@@ -196,7 +206,7 @@ class WebGPUShaderFactory
 		WebGPUShaderBuilder &addObjectBindGroup();
 
 		/**
-		 * @brief Adds light data bind group (light count + array of lights).
+		 * @brief Adds light data bind group (light header + array of lights, light clusters, light index list).
 		 * Automatically creates a new "Light" bind group with BindGroupType::Light.
 		 * @return Reference to this builder for chaining.
 		 */
@@ -222,6 +232,18 @@ class WebGPUShaderFactory
 			uint32_t visibility = static_cast<uint32_t>(wgpu::ShaderStage::Vertex)
 		);
 
+		/**
+		 * @brief Declares the material features the shader source can be specialized on.
+		 *
+		 * Each feature becomes a WGSL boolean constant (see getFeatureConstantName()) that the
+		 * source branches on. The shader built here has all of them enabled; per-material variants
+		 * with features disabled are compiled on demand by the ShaderRegistry.
+		 *
+		 * @param features Mask of specializable material features.
+		 * @return Reference to this builder for chaining.
+		 */
+		WebGPUShaderBuilder &setMaterialVariants(engine::rendering::MaterialFeature::Flag features);
+
 		/**
 		 * @brief Finalizes the shader and creates GPU resources.
 		 *
@@ -264,6 +286,7 @@ class WebGPUShaderFactory
 		bool m_depthEnabled;
 		bool m_backFaceCullingEnabled;
 		uint32_t m_shaderFeatures = 0;
+		engine::rendering::MaterialFeature::Flag m_variantFeatures = engine::rendering::MaterialFeature::Flag::None;
 		std::filesystem::path m_shaderPath;
 
 		std::map<uint32_t, BindGroupBuilder> m_bindGroupsBuilder;
@@ -296,10 +319,56 @@ class WebGPUShaderFactory
 
 	/**
 	 * @brief Loads shader module from file path.
+	 *
+	 * Modules are cached by WGSL content hash. A file whose size and write time are unchanged
+	 * since the last load is not read again, and identical sources are compiled only once.
+	 * Each call returns a new reference the caller must release.
+	 *
 	 * @param shaderPath Path to the WGSL shader file.
+	 * @param prelude WGSL code prepended to the file contents (e.g. feature constants).
 	 * @return Loaded shader module.
 	 */
-	wgpu::ShaderModule loadShaderModule(const std::filesystem::path &shaderPath);
+	wgpu::ShaderModule loadShaderModule(const std::filesystem::path &shaderPath, const std::string &prelude = {});
+
+	/**
+	 * @brief Compiles a material variant of a shader.
+	 *
+	 * The variant shares the bind group layouts of the base shader and is compiled from the
+	 * same source with the given features enabled and all other variant features disabled.
+	 *
+	 * @param baseShader Shader declaring the variant features.
+	 * @param variantName Name of the new shader info.
+	 * @param enabledFeatures Features compiled in (masked by the base shader's variant features).
+	 * @return The variant shader info (not registered), or nullptr on failure.
+	 */
+	std::shared_ptr<WebGPUShaderInfo> createVariant(
+		const std::shared_ptr<WebGPUShaderInfo> &baseShader,
+		const std::string &variantName,
+		engine::rendering::MaterialFeature::Flag enabledFeatures
+	);
+
+	/**
+	 * @brief Builds the WGSL constant declarations for a feature permutation.
+	 * @param variantFeatures Features the shader declares.
+	 * @param enabledFeatures Features to enable.
+	 * @return WGSL source with one `const <NAME>: bool` per declared feature.
+	 */
+	static std::string buildFeaturePrelude(
+		engine::rendering::MaterialFeature::Flag variantFeatures,
+		engine::rendering::MaterialFeature::Flag enabledFeatures
+	);
+
+	/**
+	 * @brief WGSL constant name of a material feature flag.
+	 * @param feature Single feature flag.
+	 * @return Constant name (e.g. "HAS_NORMAL_MAP"), or nullptr if the feature cannot be specialized.
+	 */
+	static const char *getFeatureConstantName(engine::rendering::MaterialFeature::Flag feature);
+
+	/**
+	 * @brief Drop all cached shader modules (forces recompilation on the next load).
+	 */
+	void clearModuleCache();
 
 	/**
 	 * @brief Reloads a specific shader info by reconstructing it with current data.
@@ -318,7 +387,34 @@ class WebGPUShaderFactory
 	 */
 	void createBindGroupLayouts(std::shared_ptr<WebGPUShaderInfo> shaderInfo, std::map<uint32_t, BindGroupBuilder> &bindGroupsBuilder);
 
+	/**
+	 * @brief Compile WGSL source into a shader module (no caching).
+	 */
+	wgpu::ShaderModule compileShaderModule(const std::string &source, const std::filesystem::path &shaderPath);
+
+	/**
+	 * @brief File stamp of a loaded shader source.
+	 */
+	struct ShaderSourceStamp
+	{
+		std::filesystem::file_time_type writeTime; ///< Last write time when loaded
+		uintmax_t size = 0;						   ///< File size when loaded
+		uint64_t contentHash = 0;				   ///< FNV-1a hash of the WGSL source
+	};
+
+	/**
+	 * @brief Compiled module together with the hash of the file contents it was built from.
+	 */
+	struct CachedShaderModule
+	{
+		wgpu::ShaderModule module = nullptr; ///< One reference is held by the cache
+		uint64_t contentHash = 0;			 ///< Hash of the file contents (without prelude)
+	};
+
 	WebGPUContext &m_context;
+
+	std::unordered_map<std::string, ShaderSourceStamp> m_sourceStamps; ///< Shader path -> stamp of the last load
+	std::unordered_map<uint64_t, CachedShaderModule> m_moduleCache;	   ///< Hash of (contents, prelude) -> module
 };
 
 } // namespace engine::rendering::webgpu
@@ -9,16 +9,48 @@
 
 #include <webgpu/webgpu.hpp>
 
+#include "engine/rendering/MaterialFeatureMask.h"
 #include "engine/rendering/ShaderFeatureMask.h"
 #include "engine/rendering/ShaderType.h"
 #include "engine/rendering/Vertex.h"
 #include "engine/rendering/webgpu/WebGPUBindGroupLayoutInfo.h"
 
+namespace engine::rendering
+{
+class ShaderRegistry;
+}
+
 namespace engine::rendering::webgpu
 {
 
 class WebGPUShaderFactory;
 
+/**
+ * @brief Stable integer identifier of a registered shader.
+ *
+ * Assigned by the ShaderRegistry per shader name and kept across hot-reloads,
+ * so it can be used as a cheap cache key instead of the name.
+ */
+using ShaderId = uint32_t;
+
+/// ShaderId of shaders that were never registered.
+constexpr ShaderId INVALID_SHADER_ID = 0;
+
+/**
+ * @brief Precomputed per-pipeline binding information for one bind group.
+ *
+ * Built once when the shader's layouts are registered so draw submission
+ * can bind groups without string lookups or allocations.
+ */
+struct BindGroupSlot
+{
+	uint32_t groupIndex = 0;							 ///< Bind group index in the pipeline layout
+	BindGroupType type = BindGroupType::Custom;			 ///< Semantic type of the group
+	BindGroupReuse reuse = BindGroupReuse::Global;		 ///< Rebind policy
+	uint64_t customKey = 0;								 ///< Base FrameCache key for Custom groups (hash of "ShaderName:BindGroupName")
+	const WebGPUBindGroupLayoutInfo *layout = nullptr;	 ///< Layout info (owned by the shader info)
+};
+
 /**
  * @brief Pure shader metadata with manual reflection information.
  *
@@ -31,6 +63,7 @@ class WebGPUShaderFactory;
 class WebGPUShaderInfo
 {
 	friend class WebGPUShaderFactory;
+	friend class engine::rendering::ShaderRegistry;
 
   public:
 	WebGPUShaderInfo(
@@ -63,6 +96,12 @@ class WebGPUShaderInfo
 	 * @return Shader name string.
 	 */
 	[[nodiscard]] const std::string &getName() const { return m_name; }
+
+	/**
+	 * @brief Gets the registry-assigned shader ID.
+	 * @return Shader ID, or INVALID_SHADER_ID if the shader was never registered.
+	 */
+	[[nodiscard]] ShaderId getId() const { return m_id; }
 	/**
 	 * @brief Gets the shader file path.
 	 * @return Shader file path.
@@ -115,6 +154,25 @@ class WebGPUShaderInfo
 	 */
 	[[nodiscard]] bool isBackFaceCullingEnabled() const { return m_cullBackFaces; }
 
+	/**
+	 * @brief Material features the shader source can be specialized on.
+	 * Each feature is exposed to WGSL as a boolean constant; None means the shader has no variants.
+	 * @return Mask of specializable material features.
+	 */
+	[[nodiscard]] engine::rendering::MaterialFeature::Flag getVariantFeatures() const { return m_variantFeatures; }
+
+	/**
+	 * @brief Material features compiled into this shader module (subset of getVariantFeatures()).
+	 * @return Mask of enabled material features.
+	 */
+	[[nodiscard]] engine::rendering::MaterialFeature::Flag getEnabledFeatures() const { return m_enabledFeatures; }
+
+	/**
+	 * @brief Check if material variants can be compiled from this shader.
+	 * @return True if the shader declares variant features.
+	 */
+	[[nodiscard]] bool supportsVariants() const { return m_variantFeatures != engine::rendering::MaterialFeature::Flag::None; }
+
 	/**
 	 * @brief Check if shader info is valid.
 	 * @return True if valid, false otherwise.
@@ -133,6 +191,12 @@ class WebGPUShaderInfo
 	 */
 	[[nodiscard]] std::vector<std::shared_ptr<WebGPUBindGroupLayoutInfo>> getBindGroupLayoutVector() const;
 
+	/**
+	 * @brief Access the precomputed bind group slots, sorted by group index.
+	 * @return Slots for all declared bind groups.
+	 */
+	[[nodiscard]] const std::vector<BindGroupSlot> &getBindGroupSlots() const { return m_bindGroupSlots; }
+
 	/**
 	 * @brief Get a specific bind group layout by index.
 	 * @param groupIndex The bind group index.
@@ -167,6 +231,7 @@ class WebGPUShaderInfo
 
   private:
 	void setName(std::string name);
+	void setId(ShaderId id) { m_id = id; }
 	void setPath(std::string path);
 	void setVertexLayout(engine::rendering::VertexLayout layout);
 	void setVertexEntryPoint(std::string entry);
@@ -174,12 +239,15 @@ class WebGPUShaderInfo
 	void setShaderType(engine::rendering::ShaderType type);
 	void setShaderFeatures(engine::rendering::ShaderFeature::Flag features);
 	void setEnableDepth(bool enable);
+	void setVariantFeatures(engine::rendering::MaterialFeature::Flag variantFeatures, engine::rendering::MaterialFeature::Flag enabledFeatures);
 	void addBindGroupLayout(uint32_t groupIndex, std::shared_ptr<WebGPUBindGroupLayoutInfo> layout);
+	void rebuildBindGroupSlots();
 
 	bool m_enableDepth;
 	bool m_cullBackFaces;
 
 	std::string m_name;
+	ShaderId m_id = INVALID_SHADER_ID;
 	std::filesystem::path m_path;
 	wgpu::ShaderModule m_module = nullptr;
 	std::string m_vertexEntryPoint;
@@ -187,10 +255,13 @@ class WebGPUShaderInfo
 	engine::rendering::ShaderType m_shaderType = engine::rendering::ShaderType::Lit;
 	engine::rendering::VertexLayout m_vertexLayout = engine::rendering::VertexLayout::PositionNormalUVTangentColor;
 	engine::rendering::ShaderFeature::Flag m_features = engine::rendering::ShaderFeature::Flag::None;
+	engine::rendering::MaterialFeature::Flag m_variantFeatures = engine::rendering::MaterialFeature::Flag::None;
+	engine::rendering::MaterialFeature::Flag m_enabledFeatures = engine::rendering::MaterialFeature::Flag::None;
 
 	std::unordered_map<uint64_t, std::shared_ptr<WebGPUBindGroupLayoutInfo>> m_bindGroupLayouts;
 	std::unordered_map<std::string, uint64_t> m_nameToIndex;
 	std::unordered_map<BindGroupType, uint64_t> m_typeToIndex;
+	std::vector<BindGroupSlot> m_bindGroupSlots;
 };
 
 } // namespace engine::rendering::webgpu
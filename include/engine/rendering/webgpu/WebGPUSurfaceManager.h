@@ -18,6 +18,9 @@ class WebGPUContext;
  * This class encapsulates the logic for managing the WebGPU surface, including configuration,
  * swap-chain handling, and texture acquisition. It automatically reconfigures the surface
  * when the window size or configuration changes, and provides access to the current surface texture.
+ *
+ * In headless mode there is no surface: the configuration describes an offscreen render target
+ * that is returned by acquireNextTexture() every frame, and present() does nothing.
  */
 class WebGPUSurfaceManager
 {
@@ -105,6 +108,17 @@ class WebGPUSurfaceManager
 	 */
 	std::shared_ptr<WebGPUTexture> acquireNextTexture();
 
+	/**
+	 * @brief Present the current surface texture. No-op in headless mode.
+	 */
+	void present();
+
+	/**
+	 * @brief Get the offscreen target used instead of the surface in headless mode.
+	 * @return The offscreen texture, or nullptr if not headless.
+	 */
+	[[nodiscard]] std::shared_ptr<WebGPUTexture> getOffscreenTexture() const { return m_offscreenTexture; }
+
 	/**
 	 * @brief Reapply the current surface configuration.
 	 * @param config Optional new configuration to apply. If provided, replaces the current config.
@@ -123,12 +137,22 @@ class WebGPUSurfaceManager
 	 */
 	void applyConfig();
 
+	/**
+	 * @brief Internal: (re)create the headless offscreen target for the current config.
+	 */
+	void applyOffscreenConfig();
+
+	/** @brief Render target cache id of the headless offscreen target. */
+	static constexpr uint32_t OFFSCREEN_TARGET_ID = 0xFFFFFFFFu;
+
   private:
 	WebGPUContext &m_context; ///< Reference to the WebGPU context
 
 	Config m_config{};			  ///< Current surface configuration
 	Config m_lastAppliedConfig{}; ///< Last applied surface configuration
 
+	std::shared_ptr<WebGPUTexture> m_offscreenTexture; ///< Headless render target replacing the surface
+
 #ifndef WEBGPU_BACKEND_WGPU
 	wgpu::SwapChain m_swapChain; ///< Swap-chain for non-WGPU backends
 #endif
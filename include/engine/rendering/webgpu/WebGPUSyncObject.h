@@ -16,6 +16,19 @@ namespace engine::rendering::webgpu
 // Forward declaration to avoid circular dependency
 class WebGPUContext;
 
+/**
+ * @class WebGPUSyncDependent
+ * @brief GPU object that can be told its CPU-side sources changed (see WebGPUSyncTracker).
+ */
+class WebGPUSyncDependent
+{
+  public:
+	virtual ~WebGPUSyncDependent() = default;
+
+	/** @brief Flag the object for a resync on its next syncIfNeeded(). */
+	virtual void markSyncPending() = 0;
+};
+
 /**
  * @class WebGPUSyncObject
  * @brief Base class for all GPU-side objects (mesh, material, etc.) in the WebGPU backend that need automatic syncing.
@@ -23,7 +36,7 @@ class WebGPUContext;
  * @tparam CPUObjectT The CPU-side object type this GPU object represents
  */
 template <typename CPUObjectT>
-class WebGPUSyncObject
+class WebGPUSyncObject : public WebGPUSyncDependent
 {
   public:
 	/**
@@ -51,6 +64,14 @@ class WebGPUSyncObject
 
 	const typename CPUObjectT::Handle &getCPUHandle() const { return m_cpuHandle; }
 
+	/**
+	 * @brief Get the CPU object version the GPU resources were last synced from.
+	 * Cheap to query every frame (no handle resolution); changes whenever syncIfNeeded() resynced.
+	 */
+	uint64_t getSyncedVersion() const { return m_lastSyncedVersion; }
+
+	void markSyncPending() override { m_syncPending = true; }
+
 	CPUObjectT &getCPUObject() const
 	{
 		auto obj = m_cpuHandle.get();
@@ -63,23 +84,34 @@ class WebGPUSyncObject
 
 	/**
 	 * @brief Sync GPU resources from CPU if needed.
-	 * Checks if the CPU object version has changed and calls syncFromCPU if necessary.
+	 * Change-tracked objects only resync after a markSyncPending() notification and cost a
+	 * single flag check otherwise. Other objects compare the CPU object version every call.
 	 */
 	void syncIfNeeded()
 	{
+		if (m_changeTracked && !m_syncPending)
+			return;
+
 		auto obj = m_cpuHandle.get();
 		if (!obj || !obj.value())
 			return;
 
 		const auto &cpuObj = *obj.value();
-		if (needsSync(cpuObj))
+		if (m_changeTracked || needsSync(cpuObj))
 		{
+			m_syncPending = false;
 			syncFromCPU(cpuObj);
 			m_lastSyncedVersion = cpuObj.getVersion();
 		}
 	}
 
   protected:
+	/**
+	 * @brief Switch from version polling to change notifications.
+	 * The object must then register its sources with the WebGPUSyncTracker on every sync.
+	 */
+	void enableChangeTracking() { m_changeTracked = true; }
+
 	virtual bool needsSync(const CPUObjectT &cpuObj) const
 	{
 		return cpuObj.getVersion() > m_lastSyncedVersion;
@@ -93,6 +125,8 @@ class WebGPUSyncObject
 	std::chrono::steady_clock::time_point m_creationTime;
 	std::chrono::steady_clock::time_point m_lastUpdateTime;
 	uint64_t m_lastSyncedVersion = 0;
+	bool m_changeTracked = false; ///< Resync driven by markSyncPending() instead of version polling
+	bool m_syncPending = true;	  ///< Set by notifications (and initially), cleared by the sync
 };
 
 } // namespace engine::rendering::webgpu
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/core/ChangeJournal.h"
+
+namespace engine::core
+{
+class Versioned;
+}
+
+namespace engine::rendering::webgpu
+{
+class WebGPUSyncDependent;
+
+/**
+ * @class WebGPUSyncTracker
+ * @brief Push-based dirty list for GPU objects that mirror CPU resources.
+ *
+ * GPU objects register the CPU objects they read from (e.g. a material and its textures) with
+ * watch(). Version bumps on those objects are logged by the core::ChangeJournal from any thread;
+ * processChanges() drains the journal once per frame on the render thread and flags every
+ * dependent for a resync. Objects nobody changed are never visited.
+ *
+ * Dependents unwatch() sources they stop reading from (e.g. a texture a material swapped out).
+ * Entries of destroyed dependents or sources are pruned whenever the map doubled in size.
+ */
+class WebGPUSyncTracker
+{
+  public:
+	/**
+	 * @brief Resync a dependent whenever a source object's version changes.
+	 * Registering the same pair again is a no-op.
+	 * @param source CPU object the dependent reads from.
+	 * @param dependent GPU object to notify (held weakly).
+	 * @return The source's change token, for unwatch().
+	 */
+	core::ChangeJournal::token_t watch(const core::Versioned &source, const std::shared_ptr<WebGPUSyncDependent> &dependent);
+
+	/**
+	 * @brief Stop notifying a dependent about a source (the source may already be destroyed).
+	 * @param token Change token returned by watch().
+	 * @param dependent GPU object registered for the source.
+	 */
+	void unwatch(core::ChangeJournal::token_t token, const WebGPUSyncDependent *dependent);
+
+	/**
+	 * @brief Drain the change journal and mark the dependents of changed objects.
+	 * Call once per frame before GPU resources are prepared.
+	 * @return Number of dependents marked for a resync.
+	 */
+	size_t processChanges();
+
+	/** @brief Number of watched sources. */
+	[[nodiscard]] size_t getWatchedSourceCount() const { return m_dependents.size(); }
+
+  private:
+	/** @brief Drop expired dependents, and sources left without dependents. */
+	void prune();
+
+	std::unordered_map<core::ChangeJournal::token_t, std::vector<std::weak_ptr<WebGPUSyncDependent>>> m_dependents;
+	std::vector<core::ChangeJournal::token_t> m_changedTokens; ///< Reused drain buffer
+	size_t m_pruneThreshold = 64;							   ///< Source count that triggers the next prune()
+};
+
+} // namespace engine::rendering::webgpu
@@ -135,34 +135,6 @@ class WebGPUTexture
 	 */
 	const wgpu::TextureViewDescriptor &getTextureViewDescriptor() const { return m_viewDesc; }
 
-		
-	/**
-	 * @brief Checks if a GPU-to-CPU readback has been requested but not yet initiated.
-	 * @return True if a readback request is pending, false otherwise.
-	 */
-	bool WebGPUTexture::isReadbackPending() const
-	{
-		return m_readbackPending;
-	}
-
-	/**
-	 * @brief Initiates a GPU-to-CPU readback operation for this texture.
-	 *        The result can be obtained by calling getReadbackResult() after the future is ready.
-	 * @param context The WebGPU context for command submission.
-	 * @return True if the readback was successfully initiated, false otherwise.
-	 */
-	bool WebGPUTexture::beginReadback(WebGPUContext &context);
-
-	/**
-	 * @brief Polls the status of an ongoing GPU-to-CPU readback operation and retrieves the result if complete.
-	 *        This should be called after beginReadback() and when the returned future is ready
-	 * 	  (e.g., by waiting on the future or checking its status).
-	 * @param context The WebGPU context for any necessary synchronization.
-	 * @param outTexture The CPU-side texture to write the readback result into. Must have matching width/height/format.
-	 * @return True if readback completed successfully and data was written to outTexture, false if readback failed or is not complete.
-	  */
-	bool WebGPUTexture::pollReadback(WebGPUContext &context, std::shared_ptr<Texture> outTexture);
-
 	/**
 	 * @brief Resizes the texture to the new dimensions if needed.
 	 *        Recreates the texture and view if the size or format changes.
@@ -200,6 +172,13 @@ class WebGPUTexture
 	 */
 	wgpu::TextureView getCubeMapFace(uint32_t cubeIndex, uint32_t faceIndex, const char *label = nullptr) const;
 
+	/**
+	 * @brief Gets or creates a 2D array view over all layers and mips of the texture.
+	 *        Lets a plain 2D texture be bound where the shader expects texture_2d_array (as layer 0).
+	 * @return The default view for 2D array textures, otherwise a cached array view.
+	 */
+	wgpu::TextureView getArrayView() const;
+
 	/**
 	 * @brief Checks if the texture view is an array layer view (2D Array or Cube Array).
 	 * @return True if the view is an array layer view, false otherwise.
@@ -278,6 +257,40 @@ class WebGPUTexture
 		return format;
 	}
 
+	/**
+	 * @brief Maps a block compression format to a WebGPU texture format.
+	 * @param compression The block compression format (not None).
+	 * @param colorSpace The color space; BC4/BC5 have no sRGB variant.
+	 * @return Corresponding WebGPU texture format.
+	 */
+	static wgpu::TextureFormat mapBlockCompressionToGPU(engine::resources::BlockCompression::Type compression, ColorSpace colorSpace)
+	{
+		using engine::resources::BlockCompression;
+		const bool srgb = colorSpace == ColorSpace::sRGB;
+		switch (compression)
+		{
+		case BlockCompression::Type::BC1_RGBA:
+			return srgb ? wgpu::TextureFormat::BC1RGBAUnormSrgb : wgpu::TextureFormat::BC1RGBAUnorm;
+		case BlockCompression::Type::BC3_RGBA:
+			return srgb ? wgpu::TextureFormat::BC3RGBAUnormSrgb : wgpu::TextureFormat::BC3RGBAUnorm;
+		case BlockCompression::Type::BC4_R:
+			return wgpu::TextureFormat::BC4RUnorm;
+		case BlockCompression::Type::BC5_RG:
+			return wgpu::TextureFormat::BC5RGUnorm;
+		case BlockCompression::Type::BC7_RGBA:
+			return srgb ? wgpu::TextureFormat::BC7RGBAUnormSrgb : wgpu::TextureFormat::BC7RGBAUnorm;
+		case BlockCompression::Type::ETC2_RGB8:
+			return srgb ? wgpu::TextureFormat::ETC2RGB8UnormSrgb : wgpu::TextureFormat::ETC2RGB8Unorm;
+		case BlockCompression::Type::ETC2_RGBA8:
+			return srgb ? wgpu::TextureFormat::ETC2RGBA8UnormSrgb : wgpu::TextureFormat::ETC2RGBA8Unorm;
+		case BlockCompression::Type::ASTC_4x4:
+			return srgb ? wgpu::TextureFormat::ASTC4x4UnormSrgb : wgpu::TextureFormat::ASTC4x4Unorm;
+		default:
+			assert(false && "Unsupported BlockCompression for GPU mapping");
+			return wgpu::TextureFormat::RGBA8Unorm;
+		}
+	}
+
 	/**
 	 * @brief Maps a WebGPU texture format to the corresponding ImageFormat::Type.
 	 */
@@ -343,16 +356,7 @@ class WebGPUTexture
 
 	mutable std::unordered_map<uint32_t, wgpu::TextureView> m_layerViews;	//< Cached layer views for array layers or cube faces.
 	mutable std::unordered_map<uint32_t, wgpu::TextureView> m_cubeMapViews; //< Cached cube map views for cube faces.
-
-	wgpu::Buffer m_readbackStagingBuffer = nullptr; //< Staging buffer used for GPU-to-CPU readback operations.
-	uint32_t m_readbackWidth = 0;
-	uint32_t m_readbackHeight = 0;
-	uint32_t m_readbackBytesPerRow = 0;
-	uint32_t m_readbackBPP = 0;
-	bool m_readbackPending = false;
-	std::unique_ptr<wgpu::BufferMapCallback> m_readbackCallback;
-	bool m_readbackMapped = false;
-	bool m_readbackSuccess = false;
+	mutable wgpu::TextureView m_arrayView = nullptr;						//< Cached 2D array view (see getArrayView).
 };
 
 } // namespace engine::rendering::webgpu
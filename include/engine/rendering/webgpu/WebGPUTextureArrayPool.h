@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <webgpu/webgpu.hpp>
+
+namespace engine::rendering::webgpu
+{
+class WebGPUContext;
+class WebGPUTexture;
+
+struct WebGPUTextureArrayLayer;
+
+/**
+ * @brief A texture_2d_array page of the pool. Its texture is replaced by a larger copy when the page grows.
+ */
+struct WebGPUTextureArrayPage
+{
+	std::shared_ptr<WebGPUTexture> texture;
+	std::vector<std::weak_ptr<WebGPUTextureArrayLayer>> layers; ///< Holder per used layer, expired layers are free
+	uint32_t maxLayers = 1;										///< Layer count the page may grow to
+};
+
+/**
+ * @brief A packed texture: one layer of a page, allocated for as long as the object is held.
+ */
+struct WebGPUTextureArrayLayer
+{
+	std::shared_ptr<WebGPUTextureArrayPage> page;
+	uint32_t layer = 0;
+	uint64_t key = 0; ///< Key the texture was packed under
+
+	/** @brief Current texture of the page (changes when the page grows). */
+	[[nodiscard]] const std::shared_ptr<WebGPUTexture> &getPageTexture() const { return page->texture; }
+};
+
+/**
+ * @class WebGPUTextureArrayPool
+ * @brief Packs same-size, same-format textures into shared texture_2d_array pages.
+ *
+ * Materials whose textures land on the same pages can share one material bind group and
+ * select their textures by layer index, so switching between them needs no rebind.
+ *
+ * Each page holds textures of one width, height, format and mip count. Pages start with
+ * MATERIAL_TEXTURE_ARRAY_INITIAL_LAYERS layers and double when full, up to
+ * MAX_MATERIAL_TEXTURE_ARRAY_LAYERS reduced to fit MATERIAL_TEXTURE_ARRAY_PAGE_BYTES and the
+ * device limit. Growing copies the used layers into the larger texture; bind groups created
+ * before keep sampling the old texture, which stays valid for the layers it held.
+ *
+ * pack() copies all mips of the source into a free layer (the source needs CopySrc usage).
+ * The layer is owned by the returned WebGPUTextureArrayLayer, not by the source: once packed,
+ * the caller may release the source and find the layer again by its key while it is held.
+ */
+class WebGPUTextureArrayPool
+{
+  public:
+	explicit WebGPUTextureArrayPool(WebGPUContext &context);
+
+	/**
+	 * @brief Find a texture packed under a key.
+	 * @param key Key passed to pack().
+	 * @return The layer, or nullptr if nothing holds a layer packed under the key.
+	 */
+	std::shared_ptr<WebGPUTextureArrayLayer> find(uint64_t key);
+
+	/**
+	 * @brief Copy a texture into a free layer, or return the layer already packed under the key.
+	 * @param texture 2D texture to pack.
+	 * @param key Identity of the texture contents, used by find().
+	 * @param outReplacedPage Set to the previous page texture if the page grew, otherwise left unchanged.
+	 * @return The layer, or nullptr if the texture cannot be packed
+	 *         (unsupported format, array/cube texture, missing CopySrc usage).
+	 */
+	std::shared_ptr<WebGPUTextureArrayLayer> pack(
+		const std::shared_ptr<WebGPUTexture> &texture,
+		uint64_t key,
+		std::shared_ptr<WebGPUTexture> *outReplacedPage = nullptr
+	);
+
+	/** @brief Number of allocated pages. */
+	[[nodiscard]] size_t getPageCount() const;
+
+	/** @brief Number of textures currently packed. */
+	[[nodiscard]] size_t getPackedCount() const;
+
+	/** @brief Release all pages. Materials still bound to them keep them alive. */
+	void cleanup();
+
+  private:
+	struct PageKey
+	{
+		uint32_t width = 0;
+		uint32_t height = 0;
+		wgpu::TextureFormat format = wgpu::TextureFormat::Undefined;
+		uint32_t mipLevelCount = 1;
+
+		bool operator==(const PageKey &other) const
+		{
+			return width == other.width && height == other.height && format == other.format && mipLevelCount == other.mipLevelCount;
+		}
+	};
+
+	struct PageKeyHash
+	{
+		size_t operator()(const PageKey &key) const;
+	};
+
+	static bool isPackable(const WebGPUTexture &texture);
+	[[nodiscard]] uint32_t layersPerPage(const PageKey &key) const;
+	std::shared_ptr<WebGPUTexture> createPage(const PageKey &key, uint32_t layers);
+	bool growPage(const PageKey &key, WebGPUTextureArrayPage &page);
+	void copyToLayer(const WebGPUTexture &source, const WebGPUTexture &page, uint32_t layer);
+	void prune();
+
+	WebGPUContext &m_context;
+	std::unordered_map<PageKey, std::vector<std::shared_ptr<WebGPUTextureArrayPage>>, PageKeyHash> m_pages;
+	std::unordered_map<uint64_t, std::weak_ptr<WebGPUTextureArrayLayer>> m_entries;
+};
+
+} // namespace engine::rendering::webgpu
@@ -30,8 +30,10 @@ struct hash<std::tuple<uint8_t, uint8_t, uint8_t, uint8_t, uint32_t, uint32_t>>
 #include "engine/rendering/ColorSpace.h"
 #include "engine/rendering/Texture.h"
 #include "engine/rendering/webgpu/BaseWebGPUFactory.h"
+#include "engine/rendering/webgpu/WebGPUMipmapGenerator.h"
 #include "engine/rendering/webgpu/WebGPUPipeline.h"
 #include "engine/rendering/webgpu/WebGPUTexture.h"
+#include "engine/rendering/webgpu/WebGPUTextureArrayPool.h"
 
 namespace engine::rendering::webgpu
 {
@@ -92,6 +94,23 @@ class WebGPUTextureFactory : public BaseWebGPUFactory<engine::rendering::Texture
 		const wgpu::TextureViewDescriptor &viewDesc
 	);
 
+	/**
+	 * @brief Create a sampled 2D texture from half-float pixels of every mip level.
+	 * @param width Width of mip 0.
+	 * @param height Height of mip 0.
+	 * @param format R16Float, RG16Float or RGBA16Float.
+	 * @param levels Tightly packed pixels per mip level, mip 0 first.
+	 * @param label Debug label.
+	 * @return Shared pointer to WebGPUTexture.
+	 */
+	std::shared_ptr<WebGPUTexture> createFromHalfFloatMips(
+		uint32_t width,
+		uint32_t height,
+		wgpu::TextureFormat format,
+		const std::vector<std::vector<uint16_t>> &levels,
+		const char *label
+	);
+
 	/**
 	 * @brief Get the default white texture.
 	 * @return Shared pointer to the white texture.
@@ -137,13 +156,17 @@ class WebGPUTextureFactory : public BaseWebGPUFactory<engine::rendering::Texture
 	);
 
 	/**
-	 * @brief Generate mipmaps for a texture.
+	 * @brief Queue mipmap generation for a texture.
+	 *
+	 * The mips are built by the next flushMipmaps(), together with every other texture queued
+	 * since the previous flush, in a single submit.
 	 * @param gpuTexture The WebGPU texture to generate mipmaps for.
 	 * @param format The texture format.
 	 * @param width The width of the base mip level.
 	 * @param height The height of the base mip level.
 	 * @param mipLevelCount The total number of mip levels.
-	 * @note The texture must have been created with mipLevelCount > 1 and appropriate usage flags.
+	 * @note The texture must have been created with mipLevelCount > 1 and the usage returned by
+	 *       WebGPUMipmapGenerator::getRequiredUsage().
 	 */
 	void generateMipmaps(
 		wgpu::Texture gpuTexture,
@@ -153,8 +176,29 @@ class WebGPUTextureFactory : public BaseWebGPUFactory<engine::rendering::Texture
 		uint32_t mipLevelCount
 	);
 
+	/**
+	 * @brief Generate the mips of all queued textures in one command encoder and submit.
+	 * Must run before the queued textures are sampled or copied.
+	 * @return Number of textures processed.
+	 */
+	size_t flushMipmaps();
+
+	/**
+	 * @brief Get the batched mipmap generator.
+	 * @return Reference to the mipmap generator.
+	 */
+	WebGPUMipmapGenerator &mipmapGenerator() { return m_mipmapGenerator; }
+
+	/**
+	 * @brief Get the pool packing material textures into texture_2d_array pages.
+	 * @return Reference to the texture array pool.
+	 */
+	WebGPUTextureArrayPool &arrayPool() { return m_arrayPool; }
+
 	void cleanup() override
 	{
+		m_mipmapGenerator.cleanup();
+		m_arrayPool.cleanup();
 		m_whiteTexture.reset();
 		m_defaultNormalTexture.reset();
 		m_colorTextureCache.clear();
@@ -211,13 +255,8 @@ class WebGPUTextureFactory : public BaseWebGPUFactory<engine::rendering::Texture
 	);
 
 	void uploadTextureData(const Texture &texture, wgpu::Texture &gpuTexture);
-
-	/**
-	 * @brief Get or create a mipmap generation pipeline for a specific texture format.
-	 * @param format Texture format for the mipmap pipeline.
-	 * @return Shared pointer to the mipmap pipeline.
-	 */
-	std::shared_ptr<WebGPUPipeline> getOrCreateMipmapPipeline(wgpu::TextureFormat format);
+	/** @brief Uploads every level of a cooked image (block-compressed or LDR with a mip chain). */
+	void uploadMipChain(const engine::resources::Image &image, wgpu::Texture &gpuTexture);
 
   private:
 	std::shared_ptr<WebGPUTexture> m_whiteTexture;
@@ -225,5 +264,7 @@ class WebGPUTextureFactory : public BaseWebGPUFactory<engine::rendering::Texture
 	std::shared_ptr<WebGPUTexture> m_defaultNormalTexture;
 	std::unordered_map<std::tuple<uint8_t, uint8_t, uint8_t, uint8_t, uint32_t, uint32_t>, std::shared_ptr<WebGPUTexture>> m_colorTextureCache;
 	std::unordered_map<uint64_t, std::shared_ptr<WebGPUTexture>> m_renderTargetCache;
+	WebGPUTextureArrayPool m_arrayPool;
+	WebGPUMipmapGenerator m_mipmapGenerator;
 };
 } // namespace engine::rendering::webgpu
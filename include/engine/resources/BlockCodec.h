@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "engine/resources/Image.h"
+
+namespace engine::resources
+{
+
+/**
+ * @class BlockCodec
+ * @brief CPU encoder and decoder for the BC1/BC3/BC4/BC5 block formats.
+ *
+ * Encoding is a fast endpoint fit along the principal axis of each 4x4 block, good enough for
+ * cooking textures offline. Decoding serves as the fallback when the GPU cannot sample the
+ * block format (no texture-compression-bc feature). BC7, ETC2 and ASTC are neither encoded
+ * nor decoded here; files in those formats are only usable on devices that support them.
+ */
+class BlockCodec
+{
+  public:
+	/** @brief True if encode() supports the format. */
+	[[nodiscard]] static bool canEncode(BlockCompression::Type compression);
+
+	/** @brief True if decode() supports the format. */
+	[[nodiscard]] static bool canDecode(BlockCompression::Type compression);
+
+	/**
+	 * @brief Compress one image level.
+	 * @param compression BC1_RGBA, BC3_RGBA, BC4_R or BC5_RG.
+	 * @param pixels 8-bit pixels, row-major, channels interleaved.
+	 * @param width Width in pixels.
+	 * @param height Height in pixels.
+	 * @param channels Channels per pixel in pixels (1, 2 or 4). BC1/BC3 need 4, BC5 at least 2.
+	 * @return Compressed level (BlockCompression::getLevelSize() bytes), empty on unsupported input.
+	 */
+	[[nodiscard]] static std::vector<uint8_t> encode(
+		BlockCompression::Type compression,
+		const uint8_t *pixels,
+		uint32_t width,
+		uint32_t height,
+		uint32_t channels
+	);
+
+	/**
+	 * @brief Decompress one image level.
+	 * @param compression BC1_RGBA, BC3_RGBA, BC4_R or BC5_RG.
+	 * @param blocks Compressed level data.
+	 * @param width Width in pixels.
+	 * @param height Height in pixels.
+	 * @return Pixels in BlockCompression::getDecodedFormat() layout, or std::nullopt if the
+	 *         format is unsupported or the data is too short.
+	 */
+	[[nodiscard]] static std::optional<std::vector<uint8_t>> decode(
+		BlockCompression::Type compression,
+		const std::vector<uint8_t> &blocks,
+		uint32_t width,
+		uint32_t height
+	);
+};
+
+} // namespace engine::resources
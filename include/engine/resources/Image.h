@@ -38,7 +38,7 @@ static uint32_t getChannelCount(ImageFormat::Type format)
 	}
 }
 /**
- * @brief Gets the number of color channels for the given format.
+ * @brief Gets the size of one pixel in bytes for the given format.
  * @param format ImageFormat to check
  * @return Number of bytes per pixel (1-8), or 0 if unknown format.
  */
@@ -46,19 +46,20 @@ static uint32_t getBytesPerPixel(ImageFormat::Type format)
 {
 	switch (format)
 	{
-	case ImageFormat::Type::LDR_RGBA8:
-		return 4;
 	case ImageFormat::Type::HDR_RGBA16F:
 		return 8;
-	case ImageFormat::Type::LDR_RGB8:
 	case ImageFormat::Type::HDR_RGB16F:
 		return 6;
-	case ImageFormat::Type::LDR_RG8:
+	case ImageFormat::Type::LDR_RGBA8:
 	case ImageFormat::Type::HDR_RG16F:
 		return 4;
-	case ImageFormat::Type::LDR_R8:
+	case ImageFormat::Type::LDR_RGB8:
+		return 3;
+	case ImageFormat::Type::LDR_RG8:
 	case ImageFormat::Type::HDR_R16F:
 		return 2;
+	case ImageFormat::Type::LDR_R8:
+		return 1;
 	default:
 		return 0;
 	}
@@ -109,6 +110,65 @@ ENUM_END()
 
 using ImageFormatType = ImageFormat::Type;
 
+ENUM_BEGIN_WRAPPED(BlockCompression, 9, None, BC1_RGBA, BC3_RGBA, BC4_R, BC5_RG, BC7_RGBA, ETC2_RGB8, ETC2_RGBA8, ASTC_4x4)
+
+/**
+ * @brief Size in bytes of one 4x4 block.
+ * @param compression Block compression format.
+ * @return 8 or 16, or 0 for None.
+ */
+static uint32_t getBlockBytes(Type compression)
+{
+	switch (compression)
+	{
+	case Type::BC1_RGBA:
+	case Type::BC4_R:
+	case Type::ETC2_RGB8:
+		return 8;
+	case Type::BC3_RGBA:
+	case Type::BC5_RG:
+	case Type::BC7_RGBA:
+	case Type::ETC2_RGBA8:
+	case Type::ASTC_4x4:
+		return 16;
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @brief Size in bytes of one mip level stored in the given block format.
+ * @param compression Block compression format.
+ * @param width Level width in pixels.
+ * @param height Level height in pixels.
+ * @return Byte size of the level (partial blocks at the border count as full blocks).
+ */
+static size_t getLevelSize(Type compression, uint32_t width, uint32_t height)
+{
+	return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * getBlockBytes(compression);
+}
+
+/**
+ * @brief Uncompressed format a block format decodes to (also describes its channels).
+ * @param compression Block compression format.
+ * @return LDR_R8, LDR_RG8 or LDR_RGBA8, Unknown for None.
+ */
+static ImageFormat::Type getDecodedFormat(Type compression)
+{
+	switch (compression)
+	{
+	case Type::None:
+		return ImageFormat::Type::Unknown;
+	case Type::BC4_R:
+		return ImageFormat::Type::LDR_R8;
+	case Type::BC5_RG:
+		return ImageFormat::Type::LDR_RG8;
+	default:
+		return ImageFormat::Type::LDR_RGBA8;
+	}
+}
+ENUM_END()
+
 class Image
 {
   public:
@@ -125,7 +185,24 @@ class Image
 	Image(uint32_t width, uint32_t height, ImageFormat::Type format, std::vector<uint8_t> &&ldrPixels) : m_width(width), m_height(height), m_format(format), m_ldrPixels(std::move(ldrPixels))
 	{
 	}
-	Image(uint32_t width, uint32_t height, ImageFormat::Type format, std::vector<float> &&hdrPixels) : m_width(width), m_height(height), m_format(format), m_hdrPixels(std::move(hdrPixels))
+	// HDR pixels are IEEE half floats (see engine::math::HalfFloat), the layout the GPU samples
+	Image(uint32_t width, uint32_t height, ImageFormat::Type format, std::vector<uint16_t> &&hdrPixels) : m_width(width), m_height(height), m_format(format), m_hdrPixels(std::move(hdrPixels))
+	{
+	}
+
+	/**
+	 * @brief Create a block-compressed image from its mip levels.
+	 * @param width Width of mip 0 in pixels.
+	 * @param height Height of mip 0 in pixels.
+	 * @param compression Block format of the data.
+	 * @param levels Compressed data of each mip level, mip 0 first.
+	 */
+	Image(uint32_t width, uint32_t height, BlockCompression::Type compression, std::vector<std::vector<uint8_t>> &&levels) :
+		m_width(width),
+		m_height(height),
+		m_format(BlockCompression::getDecodedFormat(compression)),
+		m_compression(compression),
+		m_compressedLevels(std::move(levels))
 	{
 	}
 
@@ -152,12 +229,57 @@ class Image
 	}
 	[[nodiscard]] bool isEmpty() const { return m_width == 0 || m_height == 0; }
 
+	/** @brief True if the data is stored block-compressed (see getCompressedLevel()). */
+	[[nodiscard]] bool isCompressed() const { return m_compression != BlockCompression::Type::None; }
+	[[nodiscard]] BlockCompression::Type getBlockCompression() const { return m_compression; }
+
+	/**
+	 * @brief Number of mip levels stored in the image (1 unless a cooked mip chain is present).
+	 */
+	[[nodiscard]] uint32_t getMipLevelCount() const
+	{
+		if (isCompressed())
+			return static_cast<uint32_t>(m_compressedLevels.size());
+		return 1 + static_cast<uint32_t>(m_ldrMips.size());
+	}
+
+	/**
+	 * @brief Get the block-compressed data of a mip level.
+	 * @param level Mip level, 0 is the full-size image.
+	 */
+	[[nodiscard]] const std::vector<uint8_t> &getCompressedLevel(uint32_t level) const
+	{
+		assert(isCompressed() && level < m_compressedLevels.size());
+		return m_compressedLevels[level];
+	}
+
+	/**
+	 * @brief Get the LDR pixels of a mip level (level 0 is getPixels8()).
+	 * @param level Mip level below getMipLevelCount().
+	 */
+	[[nodiscard]] const std::vector<uint8_t> &getMipPixels8(uint32_t level) const
+	{
+		assert(!isHDR() && !isCompressed() && level < getMipLevelCount());
+		return level == 0 ? m_ldrPixels : m_ldrMips[level - 1];
+	}
+
+	/**
+	 * @brief Attach a precomputed LDR mip chain.
+	 * @param mips Pixels of mip levels 1..n, each half the size of the previous level (at least 1).
+	 */
+	void setMipChain(std::vector<std::vector<uint8_t>> &&mips)
+	{
+		assert(!isHDR() && !isCompressed());
+		m_ldrMips = std::move(mips);
+	}
+
 	[[nodiscard]] const std::vector<uint8_t> &getPixels8() const
 	{
 		assert(!isHDR());
 		return m_ldrPixels;
 	}
-	[[nodiscard]] const std::vector<float> &getPixelsF() const
+	/** @brief HDR pixels as half floats (convert with engine::math::HalfFloat::toFloat). */
+	[[nodiscard]] const std::vector<uint16_t> &getPixels16F() const
 	{
 		assert(isHDR());
 		return m_hdrPixels;
@@ -181,6 +303,7 @@ class Image
 		m_format = format;
 		m_ldrPixels = std::move(ldrPixels);
 		m_hdrPixels.clear();
+		clearLevels();
 	}
 
 	/**
@@ -193,6 +316,7 @@ class Image
 		m_height = newHeight;
 		m_ldrPixels.clear();
 		m_hdrPixels.clear();
+		clearLevels();
 	}
 
 	/**
@@ -200,10 +324,10 @@ class Image
 	 * @param width New image width
 	 * @param height New image height
 	 * @param format New image format
-	 * @param hdrPixels New HDR pixel data (if format is HDR)
+	 * @param hdrPixels New HDR pixel data as half floats (if format is HDR)
 	 * @throws std::runtime_error if format is not HDR
 	 */
-	void replaceData(uint32_t width, uint32_t height, ImageFormat::Type format, std::vector<float> &&hdrPixels)
+	void replaceData(uint32_t width, uint32_t height, ImageFormat::Type format, std::vector<uint16_t> &&hdrPixels)
 	{
 		if (ImageFormat::isLDRFormat(format))
 		{
@@ -214,16 +338,29 @@ class Image
 		m_format = format;
 		m_hdrPixels = std::move(hdrPixels);
 		m_ldrPixels.clear();
+		clearLevels();
 	}
 
   private:
+	void clearLevels()
+	{
+		m_compression = BlockCompression::Type::None;
+		m_compressedLevels.clear();
+		m_ldrMips.clear();
+	}
+
 	uint32_t m_width = 0;
 	uint32_t m_height = 0;
 	ImageFormat::Type m_format = ImageFormat::Type::Unknown;
 
 	// Depending on format, one of these stores the pixels
 	std::vector<uint8_t> m_ldrPixels;
-	std::vector<float> m_hdrPixels;
+	std::vector<uint16_t> m_hdrPixels; ///< Half floats
+
+	// Cooked data: a block-compressed mip chain (replaces the pixels), or LDR mips 1..n
+	BlockCompression::Type m_compression = BlockCompression::Type::None;
+	std::vector<std::vector<uint8_t>> m_compressedLevels;
+	std::vector<std::vector<uint8_t>> m_ldrMips;
 };
 
 } // namespace engine::resources
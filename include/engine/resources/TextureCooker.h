@@ -0,0 +1,65 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include "engine/resources/Image.h"
+
+namespace engine::resources
+{
+
+/**
+ * @brief Options for cooking a texture.
+ */
+struct TextureCookOptions
+{
+	bool srgb = true;		   ///< Color data: mips are filtered in linear space and the file is tagged sRGB
+	bool normalMap = false;	   ///< Tangent-space normal map: only XY are kept (BC5), Z is rebuilt in the shader
+	bool generateMips = true;  ///< Store the full mip chain
+	bool compress = true;	   ///< Block-compress when the size allows it (multiple of 4)
+};
+
+/**
+ * @class TextureCooker
+ * @brief Offline texture preparation: precomputed mip chain and block compression.
+ *
+ * The format is chosen from the content: BC4 for one channel, BC5 for two channels and
+ * normal maps, BC1 for opaque RGBA and BC3 when alpha is used. That is 4-8x smaller than
+ * RGBA8 both on disk and in VRAM. Images whose size is not a multiple of 4 keep RGBA8 with
+ * their mip chain, since WebGPU requires block-aligned compressed textures.
+ *
+ * Cooked textures are stored as KTX2 next to the source (see getCookedPath()) and picked up
+ * by TextureManager when they are newer than the source.
+ */
+class TextureCooker
+{
+  public:
+	/**
+	 * @brief Cook an LDR image.
+	 * @param source Image to cook (HDR images are not supported).
+	 * @param options Cook options.
+	 * @return The cooked image (block-compressed, or LDR with a mip chain), std::nullopt on failure.
+	 */
+	[[nodiscard]] static std::optional<Image::Ptr> cook(const Image &source, const TextureCookOptions &options = {});
+
+	/**
+	 * @brief Cook options for a texture bound to a material slot.
+	 *
+	 * Color space follows defaultColorSpaceForSlot(); normal maps are cooked as linear BC5.
+	 * @param slotName Material texture slot (see MaterialTextureSlots).
+	 */
+	[[nodiscard]] static TextureCookOptions optionsForSlot(const std::string &slotName);
+
+	/**
+	 * @brief Path of the cooked file for a source texture ("<source>.ktx2").
+	 */
+	[[nodiscard]] static std::filesystem::path getCookedPath(const std::filesystem::path &source);
+
+	/**
+	 * @brief True if a cooked file exists and is at least as new as the source.
+	 */
+	[[nodiscard]] static bool isCookedUpToDate(const std::filesystem::path &source);
+};
+
+} // namespace engine::resources
@@ -1,14 +1,18 @@
 #pragma once
 
 #include <filesystem>
+#include <functional>
+#include <future>
 #include <memory>
 #include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "engine/rendering/ColorSpace.h"
 #include "engine/rendering/Texture.h"
 #include "engine/resources/ResourceManagerBase.h"
+#include "engine/resources/TextureCooker.h"
 #include "engine/resources/loaders/ImageLoader.h"
 
 namespace engine::resources
@@ -19,8 +23,15 @@ namespace engine::resources
  * @brief Manages creation, storage, and retrieval of textures within the engine.
  *
  * Supports different texture types: Image (from file or raw data), DepthStencil, and Surface.
- * Provides caching for image textures by file path, and stores created depth/surface textures
- * internally for bookkeeping. Thread-safe via internal mutex.
+ * Provides caching for image textures by file path and by content hash, and stores created
+ * depth/surface textures internally for bookkeeping. Thread-safe via internal mutex.
+ *
+ * Content-hash caching shares one Image, Texture and GPU texture (the GPU factory caches per
+ * texture handle) between identical images, e.g. the same embedded glTF image referenced by
+ * several materials or loaded with several copies of a model, or duplicate files on disk.
+ * Both caches are keyed by color space as well: the GPU texture of a handle is created in the
+ * color space of the first slot using it, so sRGB and linear uses need textures of their own.
+ * Concurrent requests for the same content wait for the one decoding it instead of decoding twice.
  */
 class TextureManager : public ResourceManagerBase<engine::rendering::Texture>
 {
@@ -40,13 +51,15 @@ class TextureManager : public ResourceManagerBase<engine::rendering::Texture>
 	 * @param image Shared pointer to an Image object containing pixel data.
 	 * @param filePath Optional file path associated with the image.
 	 * @param renderTarget If true, the texture is intended to be used as a render target.
+	 * @param colorSpace Color space the texture is sampled in (part of the file path cache key).
 	 * @return Optional shared pointer to the created texture, or std::nullopt on failure.
 	 */
 	[[nodiscard]]
 	std::optional<TexturePtr> createImageTexture(
 		engine::resources::Image::Ptr image, 
 		std::optional<path> filePath = std::nullopt,
-		bool renderTarget = true
+		bool renderTarget = true,
+		engine::rendering::ColorSpace colorSpace = engine::rendering::ColorSpace::sRGB
 	);
 
 	/**
@@ -70,26 +83,103 @@ class TextureManager : public ResourceManagerBase<engine::rendering::Texture>
 
 	/**
 	 * @brief Loads an image texture from file or returns cached one.
+	 *
+	 * If an up-to-date cooked KTX2 file exists next to the source (see TextureCooker), it is
+	 * loaded instead; the texture is still cached under the source path.
 	 * @param filepath Path to the image file.
 	 * @param forceReload If true, reloads the texture even if cached.
+	 * @param colorSpace Color space of the material slot the texture is bound to.
 	 * @return Optional shared pointer to the texture, or std::nullopt on failure.
 	 */
 	[[nodiscard]]
-	std::optional<TexturePtr> createTextureFromFile(const path &filepath, bool forceReload = false);
+	std::optional<TexturePtr> createTextureFromFile(
+		const path &filepath,
+		bool forceReload = false,
+		engine::rendering::ColorSpace colorSpace = engine::rendering::ColorSpace::sRGB
+	);
 
 	/**
 	 * @brief Retrieves a cached image texture by its file path.
 	 * @param filepath Path to the image file.
+	 * @param colorSpace Color space the texture was loaded for.
 	 * @return Optional shared pointer to the texture, or std::nullopt if not found.
 	 */
 	[[nodiscard]]
-	std::optional<TexturePtr> getTextureByPath(const path &filepath) const;
+	std::optional<TexturePtr> getTextureByPath(
+		const path &filepath,
+		engine::rendering::ColorSpace colorSpace = engine::rendering::ColorSpace::sRGB
+	) const;
+
+	/**
+	 * @brief Returns the texture with the given content hash, or creates it.
+	 *
+	 * createImage is only called on a cache miss, so callers can defer copying/decoding pixel data.
+	 * Lookup and insertion are atomic: while one caller creates the texture, others requesting
+	 * the same content and color space wait for it.
+	 * @param contentHash Hash of the image content (see computeContentHash()).
+	 * @param createImage Produces the image on a cache miss; may return nullptr on failure.
+	 * @param filePath Optional file path associated with the image.
+	 * @param colorSpace Color space of the material slot the texture is bound to.
+	 * @return Optional shared pointer to the texture, or std::nullopt on failure.
+	 */
+	[[nodiscard]]
+	std::optional<TexturePtr> getOrCreateImageTexture(
+		uint64_t contentHash,
+		const std::function<engine::resources::Image::Ptr()> &createImage,
+		std::optional<path> filePath = std::nullopt,
+		engine::rendering::ColorSpace colorSpace = engine::rendering::ColorSpace::sRGB
+	);
+
+	/**
+	 * @brief Hash of raw pixel data together with its size and format.
+	 * @param format Pixel format of the data.
+	 * @param width Width in pixels.
+	 * @param height Height in pixels.
+	 * @param data Pixel bytes.
+	 * @param size Number of bytes.
+	 */
+	[[nodiscard]] static uint64_t computeContentHash(ImageFormat::Type format, uint32_t width, uint32_t height, const void *data, size_t size);
+
+	/** @brief Hash of an image's pixel data (all mip levels of cooked images). */
+	[[nodiscard]] static uint64_t computeContentHash(const engine::resources::Image &image);
+
+	/** @brief Number of texture requests served from the content-hash cache. */
+	[[nodiscard]] size_t getDeduplicatedCount() const;
+
+	/**
+	 * @brief Cooks a source texture (mip chain + block compression) and stores it as "<source>.ktx2".
+	 * @param filepath Path to the source image file.
+	 * @param options Cook options (color space, normal map, compression).
+	 * @return True if the cooked file was written.
+	 */
+	bool cookTextureFile(const path &filepath, const TextureCookOptions &options = {});
+
+	/**
+	 * @brief Cooks a source texture with the options of the material slot it is bound to.
+	 * @param filepath Path to the source image file.
+	 * @param slotName Material texture slot, e.g. MaterialTextureSlots::NORMAL for a BC5 normal map.
+	 * @return True if the cooked file was written.
+	 */
+	bool cookTextureFile(const path &filepath, const std::string &slotName);
+
+	/** @brief Enable/disable picking up cooked KTX2 files in createTextureFromFile(). */
+	void setUseCookedTextures(bool enabled) { m_useCookedTextures = enabled; }
 
   private:
+	[[nodiscard]] path resolvePath(const path &filepath) const;
+	/** @brief Key of m_imageCache: the path, tagged with the color space. */
+	[[nodiscard]] static std::string imageCacheKey(const path &filepath, engine::rendering::ColorSpace colorSpace);
+	/** @brief Looks up a live texture in the content cache. Caller holds m_mutex. */
+	[[nodiscard]] std::optional<TexturePtr> findByContentHashLocked(uint64_t contentHash) const;
+
 	std::shared_ptr<engine::resources::loaders::ImageLoader> m_loader;
+	bool m_useCookedTextures = true; ///< Prefer "<source>.ktx2" when it is up to date
 
 	// Caches
 	std::unordered_map<std::string, TextureHandle> m_imageCache; ///< Image textures cached by absolute file path
+	std::unordered_map<uint64_t, TextureHandle> m_contentCache;	 ///< Image textures cached by content hash and color space
+	std::unordered_map<uint64_t, std::shared_future<std::optional<TexturePtr>>> m_pendingContent; ///< Content being created, by the same key
+	size_t m_deduplicatedCount = 0;
 };
 
 } // namespace engine::resources
@@ -3,6 +3,7 @@
 #include <filesystem>
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "engine/resources/Image.h"
 #include "engine/resources/loaders/LoaderBase.h"
@@ -38,10 +39,13 @@ class ImageLoader final : public LoaderBase<engine::resources::Image::Ptr>
 	 * Supported formats:
 	 *  - LDR: png, jpg, jpeg, bmp, tga
 	 *  - HDR: hdr (Radiance)
+	 *  - Cooked: ktx2 (block-compressed or RGBA8, with mip chain; see TextureCooker)
 	 *
 	 * Notes:
 	 *  - RGB images are expanded to RGBA for WebGPU compatibility.
 	 *  - EXR is NOT supported by this loader.
+	 *  - Block formats the GPU cannot sample (see setSupportedBlockCompression()) are decoded
+	 *    to RGBA8 when BlockCodec supports them; otherwise loading fails.
 	 *
 	 * @param file Relative or absolute file path.
 	 * @return Loaded Image resource, or std::nullopt on failure.
@@ -72,6 +76,24 @@ class ImageLoader final : public LoaderBase<engine::resources::Image::Ptr>
 	 */
 	bool saveAsPNG(const Image &image, const std::filesystem::path &filePath) const;
 
+	/**
+	 * @brief Saves an Image resource with its mip chain as a KTX2 file.
+	 * @param image LDR or block-compressed image (e.g. from TextureCooker).
+	 * @param filePath The file path to save the image to.
+	 * @param srgb Tag the data as sRGB-encoded.
+	 * @return True on success, false on failure.
+	 */
+	bool saveAsKTX2(const Image &image, const std::filesystem::path &filePath, bool srgb) const;
+
+	/**
+	 * @brief Set the block formats the GPU can sample. Set once by the engine after device creation.
+	 * @param formats Supported formats; KTX2 files in other formats are decoded or rejected.
+	 */
+	void setSupportedBlockCompression(std::vector<BlockCompression::Type> formats) { m_supportedBlockCompression = std::move(formats); }
+
+	/** @brief True if the GPU can sample the block format. */
+	[[nodiscard]] bool isBlockCompressionSupported(BlockCompression::Type compression) const;
+
   private:
 	[[nodiscard]]
 	static bool isHDRImage(const std::filesystem::path &path);
@@ -81,6 +103,11 @@ class ImageLoader final : public LoaderBase<engine::resources::Image::Ptr>
 
 	[[nodiscard]]
 	std::optional<Loaded> loadLDR(const std::filesystem::path &fullPath);
+
+	[[nodiscard]]
+	std::optional<Loaded> loadKTX2(const std::filesystem::path &fullPath);
+
+	std::vector<BlockCompression::Type> m_supportedBlockCompression;
 };
 
 } // namespace engine::resources::loaders
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "engine/resources/Image.h"
+
+namespace engine::resources::loaders
+{
+
+/**
+ * @class Ktx2Codec
+ * @brief Reads and writes KTX2 containers holding a 2D texture with its full mip chain.
+ *
+ * Supported vkFormats: R8/RG8/RGBA8 (UNORM and SRGB) and the BC1/BC3/BC4/BC5/BC7, ETC2 and
+ * ASTC 4x4 block formats. Supercompressed files (BasisLZ, Zstandard) need a transcoder and are
+ * rejected, as are cube maps, arrays and 3D textures.
+ *
+ * Whether the data is sRGB-encoded is stored in the vkFormat; the engine decides the view
+ * color space from the material slot, so the reader only reports it.
+ */
+class Ktx2Codec
+{
+  public:
+	/** @brief Result of parsing a KTX2 file. */
+	struct Decoded
+	{
+		Image::Ptr image;
+		bool srgb = false; ///< vkFormat was an *_SRGB format
+	};
+
+	/** @brief True if the buffer starts with the KTX2 file identifier. */
+	[[nodiscard]] static bool isKtx2(const std::vector<uint8_t> &data);
+
+	/**
+	 * @brief Parse a KTX2 file.
+	 * @param data File contents.
+	 * @param error Set to a description of the problem on failure.
+	 * @return The image (block-compressed, or LDR with mips 1..n attached), or std::nullopt.
+	 */
+	[[nodiscard]] static std::optional<Decoded> read(const std::vector<uint8_t> &data, std::string &error);
+
+	/**
+	 * @brief Serialize an image and its mip chain.
+	 * @param image LDR or block-compressed image.
+	 * @param srgb Write the *_SRGB variant of the format (color data).
+	 * @return File contents, or an empty vector if the image format cannot be stored.
+	 */
+	[[nodiscard]] static std::vector<uint8_t> write(const Image &image, bool srgb);
+};
+
+} // namespace engine::resources::loaders
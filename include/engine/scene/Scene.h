@@ -107,6 +107,19 @@ class Scene
 	/** @brief Late update phase - order-dependent logic like camera following */
 	void lateUpdate(float deltaTime);
 
+	/**
+	 * @brief Fixed update phase - dispatches fixedUpdate() to all enabled PhysicsNodes.
+	 * @param fixedDeltaTime The fixed physics timestep.
+	 * @note Must run on the thread that owns the scene graph (the game thread).
+	 */
+	void fixedUpdate(float fixedDeltaTime);
+
+	/**
+	 * @brief Interpolate PhysicsNode transforms between the last two fixed steps.
+	 * @param alpha Accumulator remainder divided by the fixed timestep, in [0, 1].
+	 */
+	void interpolatePhysics(float alpha);
+
 	/**
 	 * @brief Collect renderable items from scene graph into the RenderCollector.
 	 *
@@ -98,6 +98,13 @@ class Transform : public engine::core::Versioned
 	 */
 	const glm::vec3 &getLocalScale() const;
 
+	/**
+	 * @brief Gets the version of the local values alone.
+	 * Unlike getVersion(), it does not change when only an ancestor moved.
+	 * @return Number of changes made to this transform's local position, rotation or scale.
+	 */
+	version_t getLocalVersion() const { return m_localVersion; }
+
 	// --- World Transform ---
 
 	/**
@@ -244,11 +251,18 @@ class Transform : public engine::core::Versioned
 	// Hierarchy (parent only - children are managed by Node hierarchy)
 	Transform *m_parent = nullptr;
 
+	version_t m_localVersion = 0;
+
 	/**
 	 * @brief Marks this transform as needing matrix recomputation.
 	 */
 	void markDirty();
 
+	/**
+	 * @brief Marks the local values as changed, then the matrices as dirty.
+	 */
+	void markLocalChanged();
+
 	/**
 	 * @brief Updates the local rotation quaternion cache from Euler angles if dirty.
 	 */
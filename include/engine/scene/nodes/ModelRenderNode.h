@@ -129,7 +129,9 @@ class ModelRenderNode : public RenderNode, public SpatialNode
 				m_modelHandle,
 				getTransform().getWorldMatrix(),
 				m_renderLayer,
-				objectID
+				objectID,
+				nullptr,
+				m_static
 			);
 		}
 	}
@@ -170,6 +172,27 @@ class ModelRenderNode : public RenderNode, public SpatialNode
 		return m_renderLayer;
 	}
 
+	/**
+	 * @brief Marks the model as static scenery.
+	 * Static models are compiled into cached draw packets / render bundles and
+	 * replayed without per-frame pipeline or handle lookups. Moving a static
+	 * node is still correct, but changing its model defeats the cache.
+	 * @param isStatic True for static scenery.
+	 */
+	void setStatic(bool isStatic)
+	{
+		m_static = isStatic;
+	}
+
+	/**
+	 * @brief Checks if the model is marked as static scenery.
+	 * @return True if static.
+	 */
+	bool isStatic() const
+	{
+		return m_static;
+	}
+
 	/** @brief Override to draw transform axes when debug is enabled */
 	void onDebugDraw(engine::rendering::DebugRenderCollector &collector) override
 	{
@@ -181,6 +204,7 @@ class ModelRenderNode : public RenderNode, public SpatialNode
 	uint32_t m_renderLayer = 0;
 	std::filesystem::path m_modelPath; // Path for lazy loading
 	bool m_loadFromPath = false;	   // Flag to indicate loading from path
+	bool m_static = false;			   // Static scenery, eligible for the static draw cache
 };
 
 } // namespace engine::scene::nodes
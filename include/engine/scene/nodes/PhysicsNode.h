@@ -2,13 +2,27 @@
 
 #include "engine/scene/nodes/SpatialNode.h"
 
+namespace engine::scene
+{
+class Scene;
+}
+
 namespace engine::scene::nodes
 {
 /**
  * @brief Spatial node with fixedUpdate method for physics logic.
+ *
+ * The local transform written by fixedUpdate() is the authoritative simulation state.
+ * Between fixed steps the rendered transform is interpolated between the previous and
+ * current simulation state using the physics accumulator alpha. Writes made to the
+ * transform outside of fixedUpdate() (e.g. teleports from update()) are detected and
+ * adopted as the new simulation state without interpolation.
  */
 class PhysicsNode : public SpatialNode
 {
+	// Scene drives the fixed step and interpolation bookkeeping
+	friend class engine::scene::Scene;
+
   public:
 	using Ptr = std::shared_ptr<PhysicsNode>;
 
@@ -21,6 +35,57 @@ class PhysicsNode : public SpatialNode
 
 	/** @brief Called at fixed intervals for physics updates. */
 	virtual void fixedUpdate(float fixedDeltaTime) {}
+
+	/**
+	 * @brief Enable or disable render interpolation for this node.
+	 * @param enabled If false, the transform snaps to the latest fixed step.
+	 */
+	void setInterpolationEnabled(bool enabled) { m_interpolationEnabled = enabled; }
+
+	/** @brief Check if render interpolation is enabled. */
+	[[nodiscard]] bool isInterpolationEnabled() const { return m_interpolationEnabled; }
+
+  private:
+	/**
+	 * @brief Snapshot of a local transform used for interpolation.
+	 */
+	struct State
+	{
+		glm::vec3 position{0.0f};
+		glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
+		glm::vec3 scale{1.0f};
+	};
+
+	/**
+	 * @brief Restore the simulation state and shift current to previous before a fixed step.
+	 */
+	void beginFixedStep();
+
+	/**
+	 * @brief Capture the transform written by fixedUpdate() as the current simulation state.
+	 */
+	void endFixedStep();
+
+	/**
+	 * @brief Write the interpolated state into the transform for rendering.
+	 * @param alpha Blend factor between previous (0) and current (1) state.
+	 */
+	void applyInterpolation(float alpha);
+
+	State captureState() const;
+	void writeState(const State &state);
+
+	State m_previousState{};
+	State m_currentState{};
+	bool m_hasState = false;
+	bool m_interpolationEnabled = true;
+
+	/**
+	 * @brief Local transform version after the last write done by the physics bookkeeping.
+	 * A different version means someone else moved the node. The local version is used so a
+	 * moving physics parent does not look like a teleport of its physics children.
+	 */
+	Transform::version_t m_writtenVersion = 0;
 };
 
 } // namespace engine::scene::nodes
@@ -1,3 +1,7 @@
+// Material feature constants (HAS_BASE_COLOR_MAP, HAS_NORMAL_MAP, ...) are prepended by the
+// shader factory, one permutation per material feature set. Disabled maps are not sampled;
+// the values used instead match the engine's default textures.
+
 struct VertexInput {
     @location(0) position: vec3f,
     @location(1) normal: vec3f,
@@ -7,7 +11,7 @@ struct VertexInput {
 }
 
 struct VertexOutput {
-    @builtin(position) position: vec4f,
+    @invariant @builtin(position) position: vec4f, // must match the depth pre-pass (shadow2d.wgsl)
     @location(0) color: vec3f,
     @location(1) normal: vec3f,
     @location(2) uv: vec2f,
@@ -15,6 +19,7 @@ struct VertexOutput {
     @location(4) tangent: vec3f,
     @location(5) bitangent: vec3f,
     @location(6) world_position: vec4f,
+    @location(7) @interpolate(flat) material_index: u32,
 }
 
 struct FrameUniforms {
@@ -42,12 +47,21 @@ struct Light {
 
 struct LightsBuffer {
     count: u32,
+    global_count: u32,          // ambient/directional lights, first entries of u_light_indices
+    cluster_count_x: u32,
+    cluster_count_y: u32,
+    cluster_count_z: u32,
+    cluster_depth_scale: f32,   // slice = log(view_depth) * scale + bias
+    cluster_depth_bias: f32,
     _pad1: f32,
-    _pad2: f32,
-    _pad3: f32,
     lights: array<Light>,
 }
 
+struct LightCluster {
+    offset: u32,                // first entry in u_light_indices
+    count: u32,
+}
+
 struct ObjectUniforms {
     model_matrix: mat4x4f,
     normal_matrix: mat4x4f,
@@ -64,8 +78,21 @@ struct MaterialUniforms {
     normal_strength: f32,
 }
 
+// Array layer of each material texture within its bound texture_2d_array
+struct MaterialLayers {
+    base_color: u32,
+    normal: u32,
+    ao: u32,
+    roughness: u32,
+    metallic: u32,
+    emission: u32,
+    _pad1: u32,
+    _pad2: u32,
+}
+
 struct EnvironmentUniforms {
-    params: vec4f, // x: irradiance enabled, y: intensity, z: skybox enabled, w: reserved
+    params: vec4f, // x: image-based lighting enabled, y: intensity, z: skybox enabled, w: specular max lod
+    irradiance_sh: array<vec4f, 9>, // L2 SH of the diffuse irradiance over PI (rgb), see EnvironmentPreprocessor
 }
 
 
@@ -81,6 +108,7 @@ struct ShadowUniform {
     shadow_type: u32,       // 0 = 2D shadow (directional/spot), 1 = cube shadow (point) (4 bytes)
     textureIndex: u32,      // layer in correct texture array (4 bytes, total: 108)
     cascade_split: f32,     // far plane distance for this cascade (CSM only) (4 bytes, total: 112)
+    atlas_rect: vec4f,      // 2D only: atlas tile offset (xy) and scale (zw) in UV, zero scale = no tile (16 bytes, total: 128)
 }
 
 @group(0) @binding(0)
@@ -88,26 +116,34 @@ var<uniform> u_frame: FrameUniforms;
 
 @group(1) @binding(0)
 var<storage, read> u_lights: LightsBuffer;
+@group(1) @binding(1)
+var<storage, read> u_light_clusters: array<LightCluster>;
+@group(1) @binding(2)
+var<storage, read> u_light_indices: array<u32>;
 
 @group(2) @binding(0)
 var<uniform> u_object: ObjectUniforms;
 
+// Materials sharing their textures (or texture array pages) share this group; the draw's
+// first instance selects the material's entry. Size must match MAX_MATERIALS_PER_BATCH.
 @group(3) @binding(0)
-var<uniform> u_material: MaterialUniforms;
+var<uniform> u_materials: array<MaterialUniforms, 128>;
 @group(3) @binding(1)
 var texture_sampler: sampler;
 @group(3) @binding(2)
-var base_color_texture: texture_2d<f32>;
+var base_color_texture: texture_2d_array<f32>;
 @group(3) @binding(3)
-var normal_texture: texture_2d<f32>;
+var normal_texture: texture_2d_array<f32>;
 @group(3) @binding(4)
-var ao_texture: texture_2d<f32>;
+var ao_texture: texture_2d_array<f32>;
 @group(3) @binding(5)
-var roughness_texture: texture_2d<f32>;
+var roughness_texture: texture_2d_array<f32>;
 @group(3) @binding(6)
-var metallic_texture: texture_2d<f32>;
+var metallic_texture: texture_2d_array<f32>;
 @group(3) @binding(7)
-var emission_texture: texture_2d<f32>;
+var emission_texture: texture_2d_array<f32>;
+@group(3) @binding(8)
+var<uniform> u_material_layers: array<MaterialLayers, 128>;
 
 @group(4) @binding(0)
 var shadow_sampler: sampler_comparison;
@@ -123,12 +159,21 @@ var<uniform> u_environment: EnvironmentUniforms;
 @group(5) @binding(1)
 var environment_sampler: sampler;
 @group(5) @binding(2)
-var environment_texture: texture_2d<f32>;
+var environment_texture: texture_2d<f32>; // Raw map, only sampled by the skybox
+@group(5) @binding(3)
+var environment_specular: texture_2d<f32>; // Equirect, mip i prefiltered for roughness i / max lod
+@group(5) @binding(4)
+var brdf_lut: texture_2d<f32>; // Split-sum scale/bias, x: N.V, y: roughness
 
 const PI: f32 = 3.141592653589793;
+const BRDF_LUT_HALF_TEXEL: f32 = 0.5 / 64.0; // EnvironmentPreprocessor::BRDF_LUT_SIZE
+
+// Entry of the drawn material, loaded once per fragment
+var<private> u_material: MaterialUniforms;
+var<private> u_layers: MaterialLayers;
 
 @vertex
-fn vs_main(in: VertexInput) -> VertexOutput {
+fn vs_main(in: VertexInput, @builtin(instance_index) instance_index: u32) -> VertexOutput {
     var out: VertexOutput;
     let world_pos = u_object.model_matrix * vec4f(in.position, 1.0);
     out.world_position = world_pos;
@@ -144,6 +189,7 @@ fn vs_main(in: VertexInput) -> VertexOutput {
     out.color = in.color;
     out.uv = in.uv;
     out.view_direction = u_frame.camera_world_position - world_pos.xyz;
+    out.material_index = instance_index;
     return out;
 }
 
@@ -158,6 +204,10 @@ fn fresnel_schlick(cos_theta: f32, f0: vec3f) -> vec3f {
     return f0 + (1.0 - f0) * pow(1.0 - cos_theta, 5.0);
 }
 
+fn fresnel_schlick_roughness(cos_theta: f32, f0: vec3f, roughness: f32) -> vec3f {
+    return f0 + (max(vec3f(1.0 - roughness), f0) - f0) * pow(1.0 - cos_theta, 5.0);
+}
+
 fn distribution_ggx(n: vec3f, h: vec3f, roughness: f32) -> f32 {
     let a = roughness * roughness;
     let a2 = a * a;
@@ -197,14 +247,33 @@ fn direction_to_equirect_uv(direction: vec3f) -> vec2f {
     return vec2f(u, v);
 }
 
-fn sample_environment_irradiance(normal: vec3f) -> vec3f {
+// Basis order matches EnvironmentPreprocessor: 1, y, z, x, xy, yz, 3z^2-1, xz, x^2-y^2
+fn evaluate_irradiance_sh(n: vec3f) -> vec3f {
+    let sh = u_environment.irradiance_sh;
+    let irradiance = sh[0].rgb
+        + sh[1].rgb * n.y + sh[2].rgb * n.z + sh[3].rgb * n.x
+        + sh[4].rgb * (n.x * n.y) + sh[5].rgb * (n.y * n.z) + sh[6].rgb * (3.0 * n.z * n.z - 1.0)
+        + sh[7].rgb * (n.x * n.z) + sh[8].rgb * (n.x * n.x - n.y * n.y);
+    return max(irradiance, vec3f(0.0));
+}
+
+// Split-sum image-based lighting: SH diffuse plus prefiltered specular scaled by the BRDF lookup
+fn evaluate_environment_lighting(n: vec3f, v: vec3f, base_color: vec3f, f0: vec3f, roughness: f32, metallic: f32, ao: f32) -> vec3f {
     if (u_environment.params.x < 0.5) {
         return vec3f(0.0);
     }
 
-    let uv = direction_to_equirect_uv(normalize(normal));
-    let sample_color = textureSample(environment_texture, environment_sampler, uv).rgb;
-    return sample_color * u_environment.params.y;
+    let n_dot_v = max(dot(n, v), 0.0001);
+    let f = fresnel_schlick_roughness(n_dot_v, f0, roughness);
+    let diffuse = evaluate_irradiance_sh(n) * base_color * (1.0 - f) * (1.0 - metallic);
+
+    let r = reflect(-v, n);
+    let prefiltered = textureSampleLevel(environment_specular, environment_sampler, direction_to_equirect_uv(r), roughness * u_environment.params.w).rgb;
+    let lut_uv = clamp(vec2f(n_dot_v, roughness), vec2f(BRDF_LUT_HALF_TEXEL), vec2f(1.0 - BRDF_LUT_HALF_TEXEL));
+    let brdf = textureSampleLevel(brdf_lut, environment_sampler, lut_uv, 0.0).rg;
+    let specular = prefiltered * (f0 * brdf.x + brdf.y);
+
+    return (diffuse + specular) * ao * u_environment.params.y;
 }
 
 // ------------------------------------------------------------
@@ -247,6 +316,11 @@ fn calculate_shadow(world_pos: vec3f, normal: vec3f, light: Light) -> f32 {
         let shadow = u_shadows[shadow_index];
         let light_space_pos = shadow.view_proj * vec4f(world_pos, 1.0);
 
+        // No atlas tile was available for this shadow
+        if (shadow.atlas_rect.z <= 0.0) {
+            return 1.0;
+        }
+
         if (light_space_pos.w <= 0.00001) {
             return 1.0;
         }
@@ -301,11 +375,16 @@ fn calculate_shadow(world_pos: vec3f, normal: vec3f, light: Light) -> f32 {
         let kernel = i32(shadow.pcf_kernel);
         var samples = 0.0;
 
+        // PCF taps stay half a texel inside the tile so filtering never reads a neighbouring tile
+        let tile_min = vec2f(0.5 * shadow.texel_size);
+        let tile_max = vec2f(1.0 - 0.5 * shadow.texel_size);
+
         for (var x = -kernel; x <= kernel; x = x + 1) {
             for (var y = -kernel; y <= kernel; y = y + 1) {
                 let offset = vec2f(f32(x), f32(y)) * shadow.texel_size * pcf_scale;
-                let uv = shadow_uv + offset;
-                // Sample using shadow.textureIndex as the layer
+                let tile_uv = clamp(shadow_uv + offset, tile_min, tile_max);
+                let uv = shadow.atlas_rect.xy + tile_uv * shadow.atlas_rect.zw;
+                // Sample the atlas page (shadow.textureIndex) at the tile location
                 visibility += textureSampleCompare(shadow_maps_2d, shadow_sampler, uv, shadow.textureIndex, current_depth);
                 samples += 1.0;
             }
@@ -380,12 +459,107 @@ fn calculate_shadow(world_pos: vec3f, normal: vec3f, light: Light) -> f32 {
     return 1.0;
 }
 
+// ------------------------------------------------------------
+// Lighting
+// ------------------------------------------------------------
+
+// Cluster of the froxel grid containing a world position (screen tile + exponential depth slice)
+fn cluster_index(world_pos: vec3f) -> u32 {
+    let grid = vec3u(u_lights.cluster_count_x, u_lights.cluster_count_y, u_lights.cluster_count_z);
+    let clip = u_frame.view_projection_matrix * vec4f(world_pos, 1.0);
+    let ndc = clip.xy / max(clip.w, 0.000001);
+    let tile = vec2u(clamp(floor((ndc * 0.5 + 0.5) * vec2f(grid.xy)), vec2f(0.0), vec2f(grid.xy) - 1.0));
+
+    let view_depth = -(u_frame.view_matrix * vec4f(world_pos, 1.0)).z;
+    let slice = floor(log(max(view_depth, 0.000001)) * u_lights.cluster_depth_scale + u_lights.cluster_depth_bias);
+    let z = u32(clamp(slice, 0.0, f32(grid.z) - 1.0));
+
+    return tile.x + grid.x * (tile.y + grid.y * z);
+}
+
+fn evaluate_light(
+    light: Light,
+    world_pos: vec3f,
+    normal: vec3f,
+    v: vec3f,
+    base_color: vec3f,
+    f0: vec3f,
+    roughness: f32,
+    metallic: f32,
+    ao: f32
+) -> vec3f {
+    if (light.light_type == 0u) {
+        return base_color * u_material.ambient.rgb * u_material.ambient.w * light.color * light.intensity * ao;
+    }
+
+    var L = vec3f(0.0);
+    var attenuation = 1.0;
+
+    if (light.light_type == 1u) {
+        L = get_direction_from_transform(light.transform);
+    } else if (light.light_type == 2u) {
+        let light_pos = get_position_from_transform(light.transform);
+        let to_light = light_pos - world_pos;
+        let dist = length(to_light);
+        L = normalize(to_light);
+        // Fade out towards the range so the light ends where its clusters do
+        let range_factor = 1.0 - smoothstep(light.range * 0.75, light.range, dist);
+        attenuation = range_factor / max(dist * dist, 0.001);
+    } else if (light.light_type == 3u) {
+        let light_pos = get_position_from_transform(light.transform);
+        let to_light = light_pos - world_pos;
+        let dist = length(to_light);
+        L = normalize(to_light);
+
+        let spot_dir = get_direction_from_transform(light.transform);
+        let cos_theta = dot(L, spot_dir);
+        let inner_ratio = 1.0 - max(0.01, light.spot_softness);
+        let cos_outer = cos(light.spot_angle);
+        let cos_inner = cos(light.spot_angle * inner_ratio);
+        let spot_effect = smoothstep(cos_outer, cos_inner, cos_theta);
+
+        let dist_attenuation = 1.0 / max(dist * dist, 0.01);
+        let range_factor = 1.0 - smoothstep(light.range * 0.75, light.range, dist);
+        attenuation = select(0.0, spot_effect * dist_attenuation * range_factor, cos_theta > cos_outer);
+    }
+
+    let H = normalize(v + L);
+    let n_dot_l = max(dot(normal, L), 0.0);
+    if (n_dot_l <= 0.0 || attenuation <= 0.0) {
+        return vec3f(0.0);
+    }
+    let n_dot_v = max(dot(normal, v), 0.0);
+
+    let shadow = calculate_shadow(world_pos, normal, light);
+
+    let d = distribution_ggx(normal, H, roughness);
+    let g = geometry_smith(normal, v, L, roughness);
+    let f = fresnel_schlick(max(dot(H, v), 0.0), f0);
+
+    let numerator = d * g * f;
+    let denominator = max(4.0 * n_dot_v * n_dot_l, 0.001);
+    let specular = numerator / denominator;
+
+    let k_s = f;
+    let k_d = (vec3f(1.0) - k_s) * (1.0 - metallic);
+
+    let radiance = light.color * light.intensity * attenuation;
+    return (k_d * base_color / PI + specular) * radiance * n_dot_l * shadow;
+}
+
 // ------------------------------------------------------------
 // Fragment
 // ------------------------------------------------------------
 @fragment
 fn fs_main(in: VertexOutput) -> @location(0) vec4f {
-    let full_base_color = textureSample(base_color_texture, texture_sampler, in.uv) * u_material.diffuse;
+    u_material = u_materials[in.material_index];
+    u_layers = u_material_layers[in.material_index];
+
+    var base_sample = vec4f(1.0);
+    if (HAS_BASE_COLOR_MAP) {
+        base_sample = textureSample(base_color_texture, texture_sampler, in.uv, u_layers.base_color);
+    }
+    let full_base_color = base_sample * u_material.diffuse;
     let base_color = full_base_color.rgb * u_material.diffuse.rgb;
     let alpha = full_base_color.a * u_material.diffuse.a;
     if(alpha < 0.5) { 
@@ -393,20 +567,42 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4f {
     }
 
     let n = normalize(in.normal);
-    let t = normalize(in.tangent - n * dot(n, in.tangent));
-    let b = cross(n, t);
-    let tbn = mat3x3f(t, b, n);
-
-    let n_map: vec3f = textureSample(normal_texture, texture_sampler, in.uv).rgb * 2.0 - 1.0;
-    let scaled_n = clamp(n_map.xy * u_material.normal_strength, vec2<f32>(-2.0, -2.0), vec2<f32>(2.0, 2.0));
-    let normal = normalize(tbn * vec3<f32>(scaled_n.x, scaled_n.y, n_map.z));
+    var normal = n;
+    if (HAS_NORMAL_MAP) {
+        let t = normalize(in.tangent - n * dot(n, in.tangent));
+        let b = cross(n, t);
+        let tbn = mat3x3f(t, b, n);
+
+        // Z is rebuilt from XY so two-channel (BC5) normal maps work as well
+        let n_xy: vec2f = textureSample(normal_texture, texture_sampler, in.uv, u_layers.normal).rg * 2.0 - 1.0;
+        let n_z = sqrt(max(1.0 - dot(n_xy, n_xy), 0.0));
+        let scaled_n = clamp(n_xy * u_material.normal_strength, vec2<f32>(-2.0, -2.0), vec2<f32>(2.0, 2.0));
+        normal = normalize(tbn * vec3<f32>(scaled_n.x, scaled_n.y, n_z));
+    }
 
     let v = normalize(in.view_direction);
-    let roughness = clamp(textureSample(roughness_texture, texture_sampler, in.uv).r * u_material.roughness, 0.001, 1.0);
-    let metallic = textureSample(metallic_texture, texture_sampler, in.uv).r * u_material.metallic;
-    let ao_tex = textureSample(ao_texture, texture_sampler, in.uv).r;
-    let ao = saturate(ao_tex);
-    let emission = textureSample(emission_texture, texture_sampler, in.uv).rgb * u_material.emission.rgb * u_material.emission.w;
+
+    var roughness_sample = 1.0;
+    if (HAS_ROUGHNESS_MAP || HAS_METALLIC_ROUGHNESS_MAP) {
+        roughness_sample = textureSample(roughness_texture, texture_sampler, in.uv, u_layers.roughness).r;
+    }
+    let roughness = clamp(roughness_sample * u_material.roughness, 0.001, 1.0);
+
+    var metallic_sample = 0.0;
+    if (HAS_METALLIC_MAP || HAS_METALLIC_ROUGHNESS_MAP) {
+        metallic_sample = textureSample(metallic_texture, texture_sampler, in.uv, u_layers.metallic).r;
+    }
+    let metallic = metallic_sample * u_material.metallic;
+
+    var ao = 1.0;
+    if (HAS_OCCLUSION_MAP) {
+        ao = saturate(textureSample(ao_texture, texture_sampler, in.uv, u_layers.ao).r);
+    }
+
+    var emission = vec3f(0.0);
+    if (HAS_EMISSIVE_MAP) {
+        emission = textureSample(emission_texture, texture_sampler, in.uv, u_layers.emission).rgb * u_material.emission.rgb * u_material.emission.w;
+    }
 
     let ior = max(u_material.ior, 1.0);
     let f0_dielectric = pow((ior - 1.0) / (ior + 1.0), 2.0);
@@ -415,66 +611,21 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4f {
     var Lo = vec3f(0.0);
     let world_pos = in.world_position.xyz;
 
-    for (var i: u32 = 0u; i < u_lights.count; i = i + 1u) {
-        let light = u_lights.lights[i];
-        if (light.light_type == 0u) {
-            Lo += base_color * u_material.ambient.rgb * u_material.ambient.w * light.color * light.intensity * ao;
-            continue;
-        }
-
-        var L = vec3f(0.0);
-        var attenuation = 1.0;
-
-        if (light.light_type == 1u) {
-            L = get_direction_from_transform(light.transform);
-        } else if (light.light_type == 2u) {
-            let light_pos = get_position_from_transform(light.transform);
-            let to_light = light_pos - world_pos;
-            let dist = length(to_light);
-            L = normalize(to_light);
-            attenuation = 1.0 / max(dist * dist, 0.001);
-        } else if (light.light_type == 3u) {
-            let light_pos = get_position_from_transform(light.transform);
-            let to_light = light_pos - world_pos;
-            let dist = length(to_light);
-            L = normalize(to_light);
-
-            let spot_dir = get_direction_from_transform(light.transform);
-            let cos_theta = dot(L, spot_dir);
-            let inner_ratio = 1.0 - max(0.01, light.spot_softness);
-            let cos_outer = cos(light.spot_angle);
-            let cos_inner = cos(light.spot_angle * inner_ratio);
-            let spot_effect = smoothstep(cos_outer, cos_inner, cos_theta);
-
-            let dist_attenuation = 1.0 / max(dist * dist, 0.01);
-            let range_factor = 1.0 - smoothstep(light.range * 0.75, light.range, dist);
-            attenuation = select(0.0, spot_effect * dist_attenuation * range_factor, cos_theta > cos_outer);
-        }
-
-        let H = normalize(v + L);
-        let n_dot_l = max(dot(normal, L), 0.0);
-        if (n_dot_l <= 0.0) { continue; }
-        let n_dot_v = max(dot(normal, v), 0.0);
-
-        let shadow = calculate_shadow(world_pos, normal, light);
-
-        let d = distribution_ggx(normal, H, roughness);
-        let g = geometry_smith(normal, v, L, roughness);
-        let f = fresnel_schlick(max(dot(H, v), 0.0), f0);
-
-        let numerator = d * g * f;
-        let denominator = max(4.0 * n_dot_v * n_dot_l, 0.001);
-        let specular = numerator / denominator;
-
-        let k_s = f;
-        let k_d = (vec3f(1.0) - k_s) * (1.0 - metallic);
+    // Global lights (ambient, directional) shade every fragment
+    for (var i: u32 = 0u; i < u_lights.global_count; i = i + 1u) {
+        let light = u_lights.lights[u_light_indices[i]];
+        Lo += evaluate_light(light, world_pos, normal, v, base_color, f0, roughness, metallic, ao);
+    }
 
-        let radiance = light.color * light.intensity * attenuation;
-        Lo += (k_d * base_color / PI + specular) * radiance * n_dot_l * shadow;
+    // Local lights (point, spot) are limited to the ones binned into this fragment's cluster
+    let cluster = u_light_clusters[cluster_index(world_pos)];
+    for (var i: u32 = 0u; i < cluster.count; i = i + 1u) {
+        let light = u_lights.lights[u_light_indices[cluster.offset + i]];
+        Lo += evaluate_light(light, world_pos, normal, v, base_color, f0, roughness, metallic, ao);
     }
 
-    let irradiance = sample_environment_irradiance(normal) * base_color * (1.0 - metallic) * ao;
-    var final_color = Lo + irradiance + emission;
+    let ambient = evaluate_environment_lighting(normal, v, base_color, f0, roughness, metallic, ao);
+    var final_color = Lo + ambient + emission;
 
     // Glass refraction effect (simplified)
     // For proper refraction, you would need an environment map or screen-space texture
@@ -0,0 +1,94 @@
+// Mipmap generation compute shader - builds up to four mip levels per dispatch.
+// Each 8x8 workgroup reduces a 16x16 block of the source level: one 2x2 box filter per
+// invocation for the first level, then the remaining levels from workgroup memory.
+// STORAGE_FORMAT is replaced with the storage texel format before compilation.
+
+struct MipmapParams {
+	levelCount: u32, // number of destination levels written by this dispatch (1..4)
+	decodeSrgb: u32, // 1 if texels are sRGB-encoded and must be filtered in linear space
+	_pad0: u32,
+	_pad1: u32,
+}
+
+@group(0) @binding(0) var srcTexture: texture_2d<f32>;
+@group(0) @binding(1) var dstMip1: texture_storage_2d<STORAGE_FORMAT, write>;
+@group(0) @binding(2) var dstMip2: texture_storage_2d<STORAGE_FORMAT, write>;
+@group(0) @binding(3) var dstMip3: texture_storage_2d<STORAGE_FORMAT, write>;
+@group(0) @binding(4) var dstMip4: texture_storage_2d<STORAGE_FORMAT, write>;
+@group(0) @binding(5) var<uniform> params: MipmapParams;
+
+var<workgroup> tile: array<vec4<f32>, 64>;
+
+fn srgbToLinear(c: vec4<f32>) -> vec4<f32> {
+	let low = c.rgb / 12.92;
+	let high = pow((c.rgb + 0.055) / 1.055, vec3<f32>(2.4));
+	return vec4<f32>(select(high, low, c.rgb <= vec3<f32>(0.04045)), c.a);
+}
+
+fn linearToSrgb(c: vec4<f32>) -> vec4<f32> {
+	let low = c.rgb * 12.92;
+	let high = 1.055 * pow(c.rgb, vec3<f32>(1.0 / 2.4)) - 0.055;
+	return vec4<f32>(select(high, low, c.rgb <= vec3<f32>(0.0031308)), c.a);
+}
+
+fn loadSource(coord: vec2<i32>) -> vec4<f32> {
+	let size = vec2<i32>(textureDimensions(srcTexture));
+	let texel = textureLoad(srcTexture, clamp(coord, vec2<i32>(0), size - 1), 0);
+	if (params.decodeSrgb != 0u) {
+		return srgbToLinear(texel);
+	}
+	return texel;
+}
+
+fn storeLevel(level: u32, coord: vec2<u32>, value: vec4<f32>) {
+	var encoded = value;
+	if (params.decodeSrgb != 0u) {
+		encoded = linearToSrgb(value);
+	}
+	switch level {
+		case 1u: {
+			if (all(coord < textureDimensions(dstMip1))) { textureStore(dstMip1, coord, encoded); }
+		}
+		case 2u: {
+			if (all(coord < textureDimensions(dstMip2))) { textureStore(dstMip2, coord, encoded); }
+		}
+		case 3u: {
+			if (all(coord < textureDimensions(dstMip3))) { textureStore(dstMip3, coord, encoded); }
+		}
+		default: {
+			if (all(coord < textureDimensions(dstMip4))) { textureStore(dstMip4, coord, encoded); }
+		}
+	}
+}
+
+@compute @workgroup_size(8, 8, 1)
+fn cs_main(
+	@builtin(workgroup_id) group: vec3<u32>,
+	@builtin(local_invocation_id) local: vec3<u32>,
+	@builtin(local_invocation_index) index: u32
+) {
+	// First level: 2x2 box filter of the source
+	let coord = group.xy * 8u + local.xy;
+	let base = vec2<i32>(coord * 2u);
+	let value = (loadSource(base)
+		+ loadSource(base + vec2<i32>(1, 0))
+		+ loadSource(base + vec2<i32>(0, 1))
+		+ loadSource(base + vec2<i32>(1, 1))) * 0.25;
+	storeLevel(1u, coord, value);
+	tile[index] = value;
+
+	// Further levels: texel (x, y) of level n is kept at tile position (x, y) * 2^(n-1),
+	// so each invocation only reads and overwrites its own 2x2 block
+	for (var level = 2u; level <= 4u; level++) {
+		workgroupBarrier();
+		let edge = 8u >> (level - 1u);
+		let stride = 1u << (level - 2u);
+		if (level <= params.levelCount && all(local.xy < vec2<u32>(edge))) {
+			let p = local.xy * (stride * 2u);
+			let i = p.x + p.y * 8u;
+			let reduced = (tile[i] + tile[i + stride] + tile[i + stride * 8u] + tile[i + stride * 9u]) * 0.25;
+			tile[i] = reduced;
+			storeLevel(level, group.xy * edge + local.xy, reduced);
+		}
+	}
+}
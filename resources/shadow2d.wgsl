@@ -3,7 +3,8 @@ struct VertexInput {
 };
 
 struct VertexOutput {
-    @builtin(position) position: vec4f,
+    // Invariant: also used as the camera depth pre-pass, whose depth must match PBR_Lit_Shader exactly
+    @invariant @builtin(position) position: vec4f,
     @location(0) depth: f32, // pass depth to fragment
 };
 
@@ -26,9 +27,10 @@ var<uniform> uObject: ObjectUniforms;
 @vertex
 fn vs_shadow(in: VertexInput) -> VertexOutput {
     var out: VertexOutput;
-    let worldPos = (uObject.modelMatrix * vec4f(in.position, 1.0)).xyz;
+    let worldPos4 = uObject.modelMatrix * vec4f(in.position, 1.0);
+    let worldPos = worldPos4.xyz;
 
-    out.position = uShadow.lightViewProjectionMatrix * vec4f(worldPos, 1.0);
+    out.position = uShadow.lightViewProjectionMatrix * worldPos4;
 
     // Linear depth for debug
     let lightToFrag = worldPos - uShadow.lightPos; // uShadow.lightPos must be uniform
@@ -18,7 +18,7 @@ struct ObjectUniforms {
 };
 
 struct ShadowPassCubeUniform {
-    lightViewProjectionMatrix: mat4x4f,  // view-projection matrix for this cube face
+    faceViewProjection: array<mat4x4f, 6>,  // view-projection matrix per cube face
     lightPos: vec3f,    // position of the point light
     farPlane: f32,      // far plane for normalization
 };
@@ -30,13 +30,13 @@ var<uniform> uShadowCube: ShadowPassCubeUniform;
 var<uniform> uObject: ObjectUniforms;
 
 @vertex
-fn vs_shadow_cube(in: VertexInput) -> VertexOutput {
+fn vs_shadow_cube(in: VertexInput, @builtin(instance_index) face: u32) -> VertexOutput {
     var out: VertexOutput;
     let worldPos = (uObject.modelMatrix * vec4f(in.position, 1.0)).xyz;
     out.world_position = worldPos;
 
-    // Clip-space for rasterization
-    out.position = uShadowCube.lightViewProjectionMatrix * vec4f(worldPos, 1.0);
+    // Clip-space for rasterization, the face is selected by the draw's first instance
+    out.position = uShadowCube.faceViewProjection[min(face, 5u)] * vec4f(worldPos, 1.0);
     
     return out;
 }
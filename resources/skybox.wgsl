@@ -7,7 +7,8 @@ struct FrameUniforms {
 }
 
 struct EnvironmentUniforms {
-	params: vec4f, // x: irradiance enabled, y: intensity, z: skybox enabled, w: reserved
+	params: vec4f, // x: image-based lighting enabled, y: intensity, z: skybox enabled, w: specular max lod
+	irradiance_sh: array<vec4f, 9>,
 }
 
 @group(0) @binding(0)
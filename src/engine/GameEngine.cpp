@@ -13,11 +13,16 @@
 #include <algorithm>
 #include <backends/imgui_impl_sdl3.h>
 #include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <sdl3webgpu.h>
 #include <spdlog/spdlog.h>
 
 #include "engine/core/PathProvider.h"
+#include "engine/core/Profiler.h"
 #include "engine/rendering/FrameUniforms.h"
 #include "engine/rendering/RenderCollector.h"
 #include "engine/rendering/Renderer.h"
@@ -119,6 +124,11 @@ float GameEngine::getFrameTime() const
 	return m_currentFrameTime;
 }
 
+engine::core::FramePacingStats GameEngine::getFramePacingStats() const
+{
+	return m_framePacer.getStats();
+}
+
 void GameEngine::setOptions(const GameEngineOptions &opts)
 {
 	// Store previous states for comparison
@@ -126,6 +136,7 @@ void GameEngine::setOptions(const GameEngineOptions &opts)
 	bool windowSizeChanged = (options.windowWidth != opts.windowWidth || options.windowHeight != opts.windowHeight);
 	bool resizableChanged = (options.resizableWindow != opts.resizableWindow);
 	bool fullscreenChanged = (options.fullscreen != opts.fullscreen);
+	bool pacingChanged = (options.limitFrameRate != opts.limitFrameRate || options.targetFrameRate != opts.targetFrameRate || options.lowLatencyMode != opts.lowLatencyMode || options.frameSpinThresholdMs != opts.frameSpinThresholdMs || vsyncChanged);
 
 	// Update options
 	options = opts;
@@ -160,6 +171,15 @@ void GameEngine::setOptions(const GameEngineOptions &opts)
 	{
 		m_context->updatePresentMode(options.enableVSync);
 	}
+
+	if (pacingChanged && m_initialized)
+		configureFramePacer();
+
+	engine::core::Profiler::instance().setEnabled(options.enableProfiler);
+	if (m_initialized)
+		m_context->passTimer().setEnabled(options.enableGpuTiming);
+	if (m_renderer)
+		m_renderer->setDepthPrepassEnabled(options.enableDepthPrepass);
 }
 
 void GameEngine::stop()
@@ -177,6 +197,69 @@ bool GameEngine::initialize(std::optional<GameEngineOptions> opts)
 		options = opts.value();
 	}
 
+	if (options.headless)
+	{
+		// No SDL video, no surface: render into an offscreen target at the configured resolution
+		m_context->initializeHeadless(
+			static_cast<uint32_t>(options.windowWidth),
+			static_cast<uint32_t>(options.windowHeight),
+			options.overrideDeviceLimits,
+			options.forceFallbackAdapter
+		);
+	}
+	else
+	{
+		if (!createWindow())
+			return false;
+		m_context->initialize(m_window, options.enableVSync, options.overrideDeviceLimits);
+	}
+	options.appliedDeviceLimits = m_context->limitsConfig();
+	m_context->materialFactory().setTextureArraysEnabled(options.enableMaterialTextureArrays);
+	m_context->residencyManager().setBudget(options.gpuMemoryBudgetBytes);
+	m_resourceManager->m_imageLoader->setSupportedBlockCompression(m_context->getSupportedBlockCompression());
+
+	// Create renderer
+	m_renderer = std::make_shared<engine::rendering::Renderer>(m_context);
+	if (!m_renderer->initialize())
+	{
+		spdlog::error("Failed to initialize renderer!");
+		return false;
+	}
+	m_renderer->setDepthPrepassEnabled(options.enableDepthPrepass);
+	m_renderer->setEnvironmentCacheDirectory(
+		options.environmentCacheDirectory.empty()
+			? engine::core::PathProvider::getConfigs("environment_cache")
+			: options.environmentCacheDirectory
+	);
+
+	// Pre-create the pipelines seen in the previous session before the first frame
+	if (options.enablePipelineCache)
+	{
+		ENGINE_PROFILE_SCOPE("GameEngine::warmUpPipelines");
+		auto &pipelineManager = m_context->pipelineManager();
+		if (pipelineManager.loadManifest(getPipelineCacheFile()))
+			pipelineManager.warmUp();
+	}
+
+	// Create ImGui manager
+	if (!options.headless)
+	{
+		m_imguiManager = std::make_shared<engine::ui::ImGuiManager>();
+		if (!m_imguiManager->initialize(m_window, m_context))
+		{
+			spdlog::error("Failed to initialize ImGuiManager!");
+			return false;
+		}
+	}
+
+	configureFramePacer();
+
+	m_initialized = true;
+	return true;
+}
+
+bool GameEngine::createWindow()
+{
 	// Tell SDL we're handling main ourselves
 	SDL_SetMainReady();
 
@@ -214,32 +297,50 @@ bool GameEngine::initialize(std::optional<GameEngineOptions> opts)
 	}
 
 	SDL_SetWindowPosition(m_window, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED);
+	return true;
+}
 
-	m_context->initialize(m_window, options.enableVSync, options.overrideDeviceLimits);
-	options.appliedDeviceLimits = m_context->limitsConfig();
+std::filesystem::path GameEngine::getPipelineCacheFile() const
+{
+	return options.pipelineCacheFile.empty()
+			   ? engine::core::PathProvider::getConfigs("pipeline_manifest.txt")
+			   : options.pipelineCacheFile;
+}
 
-	// Create renderer
-	m_renderer = std::make_shared<engine::rendering::Renderer>(m_context);
-	if (!m_renderer->initialize())
+void GameEngine::configureFramePacer()
+{
+	engine::core::FramePacer::Settings settings{};
+	settings.spinThresholdMs = options.frameSpinThresholdMs;
+	settings.lowLatency = options.lowLatencyMode;
+
+	if (options.enableVSync)
 	{
-		spdlog::error("Failed to initialize renderer!");
-		return false;
+		// Present blocks on vblank; only pace when delaying input sampling towards it
+		settings.targetRate = 0.0;
+		settings.anchorToFrameEnd = true;
+		if (options.lowLatencyMode)
+		{
+			const SDL_DisplayMode *mode = m_window ? SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(m_window)) : nullptr;
+			settings.targetRate = (mode && mode->refresh_rate > 0.0f) ? mode->refresh_rate : options.targetFrameRate;
+		}
 	}
-
-	// Create ImGui manager
-	m_imguiManager = std::make_shared<engine::ui::ImGuiManager>();
-	if (!m_imguiManager->initialize(m_window, m_context))
+	else if (options.limitFrameRate || options.lowLatencyMode)
 	{
-		spdlog::error("Failed to initialize ImGuiManager!");
-		return false;
+		settings.targetRate = options.targetFrameRate;
+	}
+	else
+	{
+		settings.targetRate = 0.0;
 	}
 
-	m_initialized = true;
-	return true;
+	m_framePacer.configure(settings);
 }
 
 void GameEngine::cleanup()
 {
+	if (m_initialized && m_context && options.enablePipelineCache)
+		m_context->pipelineManager().saveManifest(getPipelineCacheFile());
+
 	if (m_imguiManager)
 	{
 		m_imguiManager->shutdown();
@@ -283,12 +384,20 @@ void GameEngine::run()
 
 	running = true;
 
-	// Launch physics thread if enabled
-	if (options.runPhysics)
-		physicsThread = std::thread(&GameEngine::physicsLoop, this);
+	if (options.headless)
+	{
+		// Physics is stepped on the main thread for a deterministic timestep
+		headlessLoop();
+	}
+	else
+	{
+		// Launch physics thread if enabled
+		if (options.runPhysics)
+			physicsThread = std::thread(&GameEngine::physicsLoop, this);
 
-	// Main/game logic loop (runs on main thread)
-	gameLoop();
+		// Main/game logic loop (runs on main thread)
+		gameLoop();
+	}
 
 	// Clean shutdown
 	stop();
@@ -297,35 +406,80 @@ void GameEngine::run()
 
 void GameEngine::physicsLoop()
 {
+	engine::core::FramePacer::Settings pacing{};
+	pacing.targetRate = 1.0 / options.fixedDeltaTime;
+	pacing.spinThresholdMs = options.frameSpinThresholdMs;
+	m_physicsPacer.configure(pacing);
+
 	double previousTime = getCurrentTime();
 	float localAccum = 0.0f;
+	uint64_t stepIndex = 0;
+	bool queueStalled = false;
+	uint64_t droppedSteps = 0;
 	while (running)
 	{
+		m_physicsPacer.beginFrame();
+
 		double currentTime = getCurrentTime();
 		float frameDelta = static_cast<float>(currentTime - previousTime);
 		previousTime = currentTime;
 		localAccum += frameDelta;
 
 		int subSteps = 0;
+		bool queueFull = false;
 		while (localAccum >= options.fixedDeltaTime && subSteps < options.maxSubSteps)
 		{
+			// Wait with the step while the game thread is too far behind; the time slice
+			// stays in the accumulator and is simulated once the queue has room again
+			if (!m_physicsExchange.canPushStep())
+			{
+				// Logged once per stall, not once per physics tick
+				if (!queueStalled && options.logSubsystemErrors)
+					spdlog::warn("Physics step queue full, game thread is falling behind");
+				queueStalled = true;
+				queueFull = true;
+				break;
+			}
+			if (queueStalled)
+			{
+				if (options.logSubsystemErrors && droppedSteps > 0)
+					spdlog::warn("Physics step queue drained, dropped {} steps while it was full", droppedSteps);
+				queueStalled = false;
+				droppedSteps = 0;
+			}
+
+			ENGINE_PROFILE_SCOPE("Physics::step");
+
 			// Step physics engine
 			m_physicsEngine.step(options.fixedDeltaTime);
 
-			// Fixed update for active scene
-			auto activeScene = m_sceneManager->getActiveScene();
-			if (activeScene)
-			{
-				// TODO: Add fixedUpdate() method to Scene if needed for physics
-				// activeScene->fixedUpdate(options.fixedDeltaTime);
-			}
+			// Hand the step over to the game thread, which owns the scene graph and
+			// dispatches PhysicsNode::fixedUpdate() when it drains the queue.
+			// Cannot fail: only this thread pushes and a slot was free above.
+			m_physicsExchange.pushStep({stepIndex + 1, options.fixedDeltaTime});
 
+			++stepIndex;
 			localAccum -= options.fixedDeltaTime;
 			subSteps++;
 		}
 
-		// Sleep briefly to avoid busy-waiting
-		SDL_Delay(1);
+		// Drop time we could not simulate instead of spiraling
+		if (subSteps >= options.maxSubSteps && localAccum >= options.fixedDeltaTime)
+			localAccum = std::fmod(localAccum, options.fixedDeltaTime);
+
+		// While the queue is full keep at most maxSubSteps of backlog, so the catch-up
+		// after the stall is bounded; the rest is counted as dropped
+		const float maxBacklog = options.fixedDeltaTime * static_cast<float>(options.maxSubSteps);
+		if (queueFull && localAccum > maxBacklog)
+		{
+			droppedSteps += static_cast<uint64_t>((localAccum - maxBacklog) / options.fixedDeltaTime);
+			localAccum = maxBacklog + std::fmod(localAccum - maxBacklog, options.fixedDeltaTime);
+		}
+
+		m_physicsExchange.publishState({stepIndex, localAccum / options.fixedDeltaTime});
+
+		// Sleep until the next fixed step is due
+		m_physicsPacer.endFrame();
 	}
 }
 
@@ -333,9 +487,18 @@ void GameEngine::gameLoop()
 {
 	double previousTime = getCurrentTime();
 	onWindowResize(options.windowWidth, options.windowHeight);
+	m_framePacer.reset();
+	engine::core::Profiler::instance().setEnabled(options.enableProfiler);
+	m_context->passTimer().setEnabled(options.enableGpuTiming);
 	while (running)
 	{
-		processEvents();
+		// Low-latency mode delays here so input is sampled as late as possible
+		m_framePacer.beginFrame();
+
+		{
+			ENGINE_PROFILE_SCOPE("GameEngine::processEvents");
+			processEvents();
+		}
 
 		const double currentTime = getCurrentTime();
 		float frameDelta = static_cast<float>(currentTime - previousTime);
@@ -344,13 +507,177 @@ void GameEngine::gameLoop()
 		if (frameDelta > options.maxDeltaTime)
 			frameDelta = options.maxDeltaTime;
 
-		updateScene(frameDelta);
-		renderFrame(frameDelta);
+		{
+			ENGINE_PROFILE_SCOPE("GameEngine::updateScene");
+			updateScene(frameDelta);
+		}
+		{
+			ENGINE_PROFILE_SCOPE("GameEngine::renderFrame");
+			renderFrame(frameDelta);
+		}
 
 		m_inputManager.endFrame();
 		updateFrameStats(frameDelta);
-		limitFrameRate(currentTime);
+		ENGINE_PROFILE_END_FRAME();
+
+		// Wait for the next frame deadline (no-op when uncapped or vsync paced)
+		m_framePacer.endFrame();
+	}
+}
+
+void GameEngine::headlessLoop()
+{
+	const float deltaTime = options.fixedDeltaTime;
+	const auto outputDirectory = options.headlessOutputDirectory.empty()
+									 ? engine::core::PathProvider::getLogs("headless")
+									 : options.headlessOutputDirectory;
+
+	// Only time frames of a fully loaded scene
+	while (running && m_sceneManager->isLoading())
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	onWindowResize(options.windowWidth, options.windowHeight);
+	engine::core::Profiler::instance().setEnabled(options.enableProfiler);
+	m_context->passTimer().setEnabled(options.enableGpuTiming);
+
+	spdlog::info(
+		"Headless run: {}x{}, {} frames, dt {:.4f}s",
+		options.windowWidth,
+		options.windowHeight,
+		options.headlessFrameCount,
+		deltaTime
+	);
+
+	std::vector<float> frameTimesMs;
+	frameTimesMs.reserve(options.headlessFrameCount);
+	m_headlessTime = 0.0;
+	uint64_t frameIndex = 0;
+	while (running && (options.headlessFrameCount == 0 || frameIndex < options.headlessFrameCount))
+	{
+		const auto frameStart = std::chrono::steady_clock::now();
+
+		// Exactly one fixed step per frame, so every run simulates the same states
+		if (options.runPhysics)
+		{
+			ENGINE_PROFILE_SCOPE("Physics::step");
+			m_physicsEngine.step(deltaTime);
+			m_physicsExchange.pushStep({frameIndex + 1, deltaTime});
+			m_physicsExchange.publishState({frameIndex + 1, 1.0f});
+		}
+		{
+			ENGINE_PROFILE_SCOPE("GameEngine::updateScene");
+			updateScene(deltaTime);
+		}
+		{
+			ENGINE_PROFILE_SCOPE("GameEngine::renderFrame");
+			renderFrame(deltaTime);
+		}
+		{
+			// Wait for the GPU so frame times include GPU work (also fires pending map callbacks)
+			ENGINE_PROFILE_SCOPE("GameEngine::waitForGPU");
+			m_context->pollDevice(true);
+		}
+		m_inputManager.endFrame();
+
+		const float frameMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+		frameTimesMs.push_back(frameMs);
+		updateFrameStats(frameMs * 0.001f);
+		ENGINE_PROFILE_END_FRAME();
+
+		++frameIndex;
+		m_headlessTime += deltaTime;
+
+		// Captures happen after the frame was timed
+		if (options.headlessCaptureInterval > 0 && frameIndex % options.headlessCaptureInterval == 0)
+		{
+			std::ostringstream name;
+			name << "frame_" << std::setw(5) << std::setfill('0') << frameIndex << ".png";
+			captureHeadlessFrame(outputDirectory / name.str());
+		}
 	}
+
+	writeHeadlessReport(outputDirectory / "timings.json", frameTimesMs);
+}
+
+bool GameEngine::captureHeadlessFrame(const std::filesystem::path &path)
+{
+	auto target = m_context->surfaceManager().getOffscreenTexture();
+	if (!target)
+		return false;
+
+	// Same readback service as camera render targets, but waited on: there is no frame to overlap with
+	auto future = m_context->readbackService().readTexture(*target);
+	while (future.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready)
+	{
+		m_context->pollDevice(true);
+		m_context->readbackService().update();
+	}
+
+	auto image = future.get();
+	if (!image || !m_resourceManager->m_imageLoader->saveAsPNG(*image, path))
+	{
+		spdlog::error("Failed to save headless capture to {}", path.string());
+		return false;
+	}
+	return true;
+}
+
+void GameEngine::writeHeadlessReport(const std::filesystem::path &path, const std::vector<float> &frameTimesMs) const
+{
+	if (frameTimesMs.empty())
+	{
+		spdlog::warn("Headless run rendered no frames, no report written");
+		return;
+	}
+
+	std::vector<float> sorted = frameTimesMs;
+	std::sort(sorted.begin(), sorted.end());
+	auto percentile = [&sorted](float p)
+	{
+		const size_t index = static_cast<size_t>(p * static_cast<float>(sorted.size() - 1) + 0.5f);
+		return sorted[std::min(index, sorted.size() - 1)];
+	};
+
+	double sum = 0.0;
+	for (float ms : frameTimesMs)
+		sum += ms;
+	const float meanMs = static_cast<float>(sum / static_cast<double>(frameTimesMs.size()));
+	const auto gpuPasses = m_renderer ? m_renderer->getGpuPassTimings() : std::vector<engine::rendering::webgpu::GpuPassTiming>{};
+
+	spdlog::info(
+		"Headless run: {} frames | mean {:.3f}ms | p50 {:.3f}ms | p95 {:.3f}ms | p99 {:.3f}ms | max {:.3f}ms",
+		frameTimesMs.size(),
+		meanMs,
+		percentile(0.50f),
+		percentile(0.95f),
+		percentile(0.99f),
+		sorted.back()
+	);
+	for (const auto &pass : gpuPasses)
+		spdlog::info("  GPU {}: {:.3f}ms", pass.name, pass.averageMs);
+
+	std::error_code ec;
+	std::filesystem::create_directories(path.parent_path(), ec);
+	std::ofstream file(path, std::ios::out | std::ios::trunc);
+	if (!file)
+	{
+		spdlog::error("Could not open headless report {}", path.string());
+		return;
+	}
+
+	file << std::fixed << std::setprecision(4);
+	file << "{\"width\":" << options.windowWidth << ",\"height\":" << options.windowHeight
+		 << ",\"deltaTime\":" << options.fixedDeltaTime << ",\"frames\":" << frameTimesMs.size()
+		 << ",\"meanMs\":" << meanMs << ",\"p50Ms\":" << percentile(0.50f) << ",\"p95Ms\":" << percentile(0.95f)
+		 << ",\"p99Ms\":" << percentile(0.99f) << ",\"maxMs\":" << sorted.back() << ",\"gpuPasses\":{";
+	for (size_t i = 0; i < gpuPasses.size(); ++i)
+		file << (i ? "," : "") << "\"" << gpuPasses[i].name << "\":" << gpuPasses[i].averageMs;
+	file << "},\"frameTimesMs\":[";
+	for (size_t i = 0; i < frameTimesMs.size(); ++i)
+		file << (i ? "," : "") << frameTimesMs[i];
+	file << "]}\n";
+
+	spdlog::info("Headless timings written to {}", path.string());
 }
 
 void GameEngine::processEvents()
@@ -408,12 +735,40 @@ void GameEngine::updateScene(float deltaTime)
 {
 	auto scene = m_sceneManager->getActiveScene();
 	if (!scene || !scene->isLoaded())
+	{
+		dispatchFixedSteps(nullptr);
 		return;
+	}
+
+	dispatchFixedSteps(scene.get());
 
 	scene->update(deltaTime);
 	scene->lateUpdate(deltaTime);
 }
 
+void GameEngine::dispatchFixedSteps(engine::scene::Scene *scene)
+{
+	if (!options.runPhysics)
+		return;
+
+	// Run every fixed step the physics thread completed since the last frame
+	while (auto step = m_physicsExchange.popStep())
+	{
+		if (scene)
+			scene->fixedUpdate(step->fixedDeltaTime);
+		m_lastConsumedPhysicsStep = step->stepIndex;
+	}
+
+	if (!scene)
+		return;
+
+	// If the published state is ahead of the drained queue, the newer step is still
+	// in flight: hold at the latest consumed state instead of extrapolating
+	const auto &state = m_physicsExchange.latestState();
+	const float alpha = (state.lastStepIndex == m_lastConsumedPhysicsStep) ? state.alpha : 1.0f;
+	scene->interpolatePhysics(alpha);
+}
+
 void GameEngine::renderFrame(float /* deltaTime*/)
 {
 	auto scene = m_sceneManager->getActiveScene();
@@ -439,14 +794,15 @@ void GameEngine::renderFrame(float /* deltaTime*/)
 	// Collect render data directly from scene graph
 	scene->collectRenderData(renderCollector);
 
-	// Sort with camera position for proper transparent object ordering
-	glm::vec3 cameraPosition = cameras.empty() ? glm::vec3(0.0f) : cameras[0]->getPosition();
-	renderCollector.sort(cameraPosition);
+	// Sort with the camera view for front-to-back opaque and back-to-front transparent ordering
+	glm::vec3 cameraPosition = cameras[0]->getPosition();
+	glm::vec3 cameraForward = cameras[0]->getTransform().forward();
+	renderCollector.sort(cameraPosition, cameraForward);
 
 	scene->collectDebugData();
 	auto debugCollector = scene->getDebugCollector();
 
-	float time = static_cast<float>(SDL_GetTicks()) * 0.001f;
+	float time = options.headless ? static_cast<float>(m_headlessTime) : static_cast<float>(SDL_GetTicks()) * 0.001f;
 
 	std::vector<engine::rendering::RenderTarget> renderTargets;
 	renderTargets.reserve(cameras.size());
@@ -524,6 +880,18 @@ void GameEngine::updateFrameStats(float frameDelta)
 				static_cast<int>(m_currentFPS),
 				m_currentFrameTime
 			);
+
+			const auto pacing = m_framePacer.getStats();
+			if (pacing.frameCount > 0)
+			{
+				spdlog::info(
+					"Pacing error: mean {:.3f}ms | sd {:.3f}ms | max {:.3f}ms | missed {}",
+					pacing.meanErrorMs,
+					pacing.stdDevErrorMs,
+					pacing.maxErrorMs,
+					pacing.missedDeadlines
+				);
+			}
 		}
 
 		frameCount = 0;
@@ -531,18 +899,4 @@ void GameEngine::updateFrameStats(float frameDelta)
 	}
 }
 
-void GameEngine::limitFrameRate(double frameStartTime)
-{
-	if (!options.limitFrameRate || options.enableVSync)
-		return;
-
-	const double targetFrameTime = 1.0 / options.targetFrameRate;
-	const double frameTime = getCurrentTime() - frameStartTime;
-
-	if (frameTime < targetFrameTime)
-	{
-		SDL_Delay(static_cast<Uint32>((targetFrameTime - frameTime) * 1000.0));
-	}
-}
-
 } // namespace engine
@@ -0,0 +1,39 @@
+#include "engine/core/ChangeJournal.h"
+#include "engine/core/Versioned.h"
+
+namespace engine::core
+{
+
+ChangeJournal &ChangeJournal::instance()
+{
+	static ChangeJournal journal;
+	return journal;
+}
+
+ChangeJournal::token_t ChangeJournal::track(const Versioned &object)
+{
+	token_t token = object.m_changeToken.load(std::memory_order_acquire);
+	if (token != 0)
+		return token;
+
+	// Two trackers racing on the same object agree on whichever token was stored first
+	const token_t candidate = m_nextToken.fetch_add(1, std::memory_order_relaxed);
+	if (object.m_changeToken.compare_exchange_strong(token, candidate, std::memory_order_acq_rel))
+		return candidate;
+	return token;
+}
+
+void ChangeJournal::record(token_t token)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_pending.push_back(token);
+}
+
+void ChangeJournal::drain(std::vector<token_t> &outTokens)
+{
+	outTokens.clear();
+	std::lock_guard<std::mutex> lock(m_mutex);
+	outTokens.swap(m_pending);
+}
+
+} // namespace engine::core
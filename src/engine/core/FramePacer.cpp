@@ -0,0 +1,163 @@
+#include "engine/core/FramePacer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace engine::core
+{
+
+using namespace std::chrono;
+
+void FramePacer::configure(const Settings &settings)
+{
+	m_settings = settings;
+	m_interval = settings.targetRate > 0.0
+					 ? duration_cast<Clock::duration>(duration<double>(1.0 / settings.targetRate))
+					 : Clock::duration::zero();
+	m_spinThreshold = duration_cast<Clock::duration>(duration<double, std::milli>(std::max(0.0, settings.spinThresholdMs)));
+	m_anchored = false;
+}
+
+void FramePacer::reset()
+{
+	m_errorsMs.fill(0.0f);
+	m_frameCount = 0;
+	m_missedDeadlines = 0;
+	m_predictedWork = 0.0;
+	m_anchored = false;
+}
+
+void FramePacer::sleepUntil(Clock::time_point deadline, Clock::duration spinThreshold)
+{
+	// Coarse OS sleep for the bulk of the wait
+	const auto sleepTarget = deadline - spinThreshold;
+	if (Clock::now() < sleepTarget)
+		std::this_thread::sleep_until(sleepTarget);
+
+	// Spin (yielding) for the remainder to hit the deadline precisely
+	while (Clock::now() < deadline)
+		std::this_thread::yield();
+}
+
+void FramePacer::beginFrame()
+{
+	const auto now = Clock::now();
+	if (!isEnabled())
+	{
+		m_workStart = now;
+		return;
+	}
+
+	if (!m_anchored)
+	{
+		m_deadline = now + m_interval;
+		m_anchored = true;
+	}
+
+	if (m_settings.lowLatency)
+	{
+		const auto predicted = duration_cast<Clock::duration>(
+			duration<double>(m_predictedWork) + duration<double, std::milli>(m_settings.latencySafetyMarginMs)
+		);
+		const auto target = m_deadline - predicted;
+		if (now < target)
+		{
+			sleepUntil(target, m_spinThreshold);
+			recordError(target, Clock::now());
+		}
+		else
+		{
+			recordError(target, now);
+		}
+	}
+
+	m_workStart = Clock::now();
+}
+
+void FramePacer::endFrame()
+{
+	const auto now = Clock::now();
+
+	// Rise quickly on spikes, decay slowly, so low-latency mode rarely misses deadlines
+	const double work = duration<double>(now - m_workStart).count();
+	const double blend = work > m_predictedWork ? 0.5 : 0.05;
+	m_predictedWork += (work - m_predictedWork) * blend;
+
+	if (!isEnabled() || !m_anchored)
+		return;
+
+	if (now > m_deadline)
+		++m_missedDeadlines;
+
+	if (!m_settings.lowLatency && !m_settings.anchorToFrameEnd)
+	{
+		if (now < m_deadline)
+		{
+			sleepUntil(m_deadline, m_spinThreshold);
+			recordError(m_deadline, Clock::now());
+		}
+		else
+		{
+			recordError(m_deadline, now);
+		}
+	}
+
+	advanceDeadline(Clock::now());
+}
+
+void FramePacer::advanceDeadline(Clock::time_point now)
+{
+	if (m_settings.anchorToFrameEnd)
+	{
+		// The blocking present already aligned us to the display, track its phase
+		m_deadline = now + m_interval;
+		return;
+	}
+
+	m_deadline += m_interval;
+
+	// More than a full interval behind: re-anchor instead of bursting to catch up
+	if (now > m_deadline)
+		m_deadline = now + m_interval;
+}
+
+void FramePacer::recordError(Clock::time_point target, Clock::time_point actual)
+{
+	const float errorMs = duration<float, std::milli>(actual - target).count();
+	m_errorsMs[m_frameCount % STATS_WINDOW] = errorMs;
+	++m_frameCount;
+}
+
+FramePacingStats FramePacer::getStats() const
+{
+	FramePacingStats stats;
+	stats.frameCount = m_frameCount;
+	stats.missedDeadlines = m_missedDeadlines;
+	stats.predictedWorkMs = static_cast<float>(m_predictedWork * 1000.0);
+
+	const size_t count = static_cast<size_t>(std::min<uint64_t>(m_frameCount, STATS_WINDOW));
+	if (count == 0)
+		return stats;
+
+	stats.lastErrorMs = m_errorsMs[(m_frameCount - 1) % STATS_WINDOW];
+
+	double sum = 0.0;
+	double sumSq = 0.0;
+	float maxAbs = 0.0f;
+	for (size_t i = 0; i < count; ++i)
+	{
+		const float e = m_errorsMs[i];
+		sum += e;
+		sumSq += static_cast<double>(e) * e;
+		maxAbs = std::max(maxAbs, std::abs(e));
+	}
+
+	const double mean = sum / static_cast<double>(count);
+	stats.meanErrorMs = static_cast<float>(mean);
+	stats.maxErrorMs = maxAbs;
+	stats.stdDevErrorMs = static_cast<float>(std::sqrt(std::max(0.0, sumSq / static_cast<double>(count) - mean * mean)));
+	return stats;
+}
+
+} // namespace engine::core
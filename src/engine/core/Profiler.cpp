@@ -0,0 +1,245 @@
+#include "engine/core/Profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+#include <spdlog/spdlog.h>
+
+namespace engine::core
+{
+
+const Profiler::Clock::time_point Profiler::s_epoch = Profiler::Clock::now();
+
+Profiler &Profiler::instance()
+{
+	// Never destroyed: threads joined during static destruction still hand back their buffers
+	static Profiler *profiler = new Profiler();
+	return *profiler;
+}
+
+ProfileThreadBuffer &Profiler::threadBuffer()
+{
+	// Hands the buffer back to the profiler when the thread exits
+	struct Registration
+	{
+		ProfileThreadBuffer *buffer = nullptr;
+		~Registration()
+		{
+			if (buffer)
+				instance().retireThreadBuffer(*buffer);
+		}
+	};
+	thread_local Registration registration;
+
+	if (!registration.buffer)
+	{
+		auto &profiler = instance();
+		std::lock_guard<std::mutex> lock(profiler.m_mutex);
+		const uint32_t id = profiler.m_nextThreadId++;
+		if (!profiler.m_freeBuffers.empty())
+		{
+			registration.buffer = profiler.m_freeBuffers.back();
+			profiler.m_freeBuffers.pop_back();
+			registration.buffer->m_threadId = id;
+			registration.buffer->depth = 0;
+		}
+		else
+		{
+			profiler.m_buffers.push_back(std::make_unique<ProfileThreadBuffer>(id));
+			registration.buffer = profiler.m_buffers.back().get();
+		}
+	}
+	return *registration.buffer;
+}
+
+void Profiler::retireThreadBuffer(ProfileThreadBuffer &buffer)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	buffer.m_retired = true;
+
+	// Nothing left to read: reusable right away, otherwise the next endFrame() recycles it
+	if (buffer.m_readCursor == buffer.m_head.load(std::memory_order_acquire))
+	{
+		buffer.m_retired = false;
+		m_freeBuffers.push_back(&buffer);
+	}
+}
+
+void Profiler::drain(ProfileThreadBuffer &buffer)
+{
+	const uint64_t head = buffer.m_head.load(std::memory_order_acquire);
+
+	// Stay well behind the writer; if we lagged too far the oldest events are lost
+	constexpr uint64_t maxLag = ProfileThreadBuffer::CAPACITY / 2;
+	if (head - buffer.m_readCursor > maxLag)
+		buffer.m_readCursor = head - maxLag;
+
+	ProfileEvent event;
+	for (uint64_t i = buffer.m_readCursor; i < head; ++i)
+	{
+		// Overwritten while copying: the writer lapped the reader, the event is lost
+		if (!buffer.read(i, event))
+			continue;
+
+		const float durationMs = static_cast<float>(event.endNs - event.startNs) * 1e-6f;
+
+		auto &history = m_history[event.name];
+		history.samplesMs[history.next] = durationMs;
+		history.next = (history.next + 1) % SUMMARY_WINDOW;
+		history.count = std::min<uint32_t>(history.count + 1, SUMMARY_WINDOW);
+		history.frameAccumMs += durationMs;
+
+		if (m_capturing)
+		{
+			if (m_capture.size() < MAX_CAPTURE_EVENTS)
+			{
+				m_capture.push_back(event);
+			}
+			else
+			{
+				m_capture[m_captureNext] = event;
+				m_captureNext = (m_captureNext + 1) % MAX_CAPTURE_EVENTS;
+				m_captureDropped++;
+			}
+		}
+	}
+	buffer.m_readCursor = head;
+}
+
+void Profiler::endFrame()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	for (auto &buffer : m_buffers)
+	{
+		drain(*buffer);
+		if (buffer->m_retired)
+		{
+			buffer->m_retired = false;
+			m_freeBuffers.push_back(buffer.get());
+		}
+	}
+
+	for (auto &[name, history] : m_history)
+	{
+		history.lastFrameMs = history.frameAccumMs;
+		history.frameAccumMs = 0.0f;
+	}
+}
+
+void Profiler::beginCapture()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_capture.clear();
+	m_captureNext = 0;
+	m_captureDropped = 0;
+	m_capturing = true;
+}
+
+bool Profiler::endCapture(const std::filesystem::path &path)
+{
+	std::vector<ProfileEvent> events;
+	uint64_t dropped = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_capturing = false;
+		events.swap(m_capture);
+		std::rotate(events.begin(), events.begin() + m_captureNext, events.end()); // Oldest first
+		dropped = m_captureDropped;
+		m_captureNext = 0;
+		m_captureDropped = 0;
+	}
+
+	if (dropped > 0)
+		spdlog::warn("Profiler: Capture exceeded {} events, the oldest {} were dropped", MAX_CAPTURE_EVENTS, dropped);
+
+	std::ofstream file(path, std::ios::out | std::ios::trunc);
+	if (!file)
+	{
+		spdlog::error("Profiler: Could not open trace file {}", path.string());
+		return false;
+	}
+
+	// Chrome trace event format, complete events ("X") with microsecond timestamps
+	file << std::fixed << std::setprecision(3);
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool first = true;
+	for (const auto &event : events)
+	{
+		if (!first)
+			file << ',';
+		first = false;
+
+		file << "{\"name\":\"";
+		for (const char *c = event.name; c && *c; ++c)
+		{
+			if (*c == '"' || *c == '\\')
+				file << '\\';
+			file << *c;
+		}
+		file << "\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId
+			 << ",\"ts\":" << static_cast<double>(event.startNs) * 1e-3
+			 << ",\"dur\":" << static_cast<double>(event.endNs - event.startNs) * 1e-3
+			 << ",\"args\":{\"depth\":" << event.depth << "}}";
+	}
+	file << "]}\n";
+
+	spdlog::info("Profiler: Wrote {} events to {}", events.size(), path.string());
+	return static_cast<bool>(file);
+}
+
+std::vector<ProfileScopeStats> Profiler::getSummary() const
+{
+	std::vector<ProfileScopeStats> result;
+	std::vector<float> sorted;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	result.reserve(m_history.size());
+	for (const auto &[name, history] : m_history)
+	{
+		if (history.count == 0)
+			continue;
+
+		sorted.assign(history.samplesMs, history.samplesMs + history.count);
+		std::sort(sorted.begin(), sorted.end());
+
+		auto percentile = [&sorted](float p)
+		{
+			const size_t index = static_cast<size_t>(p * static_cast<float>(sorted.size() - 1) + 0.5f);
+			return sorted[std::min(index, sorted.size() - 1)];
+		};
+
+		ProfileScopeStats stats;
+		stats.name = std::string(name);
+		stats.sampleCount = history.count;
+		stats.p50Ms = percentile(0.50f);
+		stats.p95Ms = percentile(0.95f);
+		stats.p99Ms = percentile(0.99f);
+		stats.maxMs = sorted.back();
+		stats.lastFrameMs = history.lastFrameMs;
+		result.push_back(std::move(stats));
+	}
+
+	std::sort(result.begin(), result.end(), [](const auto &a, const auto &b)
+			  { return a.p95Ms > b.p95Ms; });
+	return result;
+}
+
+size_t Profiler::getThreadBufferCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_buffers.size();
+}
+
+void Profiler::reset()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_history.clear();
+	m_capture.clear();
+	m_captureNext = 0;
+	m_captureDropped = 0;
+	m_capturing = false;
+}
+
+} // namespace engine::core
@@ -0,0 +1,97 @@
+#include "engine/core/WorkerPool.h"
+
+#include <algorithm>
+
+namespace engine::core
+{
+
+namespace
+{
+thread_local bool t_isWorker = false;
+}
+
+WorkerPool::WorkerPool(uint32_t threadCount)
+{
+	m_threads.reserve(threadCount);
+	for (uint32_t i = 0; i < threadCount; ++i)
+		m_threads.emplace_back([this]()
+							   { workerLoop(); });
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_wake.notify_all();
+	for (auto &thread : m_threads)
+		thread.join();
+}
+
+WorkerPool &WorkerPool::shared()
+{
+	static WorkerPool pool(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+	return pool;
+}
+
+void WorkerPool::run(uint32_t count, uint32_t chunkSize, RangeFn fn, void *context)
+{
+	if (count == 0)
+		return;
+
+	std::unique_lock<std::mutex> submitLock(m_submitMutex, std::defer_lock);
+	if (m_threads.empty() || t_isWorker || !submitLock.try_lock())
+	{
+		fn(context, 0, count);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_fn = fn;
+		m_context = context;
+		m_count = count;
+		m_chunkSize = std::max(chunkSize, 1u);
+		m_next.store(0, std::memory_order_relaxed);
+		m_pending = static_cast<uint32_t>(m_threads.size());
+		m_generation++;
+	}
+	m_wake.notify_all();
+
+	runChunks();
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_done.wait(lock, [this]()
+				{ return m_pending == 0; });
+}
+
+void WorkerPool::workerLoop()
+{
+	t_isWorker = true;
+	uint64_t seenGeneration = 0;
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_wake.wait(lock, [&]()
+					{ return m_stop || m_generation != seenGeneration; });
+		if (m_stop)
+			return;
+		seenGeneration = m_generation;
+
+		lock.unlock();
+		runChunks();
+		lock.lock();
+
+		if (--m_pending == 0)
+			m_done.notify_one();
+	}
+}
+
+void WorkerPool::runChunks()
+{
+	for (uint32_t first = m_next.fetch_add(m_chunkSize); first < m_count; first = m_next.fetch_add(m_chunkSize))
+		m_fn(m_context, first, std::min(m_count, first + m_chunkSize));
+}
+
+} // namespace engine::core
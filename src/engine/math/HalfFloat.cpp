@@ -0,0 +1,265 @@
+#include "engine/math/HalfFloat.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "engine/core/Parallel.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define ENGINE_HALF_F16C 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define ENGINE_HALF_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(ENGINE_HALF_F16C) && (defined(__GNUC__) || defined(__clang__))
+#define ENGINE_TARGET_F16C __attribute__((target("avx,f16c")))
+#else
+#define ENGINE_TARGET_F16C
+#endif
+
+namespace engine::math
+{
+
+namespace
+{
+constexpr uint16_t HALF_ONE = 0x3c00;
+constexpr size_t PARALLEL_PIXEL_THRESHOLD = 1u << 20; // Pixels before conversion goes wide
+
+#if defined(ENGINE_HALF_F16C)
+/** @brief F16C needs the instruction set and OS support for the AVX register state. */
+bool detectF16C()
+{
+	unsigned int ecx = 0;
+#if defined(_MSC_VER)
+	int info[4] = {};
+	__cpuid(info, 1);
+	ecx = static_cast<unsigned int>(info[2]);
+#else
+	unsigned int eax = 0, ebx = 0, edx = 0;
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		return false;
+#endif
+	const bool osxsave = (ecx & (1u << 27)) != 0;
+	const bool avx = (ecx & (1u << 28)) != 0;
+	const bool f16c = (ecx & (1u << 29)) != 0;
+	if (!osxsave || !avx || !f16c)
+		return false;
+
+#if defined(_MSC_VER)
+	const unsigned long long xcr0 = _xgetbv(0);
+#else
+	unsigned int xcr0Low = 0, xcr0High = 0;
+	__asm__ volatile("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+	const unsigned long long xcr0 = xcr0Low;
+#endif
+	return (xcr0 & 0x6) == 0x6; // XMM and YMM state enabled
+}
+
+bool hasF16C()
+{
+	static const bool supported = detectF16C();
+	return supported;
+}
+
+ENGINE_TARGET_F16C void fromFloatF16C(const float *src, uint16_t *dst, size_t count, size_t &done)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		const __m128i halves = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), halves);
+	}
+	done = i;
+}
+
+ENGINE_TARGET_F16C void toFloatF16C(const uint16_t *src, float *dst, size_t count, size_t &done)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		const __m128i halves = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+		_mm256_storeu_ps(dst + i, _mm256_cvtph_ps(halves));
+	}
+	done = i;
+}
+
+ENGINE_TARGET_F16C void rgbToRgbaF16C(const float *src, uint16_t *dst, size_t pixelCount, size_t &done)
+{
+	// A 4-float load at pixel i reads one float of pixel i + 1, so the last pixel is left to the caller
+	const __m128 one = _mm_set1_ps(1.0f);
+	size_t i = 0;
+	for (; i + 3 <= pixelCount; i += 2)
+	{
+		const __m128 p0 = _mm_blend_ps(_mm_loadu_ps(src + i * 3), one, 0x8);
+		const __m128 p1 = _mm_blend_ps(_mm_loadu_ps(src + i * 3 + 3), one, 0x8);
+		const __m128i halves = _mm256_cvtps_ph(_mm256_set_m128(p1, p0), _MM_FROUND_TO_NEAREST_INT);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4), halves);
+	}
+	done = i;
+}
+#endif
+
+void fromFloatBlock(const float *src, uint16_t *dst, size_t count)
+{
+	size_t done = 0;
+#if defined(ENGINE_HALF_F16C)
+	if (hasF16C())
+		fromFloatF16C(src, dst, count, done);
+#elif defined(ENGINE_HALF_NEON)
+	for (; done + 4 <= count; done += 4)
+		vst1_u16(dst + done, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + done))));
+#endif
+	for (size_t i = done; i < count; ++i)
+		dst[i] = HalfFloat::fromFloat(src[i]);
+}
+
+void rgbToRgbaBlock(const float *src, uint16_t *dst, size_t pixelCount)
+{
+	size_t done = 0;
+#if defined(ENGINE_HALF_F16C)
+	if (hasF16C())
+		rgbToRgbaF16C(src, dst, pixelCount, done);
+#elif defined(ENGINE_HALF_NEON)
+	const uint16x4_t alpha = vdup_n_u16(HALF_ONE);
+	for (; done + 4 <= pixelCount; done += 4)
+	{
+		const float32x4x3_t rgb = vld3q_f32(src + done * 3); // Deinterleaves 4 pixels
+		uint16x4x4_t rgba;
+		rgba.val[0] = vreinterpret_u16_f16(vcvt_f16_f32(rgb.val[0]));
+		rgba.val[1] = vreinterpret_u16_f16(vcvt_f16_f32(rgb.val[1]));
+		rgba.val[2] = vreinterpret_u16_f16(vcvt_f16_f32(rgb.val[2]));
+		rgba.val[3] = alpha;
+		vst4_u16(dst + done * 4, rgba);
+	}
+#endif
+	for (size_t i = done; i < pixelCount; ++i)
+	{
+		dst[i * 4 + 0] = HalfFloat::fromFloat(src[i * 3 + 0]);
+		dst[i * 4 + 1] = HalfFloat::fromFloat(src[i * 3 + 1]);
+		dst[i * 4 + 2] = HalfFloat::fromFloat(src[i * 3 + 2]);
+		dst[i * 4 + 3] = HALF_ONE;
+	}
+}
+} // namespace
+
+uint16_t HalfFloat::fromFloat(float value)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	const uint32_t sign = bits & 0x80000000u;
+	bits ^= sign;
+
+	uint32_t half;
+	if (bits >= 0x47800000u)
+	{
+		// Overflow to Inf; NaN stays a quiet NaN with its upper payload bits
+		half = bits > 0x7f800000u ? 0x7e00u | ((bits >> 13) & 0x3ffu) : 0x7c00u;
+	}
+	else if (bits < 0x38800000u)
+	{
+		// Zero or half subnormal: adding 0.5 aligns the half ulp with the float ulp, the FPU rounds
+		float f;
+		std::memcpy(&f, &bits, sizeof(f));
+		f += 0.5f;
+		std::memcpy(&bits, &f, sizeof(bits));
+		half = bits - 0x3f000000u;
+	}
+	else
+	{
+		// Normal: rebias the exponent and round the mantissa to nearest-even
+		const uint32_t mantissaOdd = (bits >> 13) & 1u;
+		bits += 0xc8000fffu;
+		bits += mantissaOdd;
+		half = bits >> 13;
+	}
+	return static_cast<uint16_t>(half | (sign >> 16));
+}
+
+float HalfFloat::toFloat(uint16_t value)
+{
+	constexpr uint32_t shiftedExponent = 0x7c00u << 13;
+	uint32_t bits = (value & 0x7fffu) << 13;
+	const uint32_t exponent = bits & shiftedExponent;
+	bits += (127u - 15u) << 23;
+
+	float result;
+	if (exponent == shiftedExponent)
+	{
+		bits += (128u - 16u) << 23; // Inf/NaN
+		std::memcpy(&result, &bits, sizeof(result));
+	}
+	else if (exponent == 0)
+	{
+		// Zero or subnormal: renormalize through the FPU
+		bits += 1u << 23;
+		std::memcpy(&result, &bits, sizeof(result));
+		result -= 6.103515625e-05f; // 2^-14
+	}
+	else
+	{
+		std::memcpy(&result, &bits, sizeof(result));
+	}
+	return (value & 0x8000u) ? -result : result;
+}
+
+void HalfFloat::fromFloat(const float *src, uint16_t *dst, size_t count)
+{
+	fromFloatBlock(src, dst, count);
+}
+
+void HalfFloat::toFloat(const uint16_t *src, float *dst, size_t count)
+{
+	size_t done = 0;
+#if defined(ENGINE_HALF_F16C)
+	if (hasF16C())
+		toFloatF16C(src, dst, count, done);
+#elif defined(ENGINE_HALF_NEON)
+	for (; done + 4 <= count; done += 4)
+		vst1q_f32(dst + done, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + done))));
+#endif
+	for (size_t i = done; i < count; ++i)
+		dst[i] = toFloat(src[i]);
+}
+
+void HalfFloat::fromFloatRGBToRGBA(const float *src, uint16_t *dst, size_t pixelCount)
+{
+	rgbToRgbaBlock(src, dst, pixelCount);
+}
+
+std::vector<uint16_t> HalfFloat::fromFloatImage(
+	const float *src,
+	uint32_t width,
+	uint32_t height,
+	uint32_t channels,
+	bool expandRGBToRGBA
+)
+{
+	const bool expand = expandRGBToRGBA && channels == 3;
+	const uint32_t dstChannels = expand ? 4 : channels;
+	const size_t srcRowFloats = static_cast<size_t>(width) * channels;
+	const size_t dstRowHalves = static_cast<size_t>(width) * dstChannels;
+	std::vector<uint16_t> dst(dstRowHalves * height);
+
+	auto convertRows = [&](uint32_t firstRow, uint32_t lastRow)
+	{
+		const float *rowSrc = src + firstRow * srcRowFloats;
+		uint16_t *rowDst = dst.data() + firstRow * dstRowHalves;
+		const size_t rows = lastRow - firstRow;
+		if (expand)
+			rgbToRgbaBlock(rowSrc, rowDst, rows * width);
+		else
+			fromFloatBlock(rowSrc, rowDst, rows * srcRowFloats);
+	};
+
+	engine::core::parallelFor(height, static_cast<size_t>(width) * height, PARALLEL_PIXEL_THRESHOLD, convertRows);
+	return dst;
+}
+
+} // namespace engine::math
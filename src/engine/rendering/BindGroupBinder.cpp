@@ -1,7 +1,9 @@
 #include "engine/rendering/BindGroupBinder.h"
 #include <spdlog/spdlog.h>
+#include <type_traits>
 #include "engine/rendering/BindGroupEnums.h"
 #include "engine/rendering/FrameCache.h"
+#include "engine/rendering/RecordingEncoder.h"
 #include "engine/rendering/webgpu/WebGPUBindGroup.h"
 #include "engine/rendering/webgpu/WebGPUBindGroupLayoutInfo.h"
 #include "engine/rendering/webgpu/WebGPUPipeline.h"
@@ -10,11 +12,12 @@
 namespace engine::rendering
 {
 
+template <typename Encoder>
 bool BindGroupBinder::bind(
-	wgpu::RenderPassEncoder &renderPass,
+	Encoder &renderPass,
 	const std::shared_ptr<webgpu::WebGPUPipeline> &pipeline,
 	uint64_t cameraId,
-	const std::unordered_map<BindGroupType, std::shared_ptr<webgpu::WebGPUBindGroup>> &bindGroups,
+	const BindGroupSet &bindGroups,
 	std::optional<uint64_t> objectId,
 	std::optional<uint64_t> materialId
 )
@@ -25,14 +28,29 @@ bool BindGroupBinder::bind(
 		return false;
 	}
 
-	auto shaderInfo = pipeline->getShaderInfo();
+	return bind(renderPass, *pipeline->getShaderInfo(), cameraId, bindGroups, objectId, materialId);
+}
 
+template <typename Encoder>
+bool BindGroupBinder::bind(
+	Encoder &renderPass,
+	const webgpu::WebGPUShaderInfo &shaderInfo,
+	uint64_t cameraId,
+	const BindGroupSet &bindGroups,
+	std::optional<uint64_t> objectId,
+	std::optional<uint64_t> materialId
+)
+{
 	// Detect render pass change
-	WGPURenderPassEncoder currentHandle = static_cast<WGPURenderPassEncoder>(renderPass);
-	if (m_lastRenderPassHandle != currentHandle)
+	const void *currentEncoder = nullptr;
+	if constexpr (std::is_same_v<Encoder, wgpu::RenderPassEncoder>)
+		currentEncoder = static_cast<WGPURenderPassEncoder>(renderPass);
+	else
+		currentEncoder = &renderPass;
+	if (m_lastEncoder != currentEncoder)
 	{
-		m_lastRenderPassHandle = currentHandle;
-		m_boundBindGroups.clear();
+		m_lastEncoder = currentEncoder;
+		m_boundBindGroups.fill(nullptr);
 		spdlog::trace("BindGroupBinder: New render pass");
 	}
 
@@ -47,18 +65,18 @@ bool BindGroupBinder::bind(
 
 	// Bind all groups declared by shader
 	bool allBound = true;
-	for (const auto &layoutInfo : shaderInfo->getBindGroupLayoutVector())
+	for (const auto &slot : shaderInfo.getBindGroupSlots())
 	{
-		if (!layoutInfo) continue;
-
-		// Get group index
-		auto indexOpt = shaderInfo->getBindGroupIndex(layoutInfo->getName());
-		if (!indexOpt.has_value()) continue;
-		uint32_t groupIndex = static_cast<uint32_t>(indexOpt.value());
+		if (slot.groupIndex >= MAX_BIND_GROUPS)
+		{
+			spdlog::error("BindGroupBinder: Group index {} exceeds maximum of {}", slot.groupIndex, MAX_BIND_GROUPS);
+			allBound = false;
+			continue;
+		}
 
 		// Check if we need to rebind based on reuse policy
 		bool needsRebind = false;
-		switch (layoutInfo->getReuse())
+		switch (slot.reuse)
 		{
 			case BindGroupReuse::Global: needsRebind = false; break;
 			case BindGroupReuse::PerFrame: needsRebind = cameraChanged; break;
@@ -67,25 +85,18 @@ bool BindGroupBinder::bind(
 		}
 
 		// Find the bind group
-		std::shared_ptr<webgpu::WebGPUBindGroup> bindGroup = findBindGroup(
-			layoutInfo, 
-			shaderInfo->getName(),
-			bindGroups, 
-			cameraId, 
-			objectId, 
-			materialId
-		);
+		const webgpu::WebGPUBindGroup *bindGroup = findBindGroup(slot, bindGroups, cameraId, objectId, materialId);
 
 		if (!bindGroup)
 		{
-			spdlog::trace("BindGroupBinder: No bind group for '{}' at group {}", layoutInfo->getName(), groupIndex);
+			spdlog::trace("BindGroupBinder: No bind group for '{}' at group {}", slot.layout->getName(), slot.groupIndex);
 			continue;
 		}
 
 		// Bind if needed
-		if (needsRebind || m_boundBindGroups[groupIndex] != bindGroup.get())
+		if (needsRebind || m_boundBindGroups[slot.groupIndex] != bindGroup)
 		{
-			if (!bindGroupAtIndex(renderPass, groupIndex, bindGroup))
+			if (!bindGroupAtIndex(renderPass, slot.groupIndex, bindGroup))
 				allBound = false;
 		}
 	}
@@ -93,67 +104,58 @@ bool BindGroupBinder::bind(
 	return allBound;
 }
 
-std::shared_ptr<webgpu::WebGPUBindGroup> BindGroupBinder::findBindGroup(
-	const std::shared_ptr<webgpu::WebGPUBindGroupLayoutInfo> &layoutInfo,
-	const std::string &shaderName,
-	const std::unordered_map<BindGroupType, std::shared_ptr<webgpu::WebGPUBindGroup>> &bindGroups,
+const webgpu::WebGPUBindGroup *BindGroupBinder::findBindGroup(
+	const webgpu::BindGroupSlot &slot,
+	const BindGroupSet &bindGroups,
 	uint64_t cameraId,
 	std::optional<uint64_t> objectId,
 	std::optional<uint64_t> materialId
 )
 {
-	auto type = layoutInfo->getType();
-	auto reuse = layoutInfo->getReuse();
-
 	// Custom bind groups - look in cache
-	if (type == BindGroupType::Custom)
+	if (slot.type == BindGroupType::Custom)
 	{
 		std::optional<uint64_t> instanceId;
-		if (reuse == BindGroupReuse::PerObject) instanceId = objectId;
-		if (reuse == BindGroupReuse::PerMaterial) instanceId = materialId;
+		if (slot.reuse == BindGroupReuse::PerObject) instanceId = objectId;
+		if (slot.reuse == BindGroupReuse::PerMaterial) instanceId = materialId;
 
-		std::string cacheKey = FrameCache::createCustomBindGroupCacheKey(
-			shaderName, 
-			layoutInfo->getName(), 
-			instanceId
-		);
+		const uint64_t cacheKey = FrameCache::createCustomBindGroupCacheKey(slot.customKey, instanceId);
 
 		auto it = m_frameCache->customBindGroupCache.find(cacheKey);
-		return (it != m_frameCache->customBindGroupCache.end()) ? it->second : nullptr;
+		return (it != m_frameCache->customBindGroupCache.end()) ? it->second.get() : nullptr;
 	}
 
 	// Built-in bind groups - check parameter first
-	auto it = bindGroups.find(type);
-	if (it != bindGroups.end())
-		return it->second;
+	if (const auto *explicitGroup = bindGroups.get(slot.type))
+		return explicitGroup;
 
 	// Fallback to caches
-	if (type == BindGroupType::Frame)
+	if (slot.type == BindGroupType::Frame)
 	{
 		auto cacheIt = m_frameCache->frameBindGroupCache.find(cameraId);
-		return (cacheIt != m_frameCache->frameBindGroupCache.end()) ? cacheIt->second : nullptr;
+		return (cacheIt != m_frameCache->frameBindGroupCache.end()) ? cacheIt->second.get() : nullptr;
 	}
 
-	if (type == BindGroupType::Object && objectId.has_value())
+	if (slot.type == BindGroupType::Object && objectId.has_value())
 	{
 		auto cacheIt = m_frameCache->objectBindGroupCache.find(objectId.value());
-		return (cacheIt != m_frameCache->objectBindGroupCache.end()) ? cacheIt->second : nullptr;
+		return (cacheIt != m_frameCache->objectBindGroupCache.end()) ? cacheIt->second.get() : nullptr;
 	}
 
 	return nullptr;
 }
 
+template <typename Encoder>
 bool BindGroupBinder::bindGroupAtIndex(
-	wgpu::RenderPassEncoder &renderPass,
+	Encoder &renderPass,
 	uint32_t groupIndex,
-	const std::shared_ptr<webgpu::WebGPUBindGroup> &bindGroup
+	const webgpu::WebGPUBindGroup *bindGroup
 )
 {
 	if (!bindGroup) return false;
 
 	// Check if already bound
-	auto it = m_boundBindGroups.find(groupIndex);
-	if (it != m_boundBindGroups.end() && it->second == bindGroup.get())
+	if (m_boundBindGroups[groupIndex] == bindGroup)
 	{
 		spdlog::trace("BindGroupBinder: Group {} already bound", groupIndex);
 		return true;
@@ -161,10 +163,23 @@ bool BindGroupBinder::bindGroupAtIndex(
 
 	// Bind it
 	renderPass.setBindGroup(groupIndex, bindGroup->getBindGroup(), 0, nullptr);
-	m_boundBindGroups[groupIndex] = bindGroup.get();
+	m_boundBindGroups[groupIndex] = bindGroup;
 
 	spdlog::trace("BindGroupBinder: Bound group {}", groupIndex);
 	return true;
 }
 
-} // namespace engine::rendering
\ No newline at end of file
+template bool BindGroupBinder::bind<wgpu::RenderPassEncoder>(
+	wgpu::RenderPassEncoder &, const std::shared_ptr<webgpu::WebGPUPipeline> &, uint64_t, const BindGroupSet &, std::optional<uint64_t>, std::optional<uint64_t>
+);
+template bool BindGroupBinder::bind<RecordingEncoder>(
+	RecordingEncoder &, const std::shared_ptr<webgpu::WebGPUPipeline> &, uint64_t, const BindGroupSet &, std::optional<uint64_t>, std::optional<uint64_t>
+);
+template bool BindGroupBinder::bind<wgpu::RenderPassEncoder>(
+	wgpu::RenderPassEncoder &, const webgpu::WebGPUShaderInfo &, uint64_t, const BindGroupSet &, std::optional<uint64_t>, std::optional<uint64_t>
+);
+template bool BindGroupBinder::bind<RecordingEncoder>(
+	RecordingEncoder &, const webgpu::WebGPUShaderInfo &, uint64_t, const BindGroupSet &, std::optional<uint64_t>, std::optional<uint64_t>
+);
+
+} // namespace engine::rendering
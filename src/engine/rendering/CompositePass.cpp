@@ -1,4 +1,5 @@
 #include "engine/rendering/CompositePass.h"
+#include "engine/core/Profiler.h"
 
 #include <spdlog/spdlog.h>
 
@@ -63,6 +64,7 @@ bool CompositePass::initialize()
 
 void CompositePass::render(FrameCache &frameCache)
 {
+	ENGINE_PROFILE_SCOPE("CompositePass::render");
 	if (!m_renderPassContext || frameCache.renderTargets.empty())
 	{
 		spdlog::error("CompositePass: Invalid render pass context or empty targets");
@@ -101,7 +103,7 @@ void CompositePass::render(FrameCache &frameCache)
 		renderPass.setScissorRect(uint32_t(x), uint32_t(y), uint32_t(w), uint32_t(h));
 
 		// --- Get or create bind group for this texture ---
-		auto bindGroup = getOrCreateBindGroup(renderToTexture, target.layerIndex);
+		auto bindGroup = getOrCreateBindGroup(targetId, renderToTexture, target.layerIndex);
 		if (!bindGroup)
 		{
 			spdlog::warn("CompositePass: Failed to create bind group for texture");
@@ -124,6 +126,7 @@ void CompositePass::cleanup()
 }
 
 std::shared_ptr<webgpu::WebGPUBindGroup> CompositePass::getOrCreateBindGroup(
+	uint64_t targetId,
 	const std::shared_ptr<webgpu::WebGPUTexture> &texture,
 	int layerIndex
 )
@@ -131,12 +134,13 @@ std::shared_ptr<webgpu::WebGPUBindGroup> CompositePass::getOrCreateBindGroup(
 	if (!texture)
 		return nullptr;
 
-	// ToDo: optimize cache key by using texture ID and layer index instead of pointer. Have a cachekey system for the engine
-	auto cacheKey = reinterpret_cast<uint64_t>(texture.get()) ^ static_cast<uint64_t>(layerIndex);
+	wgpu::TextureView textureView = texture->getTextureView(layerIndex);
+	const uint64_t generation = m_context->pipelineManager().getGeneration();
 
-	auto it = m_bindGroupCache.find(cacheKey);
-	if (it != m_bindGroupCache.end())
-		return it->second;
+	auto &cached = m_bindGroupCache[targetId];
+	if (cached.bindGroup && cached.texture.lock() == texture && cached.view == static_cast<WGPUTextureView>(textureView)
+		&& cached.generation == generation)
+		return cached.bindGroup;
 
 	auto bindGroupLayout = m_shaderInfo->getBindGroupLayout(0);
 	if (!bindGroupLayout)
@@ -151,7 +155,7 @@ std::shared_ptr<webgpu::WebGPUBindGroup> CompositePass::getOrCreateBindGroup(
 		entry.binding = layoutEntry.binding;
 
 		if (layoutEntry.texture.sampleType != wgpu::TextureSampleType::Undefined)
-			entry.textureView = texture->getTextureView(layerIndex);
+			entry.textureView = textureView;
 		else if (layoutEntry.sampler.type != wgpu::SamplerBindingType::Undefined)
 			entry.sampler = m_sampler;
 
@@ -169,7 +173,10 @@ std::shared_ptr<webgpu::WebGPUBindGroup> CompositePass::getOrCreateBindGroup(
 		std::vector<std::shared_ptr<webgpu::WebGPUBuffer>>{}
 	);
 
-	m_bindGroupCache[cacheKey] = bindGroup;
+	cached.bindGroup = bindGroup;
+	cached.texture = texture;
+	cached.view = static_cast<WGPUTextureView>(textureView);
+	cached.generation = generation;
 	return bindGroup;
 }
 
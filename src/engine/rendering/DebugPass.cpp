@@ -1,4 +1,5 @@
 #include "engine/rendering/DebugPass.h"
+#include "engine/core/Profiler.h"
 
 #include <spdlog/spdlog.h>
 
@@ -70,6 +71,7 @@ void DebugPass::setRenderPassContext(const std::shared_ptr<webgpu::WebGPURenderP
 
 void DebugPass::render(FrameCache &frameCache)
 {
+	ENGINE_PROFILE_SCOPE("DebugPass::render");
 	if (!m_debugCollector || m_debugCollector->isEmpty() || !m_renderPassContext)
 	{
 		return;
@@ -110,11 +112,13 @@ void DebugPass::render(FrameCache &frameCache)
 
 		// Use BindGroupBinder to bind frame and debug bind groups
 		BindGroupBinder binder(&frameCache);
+		BindGroupSet bindGroups;
+		bindGroups.set(BindGroupType::Debug, m_debugBindGroup);
 		binder.bind(
 			renderPass,
 			pipeline,
 			m_cameraId,
-			{{BindGroupType::Debug, m_debugBindGroup}}
+			bindGroups
 		);
 
 		constexpr uint32_t maxVertexCount = 32;
@@ -0,0 +1,148 @@
+#include "engine/rendering/DepthPrepass.h"
+#include "engine/core/Profiler.h"
+
+#include <spdlog/spdlog.h>
+
+#include "engine/rendering/BindGroupBinder.h"
+#include "engine/rendering/FrameCache.h"
+#include "engine/rendering/RenderItemGPU.h"
+#include "engine/rendering/ShadowUniforms.h"
+#include "engine/rendering/webgpu/WebGPUBindGroupFactory.h"
+#include "engine/rendering/webgpu/WebGPUContext.h"
+#include "engine/rendering/webgpu/WebGPUMaterial.h"
+#include "engine/rendering/webgpu/WebGPUMesh.h"
+#include "engine/rendering/webgpu/WebGPUPipelineManager.h"
+#include "engine/rendering/webgpu/WebGPURenderPassContext.h"
+
+namespace engine::rendering
+{
+
+DepthPrepass::DepthPrepass(std::shared_ptr<webgpu::WebGPUContext> context) : RenderPass(context) {}
+
+bool DepthPrepass::initialize()
+{
+	spdlog::info("Initializing DepthPrepass");
+
+	auto shader = m_context->shaderRegistry().getShader(shader::defaults::SHADOW_PASS_2D);
+	if (!shader || !shader->isValid())
+	{
+		spdlog::error("Depth-only shader not found or invalid");
+		return false;
+	}
+
+	auto layout = shader->getBindGroupLayout(bindgroup::defaults::SHADOW_PASS_2D);
+	if (!layout)
+	{
+		spdlog::error("Failed to get depth pre-pass bind group layout");
+		return false;
+	}
+
+	m_passBindGroup = m_context->bindGroupFactory().createBindGroup(layout, {}, nullptr, "Depth Prepass");
+	if (!m_passBindGroup)
+	{
+		spdlog::error("Failed to create depth pre-pass bind group");
+		return false;
+	}
+
+	spdlog::info("DepthPrepass initialized successfully");
+	return true;
+}
+
+bool DepthPrepass::isEligible(const webgpu::WebGPUMaterial &material)
+{
+	return material.getPipelineState().depthPrepassEligible;
+}
+
+void DepthPrepass::render(FrameCache &frameCache)
+{
+	ENGINE_PROFILE_SCOPE("DepthPrepass::render");
+	m_lastDrawCount = 0;
+	if (!m_renderPassContext || !m_renderPassContext->getDepthTexture())
+	{
+		spdlog::error("DepthPrepass::render() called without a depth render pass context");
+		return;
+	}
+
+	ShadowPass2DUniforms uniforms{m_viewProjection, m_cameraPosition, m_farPlane};
+	m_passBindGroup->updateBuffer(0, &uniforms, sizeof(uniforms), 0, m_context->getQueue());
+
+	const auto depthFormat = m_renderPassContext->getDepthTexture()->getFormat();
+	auto encoder = m_context->createCommandEncoder("DepthPrepass Encoder");
+	wgpu::RenderPassEncoder pass = m_renderPassContext->begin(encoder);
+	{
+		BindGroupBinder binder(&frameCache);
+		BindGroupSet bindGroups;
+		bindGroups.set(BindGroupType::ShadowPass2D, m_passBindGroup);
+
+		std::shared_ptr<webgpu::WebGPUPipeline> pipeline;
+		const webgpu::WebGPUMesh *mesh = nullptr;
+		wgpu::CullMode cullMode = wgpu::CullMode::Undefined;
+
+		const auto &gpuItems = frameCache.gpuRenderItems;
+		for (size_t index : m_visibleIndices)
+		{
+			if (index >= gpuItems.size() || !gpuItems[index].has_value())
+				continue;
+
+			const auto &item = gpuItems[index].value();
+			if (!item.gpuMesh || !item.gpuMaterial || !item.objectBindGroup || !isEligible(*item.gpuMaterial))
+				continue;
+
+			const auto itemCullMode = item.gpuMaterial->getPipelineState().cullMode;
+			if (item.gpuMesh != mesh || itemCullMode != cullMode)
+			{
+				pipeline = getOrCreatePipeline(item.gpuMesh->getTopology(), itemCullMode, depthFormat);
+				if (!pipeline || !pipeline->isValid())
+				{
+					mesh = nullptr;
+					continue;
+				}
+
+				pass.setPipeline(pipeline->getPipeline());
+				if (item.gpuMesh != mesh)
+					item.gpuMesh->bindBuffers(pass, pipeline->getVertexLayout());
+				mesh = item.gpuMesh;
+				cullMode = itemCullMode;
+			}
+
+			bindGroups.set(BindGroupType::Object, item.objectBindGroup);
+			binder.bind(pass, pipeline, 0, bindGroups);
+
+			item.gpuMesh->isIndexed()
+				? pass.drawIndexed(item.submesh.indexCount, 1, item.submesh.indexOffset, 0, 0)
+				: pass.draw(item.submesh.indexCount, 1, item.submesh.indexOffset, 0);
+			m_lastDrawCount++;
+		}
+	}
+	m_renderPassContext->end(pass);
+
+	m_context->submitCommandEncoder(encoder, "DepthPrepass Commands");
+}
+
+std::shared_ptr<webgpu::WebGPUPipeline> DepthPrepass::getOrCreatePipeline(
+	Topology::Type topology,
+	wgpu::CullMode cullMode,
+	wgpu::TextureFormat depthFormat
+)
+{
+	auto shader = m_context->shaderRegistry().getShader(shader::defaults::SHADOW_PASS_2D);
+	if (!shader || !shader->isValid())
+		return nullptr;
+
+	return m_context->pipelineManager().getOrCreatePipeline(
+		shader,
+		wgpu::TextureFormat::Undefined,
+		depthFormat,
+		topology,
+		cullMode,
+		false,
+		1
+	);
+}
+
+void DepthPrepass::cleanup()
+{
+	m_visibleIndices.clear();
+}
+
+} // namespace engine::rendering
@@ -0,0 +1,569 @@
+#include "engine/rendering/EnvironmentPreprocessor.h"
+#include "engine/core/Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+
+#include <spdlog/spdlog.h>
+
+#include "engine/core/Hash.h"
+#include "engine/core/Parallel.h"
+#include "engine/math/HalfFloat.h"
+#include "engine/resources/BlockCodec.h"
+#include "engine/resources/TextureManager.h"
+
+namespace engine::rendering
+{
+
+namespace
+{
+using engine::math::HalfFloat;
+using engine::resources::Image;
+
+constexpr float PI = 3.14159265358979323846f;
+constexpr uint32_t CACHE_MAGIC = 0x4c564e45; // "ENVL"
+constexpr uint32_t CACHE_VERSION = 1;		 // Bump when the preprocessing changes
+constexpr uint32_t SOURCE_MAX_WIDTH = 1024;	 // Base of the source pyramid; twice the sharpest specular level
+constexpr uint32_t SPECULAR_SAMPLES = 128;
+constexpr uint32_t BRDF_SAMPLES = 256;
+constexpr size_t PARALLEL_WORK_THRESHOLD = 1u << 16; // Samples before a pass goes wide
+
+/** @brief Float RGB equirect level. */
+struct Level
+{
+	uint32_t width = 0;
+	uint32_t height = 0;
+	std::vector<float> rgb;
+};
+
+/** @brief Run rowFn(firstRow, lastRow) over the rows, on worker threads when the work is large enough. */
+template <typename RowFn>
+void parallelRows(uint32_t height, size_t workPerRow, RowFn &&rowFn)
+{
+	core::parallelFor(height, height * workPerRow, PARALLEL_WORK_THRESHOLD, std::forward<RowFn>(rowFn));
+}
+
+/** @brief Same mapping as direction_to_equirect_uv() in the shaders. */
+glm::vec2 directionToUV(const glm::vec3 &dir)
+{
+	return {std::atan2(dir.z, dir.x) / (2.0f * PI) + 0.5f, std::acos(std::clamp(dir.y, -1.0f, 1.0f)) / PI};
+}
+
+glm::vec3 uvToDirection(float u, float v)
+{
+	const float phi = (u - 0.5f) * 2.0f * PI;
+	const float theta = v * PI;
+	const float sinTheta = std::sin(theta);
+	return {std::cos(phi) * sinTheta, std::cos(theta), std::sin(phi) * sinTheta};
+}
+
+/**
+ * @brief Linear RGB floats of the source, box-filtered to at most SOURCE_MAX_WIDTH while converting.
+ *
+ * LDR data is taken as linear, like the shaders sample it. Only a row of the full-size source is
+ * expanded to floats at a time, so large maps never exist as a whole in float. Block-compressed
+ * maps decode the first mip level that fits instead of level 0.
+ */
+std::optional<Level> loadSourceBase(const Image &image)
+{
+	if (image.isEmpty())
+		return std::nullopt;
+
+	uint32_t width = image.getWidth();
+	uint32_t height = image.getHeight();
+	const uint32_t channels = image.getChannelCount();
+	const uint8_t *ldr = nullptr;
+	const uint16_t *hdr = nullptr;
+	std::optional<std::vector<uint8_t>> decoded;
+	if (image.isCompressed())
+	{
+		uint32_t mip = 0;
+		while (mip + 1 < image.getMipLevelCount() && (width >> mip) > SOURCE_MAX_WIDTH)
+			++mip;
+		width = std::max(1u, width >> mip);
+		height = std::max(1u, height >> mip);
+		decoded = engine::resources::BlockCodec::decode(image.getBlockCompression(), image.getCompressedLevel(mip), width, height);
+		if (!decoded)
+			return std::nullopt;
+		ldr = decoded->data();
+	}
+	else if (image.isHDR())
+	{
+		hdr = image.getPixels16F().data();
+	}
+	else
+	{
+		ldr = image.getPixels8().data();
+	}
+
+	// Power-of-two box filter, same footprint as repeated 2x2 downsampling
+	uint32_t factor = 1;
+	while (width / factor > SOURCE_MAX_WIDTH && height / factor > 1)
+		factor *= 2;
+
+	Level level{std::max(1u, width / factor), std::max(1u, height / factor), {}};
+	level.rgb.resize(static_cast<size_t>(level.width) * level.height * 3);
+	const float scale = 1.0f / static_cast<float>(factor * factor);
+	parallelRows(level.height, static_cast<size_t>(width) * factor, [&](uint32_t firstRow, uint32_t lastRow)
+	{
+		std::vector<float> row(static_cast<size_t>(width) * channels);
+		for (uint32_t y = firstRow; y < lastRow; ++y)
+		{
+			float *dst = &level.rgb[static_cast<size_t>(y) * level.width * 3];
+			std::fill(dst, dst + static_cast<size_t>(level.width) * 3, 0.0f);
+			for (uint32_t sy = 0; sy < factor; ++sy)
+			{
+				const size_t srcOffset = static_cast<size_t>(std::min(y * factor + sy, height - 1)) * width * channels;
+				if (hdr)
+				{
+					HalfFloat::toFloat(hdr + srcOffset, row.data(), row.size());
+				}
+				else
+				{
+					for (size_t i = 0; i < row.size(); ++i)
+						row[i] = ldr[srcOffset + i] * (1.0f / 255.0f);
+				}
+
+				for (uint32_t x = 0; x < level.width; ++x)
+				{
+					for (uint32_t sx = 0; sx < factor; ++sx)
+					{
+						const float *p = &row[static_cast<size_t>(std::min(x * factor + sx, width - 1)) * channels];
+						dst[x * 3 + 0] += p[0];
+						dst[x * 3 + 1] += channels > 1 ? p[1] : p[0];
+						dst[x * 3 + 2] += channels > 2 ? p[2] : (channels == 1 ? p[0] : 0.0f);
+					}
+				}
+			}
+			for (size_t i = 0; i < static_cast<size_t>(level.width) * 3; ++i)
+				dst[i] *= scale;
+		}
+	});
+	return level;
+}
+
+/** @brief 2x2 box-filtered half-size level. */
+Level downsample(const Level &src)
+{
+	Level dst{std::max(1u, src.width / 2), std::max(1u, src.height / 2), {}};
+	dst.rgb.resize(static_cast<size_t>(dst.width) * dst.height * 3);
+	parallelRows(dst.height, dst.width * 4, [&](uint32_t firstRow, uint32_t lastRow)
+	{
+		for (uint32_t y = firstRow; y < lastRow; ++y)
+		{
+			const uint32_t y0 = std::min(2 * y, src.height - 1);
+			const uint32_t y1 = std::min(2 * y + 1, src.height - 1);
+			for (uint32_t x = 0; x < dst.width; ++x)
+			{
+				const uint32_t x0 = std::min(2 * x, src.width - 1);
+				const uint32_t x1 = std::min(2 * x + 1, src.width - 1);
+				for (uint32_t c = 0; c < 3; ++c)
+				{
+					const float sum = src.rgb[(static_cast<size_t>(y0) * src.width + x0) * 3 + c]
+									  + src.rgb[(static_cast<size_t>(y0) * src.width + x1) * 3 + c]
+									  + src.rgb[(static_cast<size_t>(y1) * src.width + x0) * 3 + c]
+									  + src.rgb[(static_cast<size_t>(y1) * src.width + x1) * 3 + c];
+					dst.rgb[(static_cast<size_t>(y) * dst.width + x) * 3 + c] = sum * 0.25f;
+				}
+			}
+		}
+	});
+	return dst;
+}
+
+/** @brief Bilinear sample, wrapping horizontally and clamping vertically. */
+glm::vec3 sampleBilinear(const Level &level, const glm::vec2 &uv)
+{
+	const float fx = uv.x * level.width - 0.5f;
+	const float fy = std::clamp(uv.y * level.height - 0.5f, 0.0f, static_cast<float>(level.height - 1));
+	const float x0f = std::floor(fx);
+	const float y0f = std::floor(fy);
+	const float tx = fx - x0f;
+	const float ty = fy - y0f;
+
+	const auto wrap = [&](int x)
+	{
+		const int w = static_cast<int>(level.width);
+		return static_cast<uint32_t>(((x % w) + w) % w);
+	};
+	const uint32_t x0 = wrap(static_cast<int>(x0f));
+	const uint32_t x1 = wrap(static_cast<int>(x0f) + 1);
+	const uint32_t y0 = static_cast<uint32_t>(y0f);
+	const uint32_t y1 = std::min(y0 + 1, level.height - 1);
+
+	const auto texel = [&](uint32_t x, uint32_t y)
+	{
+		const float *p = &level.rgb[(static_cast<size_t>(y) * level.width + x) * 3];
+		return glm::vec3(p[0], p[1], p[2]);
+	};
+	return glm::mix(
+		glm::mix(texel(x0, y0), texel(x1, y0), tx),
+		glm::mix(texel(x0, y1), texel(x1, y1), tx),
+		ty
+	);
+}
+
+/** @brief Trilinear sample of the source pyramid in a direction. */
+glm::vec3 samplePyramid(const std::vector<Level> &pyramid, const glm::vec3 &dir, float lod)
+{
+	const glm::vec2 uv = directionToUV(dir);
+	lod = std::clamp(lod, 0.0f, static_cast<float>(pyramid.size() - 1));
+	const uint32_t level0 = static_cast<uint32_t>(lod);
+	const uint32_t level1 = std::min(level0 + 1, static_cast<uint32_t>(pyramid.size() - 1));
+	const glm::vec3 a = sampleBilinear(pyramid[level0], uv);
+	if (level1 == level0)
+		return a;
+	return glm::mix(a, sampleBilinear(pyramid[level1], uv), lod - level0);
+}
+
+glm::vec2 hammersley(uint32_t i, uint32_t count)
+{
+	uint32_t bits = i;
+	bits = (bits << 16u) | (bits >> 16u);
+	bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+	bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+	bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+	bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+	return {static_cast<float>(i) / count, static_cast<float>(bits) * 2.3283064365386963e-10f};
+}
+
+/** @brief GGX-distributed half vector around +Z. */
+glm::vec3 importanceSampleGGX(const glm::vec2 &xi, float roughness)
+{
+	const float a = roughness * roughness;
+	const float phi = 2.0f * PI * xi.x;
+	const float cosTheta = std::sqrt((1.0f - xi.y) / (1.0f + (a * a - 1.0f) * xi.y));
+	const float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+	return {sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta};
+}
+
+/**
+ * @brief L2 SH of the irradiance over pi.
+ *
+ * Basis order: 1, y, z, x, xy, yz, 3z^2-1, xz, x^2-y^2. The returned coefficients include the
+ * basis normalization twice (projection and reconstruction) and the cosine lobe convolution
+ * divided by pi (1, 2/3, 1/4 per band), so the shader only evaluates the polynomials.
+ */
+std::array<glm::vec4, 9> projectIrradianceSH(const Level &level)
+{
+	constexpr float norm[9] = {0.282095f, 0.488603f, 0.488603f, 0.488603f, 1.092548f, 1.092548f, 0.315392f, 1.092548f, 0.546274f};
+	constexpr float band[9] = {1.0f, 2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f, 0.25f, 0.25f, 0.25f, 0.25f, 0.25f};
+
+	// Longitude terms are the same for every row
+	std::vector<float> cosPhi(level.width);
+	std::vector<float> sinPhi(level.width);
+	for (uint32_t x = 0; x < level.width; ++x)
+	{
+		const float phi = ((x + 0.5f) / level.width - 0.5f) * 2.0f * PI;
+		cosPhi[x] = std::cos(phi);
+		sinPhi[x] = std::sin(phi);
+	}
+
+	std::mutex mutex;
+	std::array<glm::dvec3, 9> total{};
+	const float texelArea = (2.0f * PI / level.width) * (PI / level.height);
+	parallelRows(level.height, level.width, [&](uint32_t firstRow, uint32_t lastRow)
+	{
+		std::array<glm::dvec3, 9> partial{};
+		for (uint32_t y = firstRow; y < lastRow; ++y)
+		{
+			const float theta = (y + 0.5f) / level.height * PI;
+			const float sinTheta = std::sin(theta);
+			const float dirY = std::cos(theta);
+			const float solidAngle = texelArea * sinTheta;
+
+			std::array<glm::vec3, 9> row{};
+			const float *rgb = &level.rgb[static_cast<size_t>(y) * level.width * 3];
+			for (uint32_t x = 0; x < level.width; ++x)
+			{
+				const float dirX = cosPhi[x] * sinTheta;
+				const float dirZ = sinPhi[x] * sinTheta;
+				const glm::vec3 c(rgb[x * 3 + 0], rgb[x * 3 + 1], rgb[x * 3 + 2]);
+				row[0] += c;
+				row[1] += c * dirY;
+				row[2] += c * dirZ;
+				row[3] += c * dirX;
+				row[4] += c * (dirX * dirY);
+				row[5] += c * (dirY * dirZ);
+				row[6] += c * (3.0f * dirZ * dirZ - 1.0f);
+				row[7] += c * (dirX * dirZ);
+				row[8] += c * (dirX * dirX - dirY * dirY);
+			}
+			for (size_t i = 0; i < 9; ++i)
+				partial[i] += glm::dvec3(row[i]) * static_cast<double>(solidAngle);
+		}
+
+		std::lock_guard lock(mutex);
+		for (size_t i = 0; i < 9; ++i)
+			total[i] += partial[i];
+	});
+
+	std::array<glm::vec4, 9> coefficients{};
+	for (size_t i = 0; i < 9; ++i)
+		coefficients[i] = glm::vec4(glm::vec3(total[i]) * (norm[i] * norm[i] * band[i]), 0.0f);
+	return coefficients;
+}
+
+/** @brief One level of the specular chain, RGBA16F. */
+std::vector<uint16_t> prefilterSpecular(const std::vector<Level> &pyramid, uint32_t mipLevel)
+{
+	const uint32_t width = std::max(1u, EnvironmentPreprocessor::SPECULAR_WIDTH >> mipLevel);
+	const uint32_t height = std::max(1u, width / 2);
+	const float roughness = static_cast<float>(mipLevel) / (EnvironmentPreprocessor::SPECULAR_MIP_COUNT - 1);
+	const Level &base = pyramid.front();
+
+	// With N = V the tangent-space samples are the same for every texel; the source lod comes
+	// from the ratio of the sample's solid angle to a source texel's (filtered importance sampling)
+	struct Sample
+	{
+		glm::vec3 direction;
+		float weight;
+		float lod;
+	};
+	std::vector<Sample> samples;
+	const float texelSolidAngle = 4.0f * PI / (static_cast<float>(base.width) * base.height);
+	if (mipLevel == 0)
+	{
+		samples.push_back({glm::vec3(0.0f, 0.0f, 1.0f), 1.0f, std::max(0.0f, std::log2(static_cast<float>(base.width) / width))});
+	}
+	else
+	{
+		const float a2 = std::pow(roughness, 4.0f);
+		for (uint32_t i = 0; i < SPECULAR_SAMPLES; ++i)
+		{
+			const glm::vec3 h = importanceSampleGGX(hammersley(i, SPECULAR_SAMPLES), roughness);
+			const glm::vec3 l(2.0f * h.z * h.x, 2.0f * h.z * h.y, 2.0f * h.z * h.z - 1.0f);
+			if (l.z <= 0.0f)
+				continue;
+			const float d = (h.z * h.z * (a2 - 1.0f) + 1.0f);
+			const float pdf = a2 / (PI * d * d) * 0.25f; // D * NdotH / (4 * VdotH), NdotH == VdotH
+			const float sampleSolidAngle = 1.0f / (SPECULAR_SAMPLES * pdf + 1e-6f);
+			samples.push_back({l, l.z, std::max(0.0f, 0.5f * std::log2(sampleSolidAngle / texelSolidAngle) + 1.0f)});
+		}
+	}
+
+	std::vector<uint16_t> halves(static_cast<size_t>(width) * height * 4);
+	parallelRows(height, static_cast<size_t>(width) * samples.size(), [&](uint32_t firstRow, uint32_t lastRow)
+	{
+		std::vector<float> row(static_cast<size_t>(width) * 3);
+		for (uint32_t y = firstRow; y < lastRow; ++y)
+		{
+			for (uint32_t x = 0; x < width; ++x)
+			{
+				const glm::vec3 n = uvToDirection((x + 0.5f) / width, (y + 0.5f) / height);
+				const glm::vec3 up = std::abs(n.y) < 0.999f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+				const glm::vec3 t = glm::normalize(glm::cross(up, n));
+				const glm::vec3 b = glm::cross(n, t);
+
+				glm::vec3 color(0.0f);
+				float weight = 0.0f;
+				for (const auto &sample : samples)
+				{
+					const glm::vec3 l = t * sample.direction.x + b * sample.direction.y + n * sample.direction.z;
+					color += samplePyramid(pyramid, l, sample.lod) * sample.weight;
+					weight += sample.weight;
+				}
+				color /= std::max(weight, 1e-6f);
+				row[x * 3 + 0] = color.r;
+				row[x * 3 + 1] = color.g;
+				row[x * 3 + 2] = color.b;
+			}
+			HalfFloat::fromFloatRGBToRGBA(row.data(), &halves[static_cast<size_t>(y) * width * 4], width);
+		}
+	});
+	return halves;
+}
+
+std::vector<uint16_t> computeBRDFLut()
+{
+	constexpr uint32_t size = EnvironmentPreprocessor::BRDF_LUT_SIZE;
+	std::vector<float> texels(static_cast<size_t>(size) * size * 2);
+	parallelRows(size, static_cast<size_t>(size) * BRDF_SAMPLES, [&](uint32_t firstRow, uint32_t lastRow)
+	{
+		for (uint32_t y = firstRow; y < lastRow; ++y)
+		{
+			const float roughness = (y + 0.5f) / size;
+			const float k = roughness * roughness * 0.5f; // Schlick-GGX k for image-based lighting
+			for (uint32_t x = 0; x < size; ++x)
+			{
+				const float nDotV = (x + 0.5f) / size;
+				const glm::vec3 v(std::sqrt(1.0f - nDotV * nDotV), 0.0f, nDotV);
+				float scale = 0.0f;
+				float bias = 0.0f;
+				for (uint32_t i = 0; i < BRDF_SAMPLES; ++i)
+				{
+					const glm::vec3 h = importanceSampleGGX(hammersley(i, BRDF_SAMPLES), roughness);
+					const float vDotH = glm::dot(v, h);
+					const glm::vec3 l = 2.0f * vDotH * h - v;
+					const float nDotL = l.z;
+					if (nDotL <= 0.0f)
+						continue;
+					const float g = (nDotV / (nDotV * (1.0f - k) + k)) * (nDotL / (nDotL * (1.0f - k) + k));
+					const float gVis = g * std::max(vDotH, 0.0f) / (std::max(h.z, 1e-6f) * nDotV);
+					const float fc = std::pow(1.0f - std::max(vDotH, 0.0f), 5.0f);
+					scale += (1.0f - fc) * gVis;
+					bias += fc * gVis;
+				}
+				texels[(static_cast<size_t>(y) * size + x) * 2 + 0] = scale / BRDF_SAMPLES;
+				texels[(static_cast<size_t>(y) * size + x) * 2 + 1] = bias / BRDF_SAMPLES;
+			}
+		}
+	});
+
+	std::vector<uint16_t> halves(texels.size());
+	HalfFloat::fromFloat(texels.data(), halves.data(), texels.size());
+	return halves;
+}
+
+template <typename T>
+void writeValue(std::ofstream &file, const T &value)
+{
+	file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::ifstream &file, T &value)
+{
+	return static_cast<bool>(file.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+} // namespace
+
+std::optional<EnvironmentLighting> EnvironmentPreprocessor::process(
+	const engine::resources::Image &environment,
+	const std::filesystem::path &cacheDirectory
+)
+{
+	const uint64_t contentHash = core::hashCombine(
+		engine::resources::TextureManager::computeContentHash(environment),
+		CACHE_VERSION
+	);
+	const auto cachePath = cacheDirectory.empty() ? std::filesystem::path{} : getCachePath(cacheDirectory, contentHash);
+	if (!cachePath.empty())
+	{
+		if (auto cached = loadCache(cachePath, contentHash))
+		{
+			spdlog::debug("EnvironmentPreprocessor: using cached lighting {}", cachePath.string());
+			return cached;
+		}
+	}
+
+	auto lighting = compute(environment);
+	if (!lighting)
+		return std::nullopt;
+	lighting->contentHash = contentHash;
+
+	if (!cachePath.empty() && !saveCache(cachePath, *lighting))
+		spdlog::warn("EnvironmentPreprocessor: could not write cache file {}", cachePath.string());
+	return lighting;
+}
+
+std::optional<EnvironmentLighting> EnvironmentPreprocessor::compute(const engine::resources::Image &environment)
+{
+	ENGINE_PROFILE_SCOPE("EnvironmentPreprocessor::compute");
+	auto source = loadSourceBase(environment);
+	if (!source)
+	{
+		spdlog::error("EnvironmentPreprocessor: unsupported environment image");
+		return std::nullopt;
+	}
+
+	EnvironmentLighting lighting;
+	lighting.irradianceSH = projectIrradianceSH(*source);
+
+	// Box-filtered source pyramid, starting at most SOURCE_MAX_WIDTH wide
+	std::vector<Level> pyramid;
+	pyramid.push_back(std::move(*source));
+	while (pyramid.back().width > 1 && pyramid.back().height > 1)
+		pyramid.push_back(downsample(pyramid.back()));
+
+	lighting.specularMips.reserve(SPECULAR_MIP_COUNT);
+	for (uint32_t level = 0; level < SPECULAR_MIP_COUNT; ++level)
+		lighting.specularMips.push_back(prefilterSpecular(pyramid, level));
+
+	spdlog::info(
+		"EnvironmentPreprocessor: {}x{} environment processed ({} specular levels)",
+		environment.getWidth(),
+		environment.getHeight(),
+		SPECULAR_MIP_COUNT
+	);
+	return lighting;
+}
+
+const std::vector<uint16_t> &EnvironmentPreprocessor::getBRDFLut()
+{
+	static const std::vector<uint16_t> lut = computeBRDFLut();
+	return lut;
+}
+
+std::filesystem::path EnvironmentPreprocessor::getCachePath(const std::filesystem::path &cacheDirectory, uint64_t contentHash)
+{
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx.envl", static_cast<unsigned long long>(contentHash));
+	return cacheDirectory / name;
+}
+
+std::optional<EnvironmentLighting> EnvironmentPreprocessor::loadCache(const std::filesystem::path &path, uint64_t contentHash)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return std::nullopt;
+
+	uint32_t magic = 0, version = 0, width = 0, mipCount = 0;
+	uint64_t hash = 0;
+	if (!readValue(file, magic) || !readValue(file, version) || !readValue(file, hash) || !readValue(file, width)
+		|| !readValue(file, mipCount))
+		return std::nullopt;
+	if (magic != CACHE_MAGIC || version != CACHE_VERSION || hash != contentHash || width != SPECULAR_WIDTH
+		|| mipCount != SPECULAR_MIP_COUNT)
+	{
+		spdlog::warn("EnvironmentPreprocessor: ignoring stale cache file {}", path.string());
+		return std::nullopt;
+	}
+
+	EnvironmentLighting lighting;
+	lighting.contentHash = hash;
+	if (!file.read(reinterpret_cast<char *>(lighting.irradianceSH.data()), sizeof(lighting.irradianceSH)))
+		return std::nullopt;
+	for (uint32_t level = 0; level < mipCount; ++level)
+	{
+		const uint32_t levelWidth = std::max(1u, width >> level);
+		const uint32_t levelHeight = std::max(1u, levelWidth / 2);
+		std::vector<uint16_t> halves(static_cast<size_t>(levelWidth) * levelHeight * 4);
+		if (!file.read(reinterpret_cast<char *>(halves.data()), static_cast<std::streamsize>(halves.size() * sizeof(uint16_t))))
+			return std::nullopt;
+		lighting.specularMips.push_back(std::move(halves));
+	}
+	return lighting;
+}
+
+bool EnvironmentPreprocessor::saveCache(const std::filesystem::path &path, const EnvironmentLighting &lighting)
+{
+	std::error_code ec;
+	std::filesystem::create_directories(path.parent_path(), ec);
+
+	// Written next to the target and renamed, so a reader never sees a partial file
+	auto tempPath = path;
+	tempPath += ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file)
+			return false;
+		writeValue(file, CACHE_MAGIC);
+		writeValue(file, CACHE_VERSION);
+		writeValue(file, lighting.contentHash);
+		writeValue(file, SPECULAR_WIDTH);
+		writeValue(file, static_cast<uint32_t>(lighting.specularMips.size()));
+		file.write(reinterpret_cast<const char *>(lighting.irradianceSH.data()), sizeof(lighting.irradianceSH));
+		for (const auto &level : lighting.specularMips)
+			file.write(reinterpret_cast<const char *>(level.data()), static_cast<std::streamsize>(level.size() * sizeof(uint16_t)));
+		if (!file)
+			return false;
+	}
+	std::filesystem::rename(tempPath, path, ec);
+	return !ec;
+}
+
+} // namespace engine::rendering
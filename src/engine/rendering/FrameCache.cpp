@@ -1,4 +1,5 @@
 #include "engine/rendering/FrameCache.h"
+#include "engine/core/Profiler.h"
 
 #include <spdlog/spdlog.h>
 
@@ -25,12 +26,13 @@ bool FrameCache::processBindGroupProviders(
 	const std::vector<BindGroupDataProvider> &providers
 )
 {
+	ENGINE_PROFILE_SCOPE("FrameCache::processBindGroupProviders");
 	bool allSuccessful = true;
 
 	for (const auto &provider : providers)
 	{
 		// Create cache key using static helper method
-		std::string cacheKey = createCustomBindGroupCacheKey(
+		const uint64_t cacheKey = createCustomBindGroupCacheKey(
 			provider.shaderName,
 			provider.bindGroupName,
 			provider.instanceId
@@ -146,7 +148,7 @@ bool FrameCache::processBindGroupProviders(
 		// Cache bind group for future use
 		customBindGroupCache[cacheKey] = bindGroup;
 		spdlog::debug(
-			"Created custom bind group '{}' for shader '{}' (cached as '{}')",
+			"Created custom bind group '{}' for shader '{}' (cached as {:#018x})",
 			provider.bindGroupName,
 			provider.shaderName,
 			cacheKey
@@ -162,6 +164,7 @@ bool FrameCache::prepareGPUResources(
 	const std::vector<size_t> &indicesToPrepare
 )
 {
+	ENGINE_PROFILE_SCOPE("FrameCache::prepareGPUResources");
 	// Make sure the FrameCache GPU item cache matches CPU items
 	if (gpuRenderItems.size() != collector.getRenderItems().size())
 		gpuRenderItems.resize(collector.getRenderItems().size());
@@ -201,6 +204,7 @@ bool FrameCache::prepareGPUResources(
 		}
 
 		gpuMesh->syncIfNeeded();
+		context->residencyManager().markUsed(*gpuMesh);
 
 		// Get GPU material
 		auto materialHandle = cpuItem.submesh.material;
@@ -212,6 +216,7 @@ bool FrameCache::prepareGPUResources(
 		}
 
 		gpuMaterial->syncIfNeeded();
+		context->residencyManager().markUsed(*gpuMaterial);
 
 		// Get or create object bind group
 		std::shared_ptr<webgpu::WebGPUBindGroup> objectBindGroup;
@@ -246,10 +251,14 @@ bool FrameCache::prepareGPUResources(
 		gpuItem.worldTransform = cpuItem.worldTransform;
 		gpuItem.renderLayer = cpuItem.renderLayer;
 		gpuItem.objectID = cpuItem.objectID;
+		gpuItem.isStatic = cpuItem.isStatic && !cpuItem.isTransparent;
 
 		gpuRenderItems[idx] = gpuItem;
 	}
 
+	// Textures created for new materials get their mips in one batched submit before any pass samples them
+	context->textureFactory().flushMipmaps();
+
 	spdlog::debug(
 		"Prepared GPU resources: {}/{} items",
 		std::count_if(gpuRenderItems.begin(), gpuRenderItems.end(), [](auto &i)
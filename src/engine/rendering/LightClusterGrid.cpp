@@ -0,0 +1,214 @@
+#include "engine/rendering/LightClusterGrid.h"
+#include "engine/core/Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <spdlog/spdlog.h>
+
+#include "engine/core/Parallel.h"
+#include "engine/rendering/Light.h"
+
+namespace engine::rendering
+{
+
+namespace
+{
+constexpr uint32_t GRID_X = constants::LIGHT_CLUSTER_GRID_X;
+constexpr uint32_t GRID_Y = constants::LIGHT_CLUSTER_GRID_Y;
+constexpr uint32_t GRID_Z = constants::LIGHT_CLUSTER_GRID_Z;
+
+uint32_t ndcToTile(float ndc, uint32_t tiles)
+{
+	const float t = std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(tiles));
+	return static_cast<uint32_t>(std::clamp(t, 0.0f, static_cast<float>(tiles - 1)));
+}
+} // namespace
+
+LightClusterGrid::LightClusterGrid() :
+	m_clusters(constants::LIGHT_CLUSTER_COUNT),
+	m_slices(GRID_Z)
+{
+	m_header.clusterCountX = GRID_X;
+	m_header.clusterCountY = GRID_Y;
+	m_header.clusterCountZ = GRID_Z;
+	for (auto &slice : m_slices)
+	{
+		slice.counts.resize(TILES_PER_SLICE);
+		slice.offsets.resize(TILES_PER_SLICE);
+	}
+}
+
+void LightClusterGrid::build(
+	const std::vector<LightStruct> &lights,
+	const glm::mat4 &viewMatrix,
+	const glm::mat4 &projectionMatrix,
+	float nearPlane,
+	float farPlane
+)
+{
+	ENGINE_PROFILE_SCOPE("LightClusterGrid::build");
+	m_viewMatrix = viewMatrix;
+	m_projectionMatrix = projectionMatrix;
+	m_nearPlane = std::max(nearPlane, 0.001f);
+	m_farPlane = std::max(farPlane, m_nearPlane * 1.01f);
+
+	// Exponential slices: slice = log(depth / near) / log(far / near) * Z
+	const float logRange = std::log(m_farPlane / m_nearPlane);
+	m_header.clusterDepthScale = static_cast<float>(GRID_Z) / logRange;
+	m_header.clusterDepthBias = -static_cast<float>(GRID_Z) * std::log(m_nearPlane) / logRange;
+
+	const auto lightCount = static_cast<uint32_t>(std::min<size_t>(lights.size(), constants::MAX_LIGHTS));
+	m_header.count = lightCount;
+
+	// Global lights lead the index list, local lights are bounded in cluster space
+	m_lightIndices.clear();
+	m_bounds.clear();
+	for (auto &slice : m_slices)
+		slice.bounds.clear();
+
+	for (uint32_t i = 0; i < lightCount; ++i)
+	{
+		const auto type = static_cast<Light::Type>(lights[i].light_type);
+		if (type == Light::Type::Ambient || type == Light::Type::Directional)
+		{
+			m_lightIndices.push_back(i);
+			continue;
+		}
+
+		LightBounds bounds;
+		if (!computeBounds(lights[i], i, bounds))
+			continue;
+
+		const auto boundsIndex = static_cast<uint32_t>(m_bounds.size());
+		m_bounds.push_back(bounds);
+		for (uint32_t z = bounds.minZ; z <= bounds.maxZ; ++z)
+			m_slices[z].bounds.push_back(boundsIndex);
+	}
+	m_header.globalCount = static_cast<uint32_t>(m_lightIndices.size());
+
+	// Bin every slice, spread over the shared worker pool when there are enough lights (serial otherwise)
+	engine::core::parallelFor(GRID_Z, m_bounds.size(), PARALLEL_BINNING_THRESHOLD, [this](uint32_t first, uint32_t last)
+	{
+		for (uint32_t z = first; z < last; ++z)
+			binSlice(z);
+	});
+
+	// Concatenate the slices into the final index list
+	const size_t capacity = constants::MAX_LIGHT_CLUSTER_INDICES;
+	bool overflow = false;
+	for (uint32_t z = 0; z < GRID_Z; ++z)
+	{
+		const auto &slice = m_slices[z];
+		for (uint32_t tile = 0; tile < TILES_PER_SLICE; ++tile)
+		{
+			auto &cluster = m_clusters[z * TILES_PER_SLICE + tile];
+			const uint32_t tileCount = slice.counts[tile] - slice.offsets[tile]; // counts holds the tile end after binning
+			const size_t available = capacity - std::min(capacity, m_lightIndices.size());
+			const auto written = static_cast<uint32_t>(std::min<size_t>(tileCount, available));
+			overflow |= written < tileCount;
+
+			cluster.offset = static_cast<uint32_t>(m_lightIndices.size());
+			cluster.count = written;
+			m_lightIndices.insert(
+				m_lightIndices.end(),
+				slice.indices.begin() + slice.offsets[tile],
+				slice.indices.begin() + slice.offsets[tile] + written
+			);
+		}
+	}
+
+	if (overflow && !m_overflowWarned)
+	{
+		spdlog::warn("LightClusterGrid: light index list exceeds {} entries, some lights are dropped from clusters", capacity);
+		m_overflowWarned = true;
+	}
+}
+
+bool LightClusterGrid::computeBounds(const LightStruct &light, uint32_t lightIndex, LightBounds &outBounds) const
+{
+	const float radius = light.range;
+	if (radius <= 0.0f)
+		return false;
+
+	const glm::vec3 center = glm::vec3(m_viewMatrix * glm::vec4(glm::vec3(light.transform[3]), 1.0f));
+	const float depthMin = std::max(-center.z - radius, m_nearPlane);
+	const float depthMax = std::min(-center.z + radius, m_farPlane);
+	if (depthMin > depthMax)
+		return false;
+
+	// Screen extent: project the corners of the sphere's view-space box, clipped to the depth range
+	glm::vec2 ndcMin(1.0f);
+	glm::vec2 ndcMax(-1.0f);
+	for (int corner = 0; corner < 8; ++corner)
+	{
+		const glm::vec4 viewPos(
+			center.x + ((corner & 1) ? radius : -radius),
+			center.y + ((corner & 2) ? radius : -radius),
+			(corner & 4) ? -depthMax : -depthMin,
+			1.0f
+		);
+		const glm::vec4 clip = m_projectionMatrix * viewPos;
+		if (clip.w <= 1e-6f)
+		{
+			ndcMin = glm::vec2(-1.0f);
+			ndcMax = glm::vec2(1.0f);
+			break;
+		}
+		const glm::vec2 ndc = glm::vec2(clip) / clip.w;
+		ndcMin = glm::min(ndcMin, ndc);
+		ndcMax = glm::max(ndcMax, ndc);
+	}
+
+	if (ndcMax.x < -1.0f || ndcMin.x > 1.0f || ndcMax.y < -1.0f || ndcMin.y > 1.0f)
+		return false;
+
+	outBounds.lightIndex = lightIndex;
+	outBounds.minX = ndcToTile(ndcMin.x, GRID_X);
+	outBounds.maxX = ndcToTile(ndcMax.x, GRID_X);
+	outBounds.minY = ndcToTile(ndcMin.y, GRID_Y);
+	outBounds.maxY = ndcToTile(ndcMax.y, GRID_Y);
+	outBounds.minZ = depthToSlice(depthMin);
+	outBounds.maxZ = depthToSlice(depthMax);
+	return true;
+}
+
+uint32_t LightClusterGrid::depthToSlice(float viewDepth) const
+{
+	const float slice = std::floor(std::log(viewDepth) * m_header.clusterDepthScale + m_header.clusterDepthBias);
+	return static_cast<uint32_t>(std::clamp(slice, 0.0f, static_cast<float>(GRID_Z - 1)));
+}
+
+void LightClusterGrid::binSlice(uint32_t z)
+{
+	auto &slice = m_slices[z];
+	std::fill(slice.counts.begin(), slice.counts.end(), 0u);
+
+	for (uint32_t boundsIndex : slice.bounds)
+	{
+		const auto &bounds = m_bounds[boundsIndex];
+		for (uint32_t y = bounds.minY; y <= bounds.maxY; ++y)
+			for (uint32_t x = bounds.minX; x <= bounds.maxX; ++x)
+				++slice.counts[y * GRID_X + x];
+	}
+
+	uint32_t total = 0;
+	for (uint32_t tile = 0; tile < TILES_PER_SLICE; ++tile)
+	{
+		slice.offsets[tile] = total;
+		total += slice.counts[tile];
+		slice.counts[tile] = slice.offsets[tile];
+	}
+	slice.indices.resize(total);
+
+	// Lights stay in submission order within each tile
+	for (uint32_t boundsIndex : slice.bounds)
+	{
+		const auto &bounds = m_bounds[boundsIndex];
+		for (uint32_t y = bounds.minY; y <= bounds.maxY; ++y)
+			for (uint32_t x = bounds.minX; x <= bounds.maxX; ++x)
+				slice.indices[slice.counts[y * GRID_X + x]++] = bounds.lightIndex;
+	}
+}
+
+} // namespace engine::rendering
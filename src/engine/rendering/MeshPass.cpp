@@ -1,8 +1,10 @@
 #include "engine/rendering/MeshPass.h"
+#include "engine/core/Profiler.h"
 
 #include <spdlog/spdlog.h>
 
 #include "engine/rendering/BindGroupBinder.h"
+#include "engine/rendering/DepthPrepass.h"
 #include "engine/rendering/FrameCache.h"
 #include "engine/rendering/LightUniforms.h"
 #include "engine/rendering/Material.h"
@@ -24,7 +26,8 @@ namespace engine::rendering
 {
 
 MeshPass::MeshPass(std::shared_ptr<webgpu::WebGPUContext> context) :
-	RenderPass(context)
+	RenderPass(context),
+	m_staticDrawCache(context)
 {
 }
 
@@ -52,6 +55,7 @@ bool MeshPass::initialize()
 
 void MeshPass::render(FrameCache &frameCache)
 {
+	ENGINE_PROFILE_SCOPE("MeshPass::render");
 	if (!m_renderPassContext)
 	{
 		spdlog::error("MeshPass::render() called without setting render pass context");
@@ -68,8 +72,23 @@ void MeshPass::render(FrameCache &frameCache)
 	// Begin render pass using context's begin() method
 	wgpu::RenderPassEncoder renderPass = m_renderPassContext->begin(encoder);
 	{
-		// Draw items from frame cache
-		drawItems(renderPass, frameCache, frameCache.gpuRenderItems, m_visibleIndices);
+		if (m_staticDrawCacheEnabled)
+		{
+			// Static items first: executing a render bundle resets the pass state
+			BindGroupSet passGroups;
+			passGroups.set(BindGroupType::Light, m_lightBindGroup)
+				.set(BindGroupType::Shadow, m_shadowBindGroup)
+				.set(BindGroupType::Environment, m_environmentBindGroup);
+			m_staticDrawCache.draw(renderPass, frameCache, m_renderPassContext, m_cameraId, passGroups, m_visibleIndices, m_dynamicIndices, m_depthPrepassed);
+
+			// Draw the remaining items from frame cache
+			drawItems(renderPass, frameCache, frameCache.gpuRenderItems, m_dynamicIndices);
+		}
+		else
+		{
+			// Draw items from frame cache
+			drawItems(renderPass, frameCache, frameCache.gpuRenderItems, m_visibleIndices);
+		}
 	}
 	m_renderPassContext->end(renderPass);
 
@@ -78,18 +97,34 @@ void MeshPass::render(FrameCache &frameCache)
 
 bool MeshPass::updateLightUniforms(FrameCache &frameCache)
 {
+	ENGINE_PROFILE_SCOPE("MeshPass::updateLightUniforms");
 	const auto &lights = frameCache.lightUniforms;
-	// Always write the header, even if there are no lights (count = 0)
-	LightsBuffer header;
-	header.count = static_cast<uint32_t>(lights.size());
+	if (lights.size() > constants::MAX_LIGHTS && !m_lightLimitWarned)
+	{
+		spdlog::warn("MeshPass: {} lights submitted, only the first {} are rendered", lights.size(), constants::MAX_LIGHTS);
+		m_lightLimitWarned = true;
+	}
+
+	// Bin lights into the camera's clusters; the fragment shader only iterates its cluster's list
+	m_lightClusters.build(lights, m_viewMatrix, m_projectionMatrix, m_nearPlane, m_farPlane);
+	const auto &header = m_lightClusters.getHeader();
+	const auto &clusters = m_lightClusters.getClusters();
+	const auto &lightIndices = m_lightClusters.getLightIndices();
+	auto queue = m_context->getQueue();
 
-	// Write header to the global lights buffer at offset 0
-	m_lightBindGroup->updateBuffer(0, &header, sizeof(LightsBuffer), 0, m_context->getQueue());
+	// Always write the header, even if there are no lights (count = 0)
+	m_lightBindGroup->updateBuffer(0, &header, sizeof(LightsBuffer), 0, queue);
 
 	// Write light data if any lights exist at offset sizeof(LightsBuffer)
-	if (!lights.empty())
+	if (header.count > 0)
 	{
-		m_lightBindGroup->updateBuffer(0, lights.data(), lights.size() * sizeof(LightStruct), sizeof(LightsBuffer), m_context->getQueue());
+		m_lightBindGroup->updateBuffer(0, lights.data(), header.count * sizeof(LightStruct), sizeof(LightsBuffer), queue);
+	}
+
+	m_lightBindGroup->updateBuffer(1, clusters.data(), clusters.size() * sizeof(LightCluster), 0, queue);
+	if (!lightIndices.empty())
+	{
+		m_lightBindGroup->updateBuffer(2, lightIndices.data(), lightIndices.size() * sizeof(uint32_t), 0, queue);
 	}
 	return true;
 }
@@ -119,11 +154,16 @@ void MeshPass::drawItems(
 )
 {
 	std::shared_ptr<webgpu::WebGPUPipeline> currentPipeline = nullptr;
+	const webgpu::WebGPUPipeline *boundPipeline = nullptr;
 	webgpu::WebGPUMesh *currentMesh = nullptr;
 	webgpu::WebGPUMaterial *currentMaterial = nullptr;
 
-	// Create bind group binder helper
+	// Create bind group binder helper. Pass-wide groups are set once, per-item ones in the loop.
 	BindGroupBinder binder(&frameCache);
+	BindGroupSet bindGroups;
+	bindGroups.set(BindGroupType::Light, m_lightBindGroup)
+		.set(BindGroupType::Shadow, m_shadowBindGroup)
+		.set(BindGroupType::Environment, m_environmentBindGroup);
 
 	spdlog::debug("MeshPass::drawItems() - Rendering {} items", indicesToRender.size());
 
@@ -158,20 +198,12 @@ void MeshPass::drawItems(
 
 		if (pipelineChanged)
 		{
-			auto cpuMesh = item.gpuMesh->getCPUHandle().get();
-			auto cpuMaterial = item.gpuMaterial->getCPUHandle().get();
-
-			if (!cpuMesh.has_value() || !cpuMaterial.has_value())
-			{
-				spdlog::warn("Invalid CPU handles - mesh: {}, material: {}", cpuMesh.has_value(), cpuMaterial.has_value());
-				itemsSkipped++;
-				continue;
-			}
-
+			// Keyed by the state cached on the GPU objects: no handle resolution or shader name lookup
 			currentPipeline = m_context->pipelineManager().getOrCreatePipeline(
-				cpuMesh.value(),
-				cpuMaterial.value(),
-				m_renderPassContext
+				*item.gpuMesh,
+				*item.gpuMaterial,
+				m_renderPassContext,
+				m_depthPrepassed && DepthPrepass::isEligible(*item.gpuMaterial)
 			);
 
 			if (!currentPipeline || !currentPipeline->isValid())
@@ -180,7 +212,12 @@ void MeshPass::drawItems(
 				itemsSkipped++;
 				continue;
 			}
-			renderPass.setPipeline(currentPipeline->getPipeline());
+			// Materials of the same variant share pipelines: only switch when it really changed
+			if (currentPipeline.get() != boundPipeline)
+			{
+				renderPass.setPipeline(currentPipeline->getPipeline());
+				boundPipeline = currentPipeline.get();
+			}
 
 			currentMaterial = item.gpuMaterial.get();
 		}
@@ -192,15 +229,14 @@ void MeshPass::drawItems(
 			// Extract material ID from the material pointer for PerMaterial bind group tracking
 			uint64_t materialId = reinterpret_cast<uint64_t>(item.gpuMaterial.get());
 
+			bindGroups.set(BindGroupType::Object, item.objectBindGroup)
+				.set(BindGroupType::Material, item.gpuMaterial->getBindGroup());
+
 			binder.bind(
 				renderPass,
 				currentPipeline,
 				m_cameraId,
-				{{BindGroupType::Object, item.objectBindGroup},
-				 {BindGroupType::Material, item.gpuMaterial->getBindGroup()},
-				 {BindGroupType::Light, m_lightBindGroup},
-				 {BindGroupType::Shadow, m_shadowBindGroup},
-				 {BindGroupType::Environment, m_environmentBindGroup}},
+				bindGroups,
 				item.objectID, // objectId for PerObject custom bind groups
 				materialId	  // materialId for PerMaterial custom bind groups
 			);
@@ -213,10 +249,11 @@ void MeshPass::drawItems(
 			currentMesh->bindBuffers(renderPass, currentPipeline->getVertexLayout());
 		}
 
-		// Draw submesh
+		// Draw submesh; the first instance selects the material's entry in the shared material bind group
+		const uint32_t materialIndex = item.gpuMaterial->getMaterialIndex();
 		item.gpuMesh->isIndexed()
-			? renderPass.drawIndexed(item.submesh.indexCount, 1, item.submesh.indexOffset, 0, 0)
-			: renderPass.draw(item.submesh.indexCount, 1, item.submesh.indexOffset, 0);
+			? renderPass.drawIndexed(item.submesh.indexCount, 1, item.submesh.indexOffset, 0, materialIndex)
+			: renderPass.draw(item.submesh.indexCount, 1, item.submesh.indexOffset, materialIndex);
 
 		itemsRendered++;
 	}
@@ -226,6 +263,7 @@ void MeshPass::drawItems(
 
 void MeshPass::cleanup()
 {
+	m_staticDrawCache.clear();
 }
 
 } // namespace engine::rendering
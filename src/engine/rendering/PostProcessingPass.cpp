@@ -1,4 +1,5 @@
 #include "engine/rendering/PostProcessingPass.h"
+#include "engine/core/Profiler.h"
 
 #include <spdlog/spdlog.h>
 
@@ -59,6 +60,7 @@ void PostProcessingPass::recordAndSubmitCommands(
 
 void PostProcessingPass::render(FrameCache &frameCache)
 {
+	ENGINE_PROFILE_SCOPE("PostProcessingPass::render");
 	// Tutorial 04 - Step 6: Main render orchestration
 }
 
@@ -1,6 +1,8 @@
 #include "engine/rendering/RenderCollector.h"
+#include "engine/core/Profiler.h"
 
 #include <algorithm>
+#include <cmath>
 #include <glm/gtx/norm.hpp>
 
 #include "engine/rendering/Material.h"
@@ -14,7 +16,8 @@ void RenderCollector::addModel(
 	const glm::mat4 &transform,
 	uint32_t layer,
 	uint64_t objectID,
-	std::shared_ptr<engine::scene::nodes::Node> node
+	std::shared_ptr<engine::scene::nodes::Node> node,
+	bool isStatic
 )
 {
 	auto modelOpt = modelHandle.get();
@@ -46,6 +49,7 @@ void RenderCollector::addModel(
 		item.renderLayer = layer;
 		item.objectID = objectID;
 		item.renderNode = node;
+		item.isStatic = isStatic;
 
 		// Cache transparency flag for efficient sorting
 		auto matOpt = submesh.material.get();
@@ -64,8 +68,9 @@ void RenderCollector::addLight(const Light &light)
 	m_lights.push_back(light);
 }
 
-void RenderCollector::sort(const glm::vec3 &cameraPosition)
+void RenderCollector::sort(const glm::vec3 &cameraPosition, const glm::vec3 &cameraForward)
 {
+	ENGINE_PROFILE_SCOPE("RenderCollector::sort");
 	// Separate opaque and transparent items
 	std::vector<RenderItemCPU> opaqueItems;
 	std::vector<RenderItemCPU> transparentItems;
@@ -73,16 +78,25 @@ void RenderCollector::sort(const glm::vec3 &cameraPosition)
 	opaqueItems.reserve(m_renderItems.size());
 	transparentItems.reserve(m_renderItems.size() / 4); // Assume ~25% transparent
 
+	const bool hasForward = glm::length2(cameraForward) > 0.0f;
 	for (auto &item : m_renderItems)
 	{
 		if (item.isTransparent)
+		{
 			transparentItems.push_back(item);
-		else
-			opaqueItems.push_back(item);
+			continue;
+		}
+
+		// Logarithmic buckets: fine near the camera where occluders matter, coarse far away
+		const glm::vec3 toItem = item.worldBounds.center() - cameraPosition;
+		const float depth = hasForward ? glm::dot(toItem, cameraForward) : glm::length(toItem);
+		item.depthBucket = depth <= 0.0f
+							   ? 0u
+							   : static_cast<uint32_t>(std::log2(1.0f + depth) * DEPTH_BUCKETS_PER_OCTAVE);
+		opaqueItems.push_back(item);
 	}
 
-	// Sort opaque objects: layer > material > model (for batching)
-	// This naturally gives front-to-back order within material groups
+	// Sort opaque objects: layer > depth bucket (front-to-back) > material > model (for batching)
 	std::sort(
 		opaqueItems.begin(),
 		opaqueItems.end(),
@@ -128,6 +142,7 @@ void RenderCollector::clear()
 
 std::vector<size_t> RenderCollector::extractVisible(const engine::math::Frustum &frustum) const
 {
+	ENGINE_PROFILE_SCOPE("RenderCollector::extractVisible");
 	std::vector<size_t> visibleIndices;
 	visibleIndices.reserve(m_renderItems.size());
 
@@ -144,6 +159,7 @@ std::vector<size_t> RenderCollector::extractVisible(const engine::math::Frustum
 
 std::vector<size_t> RenderCollector::extractForLightFrustum(const engine::math::Frustum &lightFrustum) const
 {
+	ENGINE_PROFILE_SCOPE("RenderCollector::extractForLightFrustum");
 	std::vector<size_t> visibleIndices;
 	visibleIndices.reserve(m_renderItems.size());
 
@@ -160,6 +176,7 @@ std::vector<size_t> RenderCollector::extractForLightFrustum(const engine::math::
 
 std::vector<size_t> RenderCollector::extractForPointLight(const glm::vec3 &lightPosition, float lightRange) const
 {
+	ENGINE_PROFILE_SCOPE("RenderCollector::extractForPointLight");
 	std::vector<size_t> visibleIndices;
 	visibleIndices.reserve(m_renderItems.size());
 
@@ -174,9 +191,96 @@ std::vector<size_t> RenderCollector::extractForPointLight(const glm::vec3 &light
 	return visibleIndices;
 }
 
+void RenderCollector::extractForCascades(
+	const glm::mat4 &lightView,
+	const std::vector<engine::math::Frustum::CascadeData> &cascades,
+	float zNear,
+	float zFar,
+	std::vector<std::vector<size_t>> &outIndices
+) const
+{
+	ENGINE_PROFILE_SCOPE("RenderCollector::extractForCascades");
+	outIndices.resize(cascades.size());
+	for (auto &indices : outIndices)
+		indices.clear();
+
+	// World AABB -> light-view AABB: center transformed, extent by the absolute rotation
+	const glm::mat3 rotation(lightView);
+	const glm::mat3 absRotation(glm::abs(rotation[0]), glm::abs(rotation[1]), glm::abs(rotation[2]));
+
+	for (size_t i = 0; i < m_renderItems.size(); ++i)
+	{
+		const auto &bounds = m_renderItems[i].worldBounds;
+		const glm::vec3 center = glm::vec3(lightView * glm::vec4(bounds.center(), 1.0f));
+		const glm::vec3 extent = absRotation * bounds.extent();
+
+		// The light looks down -Z: the projections keep view z in [-zFar, -zNear]
+		if (center.z - extent.z > -zNear || center.z + extent.z < -zFar)
+			continue;
+
+		for (size_t c = 0; c < cascades.size(); ++c)
+		{
+			const auto &cascade = cascades[c];
+			if (center.x + extent.x >= cascade.boundsMin.x && center.x - extent.x <= cascade.boundsMax.x
+				&& center.y + extent.y >= cascade.boundsMin.y && center.y - extent.y <= cascade.boundsMax.y)
+			{
+				outIndices[c].push_back(i);
+			}
+		}
+	}
+}
+
+void RenderCollector::extractForPointLightFaces(
+	const glm::vec3 &lightPosition,
+	float lightRange,
+	const std::array<glm::vec3, 6> &faceDirections,
+	std::vector<size_t> &outIndices,
+	std::array<std::vector<size_t>, 6> &outFaceIndices
+) const
+{
+	ENGINE_PROFILE_SCOPE("RenderCollector::extractForPointLightFaces");
+	outIndices.clear();
+	for (auto &indices : outFaceIndices)
+		indices.clear();
+
+	// Face axis and sign from its (axis-aligned) direction
+	std::array<int, 6> faceAxis{};
+	std::array<float, 6> faceSign{};
+	for (size_t f = 0; f < faceDirections.size(); ++f)
+	{
+		const glm::vec3 d = glm::abs(faceDirections[f]);
+		faceAxis[f] = (d.x >= d.y && d.x >= d.z) ? 0 : (d.y >= d.z ? 1 : 2);
+		faceSign[f] = faceDirections[f][faceAxis[f]] < 0.0f ? -1.0f : 1.0f;
+	}
+
+	for (size_t i = 0; i < m_renderItems.size(); ++i)
+	{
+		const auto &bounds = m_renderItems[i].worldBounds;
+		if (!isAABBInSphere(bounds, lightPosition, lightRange))
+			continue;
+		outIndices.push_back(i);
+
+		// Bounds relative to the light; per axis the farthest reach and the smallest distance
+		const glm::vec3 lo = bounds.min - lightPosition;
+		const glm::vec3 hi = bounds.max - lightPosition;
+		const glm::vec3 minAbs = glm::max(glm::max(lo, -hi), glm::vec3(0.0f));
+
+		// Face pyramid: sign * p[axis] >= |p[other]|. Conservative: compare the reach along the
+		// axis with the closest approach on each other axis
+		for (size_t f = 0; f < faceDirections.size(); ++f)
+		{
+			const int axis = faceAxis[f];
+			const float reach = faceSign[f] > 0.0f ? hi[axis] : -lo[axis];
+			if (reach >= minAbs[(axis + 1) % 3] && reach >= minAbs[(axis + 2) % 3])
+				outFaceIndices[f].push_back(i);
+		}
+	}
+}
+
 std::tuple<std::vector<LightStruct>, std::vector<ShadowRequest>>
 RenderCollector::extractLightsAndShadows(uint32_t maxShadow2D, uint32_t maxShadowCube) const
 {
+	ENGINE_PROFILE_SCOPE("RenderCollector::extractLightsAndShadows");
 	std::vector<LightStruct> lights;
 	std::vector<ShadowRequest> shadowRequests;
 
@@ -1,5 +1,7 @@
 #include "engine/rendering/Renderer.h"
+#include "engine/core/Profiler.h"
 
+#include <cstddef>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_inverse.hpp>
 #include <limits>
@@ -12,6 +14,9 @@
 #include "engine/rendering/CompositePass.h"
 #include "engine/rendering/DebugPass.h"
 #include "engine/rendering/DebugRenderCollector.h"
+#include "engine/rendering/DepthPrepass.h"
+#include "engine/rendering/EnvironmentPreprocessor.h"
+#include "engine/rendering/EnvironmentUniforms.h"
 #include "engine/rendering/FrameCache.h"
 #include "engine/rendering/FrameUniforms.h"
 #include "engine/rendering/LightUniforms.h"
@@ -66,6 +71,13 @@ bool Renderer::initialize()
 		return false;
 	}
 
+	m_depthPrepass = std::make_unique<DepthPrepass>(m_context);
+	if (!m_depthPrepass->initialize())
+	{
+		spdlog::error("Failed to initialize DepthPrepass");
+		return false;
+	}
+
 	m_meshPass = std::make_unique<MeshPass>(m_context);
 	if (!m_meshPass->initialize())
 	{
@@ -114,6 +126,15 @@ bool Renderer::initialize()
 		ColorSpace::Linear
 	);
 
+	// The environment-independent half of the split-sum lighting, shared by all cameras
+	m_brdfLut = m_context->textureFactory().createFromHalfFloatMips(
+		EnvironmentPreprocessor::BRDF_LUT_SIZE,
+		EnvironmentPreprocessor::BRDF_LUT_SIZE,
+		wgpu::TextureFormat::RG16Float,
+		{EnvironmentPreprocessor::getBRDFLut()},
+		"BRDF LUT"
+	);
+
 	spdlog::info("Renderer initialized successfully");
 	return true;
 }
@@ -127,9 +148,18 @@ bool Renderer::renderFrame(
 	std::function<void(wgpu::RenderPassEncoder)> uiCallback
 )
 {
+	ENGINE_PROFILE_SCOPE("Renderer::renderFrame");
 	// === PHASE 1: Frame Initialization ===
 	// Acquire swap chain texture and reset GPU resource cache
 	startFrame();
+	m_context->passTimer().beginFrame();
+	m_context->residencyManager().beginFrame();
+	// Deliver finished texture readbacks and recycle their staging buffers
+	m_context->readbackService().update();
+	// Flag GPU objects whose CPU materials/textures changed since the last frame
+	m_context->syncTracker().processChanges();
+	// Build the mips of textures created since the last frame in one submit
+	m_context->textureFactory().flushMipmaps();
 	if (renderTargets.empty())
 	{
 		spdlog::warn("renderFrame called with no render targets");
@@ -175,6 +205,7 @@ bool Renderer::renderFrame(
 	// === PHASE 4: Render Each Camera View ===
 	// Multi-camera rendering: each camera gets its own shadow maps and scene render
 	m_shadowPass->setRenderCollector(&renderCollector);
+	m_shadowPass->beginFrame();
 	for (auto &[cameraId, target] : m_frameCache.renderTargets)
 	{
 		// Render shadow maps from the perspective of lights visible to this camera
@@ -184,17 +215,20 @@ bool Renderer::renderFrame(
 		// Render scene from camera's perspective (with shadows applied)
 		renderToTexture(renderCollector, debugRenderCollector, target, customBindGroupProviders);
 	}
+	m_shadowPass->endFrame();
 
 	// === PHASE 5: Composite & Present ===
 	// Combine all camera render targets into final surface texture, then present to screen
 	compositeTexturesToSurface(uiCallback);
-	m_context->getSurface().present();
+	m_context->passTimer().endFrame();
+	m_context->surfaceManager().present();
 	m_surfaceTexture.reset();
 
 	// === PHASE 6: Post-Frame Cleanup ===
 	// Hot-reload shaders if changed, clear frame cache for next frame
 	m_context->pipelineManager().processPendingReloads();
 	m_frameCache.clear();
+	m_context->residencyManager().evictToBudget(); // After the frame's references to GPU resources are gone
 
 	return true;
 }
@@ -246,78 +280,185 @@ void Renderer::updateFrameBindGroup(const RenderTarget &target, float time)
 
 void Renderer::updateEnvironmentBindGroup(const RenderTarget &target)
 {
-	// Fetch fresh environment bind group layout from PBR shader to ensure it reflects current shader state
-	auto pbrShader = m_context->shaderRegistry().getShader(shader::defaults::PBR);
-	if (!pbrShader)
-	{
-		spdlog::warn("Failed to get PBR shader for environment bind group");
-		return;
-	}
+	auto &binding = m_environmentBindGroups[target.cameraId];
 
-	auto environmentBindGroupLayout = pbrShader->getBindGroupLayout(BindGroupType::Environment);
-	if (!environmentBindGroupLayout)
+	// Resolve the environment texture version without touching the texture factory
+	uint64_t textureId = 0;
+	uint64_t textureVersion = 0;
+	if (target.environmentTexture.has_value() && target.environmentTexture->valid())
 	{
-		spdlog::warn("Failed to get environment bind group layout from PBR shader");
-		return;
+		if (auto texture = target.environmentTexture->get(); texture && texture.value())
+		{
+			textureId = target.environmentTexture->id();
+			textureVersion = texture.value()->getVersion();
+		}
 	}
+	const uint64_t generation = m_context->pipelineManager().getGeneration();
 
-	std::shared_ptr<webgpu::WebGPUTexture> environmentTexture = m_defaultEnvironmentTexture;
-	if (target.environmentTexture.has_value() && target.environmentTexture->valid())
+	// Rebuild only when the texture, its content or the shader layout changed
+	if (!binding.bindGroup || binding.textureId != textureId || binding.textureVersion != textureVersion
+		|| binding.generation != generation)
 	{
-		webgpu::WebGPUTextureOptions options{};
-		options.colorSpace = ColorSpace::Linear;
-		auto texture = m_context->textureFactory().createFromHandle(target.environmentTexture.value(), options);
-		if (texture)
+		binding = {};
+		binding.textureId = textureId;
+		binding.textureVersion = textureVersion;
+		binding.generation = generation;
+		releaseUnusedEnvironmentMaps();
+
+		// Fetch the layout from the PBR shader to ensure it reflects the current shader state
+		auto pbrShader = m_context->shaderRegistry().getShader(shader::defaults::PBR);
+		if (!pbrShader)
 		{
-			environmentTexture = texture;
+			spdlog::warn("Failed to get PBR shader for environment bind group");
+			return;
 		}
-	}
 
-	const bool irradianceEnabled =
-		target.skyboxEnabled &&
-		target.irradianceEnabled &&
-		environmentTexture != nullptr;
+		auto environmentBindGroupLayout = pbrShader->getBindGroupLayout(BindGroupType::Environment);
+		if (!environmentBindGroupLayout)
+		{
+			spdlog::warn("Failed to get environment bind group layout from PBR shader");
+			return;
+		}
 
-	std::map<webgpu::BindGroupBindingKey, webgpu::BindGroupResource> resourceOverrides;
-	resourceOverrides.emplace(
-		std::make_tuple(0u, 1u),
-		webgpu::BindGroupResource(m_context->samplerFactory().getDefaultSampler())
-	);
-	resourceOverrides.emplace(
-		std::make_tuple(0u, 2u),
-		webgpu::BindGroupResource(environmentTexture)
-	);
+		std::shared_ptr<webgpu::WebGPUTexture> environmentTexture = m_defaultEnvironmentTexture;
+		std::shared_ptr<webgpu::WebGPUTexture> specularTexture = m_defaultEnvironmentTexture;
+		std::array<glm::vec4, 9> irradianceSH{};
+		if (textureId != 0)
+		{
+			webgpu::WebGPUTextureOptions options{};
+			options.colorSpace = ColorSpace::Linear;
+			auto texture = m_context->textureFactory().createFromHandle(target.environmentTexture.value(), options);
+			if (texture)
+			{
+				environmentTexture = texture;
+			}
+			// Created after the frame's mip flush but sampled by this frame's passes
+			m_context->textureFactory().flushMipmaps();
 
-	auto environmentBindGroup = m_context->bindGroupFactory().createBindGroup(
-		environmentBindGroupLayout,
-		resourceOverrides,
-		nullptr,
-		"Environment BindGroup"
-	);
+			const auto &maps = prepareEnvironmentMaps(target.environmentTexture.value(), textureVersion);
+			specularTexture = maps.specular;
+			irradianceSH = maps.irradianceSH;
+		}
+		binding.hasTexture = environmentTexture != nullptr;
+		if (specularTexture)
+			binding.specularMaxLod = static_cast<float>(specularTexture->getTextureDescriptor().mipLevelCount - 1);
+
+		std::map<webgpu::BindGroupBindingKey, webgpu::BindGroupResource> resourceOverrides;
+		resourceOverrides.emplace(
+			std::make_tuple(0u, 1u),
+			webgpu::BindGroupResource(m_context->samplerFactory().getDefaultSampler())
+		);
+		resourceOverrides.emplace(
+			std::make_tuple(0u, 2u),
+			webgpu::BindGroupResource(environmentTexture)
+		);
+		resourceOverrides.emplace(
+			std::make_tuple(0u, 3u),
+			webgpu::BindGroupResource(specularTexture)
+		);
+		resourceOverrides.emplace(
+			std::make_tuple(0u, 4u),
+			webgpu::BindGroupResource(m_brdfLut)
+		);
 
-	if (!environmentBindGroup)
-	{
-		spdlog::warn("Failed to create environment bind group for camera {}", target.cameraId);
-		m_environmentBindGroups[target.cameraId] = nullptr;
-		return;
+		binding.bindGroup = m_context->bindGroupFactory().createBindGroup(
+			environmentBindGroupLayout,
+			resourceOverrides,
+			nullptr,
+			"Environment BindGroup"
+		);
+
+		if (!binding.bindGroup)
+		{
+			spdlog::warn("Failed to create environment bind group for camera {}", target.cameraId);
+			return;
+		}
+
+		// The SH only change with the environment, the parameters below are written separately
+		binding.bindGroup->updateBuffer(
+			0,
+			irradianceSH.data(),
+			sizeof(irradianceSH),
+			offsetof(EnvironmentUniforms, irradianceSH),
+			m_context->getQueue()
+		);
 	}
 
+	const bool irradianceEnabled =
+		target.skyboxEnabled &&
+		target.irradianceEnabled &&
+		binding.hasTexture;
+
 	glm::vec4 environmentParams(
 		irradianceEnabled ? 1.0f : 0.0f,
 		target.irradianceIntensity,
 		target.skyboxEnabled ? 1.0f : 0.0f,
-		0.0f
+		binding.specularMaxLod
 	);
 
-	environmentBindGroup->updateBuffer(
+	// Only the parameter uniform is per frame, and only written when it changed
+	if (binding.paramsWritten && binding.params == environmentParams)
+		return;
+
+	binding.bindGroup->updateBuffer(
 		0,
 		&environmentParams,
 		sizeof(glm::vec4),
 		0,
 		m_context->getQueue()
 	);
+	binding.params = environmentParams;
+	binding.paramsWritten = true;
+}
+
+const Renderer::EnvironmentMaps &Renderer::prepareEnvironmentMaps(const Texture::Handle &handle, uint64_t version)
+{
+	auto &maps = m_environmentMaps[handle.id()];
+	if (maps.specular && maps.textureVersion == version)
+		return maps;
+
+	ENGINE_PROFILE_SCOPE("Renderer::prepareEnvironmentMaps");
+	maps = {};
+	maps.textureVersion = version;
+	maps.specular = m_defaultEnvironmentTexture; // Also kept on failure, so a broken map is not retried every frame
+
+	auto texture = handle.get();
+	auto image = texture && texture.value() ? texture.value()->getImage() : nullptr;
+	if (!image)
+	{
+		spdlog::warn("Environment texture {} has no image data, image-based lighting disabled", handle.id());
+		return maps;
+	}
+
+	auto lighting = EnvironmentPreprocessor::process(*image, m_environmentCacheDirectory);
+	if (!lighting)
+	{
+		spdlog::warn("Failed to preprocess environment texture {}", handle.id());
+		return maps;
+	}
 
-	m_environmentBindGroups[target.cameraId] = environmentBindGroup;
+	maps.irradianceSH = lighting->irradianceSH;
+	maps.specular = m_context->textureFactory().createFromHalfFloatMips(
+		EnvironmentPreprocessor::SPECULAR_WIDTH,
+		EnvironmentPreprocessor::SPECULAR_WIDTH / 2,
+		wgpu::TextureFormat::RGBA16Float,
+		lighting->specularMips,
+		"Environment Specular"
+	);
+	if (!maps.specular)
+		maps.specular = m_defaultEnvironmentTexture;
+	return maps;
+}
+
+void Renderer::releaseUnusedEnvironmentMaps()
+{
+	for (auto it = m_environmentMaps.begin(); it != m_environmentMaps.end();)
+	{
+		bool used = false;
+		for (const auto &[cameraId, binding] : m_environmentBindGroups)
+			used = used || binding.textureId == it->first;
+		it = used ? std::next(it) : m_environmentMaps.erase(it);
+	}
 }
 
 std::shared_ptr<webgpu::WebGPUTexture> Renderer::updateRenderTexture(
@@ -403,6 +544,7 @@ void Renderer::renderToTexture(
 	const std::vector<BindGroupDataProvider> &customBindGroupProviders
 )
 {
+	ENGINE_PROFILE_SCOPE("Renderer::renderToTexture");
 	auto renderTargetId = renderTarget.cameraId;
 	spdlog::debug(
 		"renderToTexture: cameraId={}, renderItems={}, lights={}",
@@ -494,7 +636,7 @@ void Renderer::renderToTexture(
 	// ========================================
 	updateEnvironmentBindGroup(renderTarget);
 
-	if (renderTarget.skyboxEnabled && m_environmentBindGroups[renderTargetId])
+	if (renderTarget.skyboxEnabled && m_environmentBindGroups[renderTargetId].bindGroup)
 	{
 		auto skyboxClearFlags = ClearFlags::SolidColor;
 
@@ -505,9 +647,10 @@ void Renderer::renderToTexture(
 			renderTarget.backgroundColor
 		);
 
+		skyboxPassContext->setTimingLabel("SkyboxPass");
 		m_skyboxPass->setRenderPassContext(skyboxPassContext);
 		m_skyboxPass->setCameraId(renderTargetId);
-		m_skyboxPass->setEnvironmentBindGroup(m_environmentBindGroups[renderTargetId]);
+		m_skyboxPass->setEnvironmentBindGroup(m_environmentBindGroups[renderTargetId].bindGroup);
 		m_skyboxPass->render(m_frameCache);
 	}
 
@@ -517,6 +660,27 @@ void Renderer::renderToTexture(
 		meshClearFlags = (meshClearFlags & ~ClearFlags::SolidColor) | ClearFlags::Depth;
 	}
 
+	// Optional depth pre-pass: only when this camera starts from a cleared depth buffer,
+	// the MeshPass then loads that depth instead of clearing it.
+	const bool depthPrepassed = m_depthPrepassEnabled && hasFlag(meshClearFlags, ClearFlags::Depth);
+	if (depthPrepassed)
+	{
+		auto depthPrepassContext = m_context->renderPassFactory().create(
+			nullptr,
+			m_depthBuffers[renderTargetId],
+			ClearFlags::Depth,
+			renderTarget.backgroundColor
+		);
+
+		depthPrepassContext->setTimingLabel("DepthPrepass");
+		m_depthPrepass->setRenderPassContext(depthPrepassContext);
+		m_depthPrepass->setCamera(renderTarget.viewProjectionMatrix, renderTarget.cameraPosition, renderTarget.farPlane);
+		m_depthPrepass->setVisibleIndices(visibleIndices);
+		m_depthPrepass->render(m_frameCache);
+
+		meshClearFlags = meshClearFlags & ~ClearFlags::Depth;
+	}
+
 	// Render all visible based on material and mesh configurations.
 	auto meshPassContext = m_context->renderPassFactory().create(
 		renderToTexture,				// Color attachment
@@ -525,11 +689,14 @@ void Renderer::renderToTexture(
 		renderTarget.backgroundColor	// Clear color
 	);
 
+	meshPassContext->setTimingLabel("MeshPass");
 	m_meshPass->setRenderPassContext(meshPassContext);
 	m_meshPass->setCameraId(renderTargetId);
+	m_meshPass->setCameraView(renderTarget.viewMatrix, renderTarget.projectionMatrix, renderTarget.nearPlane, renderTarget.farPlane);
 	m_meshPass->setVisibleIndices(visibleIndices);
+	m_meshPass->setDepthPrepassed(depthPrepassed);
 	m_meshPass->setShadowBindGroup(m_shadowPass->getShadowBindGroup());
-	m_meshPass->setEnvironmentBindGroup(m_environmentBindGroups[renderTargetId]);
+	m_meshPass->setEnvironmentBindGroup(m_environmentBindGroups[renderTargetId].bindGroup);
 
 	spdlog::debug("Rendering {} GPU mesh items", m_frameCache.gpuRenderItems.size());
 	m_meshPass->render(m_frameCache);
@@ -546,6 +713,7 @@ void Renderer::renderToTexture(
 		renderTarget.backgroundColor
 	);
 
+	debugPassContext->setTimingLabel("DebugPass");
 	m_debugPass->setRenderPassContext(debugPassContext);
 	m_debugPass->setCameraId(renderTargetId);
 	m_debugPass->setDebugCollector(&debugCollector);
@@ -562,24 +730,33 @@ void Renderer::renderToTexture(
 	// STEP 7: CPU Readback (Optional)
 	// ========================================
 	// If the application requested to read pixels back to CPU (e.g., for screenshots),
-	// initiate asynchronous GPU-to-CPU transfer.
+	// initiate asynchronous GPU-to-CPU transfer. The readback service delivers the image a few
+	// frames later without stalling; targets of different cameras read back concurrently.
 	if (renderTarget.cpuTarget.has_value() && renderTarget.cpuTarget->valid())
 	{
 		if (auto textureOpt = renderTarget.cpuTarget->get())
 		{
 			auto &tex = textureOpt.value();
-
-			// Phase 1 — initiate readback if requested and none in flight
-			if (tex->isReadbackRequested() && !renderToTexture->isReadbackPending())
+			if (tex->isReadbackRequested() && m_readbacksInFlight->insert(tex.get()).second)
 			{
-				renderToTexture->beginReadback(*m_context);
-			}
-
-			// Phase 2 — poll every frame until GPU callback fires
-			if (renderToTexture->isReadbackPending())
-			{
-				if (renderToTexture->pollReadback(*m_context, tex))
-					tex->resolveReadback();
+				std::weak_ptr<Texture> target = tex;
+				auto inFlight = m_readbacksInFlight;
+				const Texture *key = tex.get();
+				const bool started = m_context->readbackService().readTexture(
+					*renderToTexture,
+					[target, inFlight, key](engine::resources::Image::Ptr image)
+					{
+						inFlight->erase(key);
+						auto texture = target.lock();
+						if (!texture)
+							return;
+						if (image)
+							texture->replaceImageData(image);
+						texture->resolveReadback();
+					}
+				);
+				if (!started)
+					m_readbacksInFlight->erase(key);
 			}
 		}
 	}
@@ -593,6 +770,7 @@ void Renderer::compositeTexturesToSurface(
 	std::function<void(wgpu::RenderPassEncoder)> uiCallback
 )
 {
+	ENGINE_PROFILE_SCOPE("Renderer::compositeTexturesToSurface");
 	// ========================================
 	// Compositing Phase
 	// ========================================
@@ -600,6 +778,7 @@ void Renderer::compositeTexturesToSurface(
 	// For single camera: simple copy/blit to surface
 	// For multiple cameras: arrange viewports (split-screen, picture-in-picture)
 	auto compositePassContext = m_context->renderPassFactory().create(m_surfaceTexture);
+	compositePassContext->setTimingLabel("CompositePass");
 	m_compositePass->setRenderPassContext(compositePassContext);
 	m_compositePass->render(m_frameCache);
 
@@ -620,6 +799,7 @@ void Renderer::compositeTexturesToSurface(
 			nullptr,		 // No depth buffer needed for 2D UI
 			ClearFlags::None // Don't clear - render on top
 		);
+		uiPassContext->setTimingLabel("UIPass");
 
 		wgpu::RenderPassEncoder uiRenderPass = uiPassContext->begin(uiEncoder);
 		uiCallback(uiRenderPass); // Application draws UI (e.g., ImGui)
@@ -629,6 +809,11 @@ void Renderer::compositeTexturesToSurface(
 	}
 }
 
+std::vector<webgpu::GpuPassTiming> Renderer::getGpuPassTimings() const
+{
+	return m_context->passTimer().getTimings();
+}
+
 void Renderer::onResize(uint32_t width, uint32_t height)
 {
 	for (auto &[id, target] : m_renderTargets)
@@ -645,6 +830,9 @@ void Renderer::onResize(uint32_t width, uint32_t height)
 		// When the window resizes, we need to resize all render targets and depth buffers accordingly
 	}
 
+	if (m_depthPrepass)
+		m_depthPrepass->cleanup();
+
 	if (m_meshPass)
 		m_meshPass->cleanup();
 
@@ -1,9 +1,12 @@
 #include "engine/rendering/ShaderRegistry.h"
 
+#include <sstream>
+
 #include <spdlog/spdlog.h>
 
 #include "engine/core/PathProvider.h"
 #include "engine/rendering/DebugRenderCollector.h"
+#include "engine/rendering/EnvironmentUniforms.h"
 #include "engine/rendering/FrameUniforms.h"
 #include "engine/rendering/LightUniforms.h"
 #include "engine/rendering/Material.h"
@@ -24,6 +27,8 @@ using PathProvider = engine::core::PathProvider;
 // ToDo: Add Texture vs Add Texture Binding so that we can have optional textures amd BindGroup layouts that match
 ShaderRegistry::ShaderRegistry(webgpu::WebGPUContext &context) : m_context(context)
 {
+	m_shadersById.resize(1); // reserve INVALID_SHADER_ID
+	m_shaderNames.resize(1);
 }
 
 bool ShaderRegistry::initializeDefaultShaders()
@@ -140,6 +145,72 @@ std::shared_ptr<webgpu::WebGPUShaderInfo> ShaderRegistry::getShader(const std::s
 	return nullptr;
 }
 
+std::shared_ptr<webgpu::WebGPUShaderInfo> ShaderRegistry::getShader(webgpu::ShaderId id) const
+{
+	return id < m_shadersById.size() ? m_shadersById[id] : nullptr;
+}
+
+webgpu::ShaderId ShaderRegistry::resolveShaderId(const std::string &name)
+{
+	auto it = m_shaderIds.find(name);
+	if (it != m_shaderIds.end())
+		return it->second;
+
+	auto id = static_cast<webgpu::ShaderId>(m_shadersById.size());
+	m_shadersById.emplace_back();
+	m_shaderNames.push_back(name);
+	m_shaderIds.emplace(name, id);
+	return id;
+}
+
+std::string ShaderRegistry::makeVariantName(const std::string &baseName, MaterialFeature::Flag enabledFeatures)
+{
+	std::ostringstream name;
+	name << baseName << '#' << std::hex << static_cast<uint64_t>(enabledFeatures);
+	return name.str();
+}
+
+webgpu::ShaderId ShaderRegistry::resolveVariantId(const std::string &baseName, MaterialFeature::Flag materialFeatures)
+{
+	auto base = getShader(baseName);
+	if (!base || !base->supportsVariants())
+		return resolveShaderId(baseName);
+
+	const auto enabled = materialFeatures & base->getVariantFeatures();
+	if (enabled == base->getEnabledFeatures())
+		return base->getId();
+
+	return resolveShaderId(makeVariantName(baseName, enabled));
+}
+
+std::shared_ptr<webgpu::WebGPUShaderInfo> ShaderRegistry::acquireShader(webgpu::ShaderId id)
+{
+	if (auto shader = getShader(id))
+		return shader;
+	if (id == webgpu::INVALID_SHADER_ID || id >= m_shaderNames.size())
+		return nullptr;
+
+	// Not registered: only variants ("<base>#<hex mask>") can be built on demand
+	const std::string &name = m_shaderNames[id];
+	const auto separator = name.rfind('#');
+	if (separator == std::string::npos)
+		return nullptr;
+
+	auto base = getShader(name.substr(0, separator));
+	if (!base || !base->supportsVariants())
+	{
+		spdlog::error("Cannot build shader variant '{}': base shader not found or has no variants", name);
+		return nullptr;
+	}
+
+	uint64_t mask = 0;
+	std::istringstream(name.substr(separator + 1)) >> std::hex >> mask;
+	auto variant = m_context.shaderFactory().createVariant(base, name, static_cast<MaterialFeature::Flag>(mask));
+	if (!variant || !registerShader(variant))
+		return nullptr;
+	return variant;
+}
+
 bool ShaderRegistry::registerShader(std::shared_ptr<webgpu::WebGPUShaderInfo> shaderInfo, bool replaceIfExists)
 {
 	if (!replaceIfExists && m_shaders.find(shaderInfo->getName()) != m_shaders.end())
@@ -154,7 +225,10 @@ bool ShaderRegistry::registerShader(std::shared_ptr<webgpu::WebGPUShaderInfo> sh
 		return false;
 	}
 
+	auto id = resolveShaderId(shaderInfo->getName());
+	shaderInfo->setId(id);
 	m_shaders[shaderInfo->getName()] = shaderInfo;
+	m_shadersById[id] = shaderInfo;
 	if (replaceIfExists)
 	{
 		spdlog::info("Replaced existing shader '{}'", shaderInfo->getName());
@@ -171,6 +245,7 @@ bool ShaderRegistry::unregisterShader(const std::string &name)
 	auto it = m_shaders.find(name);
 	if (it != m_shaders.end())
 	{
+		m_shadersById[it->second->getId()].reset();
 		m_shaders.erase(it);
 		spdlog::info("Unregistered shader '{}'", name);
 		return true;
@@ -183,6 +258,8 @@ void ShaderRegistry::unregisterAll()
 {
 	spdlog::info("Unregistering all {} shaders", m_shaders.size());
 	m_shaders.clear();
+	for (auto &shader : m_shadersById)
+		shader.reset();
 }
 
 bool ShaderRegistry::hasShader(const std::string &name) const
@@ -197,15 +274,18 @@ std::shared_ptr<webgpu::WebGPUShaderInfo> ShaderRegistry::createPBRShader()
 	// PBR_Lit_Shader.wgsl structure:
 	// @group(0) @binding(0) var<uniform> uFrame: FrameUniforms;
 	// @group(1) @binding(0) var<storage, read> uLights: LightsBuffer;
+	// @group(1) @binding(1) var<storage, read> uLightClusters: array<LightCluster>;
+	// @group(1) @binding(2) var<storage, read> uLightIndices: array<u32>;
 	// @group(2) @binding(0) var<uniform> uObject: ObjectUniforms;
-	// @group(3) @binding(0) var<uniform> uMaterial: MaterialUniforms;
+	// @group(3) @binding(0) var<uniform> uMaterials: array<MaterialUniforms, MAX_MATERIALS_PER_BATCH>;
 	// @group(3) @binding(1) var textureSampler: sampler;
-	// @group(3) @binding(2) var baseColorTexture: texture_2d<f32>;
-	// @group(3) @binding(3) var normalTexture: texture_2d<f32>;
-	// @group(3) @binding(4) var aoTexture: texture_2d<f32>;
-	// @group(3) @binding(5) var roughnessTexture: texture_2d<f32>;
-	// @group(3) @binding(6) var metallicTexture: texture_2d<f32>;
-	// @group(3) @binding(7) var emissionTexture: texture_2d<f32>;
+	// @group(3) @binding(2) var baseColorTexture: texture_2d_array<f32>;
+	// @group(3) @binding(3) var normalTexture: texture_2d_array<f32>;
+	// @group(3) @binding(4) var aoTexture: texture_2d_array<f32>;
+	// @group(3) @binding(5) var roughnessTexture: texture_2d_array<f32>;
+	// @group(3) @binding(6) var metallicTexture: texture_2d_array<f32>;
+	// @group(3) @binding(7) var emissionTexture: texture_2d_array<f32>;
+	// @group(3) @binding(8) var<uniform> uMaterialLayers: array<MaterialLayers, MAX_MATERIALS_PER_BATCH>;
 	// @group(4) @binding(0) var shadowSampler: sampler;
 	// @group(4) @binding(1) var shadowMap2DArray:
 	// @group(4) @binding(2) var shadowMapCubeArray:
@@ -214,6 +294,8 @@ std::shared_ptr<webgpu::WebGPUShaderInfo> ShaderRegistry::createPBRShader()
 	// @group(5) @binding(0) var<uniform> uEnvironment: EnvironmentUniforms;
 	// @group(5) @binding(1) var environmentSampler: sampler;
 	// @group(5) @binding(2) var environmentTexture: texture_2d<f32>;
+	// @group(5) @binding(3) var environmentSpecular: texture_2d<f32>;
+	// @group(5) @binding(4) var brdfLut: texture_2d<f32>;
 	auto shaderInfo =
 		m_context.shaderFactory()
 			.begin(
@@ -228,15 +310,15 @@ std::shared_ptr<webgpu::WebGPUShaderInfo> ShaderRegistry::createPBRShader()
 			)
 			// Group 0: Frame uniforms (camera, time)
 			.addFrameBindGroup()
-			// Group 1: Lighting data (storage buffer with max 16 lights)
+			// Group 1: Lighting data (lights + clustered light lists)
 			.addLightBindGroup()
 			// Group 2: Object uniforms (model matrix, normal matrix)
 			.addObjectBindGroup()
-			// Group 3: Material data (properties + textures)
+			// Group 3: Material data (properties + textures), shared by a batch of materials
 			.addBindGroup(bindgroup::defaults::MATERIAL, BindGroupReuse::PerObject, BindGroupType::Material)
 			.addUniform(
 				bindgroup::entry::defaults::MATERIAL_PROPERTIES,
-				sizeof(PBRProperties),
+				constants::MAX_MATERIALS_PER_BATCH * sizeof(PBRProperties),
 				WGPUShaderStage_Fragment
 			)
 			.addSampler(
@@ -248,7 +330,7 @@ std::shared_ptr<webgpu::WebGPUShaderInfo> ShaderRegistry::createPBRShader()
 				"baseColorTexture",
 				MaterialTextureSlots::DIFFUSE, // material slot name
 				wgpu::TextureSampleType::Float,
-				wgpu::TextureViewDimension::_2D,
+				wgpu::TextureViewDimension::_2DArray,
 				WGPUShaderStage_Fragment,
 				glm::vec3(1.0f, 1.0f, 1.0f) // default white for base color
 			)
@@ -256,7 +338,7 @@ std::shared_ptr<webgpu::WebGPUShaderInfo> ShaderRegistry::createPBRShader()
 				"normalTexture",
 				MaterialTextureSlots::NORMAL, // material slot name
 				wgpu::TextureSampleType::Float,
-				wgpu::TextureViewDimension::_2D,
+				wgpu::TextureViewDimension::_2DArray,
 				WGPUShaderStage_Fragment,
 				glm::vec3(0.5f, 0.5f, 1.0f) // default normal map color
 			)
@@ -264,7 +346,7 @@ std::shared_ptr<webgpu::WebGPUShaderInfo> ShaderRegistry::createPBRShader()
 				"aoTexture",
 				MaterialTextureSlots::AMBIENT, // material slot name
 				wgpu::TextureSampleType::Float,
-				wgpu::TextureViewDimension::_2D,
+				wgpu::TextureViewDimension::_2DArray,
 				WGPUShaderStage_Fragment,
 				glm::vec3(1.0f, 1.0f, 1.0f) // default white for AO
 			)
@@ -272,7 +354,7 @@ std::shared_ptr<webgpu::WebGPUShaderInfo> ShaderRegistry::createPBRShader()
 				"roughnessTexture",
 				MaterialTextureSlots::ROUGHNESS, // material slot name
 				wgpu::TextureSampleType::Float,
-				wgpu::TextureViewDimension::_2D,
+				wgpu::TextureViewDimension::_2DArray,
 				WGPUShaderStage_Fragment,
 				glm::vec3(1.0f, 1.0f, 1.0f) // default white for roughness
 			)
@@ -280,7 +362,7 @@ std::shared_ptr<webgpu::WebGPUShaderInfo> ShaderRegistry::createPBRShader()
 				"metallicTexture",
 				MaterialTextureSlots::METALLIC, // material slot name
 				wgpu::TextureSampleType::Float,
-				wgpu::TextureViewDimension::_2D,
+				wgpu::TextureViewDimension::_2DArray,
 				WGPUShaderStage_Fragment,
 				glm::vec3(0.0f, 0.0f, 0.0f) // default black for metallic
 			)
@@ -288,17 +370,23 @@ std::shared_ptr<webgpu::WebGPUShaderInfo> ShaderRegistry::createPBRShader()
 				"emissionTexture",
 				MaterialTextureSlots::EMISSIVE, // material slot name
 				wgpu::TextureSampleType::Float,
-				wgpu::TextureViewDimension::_2D,
+				wgpu::TextureViewDimension::_2DArray,
 				WGPUShaderStage_Fragment,
 				glm::vec3(0.0f, 0.0f, 0.0f) // default black for emission
 			)
+			.addUniform(
+				bindgroup::entry::defaults::MATERIAL_LAYERS,
+				constants::MAX_MATERIALS_PER_BATCH * sizeof(MaterialTextureLayers),
+				WGPUShaderStage_Fragment
+			)
 			// Group 4: Shadow mapping (sampler, 2D array, cube array, storage buffers)
 			.addShadowBindGroup()
-			// Group 5: Environment irradiance (uniform + sampler + HDR equirect texture)
+			// Group 5: Image-based lighting (uniform with irradiance SH + sampler + HDR equirect,
+			// prefiltered specular equirect and BRDF lookup table)
 			.addBindGroup(bindgroup::defaults::ENVIRONMENT, BindGroupReuse::PerFrame, BindGroupType::Environment)
 			.addUniform(
 				"environmentUniforms",
-				sizeof(glm::vec4),
+				sizeof(EnvironmentUniforms),
 				WGPUShaderStage_Fragment
 			)
 			.addSampler(
@@ -313,6 +401,30 @@ std::shared_ptr<webgpu::WebGPUShaderInfo> ShaderRegistry::createPBRShader()
 				false,
 				WGPUShaderStage_Fragment
 			)
+			.addTexture(
+				"environmentSpecular",
+				wgpu::TextureSampleType::Float,
+				wgpu::TextureViewDimension::_2D,
+				false,
+				WGPUShaderStage_Fragment
+			)
+			.addTexture(
+				"brdfLut",
+				wgpu::TextureSampleType::Float,
+				wgpu::TextureViewDimension::_2D,
+				false,
+				WGPUShaderStage_Fragment
+			)
+			// Texture maps a material does not use are compiled out per variant
+			.setMaterialVariants(
+				MaterialFeature::Flag::UsesBaseColorMap
+				| MaterialFeature::Flag::UsesNormalMap
+				| MaterialFeature::Flag::UsesOcclusionMap
+				| MaterialFeature::Flag::UsesEmissiveMap
+				| MaterialFeature::Flag::UsesMetallicRoughnessMap
+				| MaterialFeature::Flag::UsesMetallicMap
+				| MaterialFeature::Flag::UsesRoughnessMap
+			)
 			.build();
 
 	return shaderInfo;
@@ -402,9 +514,10 @@ std::shared_ptr<webgpu::WebGPUShaderInfo> ShaderRegistry::createSkyboxShader()
 				BindGroupReuse::PerFrame,
 				BindGroupType::Custom
 			)
+			// Same entries as the PBR environment group: the skybox is drawn with that bind group
 			.addUniform(
 				"environmentUniforms",
-				sizeof(glm::vec4),
+				sizeof(EnvironmentUniforms),
 				WGPUShaderStage_Fragment
 			)
 			.addSampler(
@@ -419,6 +532,20 @@ std::shared_ptr<webgpu::WebGPUShaderInfo> ShaderRegistry::createSkyboxShader()
 				false,
 				WGPUShaderStage_Fragment
 			)
+			.addTexture(
+				"environmentSpecular",
+				wgpu::TextureSampleType::Float,
+				wgpu::TextureViewDimension::_2D,
+				false,
+				WGPUShaderStage_Fragment
+			)
+			.addTexture(
+				"brdfLut",
+				wgpu::TextureSampleType::Float,
+				wgpu::TextureViewDimension::_2D,
+				false,
+				WGPUShaderStage_Fragment
+			)
 			.build();
 
 	return shaderInfo;
@@ -521,7 +648,7 @@ std::shared_ptr<webgpu::WebGPUShaderInfo> ShaderRegistry::createShadowPassCubeSh
 				BindGroupReuse::PerFrame,
 				BindGroupType::ShadowPassCube
 			)
-			// Group 0: Shadow cube uniforms (light position and far plane)
+			// Group 0: Shadow cube uniforms (face matrices, light position and far plane)
 			.addCustomUniform(
 				"uShadowCube",
 				sizeof(ShadowPassCubeUniforms),
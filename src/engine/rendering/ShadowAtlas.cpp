@@ -0,0 +1,229 @@
+#include "engine/rendering/ShadowAtlas.h"
+
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+namespace engine::rendering
+{
+
+namespace
+{
+uint32_t nextPowerOfTwo(uint32_t value)
+{
+	uint32_t result = 1;
+	while (result < value && result < (1u << 31))
+		result <<= 1;
+	return result;
+}
+
+uint32_t log2Floor(uint32_t value)
+{
+	uint32_t result = 0;
+	while (value > 1)
+	{
+		value >>= 1;
+		++result;
+	}
+	return result;
+}
+} // namespace
+
+ShadowAtlas::ShadowAtlas(uint32_t pageSize, uint32_t minTileSize, uint32_t maxPages) :
+	m_pageSize(nextPowerOfTwo(std::max(pageSize, 1u))),
+	m_minTileSize(std::min(nextPowerOfTwo(std::max(minTileSize, 1u)), m_pageSize)),
+	m_maxPages(std::max(maxPages, 1u))
+{
+	m_levelCount = log2Floor(m_pageSize / m_minTileSize) + 1;
+}
+
+void ShadowAtlas::beginFrame()
+{
+	for (auto &[key, entry] : m_entries)
+		entry.used = false;
+}
+
+std::optional<ShadowAtlasTile> ShadowAtlas::acquire(uint64_t key, uint32_t requestedSize, bool &outAllocated, uint64_t owner)
+{
+	outAllocated = false;
+	const uint32_t size = roundTileSize(requestedSize);
+
+	auto it = m_entries.find(key);
+	if (it != m_entries.end())
+	{
+		if (it->second.requestedSize == size)
+		{
+			it->second.used = true;
+			return it->second.tile;
+		}
+		release(it->second);
+		m_entries.erase(it);
+	}
+
+	// Fall back to smaller tiles rather than dropping the shadow
+	for (uint32_t tileSize = size; tileSize >= m_minTileSize; tileSize >>= 1)
+	{
+		uint32_t node = 0;
+		if (auto tile = allocate(tileSize, owner, node))
+		{
+			if (tileSize != size)
+				spdlog::debug("ShadowAtlas: no room for a {0}x{0} tile, using {1}x{1}", size, tileSize);
+
+			m_entries[key] = Entry{*tile, size, node, true};
+			outAllocated = true;
+			return tile;
+		}
+	}
+
+	spdlog::warn("ShadowAtlas: atlas full ({} pages), shadow tile of size {} dropped", m_pages.size(), size);
+	return std::nullopt;
+}
+
+void ShadowAtlas::endFrame()
+{
+	for (auto it = m_entries.begin(); it != m_entries.end();)
+	{
+		if (!it->second.used)
+		{
+			release(it->second);
+			it = m_entries.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+void ShadowAtlas::clear()
+{
+	m_entries.clear();
+	m_pages.clear();
+}
+
+std::optional<ShadowAtlasTile> ShadowAtlas::findTile(uint64_t key) const
+{
+	auto it = m_entries.find(key);
+	if (it == m_entries.end())
+		return std::nullopt;
+	return it->second.tile;
+}
+
+uint32_t ShadowAtlas::getPageCount() const
+{
+	for (size_t i = m_pages.size(); i > 0; --i)
+	{
+		if (m_pages[i - 1].nodes.front() != NodeState::Free)
+			return static_cast<uint32_t>(i);
+	}
+	return 0;
+}
+
+uint32_t ShadowAtlas::roundTileSize(uint32_t requestedSize) const
+{
+	return std::clamp(nextPowerOfTwo(std::max(requestedSize, 1u)), m_minTileSize, m_pageSize);
+}
+
+std::optional<ShadowAtlasTile> ShadowAtlas::allocate(uint32_t size, uint64_t owner, uint32_t &outNode)
+{
+	const uint32_t targetLevel = levelForSize(size);
+	ShadowAtlasTile tile;
+
+	for (size_t i = 0; i < m_pages.size(); ++i)
+	{
+		auto &page = m_pages[i];
+		const bool empty = page.nodes.front() == NodeState::Free;
+		if (!empty && page.owner != owner)
+			continue;
+
+		if (allocateInNode(page, 0, 0, 0, 0, targetLevel, tile, outNode))
+		{
+			page.owner = owner;
+			tile.page = static_cast<uint32_t>(i);
+			return tile;
+		}
+	}
+
+	if (m_pages.size() >= m_maxPages)
+		return std::nullopt;
+
+	// Node count of a full quadtree with m_levelCount levels: (4^levels - 1) / 3
+	const size_t nodeCount = ((size_t{1} << (2 * m_levelCount)) - 1) / 3;
+	m_pages.push_back(Page{std::vector<NodeState>(nodeCount, NodeState::Free), owner});
+	if (!allocateInNode(m_pages.back(), 0, 0, 0, 0, targetLevel, tile, outNode))
+		return std::nullopt;
+
+	tile.page = static_cast<uint32_t>(m_pages.size() - 1);
+	return tile;
+}
+
+bool ShadowAtlas::allocateInNode(
+	Page &page,
+	uint32_t node,
+	uint32_t level,
+	uint32_t x,
+	uint32_t y,
+	uint32_t targetLevel,
+	ShadowAtlasTile &outTile,
+	uint32_t &outNode
+)
+{
+	auto &state = page.nodes[node];
+	if (state == NodeState::Used)
+		return false;
+
+	const uint32_t size = m_pageSize >> level;
+	if (level == targetLevel)
+	{
+		if (state != NodeState::Free)
+			return false;
+
+		state = NodeState::Used;
+		outTile = ShadowAtlasTile{0, x, y, size};
+		outNode = node;
+		return true;
+	}
+
+	const uint32_t half = size / 2;
+	for (uint32_t child = 0; child < 4; ++child)
+	{
+		const uint32_t childX = x + (child & 1u) * half;
+		const uint32_t childY = y + (child >> 1) * half;
+		if (allocateInNode(page, node * 4 + 1 + child, level + 1, childX, childY, targetLevel, outTile, outNode))
+		{
+			page.nodes[node] = NodeState::Split;
+			return true;
+		}
+	}
+	return false;
+}
+
+void ShadowAtlas::release(const Entry &entry)
+{
+	if (entry.tile.page >= m_pages.size())
+		return;
+
+	auto &nodes = m_pages[entry.tile.page].nodes;
+	uint32_t node = entry.node;
+	nodes[node] = NodeState::Free;
+
+	// Merge fully free siblings back into their parent
+	while (node > 0)
+	{
+		const uint32_t parent = (node - 1) / 4;
+		const uint32_t first = parent * 4 + 1;
+		if (!std::all_of(nodes.begin() + first, nodes.begin() + first + 4, [](NodeState s)
+						 { return s == NodeState::Free; }))
+			break;
+
+		nodes[parent] = NodeState::Free;
+		node = parent;
+	}
+}
+
+uint32_t ShadowAtlas::levelForSize(uint32_t size) const
+{
+	return std::min(log2Floor(m_pageSize / size), m_levelCount - 1);
+}
+
+} // namespace engine::rendering
@@ -1,8 +1,12 @@
 #include "engine/rendering/ShadowPass.h"
+#include "engine/core/Profiler.h"
+
+#include <algorithm>
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <spdlog/spdlog.h>
 
+#include "engine/core/Hash.h"
 #include "engine/math/Frustum.h"
 #include "engine/rendering/BindGroupBinder.h"
 #include "engine/rendering/FrameCache.h"
@@ -46,6 +50,28 @@ constexpr CubeFace CUBE_FACES[6] = {
 	{glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f), 5}	// -Z (backward)
 };
 
+constexpr std::array<glm::vec3, 6> CUBE_FACE_DIRECTIONS = {
+	CUBE_FACES[0].target, CUBE_FACES[1].target, CUBE_FACES[2].target,
+	CUBE_FACES[3].target, CUBE_FACES[4].target, CUBE_FACES[5].target
+};
+
+// Extra radius of rate-reduced cascades, lets the camera move before they must be refit
+constexpr float FAR_CASCADE_PADDING = 0.15f;
+
+namespace
+{
+glm::mat4 directionalLightView(const Light &light, float range)
+{
+	const glm::vec3 dir = glm::normalize(light.getTransform()[2]);
+	return glm::lookAt(-dir * range, glm::vec3(0), glm::vec3(0, 1, 0));
+}
+
+uint32_t cascadeUpdateInterval(uint32_t cascadeIndex)
+{
+	return cascadeIndex < 2 ? 1u : 1u << std::min(cascadeIndex - 1, 31u);
+}
+} // namespace
+
 ShadowPass::ShadowPass(std::shared_ptr<webgpu::WebGPUContext> context) : RenderPass(context) {}
 
 bool ShadowPass::initialize()
@@ -70,59 +96,39 @@ bool ShadowPass::initialize()
 		return false;
 	}
 
-	m_shadowPass2DBindGroup = m_context->bindGroupFactory().createBindGroup(
-		m_shadowPass2DBindGroupLayout,
-		{},
-		nullptr,
-		"Shadow Pass 2D"
-	);
-
-	for (int i = 0; i < 6; ++i)
+	m_shadowPass2DBindGroups.resize(constants::MAX_SHADOW_MAPS_2D);
+	for (auto &bindGroup : m_shadowPass2DBindGroups)
 	{
-		m_shadowPassCubeBindGroup[i] = m_context->bindGroupFactory().createBindGroup(
-			m_shadowPassCubeBindGroupLayout,
+		bindGroup = m_context->bindGroupFactory().createBindGroup(
+			m_shadowPass2DBindGroupLayout,
 			{},
 			nullptr,
-			"Shadow Pass Cube"
+			"Shadow Pass 2D"
 		);
 	}
 
-	auto shadowLayout = m_context->bindGroupFactory().getGlobalBindGroupLayout(bindgroup::defaults::SHADOW);
-	if (!shadowLayout)
+	m_shadowPassCubeBindGroup = m_context->bindGroupFactory().createBindGroup(
+		m_shadowPassCubeBindGroupLayout,
+		{},
+		nullptr,
+		"Shadow Pass Cube"
+	);
+
+	m_shadowLayout = m_context->bindGroupFactory().getGlobalBindGroupLayout(bindgroup::defaults::SHADOW);
+	if (!m_shadowLayout)
 	{
 		spdlog::error("Failed to get shadow bind group layout");
 		return false;
 	}
 
+	// Start with one atlas page and a single small cube; both grow with the shadow requests
 	m_shadowSampler = m_context->samplerFactory().getShadowComparisonSampler();
-	m_shadow2DArray = m_context->textureFactory().createShadowMap2DArray(
-		constants::DEFAULT_SHADOW_MAP_SIZE,
-		constants::MAX_SHADOW_MAPS_2D
-	);
-	m_shadowCubeArray = m_context->textureFactory().createShadowMapCubeArray(
-		constants::DEFAULT_CUBE_SHADOW_MAP_SIZE,
-		constants::MAX_SHADOW_MAPS_CUBE
-	);
-
-	m_shadowBindGroup = m_context->bindGroupFactory().createBindGroup(
-		shadowLayout,
-		{{{4, 0}, webgpu::BindGroupResource(m_shadowSampler)},
-		 {{4, 1}, webgpu::BindGroupResource(m_shadow2DArray)},
-		 {{4, 2}, webgpu::BindGroupResource(m_shadowCubeArray)}},
-		nullptr,
-		"Shadow Maps"
-	);
+	m_shadowAtlasTexture = m_context->textureFactory().createShadowMap2DArray(m_atlas.getPageSize(), 1);
+	m_shadowCubeArray = m_context->textureFactory().createShadowMapCubeArray(constants::SHADOW_ATLAS_MIN_TILE_SIZE, 1);
+	m_cubeCapacity = 1;
 
-	DEBUG_SHADOW_2D_ARRAY = m_context->textureFactory().createShadowMap2DArray(
-		constants::DEFAULT_SHADOW_MAP_SIZE,
-		constants::MAX_SHADOW_MAPS_2D,
-		wgpu::TextureFormat::RGBA8Unorm
-	);
-	DEBUG_SHADOW_CUBE_ARRAY = m_context->textureFactory().createShadowMapCubeArray(
-		constants::DEFAULT_CUBE_SHADOW_MAP_SIZE,
-		constants::MAX_SHADOW_MAPS_CUBE,
-		wgpu::TextureFormat::RGBA8Unorm
-	);
+	if (!createShadowBindGroup())
+		return false;
 
 	spdlog::info("ShadowPass initialized");
 	return true;
@@ -131,7 +137,9 @@ bool ShadowPass::initialize()
 std::vector<ShadowUniform> ShadowPass::computeShadowUniforms(
 	const ShadowRequest &request,
 	const RenderTarget &renderTarget,
-	float splitLambda
+	float splitLambda,
+	const std::vector<uint32_t> &tileSizes,
+	std::vector<engine::math::Frustum::CascadeData> *outCascades
 )
 {
 	std::vector<ShadowUniform> result;
@@ -153,15 +161,25 @@ std::vector<ShadowUniform> ShadowPass::computeShadowUniforms(
 
 			if constexpr (std::is_same_v<T, DirectionalLight>)
 			{
-				glm::vec3 dir = glm::normalize(light->getTransform()[2]);
-				glm::mat4 lightView = glm::lookAt(-dir * lightData.range, glm::vec3(0), glm::vec3(0, 1, 0));
+				glm::mat4 lightView = directionalLightView(*light, lightData.range);
 
 				if (request.cascadeCount > 1)
 				{
+					// Rate-reduced cascades are padded so their previous fit stays valid for a few frames
+					std::vector<float> padding;
+					if (m_stabilizeCascades && m_reduceFarCascadeRate)
+					{
+						padding.resize(request.cascadeCount, 0.0f);
+						for (uint32_t i = 0; i < request.cascadeCount; ++i)
+							padding[i] = cascadeUpdateInterval(i) > 1 ? FAR_CASCADE_PADDING : 0.0f;
+					}
+
 					auto cascades = engine::math::Frustum::computeCascades(
 						renderTarget.frustum, renderTarget.viewMatrix, lightView,
 						renderTarget.nearPlane, renderTarget.farPlane, lightData.range,
-						request.cascadeCount, splitLambda
+						request.cascadeCount, splitLambda,
+						m_stabilizeCascades ? tileSizes : std::vector<uint32_t>{},
+						padding
 					);
 
 					for (uint32_t i = 0; i < request.cascadeCount; ++i)
@@ -175,6 +193,8 @@ std::vector<ShadowUniform> ShadowPass::computeShadowUniforms(
 						cascade.textureIndex = request.textureIndexStart + i;
 						result.push_back(cascade);
 					}
+					if (outCascades)
+						*outCascades = std::move(cascades);
 					return;
 				}
 
@@ -214,6 +234,9 @@ std::vector<ShadowUniform> ShadowPass::computeShadowUniforms(
 
 void ShadowPass::render(FrameCache &frameCache)
 {
+	ENGINE_PROFILE_SCOPE("ShadowPass::render");
+	m_lastRenderedCount = 0;
+	m_lastCachedCount = 0;
 	if (!m_collector || frameCache.shadowRequests.empty())
 		return;
 
@@ -226,6 +249,8 @@ void ShadowPass::render(FrameCache &frameCache)
 
 	const auto &renderTarget = renderTargetIt->second;
 	frameCache.shadowUniforms.clear();
+	m_atlasJobs.clear();
+	m_cubeJobs.clear();
 
 	// Compute all shadow uniforms
 	size_t totalUniforms = 0;
@@ -233,17 +258,89 @@ void ShadowPass::render(FrameCache &frameCache)
 		totalUniforms += req.cascadeCount;
 	frameCache.shadowUniforms.reserve(totalUniforms);
 
+	// Place 2D shadows in the atlas before fitting them: a tile may come out smaller than requested
+	// and stabilized cascades must snap to the texels of the tile they are rendered into.
+	// Requests produce one uniform per cascade (1 for spot and non-CSM directional lights).
+	size_t uniformBase = 0;
 	for (const auto &req : frameCache.shadowRequests)
 	{
-		float lambda = (req.type == ShadowType::Directional) ? req.light->asDirectional().splitLambda : 0.5f;
-		auto uniforms = computeShadowUniforms(req, renderTarget, lambda);
-		frameCache.shadowUniforms.insert(frameCache.shadowUniforms.end(), uniforms.begin(), uniforms.end());
+		if (req.type != ShadowType::PointCube)
+		{
+			const uint32_t tileSize = computeTileSize(req, renderTarget);
+			for (uint32_t i = 0; i < req.cascadeCount; ++i)
+			{
+				const uint32_t slot = req.textureIndexStart + i;
+				if (slot >= m_shadowPass2DBindGroups.size())
+				{
+					spdlog::warn("ShadowPass::render skipped 2D shadow: slot {} out of range (max {})", slot, m_shadowPass2DBindGroups.size());
+					continue;
+				}
+
+				AtlasJob job;
+				job.uniformIndex = uniformBase + i;
+				job.slot = slot;
+				job.key = tileKey(slot);
+				job.requestedSize = tileSize;
+				m_atlasJobs.push_back(std::move(job));
+			}
+		}
+		uniformBase += req.cascadeCount;
 	}
 
-	// Render shadow maps
-	size_t idx = 0;
+	// Largest first to keep fragmentation low
+	std::stable_sort(m_atlasJobs.begin(), m_atlasJobs.end(), [](const AtlasJob &a, const AtlasJob &b)
+					 { return a.requestedSize > b.requestedSize; });
+
+	// Tiles of the cameras rendered earlier this frame stay marked as used until endFrame()
+	for (auto &job : m_atlasJobs)
+	{
+		bool allocated = false;
+		job.tile = m_atlas.acquire(job.key, job.requestedSize, allocated, m_cameraId);
+		job.dirty = allocated;
+	}
+
+	std::vector<AtlasJob *> uniformJobs(totalUniforms, nullptr);
+	for (auto &job : m_atlasJobs)
+		uniformJobs[job.uniformIndex] = &job;
+
+	uint32_t cubeCount = 0;
+	uint32_t cubeFaceSize = constants::SHADOW_ATLAS_MIN_TILE_SIZE;
+	std::vector<engine::math::Frustum::CascadeData> cascades;
+	std::vector<uint32_t> tileSizes;
 	for (const auto &req : frameCache.shadowRequests)
 	{
+		const size_t base = frameCache.shadowUniforms.size();
+		tileSizes.clear();
+		if (req.type != ShadowType::PointCube)
+		{
+			tileSizes.assign(req.cascadeCount, m_atlas.roundTileSize(computeTileSize(req, renderTarget)));
+			for (uint32_t i = 0; i < req.cascadeCount; ++i)
+			{
+				if (const auto *job = uniformJobs[base + i]; job && job->tile)
+					tileSizes[i] = job->tile->size;
+			}
+		}
+
+		float lambda = (req.type == ShadowType::Directional) ? req.light->asDirectional().splitLambda : 0.5f;
+		cascades.clear();
+		auto uniforms = computeShadowUniforms(req, renderTarget, lambda, tileSizes, &cascades);
+
+		// CSM: keep far cascades that are not due, then cull all casters once for every cascade
+		const bool cascaded = !cascades.empty() && cascades.size() == uniforms.size();
+		if (cascaded)
+		{
+			const float range = req.light->asDirectional().range;
+			const glm::mat4 lightView = directionalLightView(*req.light, range);
+			for (uint32_t i = 0; i < cascades.size(); ++i)
+			{
+				if (reuseCascade(tileKey(req.textureIndexStart + i), i, lightView, tileSizes[i], cascades[i]))
+					uniforms[i].viewProj = cascades[i].viewProj;
+			}
+			m_collector->extractForCascades(lightView, cascades, -range, range * 2.0f, m_cascadeCasters);
+		}
+
+		frameCache.shadowUniforms.insert(frameCache.shadowUniforms.end(), uniforms.begin(), uniforms.end());
+
 		if (req.type == ShadowType::PointCube)
 		{
 			if (req.textureIndexStart >= constants::MAX_SHADOW_MAPS_CUBE)
@@ -256,46 +353,137 @@ void ShadowPass::render(FrameCache &frameCache)
 				continue;
 			}
 
-			if (idx >= frameCache.shadowUniforms.size())
+			CubeJob job;
+			job.uniformIndex = base;
+			job.cubeIndex = req.textureIndexStart;
+			job.range = req.light->asPoint().range;
+			m_cubeJobs.push_back(std::move(job));
+			cubeCount = std::max(cubeCount, req.textureIndexStart + 1);
+			cubeFaceSize = std::max(cubeFaceSize, m_atlas.roundTileSize(req.light->asPoint().shadowMapSize));
+			continue;
+		}
+
+		for (size_t i = 0; i < uniforms.size(); ++i)
+		{
+			auto *job = uniformJobs[base + i];
+			if (!job)
+			{
+				frameCache.shadowUniforms[base + i].atlasRect = glm::vec4(0.0f); // Slot out of range
+				continue;
+			}
+			if (cascaded)
 			{
-				spdlog::warn("ShadowPass::render aborted: shadow uniform index out of bounds");
-				break;
+				job->casters = std::move(m_cascadeCasters[i]);
+				job->culled = true;
 			}
+		}
+	}
+
+	const bool atlasRecreated = ensureAtlasCapacity(m_atlas.getPageCount());
+	const bool cubesRecreated = cubeCount > 0 && ensureCubeCapacity(cubeCount, cubeFaceSize);
+	if (m_isDebugMode)
+		ensureDebugTextures();
+
+	// Shader reloads and debug output change what a cached shadow would contain
+	const uint64_t baseSignature = core::hashCombine(m_context->pipelineManager().getGeneration(), m_isDebugMode ? 1u : 0u);
 
-			const auto &u = frameCache.shadowUniforms[idx++];
-			auto vis = m_collector->extractForPointLight(u.lightPos, req.light->asPoint().range);
-			frameCache.prepareGPUResources(m_context, *m_collector, vis);
-			renderShadowCube(frameCache, vis, req.textureIndexStart, u);
+	// Cull casters per tile and find the pages holding a changed tile
+	const float pageSize = static_cast<float>(m_atlas.getPageSize());
+	std::vector<bool> dirtyPages(m_atlas.getPageCount(), false);
+	for (auto &job : m_atlasJobs)
+	{
+		auto &u = frameCache.shadowUniforms[job.uniformIndex];
+		if (!job.tile)
+		{
+			u.atlasRect = glm::vec4(0.0f); // Sampled as unshadowed
+			m_tileSignatures.erase(job.key);
+			continue;
 		}
-		else if (req.type == ShadowType::Directional && req.cascadeCount > 1)
+
+		const auto &tile = *job.tile;
+		u.textureIndex = tile.page;
+		u.texelSize = 1.0f / static_cast<float>(tile.size);
+		u.atlasRect = glm::vec4(tile.x, tile.y, tile.size, tile.size) / pageSize;
+
+		if (!job.culled)
+			job.casters = m_collector->extractForLightFrustum(engine::math::Frustum::fromViewProjection(u.viewProj));
+
+		uint64_t seed = core::fnv1a64Bytes(reinterpret_cast<const char *>(&u.viewProj), sizeof(u.viewProj), baseSignature);
+		seed = core::hashCombine(seed, (static_cast<uint64_t>(tile.x) << 32) | tile.y);
+		seed = core::hashCombine(seed, (static_cast<uint64_t>(tile.page) << 32) | tile.size);
+		job.signature = computeCasterSignature(seed, job.casters);
+
+		auto signatureIt = m_tileSignatures.find(job.key);
+		const bool cached = m_cachingEnabled && !atlasRecreated && signatureIt != m_tileSignatures.end() && signatureIt->second == job.signature;
+		job.dirty = job.dirty || !cached;
+		if (job.dirty)
+			dirtyPages[tile.page] = true;
+	}
+
+	// Render changed pages (a page is cleared as a whole, so all of its tiles are redrawn)
+	std::vector<const AtlasJob *> pageJobs;
+	for (uint32_t page = 0; page < dirtyPages.size(); ++page)
+	{
+		pageJobs.clear();
+		for (const auto &job : m_atlasJobs)
 		{
-			for (uint32_t i = 0; i < req.cascadeCount; ++i)
-			{
-				if (idx >= frameCache.shadowUniforms.size())
-				{
-					spdlog::warn("ShadowPass::render aborted: shadow uniform index out of bounds");
-					break;
-				}
+			if (job.tile && job.tile->page == page)
+				pageJobs.push_back(&job);
+		}
 
-				const auto &u = frameCache.shadowUniforms[idx++];
-				auto vis = m_collector->extractForLightFrustum(engine::math::Frustum::fromViewProjection(u.viewProj));
-				frameCache.prepareGPUResources(m_context, *m_collector, vis);
-				renderShadow2D(frameCache, vis, req.textureIndexStart + i, u);
-			}
+		if (!dirtyPages[page])
+		{
+			m_lastCachedCount += pageJobs.size();
+			continue;
+		}
+
+		for (const auto *job : pageJobs)
+			frameCache.prepareGPUResources(m_context, *m_collector, job->casters);
+
+		// Clearing the page wipes every tile on it (pages are not shared between cameras)
+		for (auto it = m_tileSignatures.begin(); it != m_tileSignatures.end();)
+		{
+			const auto tile = m_atlas.findTile(it->first);
+			it = (!tile || tile->page == page) ? m_tileSignatures.erase(it) : std::next(it);
 		}
-		else
+
+		// Incomplete tiles (resources still loading) get no signature and are redrawn next frame
+		const bool complete = renderAtlasPage(frameCache, page, pageJobs);
+		if (complete)
 		{
-			if (idx >= frameCache.shadowUniforms.size())
-			{
-				spdlog::warn("ShadowPass::render aborted: shadow uniform index out of bounds");
-				break;
-			}
+			for (const auto *job : pageJobs)
+				m_tileSignatures[job->key] = job->signature;
+		}
+		m_lastRenderedCount += pageJobs.size();
+	}
+
+	// Render changed cube maps
+	if (m_cubeSignatures.size() < m_cubeCapacity)
+		m_cubeSignatures.resize(m_cubeCapacity, 0);
+
+	const uint32_t cubeSize = m_shadowCubeArray->getWidth();
+	for (auto &job : m_cubeJobs)
+	{
+		auto &u = frameCache.shadowUniforms[job.uniformIndex];
+		u.texelSize = 1.0f / static_cast<float>(cubeSize);
+
+		m_collector->extractForPointLightFaces(u.lightPos, job.range, CUBE_FACE_DIRECTIONS, job.casters, job.faceCasters);
+
+		uint64_t seed = core::fnv1a64Bytes(reinterpret_cast<const char *>(&u.lightPos), sizeof(u.lightPos), baseSignature);
+		seed = core::hashCombine(seed, static_cast<uint64_t>(glm::floatBitsToUint(u.far)));
+		seed = core::hashCombine(seed, cubeSize);
+		const uint64_t signature = computeCasterSignature(seed, job.casters);
 
-			const auto &u = frameCache.shadowUniforms[idx++];
-			auto vis = m_collector->extractForLightFrustum(engine::math::Frustum::fromViewProjection(u.viewProj));
-			frameCache.prepareGPUResources(m_context, *m_collector, vis);
-			renderShadow2D(frameCache, vis, req.textureIndexStart, u);
+		auto &cachedSignature = m_cubeSignatures[job.cubeIndex];
+		if (m_cachingEnabled && !cubesRecreated && cachedSignature == signature)
+		{
+			m_lastCachedCount++;
+			continue;
 		}
+
+		frameCache.prepareGPUResources(m_context, *m_collector, job.casters);
+		cachedSignature = renderShadowCube(frameCache, job.faceCasters, job.cubeIndex, u) ? signature : 0;
+		m_lastRenderedCount++;
 	}
 
 	if (!frameCache.shadowUniforms.empty())
@@ -310,68 +498,259 @@ void ShadowPass::render(FrameCache &frameCache)
 	}
 }
 
-void ShadowPass::renderShadow2D(
-	FrameCache &frameCache,
-	const std::vector<size_t> &indicesToRender,
-	uint32_t arrayLayer,
-	const ShadowUniform &shadowUniform
+void ShadowPass::beginFrame()
+{
+	m_frameIndex++;
+	m_atlas.beginFrame();
+}
+
+void ShadowPass::endFrame()
+{
+	m_atlas.endFrame();
+
+	// Drop the cache entries of released tiles (cameras that were removed or lost their shadows)
+	for (auto it = m_tileSignatures.begin(); it != m_tileSignatures.end();)
+		it = m_atlas.findTile(it->first) ? std::next(it) : m_tileSignatures.erase(it);
+	for (auto it = m_cascadeStates.begin(); it != m_cascadeStates.end();)
+		it = m_atlas.findTile(it->first) ? std::next(it) : m_cascadeStates.erase(it);
+}
+
+bool ShadowPass::reuseCascade(
+	uint64_t key,
+	uint32_t cascadeIndex,
+	const glm::mat4 &lightView,
+	uint32_t tileSize,
+	engine::math::Frustum::CascadeData &cascade
 )
 {
-	ShadowPass2DUniforms uniforms{shadowUniform.viewProj, shadowUniform.lightPos, shadowUniform.far};
-	m_shadowPass2DBindGroup->updateBuffer(0, &uniforms, sizeof(uniforms), 0, m_context->getQueue());
+	auto &state = m_cascadeStates[key];
+	const auto &previous = state.cascade;
+
+	const uint32_t interval = cascadeUpdateInterval(cascadeIndex);
+	const bool due = !m_stabilizeCascades || !m_reduceFarCascadeRate || interval <= 1 || (m_frameIndex + cascadeIndex) % interval == 0;
+	if (!due
+		&& state.lightView == lightView
+		&& state.tileSize == tileSize
+		&& previous.near == cascade.near
+		&& previous.far == cascade.far
+		&& previous.sliceRadius == cascade.sliceRadius
+		&& glm::all(glm::greaterThanEqual(cascade.sliceCenter - cascade.sliceRadius, previous.boundsMin))
+		&& glm::all(glm::lessThanEqual(cascade.sliceCenter + cascade.sliceRadius, previous.boundsMax)))
+	{
+		// Keep the current slice data, only the projection is reused
+		const glm::vec2 sliceCenter = cascade.sliceCenter;
+		cascade = previous;
+		cascade.sliceCenter = sliceCenter;
+		return true;
+	}
+
+	state = CascadeState{lightView, tileSize, cascade};
+	return false;
+}
+
+uint32_t ShadowPass::computeTileSize(const ShadowRequest &request, const RenderTarget &renderTarget) const
+{
+	if (request.type != ShadowType::Spot)
+		return request.light->asDirectional().shadowMapSize;
+
+	const auto &spot = request.light->asSpot();
+	if (!m_screenCoverageSizing)
+		return spot.shadowMapSize;
+
+	// Projected radius of the light's range sphere relative to half the screen height
+	const glm::vec3 position = request.light->getTransform()[3];
+	const float distance = glm::length(position - renderTarget.cameraPosition);
+	if (distance <= spot.range)
+		return spot.shadowMapSize;
+
+	const float coverage = std::clamp(spot.range * renderTarget.projectionMatrix[1][1] / distance, 0.0f, 1.0f);
+	return std::max(static_cast<uint32_t>(static_cast<float>(spot.shadowMapSize) * coverage), 1u);
+}
+
+uint64_t ShadowPass::tileKey(uint32_t slot) const
+{
+	return core::hashCombine(static_cast<uint64_t>(m_cameraId), slot);
+}
+
+uint64_t ShadowPass::computeCasterSignature(uint64_t seed, const std::vector<size_t> &indices) const
+{
+	const auto &items = m_collector->getRenderItems();
+	uint64_t signature = core::hashCombine(seed, indices.size());
+	for (size_t index : indices)
+	{
+		const auto &item = items[index];
+		signature = core::hashCombine(signature, item.objectID);
+		signature = core::hashCombine(signature, item.modelHandle.id());
+		signature = core::hashCombine(signature, (static_cast<uint64_t>(item.submesh.indexOffset) << 32) | item.submesh.indexCount);
+		signature = core::fnv1a64Bytes(reinterpret_cast<const char *>(&item.worldTransform), sizeof(item.worldTransform), signature);
+
+		// Static items never change their model; others may edit it in place
+		if (!item.isStatic)
+		{
+			if (auto model = item.modelHandle.get())
+			{
+				signature = core::hashCombine(signature, (*model)->getVersion());
+				if (auto mesh = (*model)->getMesh().get())
+					signature = core::hashCombine(signature, (*mesh)->getVersion());
+			}
+		}
+	}
+	return signature;
+}
+
+bool ShadowPass::ensureAtlasCapacity(uint32_t pageCount)
+{
+	const uint32_t capacity = m_shadowAtlasTexture->getTextureViewDescriptor().arrayLayerCount;
+	if (pageCount <= capacity)
+		return false;
+
+	spdlog::info("ShadowPass: growing shadow atlas to {} pages of {}x{}", pageCount, m_atlas.getPageSize(), m_atlas.getPageSize());
+	m_shadowAtlasTexture = m_context->textureFactory().createShadowMap2DArray(m_atlas.getPageSize(), pageCount);
+	m_tileSignatures.clear();
+	createShadowBindGroup();
+	return true;
+}
+
+bool ShadowPass::ensureCubeCapacity(uint32_t cubeCount, uint32_t faceSize)
+{
+	cubeCount = std::max(cubeCount, m_cubeCapacity);
+	faceSize = std::max(faceSize, m_shadowCubeArray->getWidth());
+	if (cubeCount == m_cubeCapacity && faceSize == m_shadowCubeArray->getWidth())
+		return false;
+
+	spdlog::info("ShadowPass: growing cube shadow maps to {} cubes of {}x{}", cubeCount, faceSize, faceSize);
+	m_shadowCubeArray = m_context->textureFactory().createShadowMapCubeArray(faceSize, cubeCount);
+	m_cubeCapacity = cubeCount;
+	m_cubeSignatures.assign(cubeCount, 0);
+	createShadowBindGroup();
+	return true;
+}
+
+void ShadowPass::ensureDebugTextures()
+{
+	const auto &atlasView = m_shadowAtlasTexture->getTextureViewDescriptor();
+	if (!DEBUG_SHADOW_2D_ARRAY
+		|| DEBUG_SHADOW_2D_ARRAY->getWidth() != m_shadowAtlasTexture->getWidth()
+		|| DEBUG_SHADOW_2D_ARRAY->getTextureViewDescriptor().arrayLayerCount != atlasView.arrayLayerCount)
+	{
+		DEBUG_SHADOW_2D_ARRAY = m_context->textureFactory().createShadowMap2DArray(
+			m_shadowAtlasTexture->getWidth(),
+			atlasView.arrayLayerCount,
+			wgpu::TextureFormat::RGBA8Unorm
+		);
+		m_tileSignatures.clear();
+	}
+
+	if (!DEBUG_SHADOW_CUBE_ARRAY
+		|| DEBUG_SHADOW_CUBE_ARRAY->getWidth() != m_shadowCubeArray->getWidth()
+		|| DEBUG_SHADOW_CUBE_ARRAY->getTextureViewDescriptor().arrayLayerCount != m_cubeCapacity * 6)
+	{
+		DEBUG_SHADOW_CUBE_ARRAY = m_context->textureFactory().createShadowMapCubeArray(
+			m_shadowCubeArray->getWidth(),
+			m_cubeCapacity,
+			wgpu::TextureFormat::RGBA8Unorm
+		);
+		std::fill(m_cubeSignatures.begin(), m_cubeSignatures.end(), 0);
+	}
+}
+
+bool ShadowPass::createShadowBindGroup()
+{
+	auto bindGroup = m_context->bindGroupFactory().createBindGroup(
+		m_shadowLayout,
+		{{{4, 0}, webgpu::BindGroupResource(m_shadowSampler)},
+		 {{4, 1}, webgpu::BindGroupResource(m_shadowAtlasTexture)},
+		 {{4, 2}, webgpu::BindGroupResource(m_shadowCubeArray)}},
+		nullptr,
+		"Shadow Maps"
+	);
+	if (!bindGroup)
+	{
+		spdlog::error("Failed to create shadow bind group");
+		return false;
+	}
+
+	m_shadowBindGroup = bindGroup;
+	return true;
+}
 
-	uint32_t size = m_shadow2DArray->getWidth();
+bool ShadowPass::renderAtlasPage(
+	FrameCache &frameCache,
+	uint32_t page,
+	const std::vector<const AtlasJob *> &jobs
+)
+{
 	auto ctx = m_isDebugMode
-				   ? m_context->renderPassFactory().create(DEBUG_SHADOW_2D_ARRAY, m_shadow2DArray, ClearFlags::SolidColor | ClearFlags::Depth, glm::vec4(0), arrayLayer, arrayLayer)
-				   : m_context->renderPassFactory().createDepthOnly(m_shadow2DArray, arrayLayer);
+				   ? m_context->renderPassFactory().create(DEBUG_SHADOW_2D_ARRAY, m_shadowAtlasTexture, ClearFlags::SolidColor | ClearFlags::Depth, glm::vec4(0), page, page)
+				   : m_context->renderPassFactory().createDepthOnly(m_shadowAtlasTexture, page);
 
-	auto encoder = m_context->createCommandEncoder("Shadow 2D");
-	wgpu::RenderPassEncoder pass = encoder.beginRenderPass(ctx->getRenderPassDescriptor());
-	pass.setViewport(0, 0, size, size, 0, 1);
-	pass.setScissorRect(0, 0, size, size);
+	ctx->setTimingLabel("ShadowPass");
+
+	auto encoder = m_context->createCommandEncoder("Shadow Atlas");
+	wgpu::RenderPassEncoder pass = ctx->begin(encoder);
+
+	bool complete = true;
+	for (const auto *job : jobs)
+	{
+		const auto &u = frameCache.shadowUniforms[job->uniformIndex];
+		const auto &passBindGroup = m_shadowPass2DBindGroups[job->slot];
+		ShadowPass2DUniforms uniforms{u.viewProj, u.lightPos, u.far};
+		passBindGroup->updateBuffer(0, &uniforms, sizeof(uniforms), 0, m_context->getQueue());
 
-	renderItems(pass, frameCache, indicesToRender, false);
+		const auto &tile = *job->tile;
+		pass.setViewport(static_cast<float>(tile.x), static_cast<float>(tile.y), static_cast<float>(tile.size), static_cast<float>(tile.size), 0, 1);
+		pass.setScissorRect(tile.x, tile.y, tile.size, tile.size);
+
+		complete = renderItems(pass, frameCache, job->casters, false, passBindGroup) && complete;
+	}
 
 	ctx->end(pass);
-	m_context->submitCommandEncoder(encoder, "Shadow 2D");
+	m_context->submitCommandEncoder(encoder, "Shadow Atlas");
+	return complete;
 }
 
-void ShadowPass::renderShadowCube(
+bool ShadowPass::renderShadowCube(
 	FrameCache &frameCache,
-	const std::vector<size_t> &indicesToRender,
+	const std::array<std::vector<size_t>, 6> &faceIndices,
 	uint32_t cubeIndex,
 	const ShadowUniform &shadowUniform
 )
 {
 	uint32_t size = m_shadowCubeArray->getWidth();
 	glm::mat4 proj = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, shadowUniform.far);
-	auto encoder = m_context->createCommandEncoder("Shadow Cube");
 
+	// One upload for all faces, the shader picks the face matrix from the instance index
+	ShadowPassCubeUniforms uniforms;
 	for (const auto &face : CUBE_FACES)
-	{
-		ShadowPassCubeUniforms uniforms{
-			proj * glm::lookAt(shadowUniform.lightPos, shadowUniform.lightPos + face.target, face.up),
-			shadowUniform.lightPos,
-			shadowUniform.far
-		};
+		uniforms.faceViewProjection[face.faceIndex] = proj * glm::lookAt(shadowUniform.lightPos, shadowUniform.lightPos + face.target, face.up);
+	uniforms.lightPos = shadowUniform.lightPos;
+	uniforms.farPlane = shadowUniform.far;
+	m_shadowPassCubeBindGroup->updateBuffer(0, &uniforms, sizeof(uniforms), 0, m_context->getQueue());
 
-		m_shadowPassCubeBindGroup[face.faceIndex]->updateBuffer(0, &uniforms, sizeof(uniforms), 0, m_context->getQueue());
+	auto encoder = m_context->createCommandEncoder("Shadow Cube");
 
+	// WebGPU cannot route primitives to array layers, so each face still needs its own pass
+	bool complete = true;
+	for (const auto &face : CUBE_FACES)
+	{
 		uint32_t layer = cubeIndex * 6 + face.faceIndex;
 		auto ctx = m_isDebugMode
 					   ? m_context->renderPassFactory().create(DEBUG_SHADOW_CUBE_ARRAY, m_shadowCubeArray, ClearFlags::SolidColor | ClearFlags::Depth, glm::vec4(0), layer, layer)
 					   : m_context->renderPassFactory().createDepthOnly(m_shadowCubeArray, layer);
 
-		wgpu::RenderPassEncoder pass = encoder.beginRenderPass(ctx->getRenderPassDescriptor());
+		ctx->setTimingLabel("ShadowPass");
+
+		wgpu::RenderPassEncoder pass = ctx->begin(encoder);
 		pass.setViewport(0, 0, size, size, 0, 1);
 		pass.setScissorRect(0, 0, size, size);
 
-		renderItems(pass, frameCache, indicesToRender, true, face.faceIndex);
+		complete = renderItems(pass, frameCache, faceIndices[face.faceIndex], true, m_shadowPassCubeBindGroup, face.faceIndex) && complete;
 
 		ctx->end(pass);
 	}
 
 	m_context->submitCommandEncoder(encoder, "Shadow Cube");
+	return complete;
 }
 
 std::shared_ptr<webgpu::WebGPUPipeline> ShadowPass::getOrCreatePipeline(Topology::Type topology, bool isCube)
@@ -410,60 +789,76 @@ std::shared_ptr<webgpu::WebGPUPipeline> ShadowPass::getOrCreatePipeline(Topology
 	return pipeline;
 }
 
-void ShadowPass::renderItems(
+bool ShadowPass::renderItems(
 	wgpu::RenderPassEncoder &pass,
 	FrameCache &frameCache,
 	const std::vector<size_t> &indices,
 	bool isCube,
-	uint32_t faceIdx
+	const std::shared_ptr<webgpu::WebGPUBindGroup> &passBindGroup,
+	uint32_t firstInstance
 )
 {
 	if (indices.empty())
-		return;
+		return true;
 
 	BindGroupBinder binder(&frameCache);
 	std::shared_ptr<webgpu::WebGPUPipeline> pipeline;
 	const webgpu::WebGPUMesh *mesh = nullptr;
+	bool complete = true;
 
-	auto shadowBG = isCube ? m_shadowPassCubeBindGroup[faceIdx] : m_shadowPass2DBindGroup;
 	auto shadowType = isCube ? BindGroupType::ShadowPassCube : BindGroupType::ShadowPass2D;
 
+	BindGroupSet bindGroups;
+	bindGroups.set(shadowType, passBindGroup);
+
 	for (size_t idx : indices)
 	{
 		if (idx >= frameCache.gpuRenderItems.size() || !frameCache.gpuRenderItems[idx].has_value())
+		{
+			complete = false;
 			continue;
+		}
 
 		const auto &item = frameCache.gpuRenderItems[idx].value();
 		if (!item.gpuMesh || !item.objectBindGroup)
+		{
+			complete = false;
 			continue;
-
-		auto cpuMesh = item.gpuMesh->getCPUHandle().get();
-		if (!cpuMesh.has_value())
-			continue;
+		}
 
 		if (item.gpuMesh != mesh)
 		{
-			pipeline = getOrCreatePipeline(cpuMesh.value()->getTopology(), isCube);
+			pipeline = getOrCreatePipeline(item.gpuMesh->getTopology(), isCube);
 			if (!pipeline || !pipeline->isValid())
+			{
+				complete = false;
 				continue;
+			}
 
 			pass.setPipeline(pipeline->getPipeline());
 			mesh = item.gpuMesh;
 			mesh->bindBuffers(pass, pipeline->getVertexLayout());
 		}
 
-		binder.bind(pass, pipeline, 0, {{BindGroupType::Object, item.objectBindGroup}, {shadowType, shadowBG}});
+		bindGroups.set(BindGroupType::Object, item.objectBindGroup);
+		binder.bind(pass, pipeline, 0, bindGroups);
 
 		item.gpuMesh->isIndexed()
-			? pass.drawIndexed(item.submesh.indexCount, 1, item.submesh.indexOffset, 0, 0)
-			: pass.draw(item.submesh.indexCount, 1, item.submesh.indexOffset, 0);
+			? pass.drawIndexed(item.submesh.indexCount, 1, item.submesh.indexOffset, 0, firstInstance)
+			: pass.draw(item.submesh.indexCount, 1, item.submesh.indexOffset, firstInstance);
 	}
+	return complete;
 }
 
 void ShadowPass::cleanup()
 {
 	m_pipelineCache.clear();
 	m_cubePipelineCache.clear();
+	m_atlas.clear();
+	m_tileSignatures.clear();
+	m_cubeSignatures.clear();
+	m_cascadeStates.clear();
+	m_cascadeCasters.clear();
 }
 
 } // namespace engine::rendering
\ No newline at end of file
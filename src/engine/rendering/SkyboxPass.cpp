@@ -1,4 +1,5 @@
 #include "engine/rendering/SkyboxPass.h"
+#include "engine/core/Profiler.h"
 
 #include <spdlog/spdlog.h>
 
@@ -32,6 +33,7 @@ bool SkyboxPass::initialize()
 
 void SkyboxPass::render(FrameCache &frameCache)
 {
+	ENGINE_PROFILE_SCOPE("SkyboxPass::render");
 	if (!m_renderPassContext || !m_environmentBindGroup)
 	{
 		return;
@@ -0,0 +1,370 @@
+#include "engine/rendering/StaticDrawCache.h"
+#include "engine/core/Hash.h"
+#include "engine/core/Profiler.h"
+
+#include <spdlog/spdlog.h>
+
+#include "engine/rendering/FrameCache.h"
+#include "engine/rendering/Material.h"
+#include "engine/rendering/Mesh.h"
+#include "engine/rendering/RenderItemGPU.h"
+#include "engine/rendering/Vertex.h"
+#include "engine/rendering/webgpu/WebGPUBindGroup.h"
+#include "engine/rendering/webgpu/WebGPUContext.h"
+#include "engine/rendering/webgpu/WebGPUMaterial.h"
+#include "engine/rendering/webgpu/WebGPUMesh.h"
+#include "engine/rendering/webgpu/WebGPUPipeline.h"
+#include "engine/rendering/webgpu/WebGPUPipelineManager.h"
+#include "engine/rendering/webgpu/WebGPURenderPassContext.h"
+#include "engine/rendering/webgpu/WebGPUResidencyManager.h"
+#include "engine/rendering/webgpu/WebGPUShaderInfo.h"
+
+namespace engine::rendering
+{
+
+StaticDrawCache::StaticDrawCache(std::shared_ptr<webgpu::WebGPUContext> context) :
+	m_context(std::move(context))
+{
+}
+
+StaticDrawCache::~StaticDrawCache()
+{
+	clear();
+}
+
+template <typename Encoder>
+void StaticDrawCache::replay(Encoder &encoder, const std::vector<const DrawPacket *> &packets, const PassGroupHandles &passGroups)
+{
+	const webgpu::WebGPUPipeline *currentPipeline = nullptr;
+	std::array<WGPUBindGroup, BindGroupBinder::MAX_BIND_GROUPS> bound{};
+	WGPUBuffer currentVertexBuffer = nullptr;
+	WGPUBuffer currentIndexBuffer = nullptr;
+
+	auto setGroup = [&](uint32_t index, wgpu::BindGroup group)
+	{
+		if (!group || bound[index] == static_cast<WGPUBindGroup>(group))
+			return;
+		encoder.setBindGroup(index, group, 0, nullptr);
+		bound[index] = group;
+	};
+
+	for (const DrawPacket *packet : packets)
+	{
+		if (packet->pipeline.get() != currentPipeline)
+		{
+			currentPipeline = packet->pipeline.get();
+			encoder.setPipeline(currentPipeline->getPipeline());
+			for (const auto &slot : currentPipeline->getShaderInfo()->getBindGroupSlots())
+			{
+				if (slot.type != BindGroupType::Object && slot.type != BindGroupType::Material)
+					setGroup(slot.groupIndex, passGroups[static_cast<size_t>(slot.type)]);
+			}
+		}
+
+		if (packet->objectSlot != NO_SLOT)
+			setGroup(packet->objectSlot, packet->objectGroup);
+		if (packet->materialSlot != NO_SLOT)
+			setGroup(packet->materialSlot, packet->materialGroup);
+
+		if (static_cast<WGPUBuffer>(packet->vertexBuffer) != currentVertexBuffer)
+		{
+			currentVertexBuffer = packet->vertexBuffer;
+			encoder.setVertexBuffer(0, packet->vertexBuffer, 0, packet->vertexBufferSize);
+		}
+
+		if (packet->indexBuffer)
+		{
+			if (static_cast<WGPUBuffer>(packet->indexBuffer) != currentIndexBuffer)
+			{
+				currentIndexBuffer = packet->indexBuffer;
+				encoder.setIndexBuffer(packet->indexBuffer, wgpu::IndexFormat::Uint32, 0, packet->indexBufferSize);
+			}
+			encoder.drawIndexed(packet->indexCount, 1, packet->indexOffset, 0, packet->firstInstance);
+		}
+		else
+		{
+			encoder.draw(packet->indexCount, 1, packet->indexOffset, packet->firstInstance);
+		}
+	}
+}
+
+void StaticDrawCache::draw(
+	wgpu::RenderPassEncoder &renderPass,
+	FrameCache &frameCache,
+	const std::shared_ptr<webgpu::WebGPURenderPassContext> &passContext,
+	uint64_t cameraId,
+	const BindGroupSet &passGroups,
+	const std::vector<size_t> &visibleIndices,
+	std::vector<size_t> &outDynamicIndices,
+	bool depthPrepassed
+)
+{
+	ENGINE_PROFILE_SCOPE("StaticDrawCache::draw");
+	outDynamicIndices.clear();
+	m_lastDrawCount = 0;
+	m_lastCompileCount = 0;
+	m_lastBundleUsed = false;
+	m_lastBundleRecorded = false;
+
+	auto &cache = m_cameras[cameraId];
+	cache.frame++;
+
+	// Target formats, depth mode or reloaded pipelines invalidate every packet of this camera
+	auto colorTexture = passContext->getColorTexture(0);
+	auto depthTexture = passContext->getDepthTexture();
+	const auto colorFormat = colorTexture ? colorTexture->getFormat() : wgpu::TextureFormat::Undefined;
+	const auto depthFormat = depthTexture ? depthTexture->getFormat() : wgpu::TextureFormat::Undefined;
+	const uint64_t generation = m_context->pipelineManager().getGeneration();
+	const uint64_t residencyGeneration = m_context->residencyManager().getGeneration();
+	if (cache.colorFormat != colorFormat || cache.depthFormat != depthFormat || cache.depthPrepassed != depthPrepassed
+		|| cache.pipelineGeneration != generation || cache.residencyGeneration != residencyGeneration)
+	{
+		cache.packets.clear();
+		releaseBundle(cache);
+		cache.colorFormat = colorFormat;
+		cache.depthFormat = depthFormat;
+		cache.depthPrepassed = depthPrepassed;
+		cache.pipelineGeneration = generation;
+		cache.residencyGeneration = residencyGeneration;
+	}
+
+	// Resolve pass-wide groups once; the Frame group comes from the per-camera cache
+	PassGroupHandles passHandles{};
+	for (size_t type = 0; type < BIND_GROUP_TYPE_COUNT; ++type)
+	{
+		if (const auto *group = passGroups.get(static_cast<BindGroupType>(type)))
+			passHandles[type] = group->getBindGroup();
+	}
+	if (!passHandles[static_cast<size_t>(BindGroupType::Frame)])
+	{
+		auto frameIt = frameCache.frameBindGroupCache.find(cameraId);
+		if (frameIt != frameCache.frameBindGroupCache.end() && frameIt->second)
+			passHandles[static_cast<size_t>(BindGroupType::Frame)] = frameIt->second->getBindGroup();
+	}
+
+	uint64_t signature = core::FNV1A_64_OFFSET;
+	for (const auto &handle : passHandles)
+		signature = core::hashCombine(signature, reinterpret_cast<uint64_t>(static_cast<WGPUBindGroup>(handle)));
+
+	cache.visible.clear();
+	const auto &gpuItems = frameCache.gpuRenderItems;
+	for (size_t index : visibleIndices)
+	{
+		if (index >= gpuItems.size() || !gpuItems[index].has_value())
+		{
+			outDynamicIndices.push_back(index);
+			continue;
+		}
+
+		const auto &item = gpuItems[index].value();
+		if (!item.isStatic || item.objectID == 0 || !item.gpuMesh || !item.gpuMaterial || !item.objectBindGroup)
+		{
+			outDynamicIndices.push_back(index);
+			continue;
+		}
+
+		const uint64_t key = packetKey(item);
+		auto it = cache.packets.find(key);
+		if (it == cache.packets.end() || !isPacketValid(it->second, item))
+		{
+			// The bundle holds the handles of the old packet: it has to be recorded again
+			releaseBundle(cache);
+			auto packet = compile(item, passContext, depthPrepassed);
+			if (!packet.has_value())
+			{
+				if (it != cache.packets.end())
+					cache.packets.erase(it);
+				outDynamicIndices.push_back(index);
+				continue;
+			}
+			it = cache.packets.insert_or_assign(key, std::move(packet.value())).first;
+			m_lastCompileCount++;
+		}
+
+		it->second.lastUsedFrame = cache.frame;
+		cache.visible.push_back(&it->second);
+		signature = core::hashCombine(signature, key);
+	}
+
+	m_lastDrawCount = cache.visible.size();
+	if (!cache.visible.empty())
+	{
+		// Record a bundle once the visible set held still for a frame, then reuse it until it changes
+		const bool stable = (signature == cache.lastSignature) && m_lastCompileCount == 0;
+		if (m_bundlesEnabled && stable && (!cache.bundle || cache.bundleSignature != signature))
+			recordBundle(cache, passHandles, signature);
+
+		if (m_bundlesEnabled && cache.bundle && cache.bundleSignature == signature)
+		{
+			renderPass.executeBundles(1, &cache.bundle);
+			m_lastBundleUsed = true;
+		}
+		else
+		{
+			replay(renderPass, cache.visible, passHandles);
+		}
+	}
+	cache.lastSignature = signature;
+
+	if (cache.frame % EVICT_INTERVAL == 0)
+		evict(cache);
+}
+
+void StaticDrawCache::clear()
+{
+	for (auto &[cameraId, cache] : m_cameras)
+		releaseBundle(cache);
+	m_cameras.clear();
+}
+
+uint64_t StaticDrawCache::packetKey(const RenderItemGPU &item)
+{
+	uint64_t key = core::hashCombine(core::FNV1A_64_OFFSET, item.objectID);
+	key = core::hashCombine(key, reinterpret_cast<uint64_t>(item.gpuMesh));
+	return core::hashCombine(key, (static_cast<uint64_t>(item.submesh.indexOffset) << 32) | item.submesh.indexCount);
+}
+
+bool StaticDrawCache::isPacketValid(const DrawPacket &packet, const RenderItemGPU &item)
+{
+	return packet.mesh == item.gpuMesh
+		   && packet.material == item.gpuMaterial.get()
+		   && packet.objectBindGroup == item.objectBindGroup.get()
+		   && packet.materialBindGroup == item.gpuMaterial->getBindGroup().get()
+		   && packet.firstInstance == item.gpuMaterial->getMaterialIndex()
+		   && packet.meshVersion == item.gpuMesh->getSyncedVersion()
+		   && packet.materialVersion == item.gpuMaterial->getSyncedVersion();
+}
+
+std::optional<StaticDrawCache::DrawPacket> StaticDrawCache::compile(
+	const RenderItemGPU &item,
+	const std::shared_ptr<webgpu::WebGPURenderPassContext> &passContext,
+	bool depthPrepassed
+)
+{
+	auto pipeline = m_context->pipelineManager().getOrCreatePipeline(
+		*item.gpuMesh,
+		*item.gpuMaterial,
+		passContext,
+		depthPrepassed && item.gpuMaterial->getPipelineState().depthPrepassEligible
+	);
+	if (!pipeline || !pipeline->isValid() || !pipeline->getShaderInfo())
+		return std::nullopt;
+
+	DrawPacket packet;
+	for (const auto &slot : pipeline->getShaderInfo()->getBindGroupSlots())
+	{
+		if (slot.groupIndex >= BindGroupBinder::MAX_BIND_GROUPS)
+			return std::nullopt;
+
+		switch (slot.type)
+		{
+			case BindGroupType::Object:
+				packet.objectSlot = static_cast<uint8_t>(slot.groupIndex);
+				break;
+			case BindGroupType::Material:
+				packet.materialSlot = static_cast<uint8_t>(slot.groupIndex);
+				break;
+			case BindGroupType::Frame:
+			case BindGroupType::Light:
+			case BindGroupType::Shadow:
+			case BindGroupType::Environment:
+				break;
+			default:
+				// Custom groups are recreated every frame, others are not pass-wide: keep on the regular path
+				return std::nullopt;
+		}
+	}
+
+	const auto &materialBindGroup = item.gpuMaterial->getBindGroup();
+	if (packet.materialSlot != NO_SLOT && !materialBindGroup)
+		return std::nullopt;
+
+	const auto &vertexEntry = item.gpuMesh->ensureBufferForLayout(pipeline->getVertexLayout());
+	packet.vertexBuffer = vertexEntry.buffer;
+	packet.vertexBufferSize = static_cast<uint64_t>(vertexEntry.count) * Vertex::getStride(pipeline->getVertexLayout());
+	if (item.gpuMesh->isIndexed())
+	{
+		packet.indexBuffer = item.gpuMesh->getIndexBuffer();
+		packet.indexBufferSize = static_cast<uint64_t>(item.gpuMesh->getIndexCount()) * sizeof(uint32_t);
+	}
+	packet.indexCount = item.submesh.indexCount;
+	packet.indexOffset = item.submesh.indexOffset;
+	packet.firstInstance = item.gpuMaterial->getMaterialIndex();
+
+	packet.pipeline = std::move(pipeline);
+	packet.objectGroup = item.objectBindGroup->getBindGroup();
+	packet.materialGroup = materialBindGroup ? materialBindGroup->getBindGroup() : nullptr;
+	packet.mesh = item.gpuMesh;
+	packet.material = item.gpuMaterial.get();
+	packet.objectBindGroup = item.objectBindGroup.get();
+	packet.materialBindGroup = materialBindGroup.get();
+	packet.meshVersion = item.gpuMesh->getSyncedVersion();
+	packet.materialVersion = item.gpuMaterial->getSyncedVersion();
+	return packet;
+}
+
+void StaticDrawCache::recordBundle(CameraCache &cache, const PassGroupHandles &passGroups, uint64_t signature)
+{
+	ENGINE_PROFILE_SCOPE("StaticDrawCache::recordBundle");
+	releaseBundle(cache);
+
+	wgpu::RenderBundleEncoderDescriptor desc{};
+	desc.label = "Static Draws";
+	desc.colorFormatCount = cache.colorFormat != wgpu::TextureFormat::Undefined ? 1 : 0;
+	desc.colorFormats = reinterpret_cast<const WGPUTextureFormat *>(&cache.colorFormat);
+	desc.depthStencilFormat = cache.depthFormat;
+	desc.sampleCount = 1; // matches WebGPUPipelineManager
+	desc.depthReadOnly = false;
+	desc.stencilReadOnly = false;
+
+	wgpu::RenderBundleEncoder encoder = m_context->getDevice().createRenderBundleEncoder(desc);
+	if (!encoder)
+	{
+		spdlog::warn("StaticDrawCache: Failed to create render bundle encoder, replaying packets directly");
+		m_bundlesEnabled = false;
+		return;
+	}
+
+	replay(encoder, cache.visible, passGroups);
+
+	wgpu::RenderBundleDescriptor bundleDesc{};
+	bundleDesc.label = "Static Draws";
+	cache.bundle = encoder.finish(bundleDesc);
+	cache.bundleSignature = signature;
+	encoder.release();
+	m_lastBundleRecorded = true;
+	m_bundleRecordCount++;
+
+	spdlog::debug("StaticDrawCache: Recorded render bundle with {} draws", cache.visible.size());
+}
+
+void StaticDrawCache::releaseBundle(CameraCache &cache)
+{
+	if (cache.bundle)
+	{
+		cache.bundle.release();
+		cache.bundle = nullptr;
+	}
+	cache.bundleSignature = 0;
+}
+
+void StaticDrawCache::evict(CameraCache &cache)
+{
+	bool erased = false;
+	for (auto it = cache.packets.begin(); it != cache.packets.end();)
+	{
+		if (cache.frame - it->second.lastUsedFrame > EVICT_AFTER_FRAMES)
+		{
+			it = cache.packets.erase(it);
+			erased = true;
+		}
+		else
+		{
+			++it;
+		}
+	}
+	if (erased)
+		releaseBundle(cache);
+}
+
+} // namespace engine::rendering
@@ -71,18 +71,20 @@ std::shared_ptr<WebGPUBindGroup> WebGPUBindGroupFactory::createBindGroup(
 		auto resourceIt = std::find_if(resources.begin(), resources.end(), [&entryLayout](const auto &pair)
 									   { return std::get<1>(pair.first) == entryLayout.binding; });
 		bool hasOverride = (resourceIt != resources.end());
+		// Plain 2D textures bound to texture_2d_array bindings are viewed as a single-layer array
+		const bool arrayView = entryLayout.texture.viewDimension == wgpu::TextureViewDimension::_2DArray;
 
 		if (hasOverride)
 		{
 			// Use the provided override resource
 			const auto &bindResource = resourceIt->second;
-			std::visit([&entry](const auto &resource)
+			std::visit([&entry, arrayView](const auto &resource)
 					   {
 				using T = std::decay_t<decltype(resource)>;
 				
 				if constexpr (std::is_same_v<T, std::shared_ptr<WebGPUTexture>>)
 				{
-					entry.textureView = resource->getTextureView();
+					entry.textureView = arrayView ? resource->getArrayView() : resource->getTextureView();
 				}
 				else if constexpr (std::is_same_v<T, wgpu::Sampler>)
 				{
@@ -129,14 +131,15 @@ std::shared_ptr<WebGPUBindGroup> WebGPUBindGroupFactory::createBindGroup(
 				auto tex = material->getTexture(slotName);
 				if (tex)
 				{
-					entry.textureView = tex->getTextureView();
+					entry.textureView = arrayView ? tex->getArrayView() : tex->getTextureView();
 				}
 				else
 				{
 					auto fallbackColor = layoutInfo->getMaterialFallbackColor(entryLayout.binding);
 					if (fallbackColor.has_value())
 					{
-						entry.textureView = m_context.textureFactory().createFromColor(fallbackColor.value())->getTextureView();
+						auto fallback = m_context.textureFactory().createFromColor(fallbackColor.value());
+						entry.textureView = arrayView ? fallback->getArrayView() : fallback->getTextureView();
 					}
 					else
 					{
@@ -25,7 +25,65 @@ WebGPUContext::WebGPUContext() :
 void WebGPUContext::initialize(void *windowHandle, bool enableVSync, const std::optional<DeviceLimitsConfig> &limits)
 {
 	m_lastWindowHandle = windowHandle;
+	m_headless = false;
 
+	initFactories();
+
+	// Order matters: surface must exist before adapter so compatibleSurface is set correctly
+	initSurface(windowHandle);
+	initAdapter();
+	initDevice(limits);
+	initDeviceServices();
+
+	// ToDo: Move this to the surface manager
+	auto *sdlWindow = static_cast<SDL_Window *>(windowHandle);
+	int width = 0, height = 0;
+	SDL_GetWindowSizeInPixels(sdlWindow, &width, &height);
+
+	WebGPUSurfaceManager::Config config;
+	config.format = getSwapChainFormat();
+	config.width = width;
+	config.height = height;
+	config.presentMode = enableVSync ? wgpu::PresentMode::Fifo : wgpu::PresentMode::Immediate;
+	m_surfaceManager->reconfigure(config);
+
+	spdlog::info("[WebGPU] Initialized. Surface {}x{}, vsync: {}.", width, height, enableVSync);
+}
+
+void WebGPUContext::initializeHeadless(uint32_t width, uint32_t height, const std::optional<DeviceLimitsConfig> &limits, bool forceFallbackAdapter)
+{
+	m_lastWindowHandle = nullptr;
+	m_headless = true;
+
+	initFactories();
+	initAdapter(forceFallbackAdapter);
+	initDevice(limits);
+	initDeviceServices();
+
+	WebGPUSurfaceManager::Config config;
+	config.format = getSwapChainFormat();
+	config.width = width;
+	config.height = height;
+	config.usage = wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::CopySrc;
+	m_surfaceManager->reconfigure(config);
+
+	spdlog::info("[WebGPU] Initialized headless. Offscreen target {}x{}.", width, height);
+}
+
+void WebGPUContext::pollDevice(bool wait)
+{
+#ifdef WEBGPU_BACKEND_WGPU
+	wgpuDevicePoll(m_device, wait, nullptr);
+#elif defined(WEBGPU_BACKEND_DAWN)
+	(void)wait;
+	m_device.tick();
+#else
+	(void)wait;
+#endif
+}
+
+void WebGPUContext::initFactories()
+{
 	m_surfaceManager = std::make_unique<WebGPUSurfaceManager>(*this);
 	m_bufferFactory = std::make_unique<WebGPUBufferFactory>(*this);
 	m_meshFactory = std::make_unique<WebGPUMeshFactory>(*this);
@@ -40,6 +98,8 @@ void WebGPUContext::initialize(void *windowHandle, bool enableVSync, const std::
 	m_renderPassFactory = std::make_unique<WebGPURenderPassFactory>(*this);
 	m_shaderFactory = std::make_unique<WebGPUShaderFactory>(*this);
 	m_pipelineManager = std::make_unique<WebGPUPipelineManager>(*this);
+	m_syncTracker = std::make_unique<WebGPUSyncTracker>();
+	m_residencyManager = std::make_unique<WebGPUResidencyManager>(*this);
 #ifdef __EMSCRIPTEN__
 	m_instance = wgpu::wgpuCreateInstance(nullptr);
 #else
@@ -50,11 +110,13 @@ void WebGPUContext::initialize(void *windowHandle, bool enableVSync, const std::
 		spdlog::critical("[WebGPU] Failed to create WebGPU instance.");
 		assert(false);
 	}
+}
 
-	// Order matters: surface must exist before adapter so compatibleSurface is set correctly
-	initSurface(windowHandle);
-	initAdapter();
-	initDevice(limits);
+void WebGPUContext::initDeviceServices()
+{
+	m_passTimer = std::make_unique<WebGPUPassTimer>(*this);
+	m_passTimer->initialize(m_timestampQuerySupported);
+	m_readbackService = std::make_unique<WebGPUReadbackService>(*this);
 
 	// Initialize ShaderRegistry after device is ready
 	m_shaderRegistry = std::make_unique<ShaderRegistry>(*this);
@@ -63,20 +125,6 @@ void WebGPUContext::initialize(void *windowHandle, bool enableVSync, const std::
 		spdlog::critical("[WebGPU] Failed to initialize default shaders.");
 		assert(false);
 	}
-
-	// ToDo: Move this to the surface manager
-	auto *sdlWindow = static_cast<SDL_Window *>(windowHandle);
-	int width = 0, height = 0;
-	SDL_GetWindowSizeInPixels(sdlWindow, &width, &height);
-
-	WebGPUSurfaceManager::Config config;
-	config.format = getSwapChainFormat();
-	config.width = width;
-	config.height = height;
-	config.presentMode = enableVSync ? wgpu::PresentMode::Fifo : wgpu::PresentMode::Immediate;
-	m_surfaceManager->reconfigure(config);
-
-	spdlog::info("[WebGPU] Initialized. Surface {}x{}, vsync: {}.", width, height, enableVSync);
 }
 
 void WebGPUContext::initSurface(void *windowHandle)
@@ -101,12 +149,21 @@ void WebGPUContext::initSurface(void *windowHandle)
 	m_surface = wgpu::Surface(rawSurface);
 }
 
-void WebGPUContext::initAdapter()
+void WebGPUContext::initAdapter(bool forceFallbackAdapter)
 {
 	wgpu::RequestAdapterOptions adapterOpts{};
 	adapterOpts.compatibleSurface = m_surface;
+	adapterOpts.forceFallbackAdapter = forceFallbackAdapter;
 	m_adapter = m_instance.requestAdapter(adapterOpts);
 
+	// Headless runs (CI, build farm) may have no GPU at all: fall back to the software adapter
+	if (!m_adapter && m_headless && !forceFallbackAdapter)
+	{
+		spdlog::warn("[WebGPU] No hardware adapter available, requesting fallback adapter.");
+		adapterOpts.forceFallbackAdapter = true;
+		m_adapter = m_instance.requestAdapter(adapterOpts);
+	}
+
 	if (!m_adapter)
 	{
 		spdlog::critical("[WebGPU] Failed to acquire a compatible adapter.");
@@ -142,10 +199,26 @@ void WebGPUContext::initDevice(const std::optional<DeviceLimitsConfig> &limits)
 	// Store what was actually resolved for later inspection via resolvedLimits()
 	m_resolvedLimits = requiredLimits.limits;
 
+	// --------------- Optional features ---------------
+	std::vector<wgpu::FeatureName> requiredFeatures;
+	m_timestampQuerySupported = m_adapter.hasFeature(wgpu::FeatureName::TimestampQuery);
+	if (m_timestampQuerySupported)
+		requiredFeatures.push_back(wgpu::FeatureName::TimestampQuery);
+	m_textureCompressionBCSupported = m_adapter.hasFeature(wgpu::FeatureName::TextureCompressionBC);
+	if (m_textureCompressionBCSupported)
+		requiredFeatures.push_back(wgpu::FeatureName::TextureCompressionBC);
+	m_textureCompressionETC2Supported = m_adapter.hasFeature(wgpu::FeatureName::TextureCompressionETC2);
+	if (m_textureCompressionETC2Supported)
+		requiredFeatures.push_back(wgpu::FeatureName::TextureCompressionETC2);
+	m_textureCompressionASTCSupported = m_adapter.hasFeature(wgpu::FeatureName::TextureCompressionASTC);
+	if (m_textureCompressionASTCSupported)
+		requiredFeatures.push_back(wgpu::FeatureName::TextureCompressionASTC);
+
 	// --------------- Request device ---------------
 	wgpu::DeviceDescriptor deviceDesc{};
 	deviceDesc.label = "WebGPUContext Device";
-	deviceDesc.requiredFeatureCount = 0;
+	deviceDesc.requiredFeatureCount = requiredFeatures.size();
+	deviceDesc.requiredFeatures = reinterpret_cast<const WGPUFeatureName *>(requiredFeatures.data());
 	deviceDesc.requiredLimits = &requiredLimits;
 	deviceDesc.defaultQueue.label = "Default Queue";
 	m_device = m_adapter.requestDevice(deviceDesc);
@@ -172,10 +245,14 @@ void WebGPUContext::initDevice(const std::optional<DeviceLimitsConfig> &limits)
 	}
 
 	// --------------- Swap chain format ---------------
+	// Headless: RGBA8 so the offscreen target can be read back and written as PNG directly
+	if (m_headless)
+		m_swapChainFormat = wgpu::TextureFormat::RGBA8Unorm;
+	else
 #ifdef WEBGPU_BACKEND_WGPU
-	m_swapChainFormat = m_surface.getPreferredFormat(m_adapter);
+		m_swapChainFormat = m_surface.getPreferredFormat(m_adapter);
 #else
-	m_swapChainFormat = wgpu::TextureFormat::BGRA8Unorm;
+		m_swapChainFormat = wgpu::TextureFormat::BGRA8Unorm;
 #endif
 
 	if (m_swapChainFormat == wgpu::TextureFormat::Undefined)
@@ -195,6 +272,40 @@ wgpu::SupportedLimits WebGPUContext::getHardwareLimits() const
 	return limits;
 }
 
+bool WebGPUContext::supportsBlockCompression(engine::resources::BlockCompression::Type compression) const
+{
+	using engine::resources::BlockCompression;
+	switch (compression)
+	{
+	case BlockCompression::Type::BC1_RGBA:
+	case BlockCompression::Type::BC3_RGBA:
+	case BlockCompression::Type::BC4_R:
+	case BlockCompression::Type::BC5_RG:
+	case BlockCompression::Type::BC7_RGBA:
+		return m_textureCompressionBCSupported;
+	case BlockCompression::Type::ETC2_RGB8:
+	case BlockCompression::Type::ETC2_RGBA8:
+		return m_textureCompressionETC2Supported;
+	case BlockCompression::Type::ASTC_4x4:
+		return m_textureCompressionASTCSupported;
+	default:
+		return false;
+	}
+}
+
+std::vector<engine::resources::BlockCompression::Type> WebGPUContext::getSupportedBlockCompression() const
+{
+	using engine::resources::BlockCompression;
+	std::vector<BlockCompression::Type> formats;
+	for (size_t i = 0; i < BlockCompression::size(); ++i)
+	{
+		const auto compression = static_cast<BlockCompression::Type>(i);
+		if (supportsBlockCompression(compression))
+			formats.push_back(compression);
+	}
+	return formats;
+}
+
 void WebGPUContext::updatePresentMode(bool enableVSync)
 {
 	if (!m_surfaceManager)
@@ -220,7 +331,7 @@ void WebGPUContext::terminateSurface()
 
 wgpu::Surface WebGPUContext::getSurface()
 {
-	if (!m_surface)
+	if (!m_surface && !m_headless)
 	{
 		initSurface(m_lastWindowHandle);
 	}
@@ -362,4 +473,40 @@ WebGPUPipelineManager &WebGPUContext::pipelineManager()
 	}
 	return *m_pipelineManager;
 }
+
+WebGPUPassTimer &WebGPUContext::passTimer()
+{
+	if (!m_passTimer)
+	{
+		throw std::runtime_error("WebGPUPassTimer not initialized!");
+	}
+	return *m_passTimer;
+}
+
+WebGPUSyncTracker &WebGPUContext::syncTracker()
+{
+	if (!m_syncTracker)
+	{
+		throw std::runtime_error("WebGPUSyncTracker not initialized!");
+	}
+	return *m_syncTracker;
+}
+
+WebGPUReadbackService &WebGPUContext::readbackService()
+{
+	if (!m_readbackService)
+	{
+		throw std::runtime_error("WebGPUReadbackService not initialized!");
+	}
+	return *m_readbackService;
+}
+
+WebGPUResidencyManager &WebGPUContext::residencyManager()
+{
+	if (!m_residencyManager)
+	{
+		throw std::runtime_error("WebGPUResidencyManager not initialized!");
+	}
+	return *m_residencyManager;
+}
 } // namespace engine::rendering::webgpu
@@ -2,7 +2,10 @@
 #include "engine/rendering/ShaderRegistry.h"
 #include "engine/rendering/webgpu/WebGPUBindGroupLayoutInfo.h"
 #include "engine/rendering/webgpu/WebGPUContext.h"
+#include "engine/rendering/webgpu/WebGPUMaterialFactory.h"
 #include "engine/rendering/webgpu/WebGPUShaderInfo.h"
+#include <algorithm>
+
 #include <spdlog/spdlog.h>
 
 namespace engine::rendering::webgpu
@@ -17,44 +20,21 @@ WebGPUMaterial::WebGPUMaterial(
 	m_textures(std::move(textures)),
 	m_options(std::move(options))
 {
-	// Cache initial texture versions
-	const auto &cpuMaterial = getCPUObject();
-	cacheTextureVersions(cpuMaterial);
-}
-
-bool WebGPUMaterial::needsSync(const Material &cpuMaterial) const
-{
-	// Check material version
-	if (cpuMaterial.getVersion() > m_lastSyncedVersion)
-		return true;
-
-	// Check if any texture versions changed
-	for (const auto &[slotName, textureSlot] : cpuMaterial.getTextureSlots())
-	{
-		if (!textureSlot.handle.valid())
-			continue;
-
-		auto texOpt = textureSlot.handle.get();
-		if (!texOpt.has_value())
-			continue;
-
-		auto &tex = texOpt.value();
-
-		// Check cached texture version
-		auto it = m_textureVersions.find(slotName);
-		if (it == m_textureVersions.end() || it->second < tex->getVersion())
-			return true;
-	}
-
-	return false;
+	// Material and texture changes are pushed by the sync tracker, no per-frame polling
+	enableChangeTracking();
+	updatePipelineState(getCPUObject());
 }
 
 void WebGPUMaterial::syncFromCPU(const Material &cpuMaterial)
 {
+	// Register before reading so a concurrent change is reported for the next frame
+	watchSources(cpuMaterial);
+
 	// Determine shader type and custom shader
 	const std::string &shaderName = cpuMaterial.getShader();
 	// ToDo: bool shaderChanged = shaderName != m_shaderName;
 	m_shaderName = shaderName;
+	updatePipelineState(cpuMaterial);
 
 	// Get shader info
 	std::shared_ptr<WebGPUShaderInfo> shaderInfo =
@@ -73,10 +53,20 @@ void WebGPUMaterial::syncFromCPU(const Material &cpuMaterial)
 		return;
 	}
 
-	if (!m_materialBindGroup || layout != m_materialBindGroup->getLayoutInfo())
+	// Shared with the materials resolving to the same textures (or texture array pages)
+	auto slot = m_context.materialFactory().acquireBatchSlot(
+		shared_from_this(),
+		cpuMaterial,
+		layout,
+		m_batchSlot
+	);
+	if (!slot.has_value())
 	{
-		m_materialBindGroup = m_context.bindGroupFactory().createBindGroup(layout, {}, shared_from_this());
+		spdlog::warn("WebGPUMaterial: Failed to acquire material bind group");
+		return;
 	}
+	m_batchSlot = std::move(slot.value());
+	m_materialBindGroup = m_batchSlot.batch->bindGroup;
 
 	auto materialBindGroupBindingIndex = layout->getBindingIndex(bindgroup::entry::defaults::MATERIAL_PROPERTIES);
 	if(!materialBindGroupBindingIndex.has_value())
@@ -85,31 +75,72 @@ void WebGPUMaterial::syncFromCPU(const Material &cpuMaterial)
 		return;
 	}
 
-	// Update material properties buffer
+	// Update this material's entry of the properties table
 	m_materialBindGroup->updateBuffer(
 		static_cast<uint32_t>(materialBindGroupBindingIndex.value()),
 		reinterpret_cast<const uint8_t *>(cpuMaterial.getPropertiesData()),
 		cpuMaterial.getPropertiesSize(),
-		0,
+		static_cast<size_t>(m_batchSlot.index) * cpuMaterial.getPropertiesSize(),
 		m_context.getQueue()
 	);
 
-	// Update cached texture versions
-	cacheTextureVersions(cpuMaterial);
+	// Array layer of each texture, for shaders sampling texture array pages
+	auto layersBindingIndex = layout->getBindingIndex(bindgroup::entry::defaults::MATERIAL_LAYERS);
+	if (layersBindingIndex.has_value())
+	{
+		m_materialBindGroup->updateBuffer(
+			static_cast<uint32_t>(layersBindingIndex.value()),
+			&m_batchSlot.layers,
+			sizeof(MaterialTextureLayers),
+			static_cast<size_t>(m_batchSlot.index) * sizeof(MaterialTextureLayers),
+			m_context.getQueue()
+		);
+	}
+}
+
+void WebGPUMaterial::updatePipelineState(const Material &cpuMaterial)
+{
+	const auto features = cpuMaterial.getFeatureMask();
+	// Permutation of the material's shader with unused features compiled out
+	m_pipelineState.shaderId = m_context.shaderRegistry().resolveVariantId(cpuMaterial.getShader(), features);
+	m_pipelineState.cullMode = MaterialFeature::hasFlag(features, MaterialFeature::Flag::DoubleSided)
+								   ? wgpu::CullMode::None
+								   : wgpu::CullMode::Back;
+	m_pipelineState.blendEnabled = MaterialFeature::hasFlag(features, MaterialFeature::Flag::Transparent);
+	m_pipelineState.depthPrepassEligible = !m_pipelineState.blendEnabled
+										   && !MaterialFeature::hasFlag(features, MaterialFeature::Flag::AlphaTest);
+	m_pipelineState.hash = WebGPUMaterialPipelineState::computeHash(
+		m_pipelineState.shaderId,
+		m_pipelineState.cullMode,
+		m_pipelineState.blendEnabled
+	);
 }
 
-void WebGPUMaterial::cacheTextureVersions(const Material &cpuMaterial)
+void WebGPUMaterial::watchSources(const Material &cpuMaterial)
 {
-	m_textureVersions.clear();
+	auto &tracker = m_context.syncTracker();
+	auto self = shared_from_this();
+	tracker.watch(cpuMaterial, self);
+
+	std::vector<core::ChangeJournal::token_t> watched;
+	watched.reserve(cpuMaterial.getTextureSlots().size());
 	for (const auto &[slotName, textureSlot] : cpuMaterial.getTextureSlots())
 	{
 		if (!textureSlot.handle.valid())
 			continue;
 		auto texOpt = textureSlot.handle.get();
-		if (!texOpt.has_value())
+		if (!texOpt.has_value() || !texOpt.value())
 			continue;
-		m_textureVersions[slotName] = texOpt.value()->getVersion();
+		watched.push_back(tracker.watch(*texOpt.value(), self));
+	}
+
+	// Swapped-out textures must not keep notifying (and referencing) this material
+	for (auto token : m_watchedTextures)
+	{
+		if (std::find(watched.begin(), watched.end(), token) == watched.end())
+			tracker.unwatch(token, this);
 	}
+	m_watchedTextures = std::move(watched);
 }
 
 } // namespace engine::rendering::webgpu
@@ -1,13 +1,23 @@
 #include "engine/rendering/webgpu/WebGPUMaterialFactory.h"
 
+#include <algorithm>
+#include <iterator>
+#include <map>
 #include <memory>
 #include <optional>
 #include <stdexcept>
 
+#include <spdlog/spdlog.h>
+
+#include "engine/core/Hash.h"
 #include "engine/rendering/ColorSpace.h"
 #include "engine/rendering/Material.h"
+#include "engine/rendering/RenderingConstants.h"
+#include "engine/rendering/ShaderRegistry.h"
+#include "engine/rendering/webgpu/WebGPUBindGroupFactory.h"
 #include "engine/rendering/webgpu/WebGPUContext.h"
 #include "engine/rendering/webgpu/WebGPUTexture.h"
+#include "engine/rendering/webgpu/WebGPUTextureArrayPool.h"
 
 namespace engine::rendering::webgpu
 {
@@ -54,6 +64,14 @@ static std::shared_ptr<WebGPUTexture> getTextureView(
 	return texFactory.getWhiteTexture();
 }
 
+// Identifies the contents of a packed texture, so its layer is found without the source
+static uint64_t packedTextureKey(const TextureSlot &slot, const Texture &texture)
+{
+	uint64_t key = core::hashCombine(core::FNV1A_64_OFFSET, slot.handle.id());
+	key = core::hashCombine(key, static_cast<uint64_t>(slot.colorSpace));
+	return core::hashCombine(key, texture.getVersion());
+}
+
 std::shared_ptr<WebGPUMaterial> WebGPUMaterialFactory::createFromHandleUncached(
 	const engine::rendering::Material::Handle &materialHandle,
 	const WebGPUMaterialOptions &options
@@ -97,4 +115,290 @@ std::shared_ptr<WebGPUMaterial> WebGPUMaterialFactory::createFromHandleUncached(
 	return createFromHandleUncached(handle, WebGPUMaterialOptions{});
 }
 
+std::optional<WebGPUMaterialBatchSlot> WebGPUMaterialFactory::acquireBatchSlot(
+	const std::shared_ptr<WebGPUMaterial> &material,
+	const Material &cpuMaterial,
+	const std::shared_ptr<WebGPUBindGroupLayoutInfo> &layout,
+	const WebGPUMaterialBatchSlot &current
+)
+{
+	if (!material || !layout)
+		return std::nullopt;
+
+	auto &textures = m_resolvedScratch;
+	if (!resolveTextures(*material, cpuMaterial, *layout, textures))
+		return std::nullopt;
+
+	WebGPUMaterialBatchSlot slot;
+	for (size_t i = 0; i < textures.size() && i < std::size(slot.layers.layers); ++i)
+		slot.layers.layers[i] = textures[i].layer;
+	for (const auto &resolved : textures)
+	{
+		if (resolved.packed)
+			slot.packedLayers.push_back(resolved.packed);
+	}
+
+	// Still resolves to the same textures: keep the entry
+	if (current.batch && matches(*current.batch, layout.get(), textures))
+	{
+		slot.batch = current.batch;
+		slot.index = current.index;
+		return slot;
+	}
+	if (current.batch && current.index < current.batch->owners.size())
+		current.batch->owners[current.index].reset();
+
+	// The binding sizes declare how many entries the shader's tables hold
+	uint32_t capacity = constants::MAX_MATERIALS_PER_BATCH;
+	auto tableCapacity = [&layout](const char *name, size_t stride) -> uint32_t
+	{
+		auto index = layout->getBindingIndex(name);
+		const auto *binding = index.has_value() ? layout->getBinding(static_cast<uint32_t>(index.value())) : nullptr;
+		if (!binding || stride == 0)
+			return constants::MAX_MATERIALS_PER_BATCH;
+		return static_cast<uint32_t>(std::max<size_t>(1, binding->size / stride));
+	};
+	capacity = std::min(capacity, tableCapacity(bindgroup::entry::defaults::MATERIAL_PROPERTIES, cpuMaterial.getPropertiesSize()));
+	capacity = std::min(capacity, tableCapacity(bindgroup::entry::defaults::MATERIAL_LAYERS, sizeof(MaterialTextureLayers)));
+
+	uint64_t key = core::hashCombine(core::FNV1A_64_OFFSET, reinterpret_cast<uint64_t>(layout.get()));
+	for (const auto &resolved : textures)
+		key = core::hashCombine(key, reinterpret_cast<uint64_t>(resolved.texture.get()));
+
+	// Drop batches no material holds anymore
+	auto &bucket = m_batches[key];
+	bucket.erase(
+		std::remove_if(bucket.begin(), bucket.end(), [](const auto &batch)
+		{
+			return batch.use_count() == 1;
+		}),
+		bucket.end()
+	);
+
+	for (const auto &batch : bucket)
+	{
+		if (!matches(*batch, layout.get(), textures))
+			continue;
+
+		auto freeIt = std::find_if(batch->owners.begin(), batch->owners.end(), [](const auto &owner)
+		{
+			return owner.expired();
+		});
+		if (freeIt != batch->owners.end())
+		{
+			*freeIt = material;
+			slot.index = static_cast<uint32_t>(std::distance(batch->owners.begin(), freeIt));
+		}
+		else if (batch->owners.size() < batch->capacity)
+		{
+			slot.index = static_cast<uint32_t>(batch->owners.size());
+			batch->owners.push_back(material);
+		}
+		else
+		{
+			continue;
+		}
+		slot.batch = batch;
+		return slot;
+	}
+
+	auto batch = createBatch(material, layout, textures, capacity);
+	if (!batch)
+		return std::nullopt;
+	batch->owners.push_back(material);
+	bucket.push_back(batch);
+
+	slot.batch = std::move(batch);
+	slot.index = 0;
+	return slot;
+}
+
+size_t WebGPUMaterialFactory::getBatchCount() const
+{
+	size_t count = 0;
+	for (const auto &[key, bucket] : m_batches)
+		count += bucket.size();
+	return count;
+}
+
+size_t WebGPUMaterialFactory::pruneBatches()
+{
+	size_t released = 0;
+	for (auto it = m_batches.begin(); it != m_batches.end();)
+	{
+		auto &bucket = it->second;
+		const size_t before = bucket.size();
+		bucket.erase(
+			std::remove_if(bucket.begin(), bucket.end(), [](const auto &batch)
+			{
+				return batch.use_count() == 1;
+			}),
+			bucket.end()
+		);
+		released += before - bucket.size();
+		it = bucket.empty() ? m_batches.erase(it) : std::next(it);
+	}
+	return released;
+}
+
+bool WebGPUMaterialFactory::resolveTextures(
+	WebGPUMaterial &material,
+	const Material &cpuMaterial,
+	const WebGPUBindGroupLayoutInfo &layout,
+	std::vector<ResolvedTexture> &outTextures
+)
+{
+	outTextures.clear();
+	auto &textureFactory = m_context.textureFactory();
+	for (const auto &entry : layout.getEntries())
+	{
+		if (entry.texture.sampleType == wgpu::TextureSampleType::Undefined)
+			continue;
+
+		const std::string slotName = layout.getMaterialSlotName(entry.binding);
+		const bool packable = m_textureArraysEnabled && entry.texture.viewDimension == wgpu::TextureViewDimension::_2DArray;
+		const TextureSlot textureSlot = cpuMaterial.getTextureSlot(slotName);
+		std::shared_ptr<Texture> cpuTexture;
+		if (textureSlot.isValid())
+		{
+			auto texOpt = textureSlot.handle.get();
+			if (texOpt.has_value())
+				cpuTexture = texOpt.value();
+		}
+
+		ResolvedTexture resolved;
+		if (cpuTexture)
+		{
+			// Already packed: the source is not needed again
+			const uint64_t key = packedTextureKey(textureSlot, *cpuTexture);
+			if (packable)
+				resolved.packed = textureFactory.arrayPool().find(key);
+			if (!resolved.packed)
+			{
+				WebGPUTextureOptions options{};
+				options.colorSpace = textureSlot.colorSpace;
+				resolved.texture = textureFactory.createFromHandle(textureSlot.handle, options);
+				if (!resolved.texture)
+				{
+					spdlog::warn("Texture for slot '{}' not ready", slotName);
+					return false;
+				}
+				if (packable)
+					resolved.packed = packTexture(material, resolved.texture, key);
+			}
+
+			if (resolved.packed)
+			{
+				// The page holds the copy: drop the source so only the layer stays resident
+				material.releaseTexture(slotName);
+				textureFactory.evict(textureSlot.handle);
+			}
+			else
+			{
+				material.setTexture(slotName, resolved.texture);
+			}
+		}
+		else
+		{
+			auto fallbackColor = layout.getMaterialFallbackColor(entry.binding);
+			if (!fallbackColor.has_value())
+			{
+				spdlog::warn("Texture for slot '{}' not ready", slotName);
+				return false;
+			}
+			// Color textures stay cached for the factory's lifetime, their address identifies them
+			resolved.texture = textureFactory.createFromColor(fallbackColor.value());
+			if (packable)
+				resolved.packed = packTexture(material, resolved.texture, core::hashCombine(core::FNV1A_64_OFFSET, reinterpret_cast<uint64_t>(resolved.texture.get())));
+		}
+
+		// Unpackable textures stay bound on their own as a single-layer array
+		if (resolved.packed)
+		{
+			resolved.texture = resolved.packed->getPageTexture();
+			resolved.layer = resolved.packed->layer;
+		}
+		outTextures.push_back(std::move(resolved));
+	}
+	return true;
+}
+
+std::shared_ptr<WebGPUTextureArrayLayer> WebGPUMaterialFactory::packTexture(
+	const WebGPUMaterial &material,
+	const std::shared_ptr<WebGPUTexture> &texture,
+	uint64_t key
+)
+{
+	std::shared_ptr<WebGPUTexture> replacedPage;
+	auto layer = m_context.textureFactory().arrayPool().pack(texture, key, &replacedPage);
+	if (!replacedPage)
+		return layer;
+
+	// The page grew: materials bound to its previous texture move to the new one on their next sync
+	for (const auto &[batchKey, bucket] : m_batches)
+	{
+		for (const auto &batch : bucket)
+		{
+			if (std::find(batch->textures.begin(), batch->textures.end(), replacedPage) == batch->textures.end())
+				continue;
+			for (const auto &owner : batch->owners)
+			{
+				auto other = owner.lock();
+				if (other && other.get() != &material)
+					other->markSyncPending();
+			}
+		}
+	}
+	return layer;
+}
+
+std::shared_ptr<WebGPUMaterialBatch> WebGPUMaterialFactory::createBatch(
+	const std::shared_ptr<WebGPUMaterial> &material,
+	const std::shared_ptr<WebGPUBindGroupLayoutInfo> &layout,
+	const std::vector<ResolvedTexture> &textures,
+	uint32_t capacity
+)
+{
+	std::map<BindGroupBindingKey, BindGroupResource> resourceOverrides;
+	size_t textureIndex = 0;
+	for (const auto &entry : layout->getEntries())
+	{
+		if (entry.texture.sampleType == wgpu::TextureSampleType::Undefined)
+			continue;
+		resourceOverrides.emplace(
+			std::make_tuple(0u, entry.binding),
+			BindGroupResource(textures[textureIndex++].texture)
+		);
+	}
+
+	auto bindGroup = m_context.bindGroupFactory().createBindGroup(layout, resourceOverrides, material, "Material Batch BindGroup");
+	if (!bindGroup)
+		return nullptr;
+
+	auto batch = std::make_shared<WebGPUMaterialBatch>();
+	batch->layout = layout;
+	batch->bindGroup = std::move(bindGroup);
+	batch->capacity = capacity;
+	batch->textures.reserve(textures.size());
+	for (const auto &resolved : textures)
+		batch->textures.push_back(resolved.texture);
+	return batch;
+}
+
+bool WebGPUMaterialFactory::matches(
+	const WebGPUMaterialBatch &batch,
+	const WebGPUBindGroupLayoutInfo *layout,
+	const std::vector<ResolvedTexture> &textures
+)
+{
+	if (batch.layout.get() != layout || batch.textures.size() != textures.size())
+		return false;
+	for (size_t i = 0; i < textures.size(); ++i)
+	{
+		if (batch.textures[i] != textures[i].texture)
+			return false;
+	}
+	return true;
+}
+
 } // namespace engine::rendering::webgpu
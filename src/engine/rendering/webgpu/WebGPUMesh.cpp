@@ -40,6 +40,19 @@ void WebGPUMesh::bindBuffers(wgpu::RenderPassEncoder &renderPass, VertexLayout l
 		renderPass.setIndexBuffer(m_indexBuffer, wgpu::IndexFormat::Uint32, 0, m_indexCount * sizeof(uint32_t));
 }
 
+uint64_t WebGPUMesh::getGPUMemoryBytes() const
+{
+	wgpu::Buffer indexBuffer = m_indexBuffer;
+	uint64_t bytes = indexBuffer ? indexBuffer.getSize() : 0;
+	for (const auto &[layout, entry] : m_vertexBuffers)
+	{
+		wgpu::Buffer buffer = entry.buffer;
+		if (buffer)
+			bytes += buffer.getSize();
+	}
+	return bytes;
+}
+
 void WebGPUMesh::syncFromCPU(const Mesh &cpuMesh)
 {
 	wgpu::Buffer indexBuffer = nullptr;
@@ -48,6 +61,7 @@ void WebGPUMesh::syncFromCPU(const Mesh &cpuMesh)
 		indexBuffer = m_context.bufferFactory().createBufferWithData(cpuMesh.getIndices(), wgpu::BufferUsage::Index);
 	}
 	m_indexBuffer = indexBuffer;
+	m_topology = cpuMesh.getTopology();
 }
 
 } // namespace engine::rendering::webgpu
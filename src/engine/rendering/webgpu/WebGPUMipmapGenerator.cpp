@@ -0,0 +1,547 @@
+#include "engine/rendering/webgpu/WebGPUMipmapGenerator.h"
+#include "engine/core/Profiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+#include "engine/core/PathProvider.h"
+#include "engine/io/FileReader.h"
+#include "engine/rendering/ShaderRegistry.h"
+#include "engine/rendering/webgpu/WebGPUContext.h"
+#include "engine/rendering/webgpu/WebGPUSamplerFactory.h"
+
+#ifdef None
+#undef None
+#endif
+
+namespace engine::rendering::webgpu
+{
+
+namespace
+{
+constexpr uint32_t WORKGROUP_SIZE = 8;
+constexpr uint32_t PARAMS_SLOT_COUNT = WebGPUMipmapGenerator::MAX_LEVELS_PER_DISPATCH * 2;
+
+/** @brief Mirrors MipmapParams in mipmap_compute.wgsl. */
+struct MipmapParams
+{
+	uint32_t levelCount = 1;
+	uint32_t decodeSrgb = 0;
+	uint32_t pad0 = 0;
+	uint32_t pad1 = 0;
+};
+
+const char *wgslStorageFormat(wgpu::TextureFormat format)
+{
+	switch (format)
+	{
+	case wgpu::TextureFormat::RGBA8Unorm:
+		return "rgba8unorm";
+	case wgpu::TextureFormat::RGBA16Float:
+		return "rgba16float";
+	case wgpu::TextureFormat::RGBA32Float:
+		return "rgba32float";
+	default:
+		return nullptr;
+	}
+}
+
+wgpu::TextureView createMipView(wgpu::Texture texture, uint32_t mipLevel)
+{
+	wgpu::TextureViewDescriptor viewDesc{};
+	viewDesc.dimension = wgpu::TextureViewDimension::_2D;
+	viewDesc.baseMipLevel = mipLevel;
+	viewDesc.mipLevelCount = 1;
+	viewDesc.baseArrayLayer = 0;
+	viewDesc.arrayLayerCount = 1;
+	viewDesc.aspect = wgpu::TextureAspect::All;
+	return texture.createView(viewDesc);
+}
+
+void copyMips(wgpu::CommandEncoder encoder, wgpu::Texture from, wgpu::Texture to, uint32_t firstMip, uint32_t lastMip, uint32_t width, uint32_t height)
+{
+	for (uint32_t mip = firstMip; mip <= lastMip; ++mip)
+	{
+		wgpu::ImageCopyTexture src{};
+		src.texture = from;
+		src.mipLevel = mip;
+		src.origin = {0, 0, 0};
+		src.aspect = wgpu::TextureAspect::All;
+
+		wgpu::ImageCopyTexture dst{};
+		dst.texture = to;
+		dst.mipLevel = mip;
+		dst.origin = {0, 0, 0};
+		dst.aspect = wgpu::TextureAspect::All;
+
+		encoder.copyTextureToTexture(src, dst, {std::max(1u, width >> mip), std::max(1u, height >> mip), 1});
+	}
+}
+} // namespace
+
+WebGPUMipmapGenerator::WebGPUMipmapGenerator(WebGPUContext &context) :
+	m_context(context)
+{
+}
+
+WebGPUMipmapGenerator::~WebGPUMipmapGenerator()
+{
+	cleanup();
+}
+
+void WebGPUMipmapGenerator::enqueue(wgpu::Texture texture, wgpu::TextureFormat format, uint32_t width, uint32_t height, uint32_t mipLevelCount)
+{
+	if (!texture)
+	{
+		spdlog::error("Cannot generate mipmaps for invalid texture");
+		return;
+	}
+
+	if (mipLevelCount <= 1)
+	{
+		spdlog::warn("Texture has only 1 mip level, no mipmaps to generate");
+		return;
+	}
+
+	texture.reference(); // Kept alive until the job is submitted
+	m_pending.push_back(Job{texture, format, width, height, mipLevelCount});
+}
+
+bool WebGPUMipmapGenerator::isPending(const wgpu::Texture &texture) const
+{
+	return std::any_of(m_pending.begin(), m_pending.end(), [&](const Job &job)
+	{
+		return job.texture == texture;
+	});
+}
+
+wgpu::TextureUsage WebGPUMipmapGenerator::getRequiredUsage(wgpu::TextureFormat format)
+{
+	if (format == wgpu::TextureFormat::RGBA8UnormSrgb)
+		return wgpu::TextureUsage::CopySrc;
+	if (storageFormatFor(format) != wgpu::TextureFormat::Undefined)
+		return wgpu::TextureUsage::StorageBinding;
+	return wgpu::TextureUsage::RenderAttachment;
+}
+
+wgpu::TextureFormat WebGPUMipmapGenerator::storageFormatFor(wgpu::TextureFormat format)
+{
+	switch (format)
+	{
+	case wgpu::TextureFormat::RGBA8Unorm:
+	case wgpu::TextureFormat::RGBA8UnormSrgb: // Through an RGBA8Unorm scratch texture
+		return wgpu::TextureFormat::RGBA8Unorm;
+	case wgpu::TextureFormat::RGBA16Float:
+		return wgpu::TextureFormat::RGBA16Float;
+	case wgpu::TextureFormat::RGBA32Float:
+		return wgpu::TextureFormat::RGBA32Float;
+	default:
+		return wgpu::TextureFormat::Undefined;
+	}
+}
+
+size_t WebGPUMipmapGenerator::flush()
+{
+	if (m_pending.empty())
+		return 0;
+
+	ENGINE_PROFILE_SCOPE("WebGPUMipmapGenerator::flush");
+	std::vector<Job> jobs;
+	jobs.swap(m_pending);
+
+	// sRGB textures are filtered in an RGBA8Unorm scratch copy (sRGB formats cannot be storage-bound)
+	struct ComputeJob
+	{
+		const Job *job = nullptr;
+		wgpu::Texture target = nullptr;
+		wgpu::TextureFormat storageFormat = wgpu::TextureFormat::Undefined;
+		bool decodeSrgb = false;
+	};
+	std::vector<ComputeJob> computeJobs;
+	std::vector<const Job *> blitJobs;
+	std::vector<wgpu::Texture> scratchTextures;
+
+	const bool computeAvailable = ensureParamsBuffer();
+	for (const auto &job : jobs)
+	{
+		const wgpu::TextureFormat storageFormat = storageFormatFor(job.format);
+		if (!computeAvailable || storageFormat == wgpu::TextureFormat::Undefined || !getOrCreateComputePipeline(storageFormat))
+		{
+			blitJobs.push_back(&job);
+			continue;
+		}
+
+		if (job.format != wgpu::TextureFormat::RGBA8UnormSrgb)
+		{
+			computeJobs.push_back(ComputeJob{&job, job.texture, storageFormat, false});
+			continue;
+		}
+
+		wgpu::TextureDescriptor scratchDesc{};
+		scratchDesc.label = "MipmapScratch";
+		scratchDesc.dimension = wgpu::TextureDimension::_2D;
+		scratchDesc.size = {job.width, job.height, 1};
+		scratchDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+		scratchDesc.mipLevelCount = job.mipLevelCount;
+		scratchDesc.sampleCount = 1;
+		scratchDesc.usage = wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::StorageBinding | wgpu::TextureUsage::CopySrc | wgpu::TextureUsage::CopyDst;
+		wgpu::Texture scratch = m_context.getDevice().createTexture(scratchDesc);
+		if (!scratch)
+		{
+			blitJobs.push_back(&job);
+			continue;
+		}
+		scratchTextures.push_back(scratch);
+		computeJobs.push_back(ComputeJob{&job, scratch, storageFormat, true});
+	}
+
+	std::vector<wgpu::BindGroup> bindGroups;
+	std::vector<wgpu::TextureView> views;
+	wgpu::CommandEncoder encoder = m_context.getDevice().createCommandEncoder();
+
+	for (const auto &computeJob : computeJobs)
+	{
+		if (computeJob.decodeSrgb)
+			copyMips(encoder, computeJob.job->texture, computeJob.target, 0, 0, computeJob.job->width, computeJob.job->height);
+	}
+
+	if (!computeJobs.empty())
+	{
+		// Dispatches within one pass run in order, so later dispatches see the levels written before
+		wgpu::ComputePassDescriptor passDesc{};
+		passDesc.label = "Mipmap Generation";
+		wgpu::ComputePassEncoder pass = encoder.beginComputePass(passDesc);
+		for (const auto &computeJob : computeJobs)
+			recordCompute(pass, *computeJob.job, computeJob.target, computeJob.storageFormat, computeJob.decodeSrgb, bindGroups, views);
+		pass.end();
+		pass.release();
+	}
+
+	for (const auto &computeJob : computeJobs)
+	{
+		if (computeJob.decodeSrgb)
+			copyMips(encoder, computeJob.target, computeJob.job->texture, 1, computeJob.job->mipLevelCount - 1, computeJob.job->width, computeJob.job->height);
+	}
+
+	for (const Job *job : blitJobs)
+		recordBlit(encoder, *job, bindGroups, views);
+
+	wgpu::CommandBuffer commands = encoder.finish();
+	m_context.getQueue().submit(commands);
+	commands.release();
+	encoder.release();
+
+	for (auto &bindGroup : bindGroups)
+		bindGroup.release();
+	for (auto &view : views)
+		view.release();
+	for (auto &scratch : scratchTextures)
+		scratch.release();
+	for (auto &job : jobs)
+		job.texture.release();
+
+	spdlog::debug("Generated mipmaps for {} textures ({} compute, {} blit) in one submit", jobs.size(), computeJobs.size(), blitJobs.size());
+	return jobs.size();
+}
+
+void WebGPUMipmapGenerator::recordCompute(
+	wgpu::ComputePassEncoder pass,
+	const Job &job,
+	wgpu::Texture target,
+	wgpu::TextureFormat storageFormat,
+	bool decodeSrgb,
+	std::vector<wgpu::BindGroup> &bindGroups,
+	std::vector<wgpu::TextureView> &views
+)
+{
+	ComputePipeline *pipeline = getOrCreateComputePipeline(storageFormat);
+	pass.setPipeline(pipeline->pipeline);
+
+	for (uint32_t baseMip = 0; baseMip + 1 < job.mipLevelCount; baseMip += MAX_LEVELS_PER_DISPATCH)
+	{
+		const uint32_t levelCount = std::min(MAX_LEVELS_PER_DISPATCH, job.mipLevelCount - 1 - baseMip);
+
+		std::vector<wgpu::BindGroupEntry> entries(MAX_LEVELS_PER_DISPATCH + 2);
+		entries[0].binding = 0;
+		entries[0].textureView = views.emplace_back(createMipView(target, baseMip));
+		for (uint32_t level = 0; level < MAX_LEVELS_PER_DISPATCH; ++level)
+		{
+			entries[level + 1].binding = level + 1;
+			entries[level + 1].textureView = level < levelCount
+												 ? views.emplace_back(createMipView(target, baseMip + 1 + level))
+												 : pipeline->dummyView;
+		}
+		entries[MAX_LEVELS_PER_DISPATCH + 1].binding = MAX_LEVELS_PER_DISPATCH + 1;
+		entries[MAX_LEVELS_PER_DISPATCH + 1].buffer = m_paramsBuffer;
+		entries[MAX_LEVELS_PER_DISPATCH + 1].offset = 0;
+		entries[MAX_LEVELS_PER_DISPATCH + 1].size = sizeof(MipmapParams);
+
+		wgpu::BindGroupDescriptor bindGroupDesc{};
+		bindGroupDesc.layout = pipeline->bindGroupLayout;
+		bindGroupDesc.entryCount = entries.size();
+		bindGroupDesc.entries = entries.data();
+		wgpu::BindGroup bindGroup = bindGroups.emplace_back(m_context.getDevice().createBindGroup(bindGroupDesc));
+
+		const uint32_t paramsOffset = ((decodeSrgb ? MAX_LEVELS_PER_DISPATCH : 0) + levelCount - 1) * m_paramsStride;
+		pass.setBindGroup(0, bindGroup, 1, &paramsOffset);
+
+		const uint32_t firstWidth = std::max(1u, job.width >> (baseMip + 1));
+		const uint32_t firstHeight = std::max(1u, job.height >> (baseMip + 1));
+		pass.dispatchWorkgroups((firstWidth + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, (firstHeight + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1);
+	}
+}
+
+void WebGPUMipmapGenerator::recordBlit(
+	wgpu::CommandEncoder encoder,
+	const Job &job,
+	std::vector<wgpu::BindGroup> &bindGroups,
+	std::vector<wgpu::TextureView> &views
+)
+{
+	auto mipmapPipeline = getOrCreateBlitPipeline(job.format);
+	if (!mipmapPipeline || !mipmapPipeline->isValid())
+	{
+		spdlog::error("Failed to get/create mipmap pipeline for format {}", static_cast<int>(job.format));
+		return;
+	}
+
+	auto mipmapShader = m_context.shaderRegistry().getShader(shader::defaults::MIPMAP_BLIT);
+	auto bindGroupLayouts = mipmapShader->getBindGroupLayoutVector();
+	if (bindGroupLayouts.empty())
+	{
+		spdlog::error("Mipmap shader has no bind group layouts");
+		return;
+	}
+
+	auto mipmapSampler = m_context.samplerFactory().getMipmapSampler();
+
+	// Blit each level from the previous one with linear filtering
+	for (uint32_t mipLevel = 1; mipLevel < job.mipLevelCount; ++mipLevel)
+	{
+		wgpu::TextureView srcView = views.emplace_back(createMipView(job.texture, mipLevel - 1));
+		wgpu::TextureView dstView = views.emplace_back(createMipView(job.texture, mipLevel));
+
+		std::vector<wgpu::BindGroupEntry> entries(2);
+		entries[0].binding = 0;
+		entries[0].textureView = srcView;
+		entries[1].binding = 1;
+		entries[1].sampler = mipmapSampler;
+
+		wgpu::BindGroupDescriptor bindGroupDesc{};
+		bindGroupDesc.layout = bindGroupLayouts[0]->getLayout();
+		bindGroupDesc.entryCount = entries.size();
+		bindGroupDesc.entries = entries.data();
+		wgpu::BindGroup bindGroup = bindGroups.emplace_back(m_context.getDevice().createBindGroup(bindGroupDesc));
+
+		wgpu::RenderPassColorAttachment colorAttachment{};
+		colorAttachment.view = dstView;
+		colorAttachment.loadOp = wgpu::LoadOp::Clear;
+		colorAttachment.storeOp = wgpu::StoreOp::Store;
+		colorAttachment.clearValue = {0.0, 0.0, 0.0, 0.0};
+
+		wgpu::RenderPassDescriptor renderPassDesc{};
+		renderPassDesc.colorAttachmentCount = 1;
+		renderPassDesc.colorAttachments = &colorAttachment;
+
+		wgpu::RenderPassEncoder renderPass = encoder.beginRenderPass(renderPassDesc);
+		renderPass.setPipeline(mipmapPipeline->getPipeline());
+		renderPass.setBindGroup(0, bindGroup, 0, nullptr);
+		renderPass.draw(3, 1, 0, 0); // Fullscreen triangle
+		renderPass.end();
+		renderPass.release();
+	}
+}
+
+std::shared_ptr<WebGPUPipeline> WebGPUMipmapGenerator::getOrCreateBlitPipeline(wgpu::TextureFormat format)
+{
+	auto mipmapShader = m_context.shaderRegistry().getShader(shader::defaults::MIPMAP_BLIT);
+	if (!mipmapShader || !mipmapShader->isValid())
+	{
+		spdlog::error("Failed to get mipmap blit shader from registry");
+		return nullptr;
+	}
+
+	auto mipmapPipeline = m_context.pipelineManager().getOrCreatePipeline(
+		mipmapShader,					// shader
+		format,							// color format (specific to this texture)
+		wgpu::TextureFormat::Undefined, // no depth
+		engine::rendering::Topology::Type::Triangles,
+		wgpu::CullMode::None,
+		false,
+		1 // sample count
+	);
+
+	if (!mipmapPipeline || !mipmapPipeline->getPipeline())
+	{
+		spdlog::error("Failed to create mipmap pipeline for format {}", static_cast<int>(format));
+		return nullptr;
+	}
+	return mipmapPipeline;
+}
+
+WebGPUMipmapGenerator::ComputePipeline *WebGPUMipmapGenerator::getOrCreateComputePipeline(wgpu::TextureFormat storageFormat)
+{
+	const uint32_t key = static_cast<uint32_t>(storageFormat);
+	auto it = m_computePipelines.find(key);
+	if (it != m_computePipelines.end())
+		return it->second.pipeline ? &it->second : nullptr;
+
+	// A failed format is remembered as an empty entry so it is not retried every flush
+	auto &entry = m_computePipelines[key];
+	const char *formatToken = wgslStorageFormat(storageFormat);
+	if (!formatToken)
+		return nullptr;
+
+	const auto shaderPath = engine::core::PathProvider::getResource("mipmap_compute.wgsl");
+	auto source = engine::io::FileReader::loadText(shaderPath.string());
+	if (!source)
+	{
+		spdlog::error("WebGPUMipmapGenerator: Failed to open shader file '{}'", shaderPath.string());
+		return nullptr;
+	}
+	const std::string token = "STORAGE_FORMAT";
+	for (size_t pos = source->find(token); pos != std::string::npos; pos = source->find(token, pos))
+		source->replace(pos, token.size(), formatToken);
+
+	wgpu::ShaderModuleWGSLDescriptor shaderCodeDesc;
+	shaderCodeDesc.chain.next = nullptr;
+	shaderCodeDesc.chain.sType = wgpu::SType::ShaderModuleWGSLDescriptor;
+	shaderCodeDesc.code = source->c_str();
+	wgpu::ShaderModuleDescriptor shaderDesc;
+	shaderDesc.nextInChain = &shaderCodeDesc.chain;
+#ifdef WEBGPU_BACKEND_WGPU
+	shaderDesc.hintCount = 0;
+	shaderDesc.hints = nullptr;
+#endif
+	wgpu::ShaderModule shaderModule = m_context.getDevice().createShaderModule(shaderDesc);
+	if (!shaderModule)
+	{
+		spdlog::error("WebGPUMipmapGenerator: Failed to compile '{}' for {}", shaderPath.string(), formatToken);
+		return nullptr;
+	}
+
+	std::vector<wgpu::BindGroupLayoutEntry> layoutEntries(MAX_LEVELS_PER_DISPATCH + 2);
+	layoutEntries[0].binding = 0;
+	layoutEntries[0].visibility = wgpu::ShaderStage::Compute;
+	layoutEntries[0].texture.sampleType = wgpu::TextureSampleType::UnfilterableFloat;
+	layoutEntries[0].texture.viewDimension = wgpu::TextureViewDimension::_2D;
+	layoutEntries[0].texture.multisampled = false;
+	for (uint32_t level = 1; level <= MAX_LEVELS_PER_DISPATCH; ++level)
+	{
+		layoutEntries[level].binding = level;
+		layoutEntries[level].visibility = wgpu::ShaderStage::Compute;
+		layoutEntries[level].storageTexture.access = wgpu::StorageTextureAccess::WriteOnly;
+		layoutEntries[level].storageTexture.format = storageFormat;
+		layoutEntries[level].storageTexture.viewDimension = wgpu::TextureViewDimension::_2D;
+	}
+	auto &paramsEntry = layoutEntries[MAX_LEVELS_PER_DISPATCH + 1];
+	paramsEntry.binding = MAX_LEVELS_PER_DISPATCH + 1;
+	paramsEntry.visibility = wgpu::ShaderStage::Compute;
+	paramsEntry.buffer.type = wgpu::BufferBindingType::Uniform;
+	paramsEntry.buffer.hasDynamicOffset = true;
+	paramsEntry.buffer.minBindingSize = sizeof(MipmapParams);
+
+	wgpu::BindGroupLayoutDescriptor layoutDesc{};
+	layoutDesc.entryCount = layoutEntries.size();
+	layoutDesc.entries = layoutEntries.data();
+	wgpu::BindGroupLayout bindGroupLayout = m_context.getDevice().createBindGroupLayout(layoutDesc);
+
+	wgpu::PipelineLayoutDescriptor pipelineLayoutDesc{};
+	pipelineLayoutDesc.bindGroupLayoutCount = 1;
+	pipelineLayoutDesc.bindGroupLayouts = (WGPUBindGroupLayout *)&bindGroupLayout;
+	wgpu::PipelineLayout pipelineLayout = m_context.getDevice().createPipelineLayout(pipelineLayoutDesc);
+
+	wgpu::ComputePipelineDescriptor pipelineDesc{};
+	pipelineDesc.label = "MipmapCompute";
+	pipelineDesc.layout = pipelineLayout;
+	pipelineDesc.compute.module = shaderModule;
+	pipelineDesc.compute.entryPoint = "cs_main";
+	pipelineDesc.compute.constantCount = 0;
+	pipelineDesc.compute.constants = nullptr;
+	wgpu::ComputePipeline pipeline = m_context.getDevice().createComputePipeline(pipelineDesc);
+	pipelineLayout.release();
+	shaderModule.release();
+	if (!pipeline)
+	{
+		spdlog::error("WebGPUMipmapGenerator: Failed to create compute pipeline for {}", formatToken);
+		bindGroupLayout.release();
+		return nullptr;
+	}
+
+	wgpu::TextureDescriptor dummyDesc{};
+	dummyDesc.label = "MipmapDummyTarget";
+	dummyDesc.dimension = wgpu::TextureDimension::_2D;
+	dummyDesc.size = {1, 1, 1};
+	dummyDesc.format = storageFormat;
+	dummyDesc.mipLevelCount = 1;
+	dummyDesc.sampleCount = 1;
+	dummyDesc.usage = wgpu::TextureUsage::StorageBinding;
+	wgpu::Texture dummyTexture = m_context.getDevice().createTexture(dummyDesc);
+
+	entry = ComputePipeline{pipeline, bindGroupLayout, dummyTexture, createMipView(dummyTexture, 0)};
+	spdlog::debug("Created compute mipmap pipeline for {}", formatToken);
+	return &entry;
+}
+
+bool WebGPUMipmapGenerator::ensureParamsBuffer()
+{
+	if (m_paramsBuffer)
+		return true;
+
+	m_paramsStride = std::max<uint32_t>(sizeof(MipmapParams), m_context.resolvedLimits().minUniformBufferOffsetAlignment);
+
+	wgpu::BufferDescriptor desc{};
+	desc.label = "MipmapParams";
+	desc.size = static_cast<uint64_t>(m_paramsStride) * PARAMS_SLOT_COUNT;
+	desc.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
+	m_paramsBuffer = m_context.getDevice().createBuffer(desc);
+	if (!m_paramsBuffer)
+	{
+		spdlog::error("WebGPUMipmapGenerator: Failed to create params buffer, using render-pass mipmaps");
+		return false;
+	}
+
+	// Slot (decodeSrgb * MAX_LEVELS_PER_DISPATCH + levelCount - 1), selected with a dynamic offset
+	std::vector<uint8_t> data(desc.size, 0);
+	for (uint32_t decode = 0; decode < 2; ++decode)
+	{
+		for (uint32_t levels = 1; levels <= MAX_LEVELS_PER_DISPATCH; ++levels)
+		{
+			const MipmapParams params{levels, decode, 0, 0};
+			std::memcpy(data.data() + ((decode * MAX_LEVELS_PER_DISPATCH) + levels - 1) * m_paramsStride, &params, sizeof(params));
+		}
+	}
+	m_context.getQueue().writeBuffer(m_paramsBuffer, 0, data.data(), data.size());
+	return true;
+}
+
+void WebGPUMipmapGenerator::cleanup()
+{
+	for (auto &job : m_pending)
+		job.texture.release();
+	m_pending.clear();
+
+	for (auto &[key, pipeline] : m_computePipelines)
+	{
+		if (pipeline.dummyView)
+			pipeline.dummyView.release();
+		if (pipeline.dummyTexture)
+			pipeline.dummyTexture.release();
+		if (pipeline.bindGroupLayout)
+			pipeline.bindGroupLayout.release();
+		if (pipeline.pipeline)
+			pipeline.pipeline.release();
+	}
+	m_computePipelines.clear();
+
+	if (m_paramsBuffer)
+	{
+		m_paramsBuffer.release();
+		m_paramsBuffer = nullptr;
+	}
+}
+
+} // namespace engine::rendering::webgpu
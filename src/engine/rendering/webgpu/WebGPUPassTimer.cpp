@@ -0,0 +1,253 @@
+#include "engine/rendering/webgpu/WebGPUPassTimer.h"
+
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+#include "engine/rendering/webgpu/WebGPUContext.h"
+
+namespace engine::rendering::webgpu
+{
+
+namespace
+{
+constexpr uint32_t QUERIES_PER_FRAME = WebGPUPassTimer::MAX_PASSES_PER_FRAME * 2;
+constexpr uint64_t SLOT_BYTES = QUERIES_PER_FRAME * sizeof(uint64_t); // multiple of 256 (resolve offset alignment)
+} // namespace
+
+WebGPUPassTimer::WebGPUPassTimer(WebGPUContext &context) : m_context(context) {}
+
+WebGPUPassTimer::~WebGPUPassTimer()
+{
+	for (auto &slot : m_slots)
+	{
+		slot.mapCallback.reset();
+		if (slot.readback)
+		{
+			if (slot.mapped)
+				slot.readback.unmap();
+			slot.readback.release();
+		}
+	}
+	if (m_resolveBuffer)
+		m_resolveBuffer.release();
+	if (m_querySet)
+		m_querySet.release();
+}
+
+bool WebGPUPassTimer::initialize(bool supported)
+{
+	if (!supported)
+	{
+		spdlog::info("[WebGPU] timestamp-query not supported, GPU pass timing disabled.");
+		return false;
+	}
+
+	wgpu::QuerySetDescriptor queryDesc{};
+	queryDesc.label = "Pass Timer Queries";
+	queryDesc.type = wgpu::QueryType::Timestamp;
+	queryDesc.count = QUERIES_PER_FRAME * FRAMES_IN_FLIGHT;
+	m_querySet = m_context.getDevice().createQuerySet(queryDesc);
+	if (!m_querySet)
+	{
+		spdlog::warn("[WebGPU] Failed to create timestamp query set, GPU pass timing disabled.");
+		return false;
+	}
+
+	wgpu::BufferDescriptor resolveDesc{};
+	resolveDesc.label = "Pass Timer Resolve";
+	resolveDesc.size = SLOT_BYTES * FRAMES_IN_FLIGHT;
+	resolveDesc.usage = wgpu::BufferUsage::QueryResolve | wgpu::BufferUsage::CopySrc;
+	m_resolveBuffer = m_context.getDevice().createBuffer(resolveDesc);
+
+	for (auto &slot : m_slots)
+	{
+		wgpu::BufferDescriptor readbackDesc{};
+		readbackDesc.label = "Pass Timer Readback";
+		readbackDesc.size = SLOT_BYTES;
+		readbackDesc.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::MapRead;
+		slot.readback = m_context.getDevice().createBuffer(readbackDesc);
+		slot.labelIds.reserve(MAX_PASSES_PER_FRAME);
+	}
+
+	spdlog::info("[WebGPU] GPU pass timing enabled ({} passes/frame, {} frames in flight).", MAX_PASSES_PER_FRAME, FRAMES_IN_FLIGHT);
+	return true;
+}
+
+void WebGPUPassTimer::setAveragingFrames(uint32_t frames)
+{
+	m_averagingFrames = std::clamp<uint32_t>(frames, 1, MAX_AVERAGING_FRAMES);
+	for (auto &history : m_history)
+	{
+		history.count = 0;
+		history.next = 0;
+	}
+}
+
+void WebGPUPassTimer::beginFrame()
+{
+	m_frameActive = false;
+	if (!isEnabled())
+		return;
+
+	m_currentSlot = (m_currentSlot + 1) % FRAMES_IN_FLIGHT;
+	FrameSlot &slot = m_slots[m_currentSlot];
+
+	if (slot.state == SlotState::Mapping)
+	{
+		// Still in flight: skip timing this frame rather than waiting on the GPU
+		if (!slot.mapped)
+			return;
+		consume(slot);
+	}
+
+	slot.labelIds.clear();
+	slot.state = SlotState::Recording;
+	m_frameActive = true;
+}
+
+bool WebGPUPassTimer::allocate(const std::string &label, wgpu::RenderPassTimestampWrites &outWrites)
+{
+	if (!m_frameActive)
+		return false;
+
+	FrameSlot &slot = m_slots[m_currentSlot];
+	if (slot.labelIds.size() >= MAX_PASSES_PER_FRAME)
+		return false;
+
+	const uint32_t first = m_currentSlot * QUERIES_PER_FRAME + static_cast<uint32_t>(slot.labelIds.size()) * 2;
+	slot.labelIds.push_back(labelId(label));
+
+	outWrites.querySet = m_querySet;
+	outWrites.beginningOfPassWriteIndex = first;
+	outWrites.endOfPassWriteIndex = first + 1;
+	return true;
+}
+
+void WebGPUPassTimer::endFrame()
+{
+	if (!m_frameActive)
+		return;
+	m_frameActive = false;
+
+	FrameSlot &slot = m_slots[m_currentSlot];
+	if (slot.labelIds.empty())
+	{
+		slot.state = SlotState::Idle;
+		return;
+	}
+
+	const uint32_t firstQuery = m_currentSlot * QUERIES_PER_FRAME;
+	const uint32_t queryCount = static_cast<uint32_t>(slot.labelIds.size()) * 2;
+	const uint64_t byteOffset = m_currentSlot * SLOT_BYTES;
+	const uint64_t byteSize = queryCount * sizeof(uint64_t);
+
+	auto encoder = m_context.createCommandEncoder("Pass Timer Resolve");
+	encoder.resolveQuerySet(m_querySet, firstQuery, queryCount, m_resolveBuffer, byteOffset);
+	encoder.copyBufferToBuffer(m_resolveBuffer, byteOffset, slot.readback, 0, byteSize);
+	m_context.submitCommandEncoder(encoder, "Pass Timer Resolve");
+
+	slot.state = SlotState::Mapping;
+	slot.mapped = false;
+	slot.mapSuccess = false;
+	slot.mapCallback = slot.readback.mapAsync(
+		wgpu::MapMode::Read,
+		0,
+		byteSize,
+		[&slot](WGPUBufferMapAsyncStatus status)
+		{
+			slot.mapSuccess = (status == WGPUBufferMapAsyncStatus_Success);
+			slot.mapped = true;
+		}
+	);
+}
+
+void WebGPUPassTimer::consume(FrameSlot &slot)
+{
+	slot.mapCallback.reset();
+	slot.state = SlotState::Idle;
+	slot.mapped = false;
+
+	if (!slot.mapSuccess)
+	{
+		spdlog::warn("[WebGPU] Pass timer readback failed.");
+		return;
+	}
+
+	const size_t queryCount = slot.labelIds.size() * 2;
+	const auto *timestamps = static_cast<const uint64_t *>(
+		slot.readback.getMappedRange(0, queryCount * sizeof(uint64_t))
+	);
+
+	if (timestamps)
+	{
+		for (size_t i = 0; i < slot.labelIds.size(); ++i)
+		{
+			const uint64_t begin = timestamps[i * 2];
+			const uint64_t end = timestamps[i * 2 + 1];
+			auto &history = m_history[slot.labelIds[i]];
+			// Timestamps can be reset (e.g. on power-state changes); drop those samples
+			if (end >= begin)
+				history.frameAccumMs += static_cast<float>(end - begin) * 1e-6f;
+			history.framePassCount++;
+		}
+	}
+	slot.readback.unmap();
+
+	for (auto &history : m_history)
+	{
+		if (history.framePassCount == 0)
+			continue;
+		history.lastMs = history.frameAccumMs;
+		history.lastPassCount = history.framePassCount;
+		history.samplesMs[history.next] = history.frameAccumMs;
+		history.next = (history.next + 1) % m_averagingFrames;
+		history.count = std::min(history.count + 1, m_averagingFrames);
+		history.frameAccumMs = 0.0f;
+		history.framePassCount = 0;
+	}
+}
+
+uint32_t WebGPUPassTimer::labelId(const std::string &label)
+{
+	auto it = m_labelIds.find(label);
+	if (it != m_labelIds.end())
+		return it->second;
+
+	const auto id = static_cast<uint32_t>(m_history.size());
+	m_history.emplace_back().name = label;
+	m_labelIds.emplace(label, id);
+	return id;
+}
+
+std::vector<GpuPassTiming> WebGPUPassTimer::getTimings() const
+{
+	std::vector<GpuPassTiming> result;
+	result.reserve(m_history.size());
+	for (const auto &history : m_history)
+	{
+		if (history.count == 0)
+			continue;
+
+		float sum = 0.0f;
+		for (uint32_t i = 0; i < history.count; ++i)
+			sum += history.samplesMs[i];
+
+		GpuPassTiming timing;
+		timing.name = history.name;
+		timing.averageMs = sum / static_cast<float>(history.count);
+		timing.lastMs = history.lastMs;
+		timing.passCount = history.lastPassCount;
+		result.push_back(std::move(timing));
+	}
+	return result;
+}
+
+float WebGPUPassTimer::getTotalMs() const
+{
+	float total = 0.0f;
+	for (const auto &timing : getTimings())
+		total += timing.averageMs;
+	return total;
+}
+
+} // namespace engine::rendering::webgpu
@@ -40,7 +40,8 @@ std::shared_ptr<WebGPUPipeline> WebGPUPipelineFactory::createRenderPipeline(
 	engine::rendering::Topology::Type topology,
 	wgpu::CullMode cullMode,
 	bool blendEnabled,
-	uint32_t sampleCount
+	uint32_t sampleCount,
+	bool depthPrepassed
 )
 {
 	if (!shaderInfo)
@@ -112,8 +113,8 @@ std::shared_ptr<WebGPUPipeline> WebGPUPipelineFactory::createRenderPipeline(
 	if (hasDepth)
 	{
 		depthStencil.format = depthFormat;
-		depthStencil.depthWriteEnabled = true;
-		depthStencil.depthCompare = wgpu::CompareFunction::Less;
+		depthStencil.depthWriteEnabled = !depthPrepassed;
+		depthStencil.depthCompare = depthPrepassed ? wgpu::CompareFunction::Equal : wgpu::CompareFunction::Less;
 		depthStencil.stencilFront = {wgpu::CompareFunction::Always, wgpu::StencilOperation::Keep, wgpu::StencilOperation::Keep, wgpu::StencilOperation::Keep};
 		depthStencil.stencilBack = depthStencil.stencilFront;
 		desc.depthStencil = &depthStencil;
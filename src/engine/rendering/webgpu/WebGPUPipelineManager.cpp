@@ -1,8 +1,12 @@
 #include "engine/rendering/webgpu/WebGPUPipelineManager.h"
 #include "engine/rendering/webgpu/WebGPUContext.h"
+#include "engine/rendering/webgpu/WebGPUMesh.h"
 #include "engine/rendering/webgpu/WebGPUPipelineFactory.h"
 #include "engine/rendering/webgpu/WebGPUShaderInfo.h"
 
+#include <fstream>
+#include <optional>
+#include <sstream>
 #include <spdlog/spdlog.h>
 
 namespace engine::rendering::webgpu
@@ -25,34 +29,42 @@ std::shared_ptr<WebGPUPipeline> WebGPUPipelineManager::getOrCreatePipeline(
 	const std::shared_ptr<engine::rendering::webgpu::WebGPURenderPassContext> &renderPass
 )
 {
-	auto shaderInfo = m_context.shaderRegistry().getShader(material->getShader());
-	auto colorFormat = renderPass->getColorTexture(0)->getFormat();
-	auto depthFormat = renderPass->getDepthTexture()->getFormat();
-	PipelineKey key{
-		shaderInfo->getName(),
-		colorFormat,
-		depthFormat,
+	auto &registry = m_context.shaderRegistry();
+	auto key = PipelineKey::create(
+		registry.resolveVariantId(material->getShader(), material->getFeatureMask()),
+		renderPass->getColorTexture(0)->getFormat(),
+		renderPass->getDepthTexture()->getFormat(),
 		mesh->getTopology(),
 		(MaterialFeature::hasFlag(material->getFeatureMask(), MaterialFeature::Flag::DoubleSided))
 			? wgpu::CullMode::None
 			: wgpu::CullMode::Back,
-		(MaterialFeature::hasFlag(material->getFeatureMask(), MaterialFeature::Flag::Transparent))
-			? true
-			: false,
+		MaterialFeature::hasFlag(material->getFeatureMask(), MaterialFeature::Flag::Transparent),
 		1 // ToDo: Get sample count from render target
-	};
-	auto it = m_pipelines.find(key);
-	if (it != m_pipelines.end())
-	{
-		return it->second;
-	}
-	std::shared_ptr<WebGPUPipeline> pipeline;
-	if (!createPipelineInternal(key, shaderInfo, pipeline))
-	{
+	);
+	auto pipeline = findOrCreate(key, nullptr);
+	if (!pipeline)
 		spdlog::error("Failed to create pipeline for mesh '{}' and material '{}'", mesh->getName().value_or("Unnamed"), material->getName().value_or("Unnamed"));
-		return nullptr;
-	}
-	m_pipelines[key] = pipeline;
+	return pipeline;
+}
+
+std::shared_ptr<WebGPUPipeline> WebGPUPipelineManager::getOrCreatePipeline(
+	const WebGPUMesh &mesh,
+	const WebGPUMaterial &material,
+	const std::shared_ptr<engine::rendering::webgpu::WebGPURenderPassContext> &renderPass,
+	bool depthPrepassed
+)
+{
+	auto key = PipelineKey::create(
+		material.getPipelineState(),
+		renderPass->getColorTexture(0)->getFormat(),
+		renderPass->getDepthTexture()->getFormat(),
+		mesh.getTopology(),
+		1, // ToDo: Get sample count from render target
+		depthPrepassed
+	);
+	auto pipeline = findOrCreate(key, nullptr);
+	if (!pipeline)
+		spdlog::error("Failed to create pipeline for material with shader '{}'", material.getShaderName());
 	return pipeline;
 }
 
@@ -66,16 +78,29 @@ std::shared_ptr<WebGPUPipeline> WebGPUPipelineManager::getOrCreatePipeline(
 	uint32_t sampleCount
 )
 {
-	PipelineKey key{
-		shaderInfo->getName(),
-		colorFormat,
-		depthFormat,
-		topology,
-		cullMode,
-		blendEnabled,
-		sampleCount
-	};
+	if (!shaderInfo)
+	{
+		spdlog::error("Cannot create pipeline without shader info");
+		return nullptr;
+	}
+
+	// Registered shaders carry their ID; unregistered ones are keyed by name
+	ShaderId shaderId = shaderInfo->getId();
+	if (shaderId == INVALID_SHADER_ID)
+		shaderId = m_context.shaderRegistry().resolveShaderId(shaderInfo->getName());
+
+	auto key = PipelineKey::create(shaderId, colorFormat, depthFormat, topology, cullMode, blendEnabled, sampleCount);
+	auto pipeline = findOrCreate(key, shaderInfo);
+	if (!pipeline)
+		spdlog::error("Failed to create pipeline with explicit parameters");
+	return pipeline;
+}
 
+std::shared_ptr<WebGPUPipeline> WebGPUPipelineManager::findOrCreate(
+	const PipelineKey &key,
+	std::shared_ptr<WebGPUShaderInfo> shaderInfo
+)
+{
 	// Check cache first
 	auto it = m_pipelines.find(key);
 	if (it != m_pipelines.end())
@@ -83,15 +108,15 @@ std::shared_ptr<WebGPUPipeline> WebGPUPipelineManager::getOrCreatePipeline(
 		return it->second;
 	}
 
-	// Create new pipeline
+	// Create new pipeline (compiles the shader variant on first use)
+	if (!shaderInfo)
+		shaderInfo = m_context.shaderRegistry().acquireShader(key.shaderId);
+
 	std::shared_ptr<WebGPUPipeline> pipeline;
 	if (!createPipelineInternal(key, shaderInfo, pipeline))
-	{
-		spdlog::error("Failed to create pipeline with explicit parameters");
 		return nullptr;
-	}
 
-	m_pipelines[key] = pipeline;
+	m_pipelines.emplace(key, pipeline);
 	return pipeline;
 }
 
@@ -129,65 +154,231 @@ size_t WebGPUPipelineManager::processPendingReloads()
 	size_t successCount = 0;
 
 	// Step 1: Collect unique shaders to reload
-	std::unordered_set<std::string> shadersToReload;
+	std::unordered_set<ShaderId> shadersToReload;
 	for (const auto &pair : m_pipelines)
 	{
 		if (m_pendingReloads.find(pair.second) != m_pendingReloads.end())
-			shadersToReload.insert(pair.first.shaderName);
+			shadersToReload.insert(pair.first.shaderId);
 	}
 
-	// Step 2: Reload each shader once
-	std::unordered_map<std::string, std::shared_ptr<WebGPUShaderInfo>> reloadedShaders;
-	for (const auto &shaderName : shadersToReload)
+	// Step 2: Reload each shader once (IDs are stable across reloads)
+	std::unordered_map<ShaderId, std::shared_ptr<WebGPUShaderInfo>> reloadedShaders;
+	for (const auto shaderId : shadersToReload)
 	{
-		auto shaderInfo = m_context.shaderRegistry().getShader(shaderName);
+		auto shaderInfo = m_context.shaderRegistry().getShader(shaderId);
 		if (!shaderInfo || !shaderInfo->isValid())
 		{
-			spdlog::error("Cannot reload shader '{}' — not found or invalid", shaderName);
+			spdlog::error("Cannot reload shader #{} — not found or invalid", shaderId);
 			continue;
 		}
 
+		const std::string shaderName = shaderInfo->getName();
 		spdlog::info("Reloading shader: {}", shaderName);
 		m_context.shaderFactory().reloadShader(shaderInfo);
 
-		shaderInfo = m_context.shaderRegistry().getShader(shaderName);
+		shaderInfo = m_context.shaderRegistry().getShader(shaderId);
 		if (!shaderInfo || !shaderInfo->isValid())
 		{
 			spdlog::error("Failed to reload shader: {}", shaderName);
 			continue;
 		}
 
-		reloadedShaders[shaderName] = shaderInfo;
+		reloadedShaders[shaderId] = shaderInfo;
 	}
 
 	// Step 3: Rebuild pipelines that use reloaded shaders
 	for (auto &pair : m_pipelines)
 	{
 		const auto &key = pair.first;
-		auto it = reloadedShaders.find(key.shaderName);
+		auto it = reloadedShaders.find(key.shaderId);
 		if (it == reloadedShaders.end())
 			continue; // shader not reloaded, skip
 
 		std::shared_ptr<WebGPUPipeline> newPipeline;
 		if (!createPipelineInternal(key, it->second, newPipeline))
 		{
-			spdlog::error("Failed to recreate pipeline for shader: {}", key.shaderName);
+			spdlog::error("Failed to recreate pipeline for shader: {}", it->second->getName());
 			continue;
 		}
 
 		pair.second = newPipeline;
 		successCount++;
-		spdlog::info("Pipeline reloaded successfully for shader: {}", key.shaderName);
+		spdlog::info("Pipeline reloaded successfully for shader: {}", it->second->getName());
 	}
 
 	m_pendingReloads.clear();
+	if (successCount > 0)
+		++m_generation;
 	spdlog::info("Completed: {}/{} pipeline(s) reloaded", successCount, m_pipelines.size());
 	return successCount;
 }
 
+namespace
+{
+constexpr const char *MANIFEST_HEADER = "# pipeline manifest v1";
+
+std::string formatManifestEntry(const PipelineManifestEntry &entry)
+{
+	std::ostringstream line;
+	line << entry.shaderName << '\t'
+		 << static_cast<uint32_t>(entry.colorFormat) << '\t'
+		 << static_cast<uint32_t>(entry.depthFormat) << '\t'
+		 << static_cast<uint32_t>(entry.topology) << '\t'
+		 << static_cast<uint32_t>(entry.cullMode) << '\t'
+		 << (entry.blendEnabled ? 1 : 0) << '\t'
+		 << entry.sampleCount << '\t'
+		 << (entry.depthPrepassed ? 1 : 0);
+	return line.str();
+}
+
+std::optional<PipelineManifestEntry> parseManifestEntry(const std::string &line)
+{
+	std::istringstream stream(line);
+	PipelineManifestEntry entry;
+	uint32_t colorFormat = 0, depthFormat = 0, topology = 0, cullMode = 0, blend = 0;
+	if (!(stream >> entry.shaderName >> colorFormat >> depthFormat >> topology >> cullMode >> blend >> entry.sampleCount))
+		return std::nullopt;
+	if (topology > static_cast<uint32_t>(engine::rendering::Topology::TriangleStrip) || entry.sampleCount == 0)
+		return std::nullopt;
+
+	// Optional trailing column, absent in manifests written before the depth pre-pass existed
+	uint32_t depthPrepassed = 0;
+	if (stream >> depthPrepassed)
+		entry.depthPrepassed = depthPrepassed != 0;
+
+	entry.colorFormat = static_cast<wgpu::TextureFormat>(colorFormat);
+	entry.depthFormat = static_cast<wgpu::TextureFormat>(depthFormat);
+	entry.topology = static_cast<engine::rendering::Topology::Type>(topology);
+	entry.cullMode = static_cast<wgpu::CullMode>(cullMode);
+	entry.blendEnabled = blend != 0;
+	return entry;
+}
+} // namespace
+
+bool WebGPUPipelineManager::loadManifest(const std::filesystem::path &path)
+{
+	std::ifstream file(path);
+	if (!file.is_open())
+	{
+		spdlog::info("No pipeline manifest at '{}', pipelines are created on first use", path.string());
+		return false;
+	}
+
+	std::string line;
+	if (!std::getline(file, line) || line != MANIFEST_HEADER)
+	{
+		spdlog::warn("Ignoring pipeline manifest '{}' with unknown format", path.string());
+		return false;
+	}
+
+	size_t queued = 0;
+	while (std::getline(file, line))
+	{
+		if (line.empty() || line[0] == '#')
+			continue;
+		auto entry = parseManifestEntry(line);
+		if (!entry)
+		{
+			spdlog::warn("Skipping malformed pipeline manifest line: '{}'", line);
+			continue;
+		}
+		m_warmUpQueue.push_back(std::move(entry.value()));
+		queued++;
+	}
+
+	spdlog::info("Queued {} pipeline(s) from manifest '{}'", queued, path.string());
+	return true;
+}
+
+bool WebGPUPipelineManager::saveManifest(const std::filesystem::path &path) const
+{
+	std::error_code ec;
+	if (path.has_parent_path())
+		std::filesystem::create_directories(path.parent_path(), ec);
+
+	std::ofstream file(path, std::ios::trunc);
+	if (!file.is_open())
+	{
+		spdlog::error("Failed to write pipeline manifest '{}'", path.string());
+		return false;
+	}
+
+	std::unordered_set<std::string> written;
+	auto write = [&](const PipelineManifestEntry &entry)
+	{
+		// Whitespace would break the line format; such names are simply not persisted
+		if (entry.shaderName.find_first_of(" \t\r\n") != std::string::npos)
+			return;
+		auto line = formatManifestEntry(entry);
+		if (written.insert(line).second)
+			file << line << '\n';
+	};
+
+	file << MANIFEST_HEADER << '\n';
+	for (const auto &[key, pipeline] : m_pipelines)
+	{
+		auto shaderInfo = m_context.shaderRegistry().getShader(key.shaderId);
+		if (!shaderInfo)
+			continue;
+		write({shaderInfo->getName(), key.colorFormat, key.depthFormat, key.topology, key.cullMode, key.blendEnabled, key.sampleCount, key.depthPrepassed});
+	}
+	for (const auto &entry : m_unresolvedManifestEntries)
+		write(entry);
+	for (size_t i = m_warmUpCursor; i < m_warmUpQueue.size(); ++i)
+		write(m_warmUpQueue[i]);
+
+	spdlog::info("Wrote {} pipeline(s) to manifest '{}'", written.size(), path.string());
+	return file.good();
+}
+
+size_t WebGPUPipelineManager::warmUp(size_t maxPipelines)
+{
+	auto &registry = m_context.shaderRegistry();
+	size_t processed = 0;
+	size_t created = 0;
+	for (; m_warmUpCursor < m_warmUpQueue.size() && processed < maxPipelines; ++m_warmUpCursor, ++processed)
+	{
+		const auto &entry = m_warmUpQueue[m_warmUpCursor];
+		auto shaderInfo = registry.getShader(entry.shaderName);
+		if (!shaderInfo && entry.shaderName.find('#') != std::string::npos)
+			shaderInfo = registry.acquireShader(registry.resolveShaderId(entry.shaderName));
+		if (!shaderInfo || !shaderInfo->isValid())
+		{
+			// Shader registered later (or removed); keep the entry for the next session
+			m_unresolvedManifestEntries.push_back(entry);
+			continue;
+		}
+
+		auto key = PipelineKey::create(
+			shaderInfo->getId(),
+			entry.colorFormat,
+			entry.depthFormat,
+			entry.topology,
+			entry.cullMode,
+			entry.blendEnabled,
+			entry.sampleCount,
+			entry.depthPrepassed
+		);
+		if (m_pipelines.find(key) != m_pipelines.end())
+			continue;
+		if (findOrCreate(key, shaderInfo))
+			created++;
+	}
+
+	if (m_warmUpCursor >= m_warmUpQueue.size())
+	{
+		m_warmUpQueue.clear();
+		m_warmUpCursor = 0;
+	}
+	if (created > 0)
+		spdlog::info("Warmed up {} pipeline(s), {} pending", created, getPendingWarmUpCount());
+	return getPendingWarmUpCount();
+}
+
 void WebGPUPipelineManager::cleanup()
 {
 	m_pipelines.clear();
+	++m_generation;
 }
 
 bool WebGPUPipelineManager::createPipelineInternal(
@@ -199,7 +390,7 @@ bool WebGPUPipelineManager::createPipelineInternal(
 	// Validate shader info
 	if (!shaderInfo || !shaderInfo->isValid())
 	{
-		spdlog::error("No valid shader info provided for pipeline with shader '{}'", config.shaderName);
+		spdlog::error("No valid shader info provided for pipeline with shader #{}", config.shaderId);
 		return false;
 	}
 
@@ -210,12 +401,13 @@ bool WebGPUPipelineManager::createPipelineInternal(
 		config.topology,
 		config.cullMode,
 		config.blendEnabled,
-		config.sampleCount
+		config.sampleCount,
+		config.depthPrepassed
 	);
 
 	if (!outPipeline || !outPipeline->isValid())
 	{
-		spdlog::error("Failed to create pipeline for shader '{}'", config.shaderName);
+		spdlog::error("Failed to create pipeline for shader '{}'", shaderInfo->getName());
 		return false;
 	}
 	return true;
@@ -0,0 +1,347 @@
+#include "engine/rendering/webgpu/WebGPUReadbackService.h"
+#include "engine/core/Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <glm/gtc/packing.hpp>
+#include <spdlog/spdlog.h>
+
+#include "engine/rendering/webgpu/WebGPUContext.h"
+#include "engine/rendering/webgpu/WebGPUTexture.h"
+
+namespace engine::rendering::webgpu
+{
+
+namespace
+{
+constexpr uint32_t BYTES_PER_ROW_ALIGNMENT = 256; // copyTextureToBuffer requirement
+
+uint32_t bytesPerPixel(wgpu::TextureFormat format)
+{
+	switch (format)
+	{
+	case wgpu::TextureFormat::RGBA8Unorm:
+	case wgpu::TextureFormat::RGBA8UnormSrgb:
+	case wgpu::TextureFormat::BGRA8Unorm:
+	case wgpu::TextureFormat::BGRA8UnormSrgb:
+		return 4;
+	case wgpu::TextureFormat::RGBA16Float:
+		return 8;
+	case wgpu::TextureFormat::RGBA32Float:
+		return 16;
+	default:
+		return 0; // Not supported for readback
+	}
+}
+
+// Accurate linear -> sRGB conversion (IEC 61966-2-1 standard)
+uint8_t linearToSRGB8(float linear)
+{
+	linear = std::max(linear, 0.0f);
+	const float srgb = linear <= 0.0031308f ? linear * 12.92f : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+	return static_cast<uint8_t>(std::clamp(srgb, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+uint8_t unorm8(float value)
+{
+	return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+} // namespace
+
+WebGPUReadbackService::WebGPUReadbackService(WebGPUContext &context) : m_context(context) {}
+
+WebGPUReadbackService::~WebGPUReadbackService()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		m_stopWorker = true;
+	}
+	m_queueCondition.notify_all();
+	if (m_worker.joinable())
+		m_worker.join();
+
+	for (auto &readback : m_readbacks)
+	{
+		if (readback->promise && readback->state == State::Mapping)
+			readback->promise->set_value(nullptr); // Converting/Done ones were fulfilled by the worker
+		// Unmapping a pending map aborts it and fires the callback, so the callback must
+		// outlive unmap() and release()
+		if (!readback->mapped || readback->mapSuccess)
+			readback->staging.buffer.unmap();
+		readback->staging.buffer.release();
+		readback->mapCallback.reset();
+	}
+	for (auto &staging : m_freeStaging)
+		staging.buffer.release();
+}
+
+bool WebGPUReadbackService::readTexture(const WebGPUTexture &texture, ReadbackCallback callback)
+{
+	return startReadback(texture, std::move(callback), nullptr);
+}
+
+std::future<engine::resources::Image::Ptr> WebGPUReadbackService::readTexture(const WebGPUTexture &texture)
+{
+	auto promise = std::make_shared<std::promise<engine::resources::Image::Ptr>>();
+	auto future = promise->get_future();
+	if (!startReadback(texture, nullptr, promise))
+		promise->set_value(nullptr);
+	return future;
+}
+
+bool WebGPUReadbackService::startReadback(
+	const WebGPUTexture &texture,
+	ReadbackCallback callback,
+	std::shared_ptr<std::promise<engine::resources::Image::Ptr>> promise
+)
+{
+	const uint32_t bpp = bytesPerPixel(texture.getFormat());
+	if (bpp == 0 || !texture.getTexture())
+	{
+		spdlog::warn("WebGPUReadbackService: unsupported texture format {} for readback", static_cast<int>(texture.getFormat()));
+		return false;
+	}
+	if (m_readbacks.size() >= MAX_IN_FLIGHT)
+	{
+		spdlog::warn("WebGPUReadbackService: {} readbacks in flight, request dropped", m_readbacks.size());
+		return false;
+	}
+
+	ENGINE_PROFILE_SCOPE("WebGPUReadbackService::readTexture");
+	auto readback = std::make_unique<Readback>();
+	readback->width = texture.getWidth();
+	readback->height = texture.getHeight();
+	readback->bytesPerRow = (readback->width * bpp + BYTES_PER_ROW_ALIGNMENT - 1) & ~(BYTES_PER_ROW_ALIGNMENT - 1);
+	readback->format = texture.getFormat();
+	readback->callback = std::move(callback);
+	readback->promise = std::move(promise);
+
+	const uint64_t size = static_cast<uint64_t>(readback->bytesPerRow) * readback->height;
+	readback->staging = acquireStaging(size);
+	if (!readback->staging.buffer)
+		return false;
+
+	wgpu::ImageCopyTexture src{};
+	src.texture = texture.getTexture();
+	src.mipLevel = 0;
+	src.origin = {0, 0, 0};
+
+	wgpu::ImageCopyBuffer dst{};
+	dst.buffer = readback->staging.buffer;
+	dst.layout.bytesPerRow = readback->bytesPerRow;
+	dst.layout.rowsPerImage = readback->height;
+	dst.layout.offset = 0;
+
+	auto encoder = m_context.createCommandEncoder("Readback Copy");
+	encoder.copyTextureToBuffer(src, dst, {readback->width, readback->height, 1});
+	m_context.submitCommandEncoder(encoder, "Readback Copy");
+
+	Readback *target = readback.get();
+	readback->mapCallback = readback->staging.buffer.mapAsync(
+		wgpu::MapMode::Read,
+		0,
+		size,
+		[target](WGPUBufferMapAsyncStatus status)
+		{
+			target->mapSuccess = (status == WGPUBufferMapAsyncStatus_Success);
+			target->mapped = true;
+		}
+	);
+
+	m_readbacks.push_back(std::move(readback));
+	return true;
+}
+
+void WebGPUReadbackService::update()
+{
+	ENGINE_PROFILE_SCOPE("WebGPUReadbackService::update");
+	m_frame++;
+
+	std::vector<std::unique_ptr<Readback>> finished;
+	for (auto it = m_readbacks.begin(); it != m_readbacks.end();)
+	{
+		Readback &readback = **it;
+		if (readback.state == State::Mapping && readback.mapped)
+		{
+			readback.mapCallback.reset();
+			if (readback.mapSuccess)
+			{
+				const uint64_t size = static_cast<uint64_t>(readback.bytesPerRow) * readback.height;
+				readback.mappedData = static_cast<const uint8_t *>(readback.staging.buffer.getMappedRange(0, size));
+			}
+			if (!readback.mapSuccess || !readback.mappedData)
+				spdlog::error("WebGPUReadbackService: texture readback failed");
+			readback.mapped = readback.mapSuccess; // Only a successful map needs an unmap
+
+			// The worker converts straight from the mapped memory, the buffer stays mapped until Done
+			ensureWorker();
+			readback.state = State::Converting;
+			{
+				std::lock_guard<std::mutex> lock(m_queueMutex);
+				m_queue.push_back(&readback);
+			}
+			m_queueCondition.notify_one();
+		}
+
+		if (readback.state == State::Converting && readback.converted.load(std::memory_order_acquire))
+			readback.state = State::Done;
+
+		if (readback.state == State::Done)
+		{
+			if (readback.mapped)
+				readback.staging.buffer.unmap();
+			readback.mapped = false;
+			releaseStaging(readback.staging);
+			finished.push_back(std::move(*it));
+			it = m_readbacks.erase(it);
+			continue;
+		}
+		++it;
+	}
+
+	// Deliver after the bookkeeping so callbacks may start new readbacks
+	for (auto &readback : finished)
+	{
+		if (readback->callback)
+			readback->callback(readback->image);
+	}
+
+	m_freeStaging.erase(
+		std::remove_if(m_freeStaging.begin(), m_freeStaging.end(), [this](Staging &staging)
+					   {
+			if (m_frame - staging.lastUsedFrame <= STAGING_IDLE_FRAMES)
+				return false;
+			staging.buffer.release();
+			return true; }),
+		m_freeStaging.end()
+	);
+}
+
+WebGPUReadbackService::Staging WebGPUReadbackService::acquireStaging(uint64_t size)
+{
+	// Smallest free buffer that fits without wasting more than half of it
+	auto best = m_freeStaging.end();
+	for (auto it = m_freeStaging.begin(); it != m_freeStaging.end(); ++it)
+	{
+		if (it->size >= size && it->size <= size * 2 && (best == m_freeStaging.end() || it->size < best->size))
+			best = it;
+	}
+	if (best != m_freeStaging.end())
+	{
+		Staging staging = *best;
+		m_freeStaging.erase(best);
+		return staging;
+	}
+
+	wgpu::BufferDescriptor desc{};
+	desc.label = "Readback Staging";
+	desc.size = size;
+	desc.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::MapRead;
+	Staging staging;
+	staging.buffer = m_context.getDevice().createBuffer(desc);
+	staging.size = size;
+	if (!staging.buffer)
+		spdlog::error("WebGPUReadbackService: failed to create a {} byte staging buffer", size);
+	return staging;
+}
+
+void WebGPUReadbackService::releaseStaging(Staging staging)
+{
+	staging.lastUsedFrame = m_frame;
+	m_freeStaging.push_back(staging);
+}
+
+void WebGPUReadbackService::ensureWorker()
+{
+	if (!m_worker.joinable())
+		m_worker = std::thread(&WebGPUReadbackService::workerLoop, this);
+}
+
+void WebGPUReadbackService::workerLoop()
+{
+	while (true)
+	{
+		Readback *readback = nullptr;
+		{
+			std::unique_lock<std::mutex> lock(m_queueMutex);
+			m_queueCondition.wait(lock, [this]
+								  { return m_stopWorker || !m_queue.empty(); });
+			if (m_queue.empty())
+				return; // Stopped and drained
+			readback = m_queue.front();
+			m_queue.pop_front();
+		}
+
+		readback->image = readback->mappedData ? convert(*readback) : nullptr;
+		if (readback->promise)
+			readback->promise->set_value(readback->image);
+		readback->converted.store(true, std::memory_order_release);
+	}
+}
+
+engine::resources::Image::Ptr WebGPUReadbackService::convert(const Readback &readback)
+{
+	ENGINE_PROFILE_SCOPE("WebGPUReadbackService::convert");
+
+	// Output is always RGBA8 (LDR, sRGB-encoded for HDR sources) for PNG compatibility
+	const uint32_t outBPR = readback.width * 4;
+	std::vector<uint8_t> pixelData(static_cast<size_t>(readback.height) * outBPR);
+
+	for (uint32_t row = 0; row < readback.height; ++row)
+	{
+		const uint8_t *rowSrc = readback.mappedData + static_cast<size_t>(row) * readback.bytesPerRow;
+		uint8_t *rowDst = pixelData.data() + static_cast<size_t>(row) * outBPR;
+
+		switch (readback.format)
+		{
+		case wgpu::TextureFormat::RGBA16Float:
+		{
+			const auto *src = reinterpret_cast<const uint16_t *>(rowSrc);
+			for (uint32_t i = 0; i < readback.width * 4; i += 4)
+			{
+				rowDst[i + 0] = linearToSRGB8(glm::unpackHalf1x16(src[i + 0]));
+				rowDst[i + 1] = linearToSRGB8(glm::unpackHalf1x16(src[i + 1]));
+				rowDst[i + 2] = linearToSRGB8(glm::unpackHalf1x16(src[i + 2]));
+				rowDst[i + 3] = unorm8(glm::unpackHalf1x16(src[i + 3]));
+			}
+			break;
+		}
+		case wgpu::TextureFormat::RGBA32Float:
+		{
+			const auto *src = reinterpret_cast<const float *>(rowSrc);
+			for (uint32_t i = 0; i < readback.width * 4; i += 4)
+			{
+				rowDst[i + 0] = linearToSRGB8(src[i + 0]);
+				rowDst[i + 1] = linearToSRGB8(src[i + 1]);
+				rowDst[i + 2] = linearToSRGB8(src[i + 2]);
+				rowDst[i + 3] = unorm8(src[i + 3]);
+			}
+			break;
+		}
+		case wgpu::TextureFormat::BGRA8Unorm:
+		case wgpu::TextureFormat::BGRA8UnormSrgb:
+			for (uint32_t i = 0; i < readback.width * 4; i += 4)
+			{
+				rowDst[i + 0] = rowSrc[i + 2];
+				rowDst[i + 1] = rowSrc[i + 1];
+				rowDst[i + 2] = rowSrc[i + 0];
+				rowDst[i + 3] = rowSrc[i + 3];
+			}
+			break;
+		default:
+			// RGBA8 — direct copy, stripping alignment padding
+			std::copy(rowSrc, rowSrc + outBPR, rowDst);
+			break;
+		}
+	}
+
+	return std::make_shared<engine::resources::Image>(
+		readback.width,
+		readback.height,
+		engine::resources::ImageFormat::Type::LDR_RGBA8,
+		std::move(pixelData)
+	);
+}
+
+} // namespace engine::rendering::webgpu
@@ -57,11 +57,13 @@ std::shared_ptr<WebGPURenderPassContext> WebGPURenderPassFactory::create(
 		renderPassDesc.depthStencilAttachment = &depthAttachment;
 	}
 
-	return std::make_shared<WebGPURenderPassContext>(
+	auto context = std::make_shared<WebGPURenderPassContext>(
 		std::vector<std::shared_ptr<WebGPUTexture>>{colorTexture},
 		depthTexture,
 		renderPassDesc
 	);
+	context->setPassTimer(&m_context.passTimer());
+	return context;
 }
 
 std::shared_ptr<WebGPURenderPassContext> WebGPURenderPassFactory::createDepthOnly(
@@ -93,11 +95,13 @@ std::shared_ptr<WebGPURenderPassContext> WebGPURenderPassFactory::createDepthOnl
 	renderPassDesc.depthStencilAttachment = &depthAttachment;
 
 	// No color textures for depth-only pass
-	return std::make_shared<WebGPURenderPassContext>(
+	auto context = std::make_shared<WebGPURenderPassContext>(
 		std::vector<std::shared_ptr<WebGPUTexture>>{},
 		nullptr,
 		renderPassDesc
 	);
+	context->setPassTimer(&m_context.passTimer());
+	return context;
 }
 
 std::shared_ptr<WebGPURenderPassContext> WebGPURenderPassFactory::createCustom(
@@ -131,11 +135,13 @@ std::shared_ptr<WebGPURenderPassContext> WebGPURenderPassFactory::createCustom(
 		descCopy.depthStencilAttachment = &(*depthAttachmentCopy);
 	}
 
-	return std::make_shared<WebGPURenderPassContext>(
+	auto context = std::make_shared<WebGPURenderPassContext>(
 		colorTextures,
 		depthTexture,
 		descCopy
 	);
+	context->setPassTimer(&m_context.passTimer());
+	return context;
 }
 
 } // namespace engine::rendering::webgpu
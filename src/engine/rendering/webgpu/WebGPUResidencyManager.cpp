@@ -0,0 +1,237 @@
+#include "engine/rendering/webgpu/WebGPUResidencyManager.h"
+#include "engine/core/Profiler.h"
+
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "engine/rendering/webgpu/WebGPUContext.h"
+#include "engine/rendering/webgpu/WebGPUMaterial.h"
+#include "engine/rendering/webgpu/WebGPUMesh.h"
+#include "engine/rendering/webgpu/WebGPUModel.h"
+#include "engine/rendering/webgpu/WebGPUTexture.h"
+
+namespace engine::rendering::webgpu
+{
+
+namespace
+{
+/** @brief Bytes of one 4x4 block, 0 for uncompressed formats. */
+uint32_t getBytesPerBlock(wgpu::TextureFormat format)
+{
+	switch (format)
+	{
+	case wgpu::TextureFormat::BC1RGBAUnorm:
+	case wgpu::TextureFormat::BC1RGBAUnormSrgb:
+	case wgpu::TextureFormat::BC4RUnorm:
+	case wgpu::TextureFormat::ETC2RGB8Unorm:
+	case wgpu::TextureFormat::ETC2RGB8UnormSrgb:
+		return 8;
+	case wgpu::TextureFormat::BC3RGBAUnorm:
+	case wgpu::TextureFormat::BC3RGBAUnormSrgb:
+	case wgpu::TextureFormat::BC5RGUnorm:
+	case wgpu::TextureFormat::BC7RGBAUnorm:
+	case wgpu::TextureFormat::BC7RGBAUnormSrgb:
+	case wgpu::TextureFormat::ETC2RGBA8Unorm:
+	case wgpu::TextureFormat::ETC2RGBA8UnormSrgb:
+	case wgpu::TextureFormat::ASTC4x4Unorm:
+	case wgpu::TextureFormat::ASTC4x4UnormSrgb:
+		return 16;
+	default:
+		return 0;
+	}
+}
+
+/** @brief Bytes per texel of uncompressed formats; unknown formats count as 4 bytes. */
+uint32_t getBytesPerTexel(wgpu::TextureFormat format)
+{
+	switch (format)
+	{
+	case wgpu::TextureFormat::R8Unorm:
+		return 1;
+	case wgpu::TextureFormat::RG8Unorm:
+	case wgpu::TextureFormat::R16Float:
+	case wgpu::TextureFormat::Depth16Unorm:
+		return 2;
+	case wgpu::TextureFormat::RGBA16Float:
+	case wgpu::TextureFormat::RG32Float:
+		return 8;
+	case wgpu::TextureFormat::RGBA32Float:
+		return 16;
+	default:
+		return 4;
+	}
+}
+} // namespace
+
+WebGPUResidencyManager::WebGPUResidencyManager(WebGPUContext &context) :
+	m_context(context)
+{
+}
+
+void WebGPUResidencyManager::markUsed(const WebGPUMesh &mesh)
+{
+	auto &entry = m_meshes[mesh.getCPUHandle()];
+	entry.lastUsedFrame = m_frame;
+
+	// Vertex buffers are created lazily per layout, so the size can grow after the first mark
+	const uint64_t bytes = mesh.getGPUMemoryBytes();
+	m_meshBytes = m_meshBytes - entry.bytes + bytes;
+	entry.bytes = bytes;
+}
+
+void WebGPUResidencyManager::markUsed(const WebGPUMaterial &material)
+{
+	for (const auto &[slot, texture] : material.getTextures())
+	{
+		if (texture)
+			markUsed(*texture);
+	}
+}
+
+void WebGPUResidencyManager::markUsed(const WebGPUTexture &texture)
+{
+	const auto &handle = texture.getCPUHandle();
+	if (!handle.valid())
+		return;
+
+	auto [it, inserted] = m_textures.try_emplace(handle);
+	if (inserted)
+	{
+		it->second.bytes = estimateTextureBytes(texture.getTextureDescriptor());
+		m_textureBytes += it->second.bytes;
+	}
+	it->second.lastUsedFrame = m_frame;
+}
+
+size_t WebGPUResidencyManager::evictToBudget()
+{
+	if (m_budget == 0 || getResidentBytes() <= m_budget || m_frame <= m_minIdleFrames)
+		return 0;
+
+	ENGINE_PROFILE_SCOPE("WebGPUResidencyManager::evictToBudget");
+	const uint64_t idleBefore = m_frame - m_minIdleFrames;
+
+	struct Candidate
+	{
+		uint64_t lastUsedFrame;
+		uint64_t bytes;
+		Texture::Handle texture;
+		Mesh::Handle mesh;
+	};
+	std::vector<Candidate> candidates;
+	for (const auto &[handle, entry] : m_textures)
+	{
+		if (entry.lastUsedFrame < idleBefore)
+			candidates.push_back({entry.lastUsedFrame, entry.bytes, handle, {}});
+	}
+	for (const auto &[handle, entry] : m_meshes)
+	{
+		if (entry.lastUsedFrame < idleBefore)
+			candidates.push_back({entry.lastUsedFrame, entry.bytes, {}, handle});
+	}
+	if (candidates.empty())
+		return 0;
+
+	// Least recently used first, larger resources first among equally old ones
+	std::sort(candidates.begin(), candidates.end(), [](const Candidate &a, const Candidate &b)
+	{
+		return a.lastUsedFrame != b.lastUsedFrame ? a.lastUsedFrame < b.lastUsedFrame : a.bytes > b.bytes;
+	});
+
+	std::unordered_set<Texture::Handle> evictedTextures;
+	std::unordered_set<Mesh::Handle> evictedMeshes;
+	uint64_t resident = getResidentBytes();
+	uint64_t freed = 0;
+	for (const auto &candidate : candidates)
+	{
+		if (resident <= m_budget)
+			break;
+		if (candidate.texture.valid())
+		{
+			evictedTextures.insert(candidate.texture);
+			m_textures.erase(candidate.texture);
+			m_textureBytes -= candidate.bytes;
+		}
+		else
+		{
+			evictedMeshes.insert(candidate.mesh);
+			m_meshes.erase(candidate.mesh);
+			m_meshBytes -= candidate.bytes;
+		}
+		resident -= candidate.bytes;
+		freed += candidate.bytes;
+	}
+
+	// Drop everything that holds the evicted resources, so the last references go away
+	if (!evictedTextures.empty())
+	{
+		m_context.materialFactory().evictIf([&](const WebGPUMaterial &material)
+		{
+			for (const auto &[slot, texture] : material.getTextures())
+			{
+				if (texture && evictedTextures.count(texture->getCPUHandle()) > 0)
+					return true;
+			}
+			return false;
+		});
+		m_context.materialFactory().pruneBatches();
+		for (const auto &handle : evictedTextures)
+			m_context.textureFactory().evict(handle);
+	}
+	if (!evictedMeshes.empty())
+	{
+		m_context.modelFactory().evictIf([&](const WebGPUModel &model)
+		{
+			const auto mesh = model.getMesh();
+			return mesh && evictedMeshes.count(mesh->getCPUHandle()) > 0;
+		});
+		for (const auto &handle : evictedMeshes)
+			m_context.meshFactory().evict(handle);
+	}
+
+	const size_t evicted = evictedTextures.size() + evictedMeshes.size();
+	++m_generation;
+	m_evictionCount += evicted;
+	m_evictedBytes += freed;
+	spdlog::info(
+		"Residency: evicted {} textures and {} meshes ({:.1f} MiB), {:.1f}/{:.1f} MiB resident",
+		evictedTextures.size(),
+		evictedMeshes.size(),
+		freed / (1024.0 * 1024.0),
+		getResidentBytes() / (1024.0 * 1024.0),
+		m_budget / (1024.0 * 1024.0)
+	);
+	return evicted;
+}
+
+void WebGPUResidencyManager::clear()
+{
+	m_textures.clear();
+	m_meshes.clear();
+	m_textureBytes = 0;
+	m_meshBytes = 0;
+}
+
+uint64_t WebGPUResidencyManager::estimateTextureBytes(const wgpu::TextureDescriptor &descriptor)
+{
+	const uint32_t blockBytes = getBytesPerBlock(descriptor.format);
+	const uint32_t texelBytes = blockBytes == 0 ? getBytesPerTexel(descriptor.format) : 0;
+	const uint32_t mipLevels = std::max(1u, descriptor.mipLevelCount);
+
+	uint64_t bytes = 0;
+	for (uint32_t level = 0; level < mipLevels; ++level)
+	{
+		const uint64_t width = std::max(1u, descriptor.size.width >> level);
+		const uint64_t height = std::max(1u, descriptor.size.height >> level);
+		if (blockBytes > 0)
+			bytes += ((width + 3) / 4) * ((height + 3) / 4) * blockBytes;
+		else
+			bytes += width * height * texelBytes;
+	}
+	return bytes * std::max(1u, descriptor.size.depthOrArrayLayers) * std::max(1u, descriptor.sampleCount);
+}
+
+} // namespace engine::rendering::webgpu
@@ -5,6 +5,7 @@
 #include <fstream>
 #include <spdlog/spdlog.h>
 
+#include "engine/core/Hash.h"
 #include "engine/core/PathProvider.h"
 #include "engine/rendering/BindGroupEnums.h"
 #include "engine/rendering/RenderingConstants.h"
@@ -20,6 +21,11 @@ WebGPUShaderFactory::WebGPUShaderFactory(WebGPUContext &context) : m_context(con
 {
 }
 
+WebGPUShaderFactory::~WebGPUShaderFactory()
+{
+	clearModuleCache();
+}
+
 WebGPUShaderFactory::WebGPUShaderBuilder WebGPUShaderFactory::begin(
 	const std::string &name,
 	ShaderType type,
@@ -224,8 +230,29 @@ WebGPUShaderFactory::WebGPUShaderBuilder &WebGPUShaderFactory::WebGPUShaderBuild
 	buffer.usage = WGPUBufferUsage_Storage | WGPUBufferUsage_CopyDst;
 	buffer.visibility = WGPUShaderStage_Vertex | WGPUShaderStage_Fragment;
 	buffer.readOnly = true;
-
 	bindGroupBuilder.bindings.push_back(buffer);
+
+	// Clustered lighting: offset/count per cluster into the light index list
+	ShaderBinding clusterBuffer;
+	clusterBuffer.type = BindingType::StorageBuffer;
+	clusterBuffer.name = "lightClusters";
+	clusterBuffer.binding = 1;
+	clusterBuffer.size = constants::LIGHT_CLUSTER_COUNT * sizeof(engine::rendering::LightCluster);
+	clusterBuffer.usage = WGPUBufferUsage_Storage | WGPUBufferUsage_CopyDst;
+	clusterBuffer.visibility = WGPUShaderStage_Fragment;
+	clusterBuffer.readOnly = true;
+	bindGroupBuilder.bindings.push_back(clusterBuffer);
+
+	ShaderBinding indexBuffer;
+	indexBuffer.type = BindingType::StorageBuffer;
+	indexBuffer.name = "lightIndices";
+	indexBuffer.binding = 2;
+	indexBuffer.size = constants::MAX_LIGHT_CLUSTER_INDICES * sizeof(uint32_t);
+	indexBuffer.usage = WGPUBufferUsage_Storage | WGPUBufferUsage_CopyDst;
+	indexBuffer.visibility = WGPUShaderStage_Fragment;
+	indexBuffer.readOnly = true;
+	bindGroupBuilder.bindings.push_back(indexBuffer);
+
 	m_lastBindGroupIndex = groupIndex;
 	return *this;
 }
@@ -297,6 +324,12 @@ WebGPUShaderFactory::WebGPUShaderBuilder &WebGPUShaderFactory::WebGPUShaderBuild
 	return *this;
 }
 
+WebGPUShaderFactory::WebGPUShaderBuilder &WebGPUShaderFactory::WebGPUShaderBuilder::setMaterialVariants(engine::rendering::MaterialFeature::Flag features)
+{
+	m_variantFeatures = features;
+	return *this;
+}
+
 void WebGPUShaderFactory::WebGPUShaderBuilder::checkLastBindGroup()
 {
 	if (m_lastBindGroupIndex < 0)
@@ -308,7 +341,8 @@ std::shared_ptr<WebGPUShaderInfo> WebGPUShaderFactory::WebGPUShaderBuilder::buil
 	wgpu::ShaderModule shaderModule = m_shaderModule;
 	if (!shaderModule && !m_shaderPath.empty())
 	{
-		shaderModule = m_factory.loadShaderModule(m_shaderPath.string());
+		// The base shader is the permutation with every variant feature enabled
+		shaderModule = m_factory.loadShaderModule(m_shaderPath.string(), buildFeaturePrelude(m_variantFeatures, m_variantFeatures));
 		if (!shaderModule)
 		{
 			spdlog::error("WebGPUShaderFactory::build() - Failed to load shader from '{}'", m_shaderPath.string());
@@ -335,6 +369,7 @@ std::shared_ptr<WebGPUShaderInfo> WebGPUShaderFactory::WebGPUShaderBuilder::buil
 		m_backFaceCullingEnabled
 	);
 
+	builtShaderInfo->setVariantFeatures(m_variantFeatures, m_variantFeatures);
 	m_factory.createBindGroupLayouts(builtShaderInfo, m_bindGroupsBuilder);
 
 	spdlog::info("WebGPUShaderFactory: Built shader '{}' with {} bind groups", builtShaderInfo->getName(), builtShaderInfo->getBindGroupLayouts().size());
@@ -450,7 +485,7 @@ void WebGPUShaderFactory::createBindGroupLayouts(
 	}
 }
 
-wgpu::ShaderModule WebGPUShaderFactory::loadShaderModule(const std::filesystem::path &shaderPath)
+wgpu::ShaderModule WebGPUShaderFactory::loadShaderModule(const std::filesystem::path &shaderPath, const std::string &prelude)
 {
 	if (shaderPath.empty())
 	{
@@ -458,6 +493,27 @@ wgpu::ShaderModule WebGPUShaderFactory::loadShaderModule(const std::filesystem::
 		return nullptr;
 	}
 
+	auto moduleKey = [&prelude](uint64_t contentHash)
+	{
+		return prelude.empty() ? contentHash : engine::core::hashCombine(contentHash, engine::core::fnv1a64(prelude));
+	};
+
+	// Unchanged file: reuse the module without reading the source again
+	std::error_code ec;
+	const auto writeTime = std::filesystem::last_write_time(shaderPath, ec);
+	const auto fileSize = ec ? 0 : std::filesystem::file_size(shaderPath, ec);
+	const std::string pathKey = shaderPath.string();
+	auto stampIt = m_sourceStamps.find(pathKey);
+	if (!ec && stampIt != m_sourceStamps.end() && stampIt->second.writeTime == writeTime && stampIt->second.size == fileSize)
+	{
+		auto moduleIt = m_moduleCache.find(moduleKey(stampIt->second.contentHash));
+		if (moduleIt != m_moduleCache.end())
+		{
+			moduleIt->second.module.reference();
+			return moduleIt->second.module;
+		}
+	}
+
 	// Use ResourceManager to load shader
 	std::ifstream file(shaderPath);
 	if (!file.is_open())
@@ -471,10 +527,52 @@ wgpu::ShaderModule WebGPUShaderFactory::loadShaderModule(const std::filesystem::
 	file.seekg(0);
 	file.read(shaderSource.data(), size);
 
+	const uint64_t contentHash = engine::core::fnv1a64(shaderSource);
+
+	// The source changed: drop the modules compiled from the previous version
+	if (stampIt != m_sourceStamps.end() && stampIt->second.contentHash != contentHash)
+	{
+		const uint64_t staleHash = stampIt->second.contentHash;
+		for (auto it = m_moduleCache.begin(); it != m_moduleCache.end();)
+		{
+			if (it->second.contentHash == staleHash)
+			{
+				it->second.module.release();
+				it = m_moduleCache.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+	if (!ec)
+		m_sourceStamps[pathKey] = {writeTime, fileSize, contentHash};
+
+	// Identical source already compiled (e.g. reload of an unchanged shader)
+	const uint64_t key = moduleKey(contentHash);
+	auto moduleIt = m_moduleCache.find(key);
+	if (moduleIt != m_moduleCache.end())
+	{
+		moduleIt->second.module.reference();
+		return moduleIt->second.module;
+	}
+
+	auto shaderModule = compileShaderModule(prelude.empty() ? shaderSource : prelude + shaderSource, shaderPath);
+	if (!shaderModule)
+		return nullptr;
+
+	shaderModule.reference(); // reference held by the cache
+	m_moduleCache.emplace(key, CachedShaderModule{shaderModule, contentHash});
+	return shaderModule;
+}
+
+wgpu::ShaderModule WebGPUShaderFactory::compileShaderModule(const std::string &source, const std::filesystem::path &shaderPath)
+{
 	wgpu::ShaderModuleWGSLDescriptor shaderCodeDesc;
 	shaderCodeDesc.chain.next = nullptr;
 	shaderCodeDesc.chain.sType = wgpu::SType::ShaderModuleWGSLDescriptor;
-	shaderCodeDesc.code = shaderSource.c_str();
+	shaderCodeDesc.code = source.c_str();
 	wgpu::ShaderModuleDescriptor shaderDesc;
 	shaderDesc.nextInChain = &shaderCodeDesc.chain;
 #ifdef WEBGPU_BACKEND_WGPU
@@ -492,6 +590,14 @@ wgpu::ShaderModule WebGPUShaderFactory::loadShaderModule(const std::filesystem::
 	return shaderModule;
 }
 
+void WebGPUShaderFactory::clearModuleCache()
+{
+	for (auto &[key, cached] : m_moduleCache)
+		cached.module.release();
+	m_moduleCache.clear();
+	m_sourceStamps.clear();
+}
+
 bool WebGPUShaderFactory::reloadShader(std::shared_ptr<WebGPUShaderInfo> shaderInfo)
 {
 	if (!shaderInfo || shaderInfo->getPath().empty())
@@ -501,7 +607,7 @@ bool WebGPUShaderFactory::reloadShader(std::shared_ptr<WebGPUShaderInfo> shaderI
 	}
 
 	std::filesystem::path shaderPath = shaderInfo->getPath();
-	auto shaderModule = loadShaderModule(shaderPath);
+	auto shaderModule = loadShaderModule(shaderPath, buildFeaturePrelude(shaderInfo->getVariantFeatures(), shaderInfo->getEnabledFeatures()));
 
 	if (!shaderModule)
 	{
@@ -528,8 +634,114 @@ bool WebGPUShaderFactory::reloadShader(std::shared_ptr<WebGPUShaderInfo> shaderI
 	{
 		newShaderInfo->addBindGroupLayout(groupIndex, layoutInfo);
 	}
+	newShaderInfo->setVariantFeatures(shaderInfo->getVariantFeatures(), shaderInfo->getEnabledFeatures());
 
 	return m_context.shaderRegistry().registerShader(newShaderInfo, true);
 }
 
+std::shared_ptr<WebGPUShaderInfo> WebGPUShaderFactory::createVariant(
+	const std::shared_ptr<WebGPUShaderInfo> &baseShader,
+	const std::string &variantName,
+	engine::rendering::MaterialFeature::Flag enabledFeatures
+)
+{
+	if (!baseShader || !baseShader->supportsVariants() || baseShader->getPath().empty())
+	{
+		spdlog::error("WebGPUShaderFactory::createVariant() - Shader does not support material variants");
+		return nullptr;
+	}
+
+	const auto variantFeatures = baseShader->getVariantFeatures();
+	auto shaderModule = loadShaderModule(baseShader->getPath(), buildFeaturePrelude(variantFeatures, enabledFeatures));
+	if (!shaderModule)
+	{
+		spdlog::error("WebGPUShaderFactory::createVariant() - Failed to compile variant '{}'", variantName);
+		return nullptr;
+	}
+
+	auto variant = std::make_shared<WebGPUShaderInfo>(
+		variantName,
+		baseShader->getPath(),
+		baseShader->getShaderType(),
+		shaderModule,
+		baseShader->getVertexEntryPoint(),
+		baseShader->getFragmentEntryPoint(),
+		baseShader->getVertexLayout(),
+		baseShader->getShaderFeatures(),
+		baseShader->isDepthEnabled(),
+		baseShader->isBackFaceCullingEnabled()
+	);
+
+	// Variants share the layouts, so material and frame bind groups stay compatible
+	for (const auto &[groupIndex, layoutInfo] : baseShader->getBindGroupLayouts())
+	{
+		variant->addBindGroupLayout(groupIndex, layoutInfo);
+	}
+	variant->setVariantFeatures(variantFeatures, enabledFeatures);
+
+	spdlog::info("WebGPUShaderFactory: Compiled shader variant '{}'", variantName);
+	return variant;
+}
+
+const char *WebGPUShaderFactory::getFeatureConstantName(engine::rendering::MaterialFeature::Flag feature)
+{
+	using Flag = engine::rendering::MaterialFeature::Flag;
+	switch (feature)
+	{
+	case Flag::UsesBaseColorMap:
+		return "HAS_BASE_COLOR_MAP";
+	case Flag::UsesNormalMap:
+		return "HAS_NORMAL_MAP";
+	case Flag::UsesOcclusionMap:
+		return "HAS_OCCLUSION_MAP";
+	case Flag::UsesEmissiveMap:
+		return "HAS_EMISSIVE_MAP";
+	case Flag::UsesMetallicRoughnessMap:
+		return "HAS_METALLIC_ROUGHNESS_MAP";
+	case Flag::UsesMetallicMap:
+		return "HAS_METALLIC_MAP";
+	case Flag::UsesRoughnessMap:
+		return "HAS_ROUGHNESS_MAP";
+	case Flag::UsesSpecularGlossiness:
+		return "HAS_SPECULAR_GLOSSINESS";
+	case Flag::UsesHeightMap:
+		return "HAS_HEIGHT_MAP";
+	case Flag::AlphaTest:
+		return "ALPHA_TEST";
+	case Flag::Transparent:
+		return "TRANSPARENT";
+	case Flag::DoubleSided:
+		return "DOUBLE_SIDED";
+	default:
+		return nullptr;
+	}
+}
+
+std::string WebGPUShaderFactory::buildFeaturePrelude(
+	engine::rendering::MaterialFeature::Flag variantFeatures,
+	engine::rendering::MaterialFeature::Flag enabledFeatures
+)
+{
+	using engine::rendering::MaterialFeature;
+	if (variantFeatures == MaterialFeature::Flag::None)
+		return {};
+
+	std::string prelude = "// Material feature constants (generated)\n";
+	for (size_t bit = 0; bit < 64; ++bit)
+	{
+		const auto flag = static_cast<MaterialFeature::Flag>(uint64_t{1} << bit);
+		if (!MaterialFeature::hasFlag(variantFeatures, flag))
+			continue;
+
+		const char *name = getFeatureConstantName(flag);
+		if (!name)
+			continue;
+
+		prelude += "const ";
+		prelude += name;
+		prelude += MaterialFeature::hasFlag(enabledFeatures, flag) ? ": bool = true;\n" : ": bool = false;\n";
+	}
+	return prelude;
+}
+
 } // namespace engine::rendering::webgpu
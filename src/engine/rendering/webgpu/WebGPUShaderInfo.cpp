@@ -1,8 +1,10 @@
 #include "engine/rendering/webgpu/WebGPUShaderInfo.h"
 
+#include <algorithm>
 #include <utility>
 #include <optional>
 
+#include "engine/rendering/FrameCache.h"
 #include "engine/rendering/webgpu/WebGPUBindGroupLayoutInfo.h"
 
 namespace engine::rendering::webgpu
@@ -18,6 +20,7 @@ WebGPUShaderInfo::~WebGPUShaderInfo()
 	m_bindGroupLayouts.clear();
 	m_nameToIndex.clear();
 	m_typeToIndex.clear();
+	m_bindGroupSlots.clear();
 }
 
 bool WebGPUShaderInfo::isValid() const
@@ -97,13 +100,22 @@ bool WebGPUShaderInfo::hasBindGroup(BindGroupType type) const
 	return m_typeToIndex.find(type) != m_typeToIndex.end();
 }
 
-void WebGPUShaderInfo::setName(std::string name) { m_name = std::move(name); }
+void WebGPUShaderInfo::setName(std::string name)
+{
+	m_name = std::move(name);
+	rebuildBindGroupSlots(); // custom keys depend on the shader name
+}
 void WebGPUShaderInfo::setPath(std::string path) { m_path = std::move(path); }
 void WebGPUShaderInfo::setVertexLayout(engine::rendering::VertexLayout layout) { m_vertexLayout = layout; }
 void WebGPUShaderInfo::setVertexEntryPoint(std::string entry) { m_vertexEntryPoint = std::move(entry); }
 void WebGPUShaderInfo::setFragmentEntryPoint(std::string entry) { m_fragmentEntryPoint = std::move(entry); }
 void WebGPUShaderInfo::setShaderType(engine::rendering::ShaderType type) { m_shaderType = type; }
 void WebGPUShaderInfo::setShaderFeatures(engine::rendering::ShaderFeature::Flag features) { m_features = features; }
+void WebGPUShaderInfo::setVariantFeatures(engine::rendering::MaterialFeature::Flag variantFeatures, engine::rendering::MaterialFeature::Flag enabledFeatures)
+{
+	m_variantFeatures = variantFeatures;
+	m_enabledFeatures = enabledFeatures & variantFeatures;
+}
 void WebGPUShaderInfo::setEnableDepth(bool enable) { m_enableDepth = enable; }
 void WebGPUShaderInfo::addBindGroupLayout(uint32_t groupIndex, std::shared_ptr<WebGPUBindGroupLayoutInfo> layout)
 {
@@ -111,6 +123,30 @@ void WebGPUShaderInfo::addBindGroupLayout(uint32_t groupIndex, std::shared_ptr<W
 	auto &ptr = m_bindGroupLayouts[groupIndex];
 	m_nameToIndex[ptr->getName()] = groupIndex;
 	m_typeToIndex[ptr->getType()] = groupIndex;
+	rebuildBindGroupSlots();
+}
+
+void WebGPUShaderInfo::rebuildBindGroupSlots()
+{
+	m_bindGroupSlots.clear();
+	m_bindGroupSlots.reserve(m_bindGroupLayouts.size());
+	for (const auto &[groupIndex, layout] : m_bindGroupLayouts)
+	{
+		if (!layout)
+			continue;
+
+		BindGroupSlot slot;
+		slot.groupIndex = static_cast<uint32_t>(groupIndex);
+		slot.type = layout->getType();
+		slot.reuse = layout->getReuse();
+		slot.layout = layout.get();
+		if (slot.type == BindGroupType::Custom)
+			slot.customKey = FrameCache::createCustomBindGroupBaseKey(m_name, layout->getName());
+		m_bindGroupSlots.push_back(slot);
+	}
+
+	std::sort(m_bindGroupSlots.begin(), m_bindGroupSlots.end(), [](const auto &a, const auto &b)
+			  { return a.groupIndex < b.groupIndex; });
 }
 
 } // namespace engine::rendering::webgpu
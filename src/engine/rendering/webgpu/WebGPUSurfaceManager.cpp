@@ -37,6 +37,12 @@ void WebGPUSurfaceManager::reconfigure(const std::optional<Config> &config)
 
 void WebGPUSurfaceManager::applyConfig()
 {
+	if (m_context.isHeadless())
+	{
+		applyOffscreenConfig();
+		return;
+	}
+
 	m_context.terminateSurface();
 	auto surface = m_context.getSurface();
 
@@ -64,8 +70,39 @@ void WebGPUSurfaceManager::applyConfig()
 	m_lastAppliedConfig = m_config;
 }
 
+void WebGPUSurfaceManager::applyOffscreenConfig()
+{
+	m_lastAppliedConfig = m_config;
+	if (m_config.width == 0 || m_config.height == 0)
+	{
+		m_offscreenTexture.reset();
+		return;
+	}
+
+	m_offscreenTexture = m_context.textureFactory().createRenderTarget(
+		OFFSCREEN_TARGET_ID,
+		m_config.width,
+		m_config.height,
+		m_config.format
+	);
+}
+
+void WebGPUSurfaceManager::present()
+{
+	if (m_context.isHeadless())
+		return;
+	m_context.getSurface().present();
+}
+
 std::shared_ptr<WebGPUTexture> WebGPUSurfaceManager::acquireNextTexture()
 {
+	if (m_context.isHeadless())
+	{
+		if (m_config != m_lastAppliedConfig)
+			applyOffscreenConfig();
+		return m_offscreenTexture;
+	}
+
 	// ToDo: Handle lost surface/swap-chain
 	auto surface = m_context.getSurface();
 	// ensure surface is up-to-date
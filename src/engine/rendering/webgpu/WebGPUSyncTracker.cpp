@@ -0,0 +1,103 @@
+#include "engine/rendering/webgpu/WebGPUSyncTracker.h"
+#include "engine/core/Profiler.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "engine/core/Versioned.h"
+#include "engine/rendering/webgpu/WebGPUSyncObject.h"
+
+namespace engine::rendering::webgpu
+{
+
+core::ChangeJournal::token_t WebGPUSyncTracker::watch(const core::Versioned &source, const std::shared_ptr<WebGPUSyncDependent> &dependent)
+{
+	const auto token = core::ChangeJournal::instance().track(source);
+	if (!dependent)
+		return token;
+
+	auto &dependents = m_dependents[token];
+	const bool known = std::any_of(dependents.begin(), dependents.end(), [&dependent](const auto &weak)
+	{
+		return !weak.owner_before(dependent) && !dependent.owner_before(weak);
+	});
+	if (!known)
+		dependents.push_back(dependent);
+
+	// Sources that are never changed again would keep their expired entries forever
+	if (m_dependents.size() >= m_pruneThreshold)
+	{
+		prune();
+		m_pruneThreshold = std::max<size_t>(64, m_dependents.size() * 2);
+	}
+	return token;
+}
+
+void WebGPUSyncTracker::unwatch(core::ChangeJournal::token_t token, const WebGPUSyncDependent *dependent)
+{
+	auto it = m_dependents.find(token);
+	if (it == m_dependents.end())
+		return;
+
+	auto &dependents = it->second;
+	dependents.erase(
+		std::remove_if(dependents.begin(), dependents.end(), [dependent](const auto &weak)
+		{
+			auto locked = weak.lock();
+			return !locked || locked.get() == dependent;
+		}),
+		dependents.end()
+	);
+	if (dependents.empty())
+		m_dependents.erase(it);
+}
+
+size_t WebGPUSyncTracker::processChanges()
+{
+	ENGINE_PROFILE_SCOPE("WebGPUSyncTracker::processChanges");
+	core::ChangeJournal::instance().drain(m_changedTokens);
+
+	size_t marked = 0;
+	for (auto token : m_changedTokens)
+	{
+		auto it = m_dependents.find(token);
+		if (it == m_dependents.end())
+			continue;
+
+		// Drop dependents that were destroyed since they registered
+		auto &dependents = it->second;
+		dependents.erase(
+			std::remove_if(dependents.begin(), dependents.end(), [&marked](const auto &weak)
+			{
+				auto dependent = weak.lock();
+				if (!dependent)
+					return true;
+				dependent->markSyncPending();
+				++marked;
+				return false;
+			}),
+			dependents.end()
+		);
+		if (dependents.empty())
+			m_dependents.erase(it);
+	}
+	return marked;
+}
+
+void WebGPUSyncTracker::prune()
+{
+	for (auto it = m_dependents.begin(); it != m_dependents.end();)
+	{
+		auto &dependents = it->second;
+		dependents.erase(
+			std::remove_if(dependents.begin(), dependents.end(), [](const auto &weak)
+			{
+				return weak.expired();
+			}),
+			dependents.end()
+		);
+		it = dependents.empty() ? m_dependents.erase(it) : std::next(it);
+	}
+}
+
+} // namespace engine::rendering::webgpu
@@ -18,6 +18,10 @@ WebGPUTexture::~WebGPUTexture()
 		}
 	}
 	m_layerViews.clear();
+	if (m_arrayView)
+	{
+		m_arrayView.release();
+	}
 
 	// Release main view and texture
 	if (m_textureView)
@@ -81,6 +85,11 @@ bool WebGPUTexture::resize(WebGPUContext &context, uint32_t newWidth, uint32_t n
 		}
 	}
 	m_layerViews.clear();
+	if (m_arrayView)
+	{
+		m_arrayView.release();
+		m_arrayView = nullptr;
+	}
 
 	if (m_textureView)
 		m_textureView.release();
@@ -244,150 +253,32 @@ wgpu::TextureView WebGPUTexture::getCubeMapFace(uint32_t cubeIndex, uint32_t fac
 	return view;
 }
 
-bool WebGPUTexture::beginReadback(WebGPUContext &context)
+wgpu::TextureView WebGPUTexture::getArrayView() const
 {
-	if (m_readbackPending)
-		return false;
-
-	m_readbackWidth = getWidth();
-	m_readbackHeight = getHeight();
-	m_readbackBPP = engine::resources::ImageFormat::getBytesPerPixel(
-		mapGPUFormatToImageFormat(getFormat())
-	);
-
-	const uint32_t unaligned = m_readbackWidth * m_readbackBPP;
-	m_readbackBytesPerRow = (unaligned + 255u) & ~255u;
-	const uint64_t bufferSize = static_cast<uint64_t>(m_readbackBytesPerRow) * m_readbackHeight;
-
-	wgpu::BufferDescriptor bufferDesc{};
-	bufferDesc.size = bufferSize;
-	bufferDesc.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::MapRead;
-	m_readbackStagingBuffer = context.getDevice().createBuffer(bufferDesc);
-
-	wgpu::CommandEncoder encoder = context.getDevice().createCommandEncoder();
-
-	wgpu::ImageCopyTexture src{};
-	src.texture = m_texture;
-	src.mipLevel = 0;
-	src.origin = {0, 0, 0};
-
-	wgpu::ImageCopyBuffer dst{};
-	dst.buffer = m_readbackStagingBuffer;
-	dst.layout.bytesPerRow = m_readbackBytesPerRow;
-	dst.layout.rowsPerImage = m_readbackHeight;
-	dst.layout.offset = 0;
-	encoder.copyTextureToBuffer(src, dst, {m_readbackWidth, m_readbackHeight, 1});
-	wgpu::CommandBuffer commands = encoder.finish();
-	context.getQueue().submit(1, &commands);
-
-	m_readbackMapped = false;
-	m_readbackSuccess = false;
-	m_readbackPending = true;
-
-	m_readbackCallback = m_readbackStagingBuffer.mapAsync(
-		wgpu::MapMode::Read,
-		0,
-		bufferSize,
-		[this](WGPUBufferMapAsyncStatus status)
-		{
-			m_readbackSuccess = (status == WGPUBufferMapAsyncStatus_Success);
-			m_readbackMapped = true;
-		}
-	);
-
-	return true;
-}
-bool WebGPUTexture::pollReadback(WebGPUContext &context, std::shared_ptr<Texture> outTexture)
-{
-	if (!m_readbackPending)
-		return true;
-	if (!m_readbackMapped)
-		return false;
-
-	m_readbackPending = false;
-	m_readbackCallback = nullptr;
-
-	if (!m_readbackSuccess)
-	{
-		spdlog::error("Texture readback failed.");
-		m_readbackStagingBuffer.release();
-		return true;
-	}
-
-	const uint64_t bufferSize = static_cast<uint64_t>(m_readbackBytesPerRow) * m_readbackHeight;
-	const uint8_t *src = static_cast<const uint8_t *>(
-		m_readbackStagingBuffer.getMappedRange(0, bufferSize)
-	);
-
-	// Output is always RGBA8Unorm (LDR) for PNG compatibility
-	const uint32_t outBPP = 4; // RGBA8
-	const uint32_t outBPR = m_readbackWidth * outBPP;
-	std::vector<uint8_t> pixelData(m_readbackHeight * outBPR);
+	if (is2DArrayLayerView())
+		return m_textureView;
 
-	const bool isHDR = (getFormat() == wgpu::TextureFormat::RGBA16Float || getFormat() == wgpu::TextureFormat::RGBA32Float);
+	if (m_arrayView)
+		return m_arrayView;
 
-	for (uint32_t row = 0; row < m_readbackHeight; ++row)
+	if (!m_texture)
 	{
-		const uint8_t *rowSrc = src + row * m_readbackBytesPerRow;
-		uint8_t *rowDst = pixelData.data() + row * outBPR;
-
-		// Accurate linear -> sRGB conversion (IEC 61966-2-1 standard)
-		auto linearToSRGB = [](float linear) -> float
-		{
-			linear = std::max(linear, 0.0f);
-			if (linear <= 0.0031308f)
-				return linear * 12.92f;
-			return 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
-		};
-
-		if (isHDR && getFormat() == wgpu::TextureFormat::RGBA16Float)
-		{
-			const uint16_t *f16Src = reinterpret_cast<const uint16_t *>(rowSrc);
-			for (uint32_t x = 0; x < m_readbackWidth; ++x)
-			{
-				const uint32_t i = x * 4;
-				float r = glm::detail::toFloat32(f16Src[i + 0]);
-				float g = glm::detail::toFloat32(f16Src[i + 1]);
-				float b = glm::detail::toFloat32(f16Src[i + 2]);
-				float a = glm::detail::toFloat32(f16Src[i + 3]);
-
-				rowDst[i + 0] = static_cast<uint8_t>(std::clamp(linearToSRGB(r), 0.0f, 1.0f) * 255.0f + 0.5f);
-				rowDst[i + 1] = static_cast<uint8_t>(std::clamp(linearToSRGB(g), 0.0f, 1.0f) * 255.0f + 0.5f);
-				rowDst[i + 2] = static_cast<uint8_t>(std::clamp(linearToSRGB(b), 0.0f, 1.0f) * 255.0f + 0.5f);
-				rowDst[i + 3] = static_cast<uint8_t>(std::clamp(a, 0.0f, 1.0f) * 255.0f + 0.5f);
-			}
-		}
-		else if (isHDR && getFormat() == wgpu::TextureFormat::RGBA32Float)
-		{
-			const float *f32Src = reinterpret_cast<const float *>(rowSrc);
-			for (uint32_t x = 0; x < m_readbackWidth; ++x)
-			{
-				const uint32_t i = x * 4;
-				rowDst[i + 0] = static_cast<uint8_t>(std::clamp(linearToSRGB(f32Src[i + 0]), 0.0f, 1.0f) * 255.0f + 0.5f);
-				rowDst[i + 1] = static_cast<uint8_t>(std::clamp(linearToSRGB(f32Src[i + 1]), 0.0f, 1.0f) * 255.0f + 0.5f);
-				rowDst[i + 2] = static_cast<uint8_t>(std::clamp(linearToSRGB(f32Src[i + 2]), 0.0f, 1.0f) * 255.0f + 0.5f);
-				rowDst[i + 3] = static_cast<uint8_t>(std::clamp(f32Src[i + 3], 0.0f, 1.0f) * 255.0f + 0.5f);
-			}
-		}
-		else
-		{
-			// LDR formats — direct copy, stripping alignment padding
-			std::memcpy(rowDst, rowSrc, outBPR);
-		}
+		spdlog::error("WebGPUTexture::getArrayView: Cannot create array view from null texture.");
+		return nullptr;
 	}
 
-	m_readbackStagingBuffer.unmap();
-	m_readbackStagingBuffer.release();
-
-	auto image = std::make_shared<engine::resources::Image>(
-		m_readbackWidth,
-		m_readbackHeight,
-		engine::resources::ImageFormat::Type::LDR_RGBA8, // always LDR output
-		std::move(pixelData)
-	);
-	outTexture->replaceImageData(image);
+	wgpu::TextureViewDescriptor viewDesc{};
+	viewDesc.label = "Texture 2D Array View";
+	viewDesc.format = m_textureDesc.format;
+	viewDesc.dimension = wgpu::TextureViewDimension::_2DArray;
+	viewDesc.baseMipLevel = 0;
+	viewDesc.mipLevelCount = m_textureDesc.mipLevelCount;
+	viewDesc.baseArrayLayer = 0;
+	viewDesc.arrayLayerCount = m_textureDesc.size.depthOrArrayLayers;
+	viewDesc.aspect = wgpu::TextureAspect::All;
 
-	return true;
+	m_arrayView = wgpuTextureCreateView(m_texture, &viewDesc); // Use C API to create the view because of const correctness
+	return m_arrayView;
 }
 
 } // namespace engine::rendering::webgpu
\ No newline at end of file
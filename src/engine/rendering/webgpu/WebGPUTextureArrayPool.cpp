@@ -0,0 +1,299 @@
+#include "engine/rendering/webgpu/WebGPUTextureArrayPool.h"
+#include "engine/core/Profiler.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+#include "engine/core/Hash.h"
+#include "engine/rendering/RenderingConstants.h"
+#include "engine/rendering/webgpu/WebGPUContext.h"
+#include "engine/rendering/webgpu/WebGPUTexture.h"
+#include "engine/rendering/webgpu/WebGPUTextureFactory.h"
+
+namespace engine::rendering::webgpu
+{
+
+size_t WebGPUTextureArrayPool::PageKeyHash::operator()(const PageKey &key) const
+{
+	uint64_t h = core::hashCombine(core::FNV1A_64_OFFSET, (static_cast<uint64_t>(key.width) << 32) | key.height);
+	h = core::hashCombine(h, static_cast<uint64_t>(key.format));
+	return static_cast<size_t>(core::hashCombine(h, key.mipLevelCount));
+}
+
+WebGPUTextureArrayPool::WebGPUTextureArrayPool(WebGPUContext &context) :
+	m_context(context)
+{
+}
+
+std::shared_ptr<WebGPUTextureArrayLayer> WebGPUTextureArrayPool::find(uint64_t key)
+{
+	auto it = m_entries.find(key);
+	if (it == m_entries.end())
+		return nullptr;
+	if (auto layer = it->second.lock())
+		return layer;
+	m_entries.erase(it);
+	return nullptr;
+}
+
+std::shared_ptr<WebGPUTextureArrayLayer> WebGPUTextureArrayPool::pack(
+	const std::shared_ptr<WebGPUTexture> &texture,
+	uint64_t key,
+	std::shared_ptr<WebGPUTexture> *outReplacedPage
+)
+{
+	if (auto existing = find(key))
+		return existing;
+	if (!texture || !isPackable(*texture))
+		return nullptr;
+
+	ENGINE_PROFILE_SCOPE("WebGPUTextureArrayPool::pack");
+	const auto &desc = texture->getTextureDescriptor();
+	const PageKey pageKey{desc.size.width, desc.size.height, desc.format, desc.mipLevelCount};
+	auto &pages = m_pages[pageKey];
+
+	auto layer = std::make_shared<WebGPUTextureArrayLayer>();
+	layer->key = key;
+
+	// First free layer: released by all holders, never used, or gained by growing the page
+	bool reused = false;
+	for (auto &page : pages)
+	{
+		auto freeIt = std::find_if(page->layers.begin(), page->layers.end(), [](const auto &holder)
+		{
+			return holder.expired();
+		});
+		reused = freeIt != page->layers.end();
+		if (!reused)
+		{
+			const uint32_t capacity = page->texture->getTextureDescriptor().size.depthOrArrayLayers;
+			if (page->layers.size() >= capacity)
+			{
+				if (capacity >= page->maxLayers)
+					continue;
+				auto previous = page->texture;
+				if (!growPage(pageKey, *page))
+					continue;
+				if (outReplacedPage)
+					*outReplacedPage = std::move(previous);
+			}
+			freeIt = page->layers.emplace(page->layers.end());
+		}
+		layer->page = page;
+		layer->layer = static_cast<uint32_t>(std::distance(page->layers.begin(), freeIt));
+		*freeIt = layer;
+		break;
+	}
+
+	if (!layer->page)
+	{
+		auto page = std::make_shared<WebGPUTextureArrayPage>();
+		page->maxLayers = layersPerPage(pageKey);
+		page->texture = createPage(pageKey, std::min(constants::MATERIAL_TEXTURE_ARRAY_INITIAL_LAYERS, page->maxLayers));
+		if (!page->texture)
+			return nullptr;
+		page->layers.push_back(layer);
+		pages.push_back(page);
+		layer->page = std::move(page);
+		layer->layer = 0;
+	}
+
+	copyToLayer(*texture, *layer->page->texture, layer->layer);
+
+	if (reused)
+		prune();
+
+	m_entries[key] = layer;
+	return layer;
+}
+
+size_t WebGPUTextureArrayPool::getPageCount() const
+{
+	size_t count = 0;
+	for (const auto &[key, pages] : m_pages)
+		count += pages.size();
+	return count;
+}
+
+size_t WebGPUTextureArrayPool::getPackedCount() const
+{
+	return static_cast<size_t>(std::count_if(m_entries.begin(), m_entries.end(), [](const auto &entry)
+	{
+		return !entry.second.expired();
+	}));
+}
+
+void WebGPUTextureArrayPool::cleanup()
+{
+	m_entries.clear();
+	m_pages.clear();
+}
+
+bool WebGPUTextureArrayPool::isPackable(const WebGPUTexture &texture)
+{
+	const auto &desc = texture.getTextureDescriptor();
+	if (!texture.getTexture() || texture.isSurfaceTexture() || texture.isDepthTexture())
+		return false;
+	if (desc.dimension != wgpu::TextureDimension::_2D || desc.size.depthOrArrayLayers != 1 || desc.sampleCount != 1)
+		return false;
+	if ((static_cast<WGPUTextureUsageFlags>(desc.usage) & WGPUTextureUsage_CopySrc) == 0)
+		return false;
+
+	switch (desc.format)
+	{
+	case wgpu::TextureFormat::R8Unorm:
+	case wgpu::TextureFormat::RG8Unorm:
+	case wgpu::TextureFormat::RGBA8Unorm:
+	case wgpu::TextureFormat::RGBA8UnormSrgb:
+	case wgpu::TextureFormat::R16Float:
+	case wgpu::TextureFormat::RG16Float:
+	case wgpu::TextureFormat::RGBA16Float:
+	case wgpu::TextureFormat::RGBA32Float:
+		return true;
+	default:
+		return false;
+	}
+}
+
+uint32_t WebGPUTextureArrayPool::layersPerPage(const PageKey &key) const
+{
+	uint64_t layerBytes = 0;
+	for (uint32_t mip = 0; mip < key.mipLevelCount; ++mip)
+	{
+		const uint64_t width = std::max(1u, key.width >> mip);
+		const uint64_t height = std::max(1u, key.height >> mip);
+		layerBytes += width * height * WebGPUTexture::getBytesPerPixel(key.format);
+	}
+
+	const uint64_t budgetLayers = constants::MATERIAL_TEXTURE_ARRAY_PAGE_BYTES / std::max<uint64_t>(layerBytes, 1);
+	const uint32_t maxLayers = std::min(constants::MAX_MATERIAL_TEXTURE_ARRAY_LAYERS, m_context.resolvedLimits().maxTextureArrayLayers);
+	return static_cast<uint32_t>(std::clamp<uint64_t>(budgetLayers, 1, std::max(maxLayers, 1u)));
+}
+
+std::shared_ptr<WebGPUTexture> WebGPUTextureArrayPool::createPage(const PageKey &key, uint32_t layers)
+{
+	const std::string label = "TextureArrayPage_" + std::to_string(key.width) + "x" + std::to_string(key.height);
+
+	wgpu::TextureDescriptor desc{};
+	desc.label = label.c_str();
+	desc.dimension = wgpu::TextureDimension::_2D;
+	desc.size = {key.width, key.height, layers};
+	desc.format = key.format;
+	desc.mipLevelCount = key.mipLevelCount;
+	desc.sampleCount = 1;
+	// CopySrc to move the layers into a larger page when this one is full
+	desc.usage = wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::CopyDst | wgpu::TextureUsage::CopySrc;
+
+	wgpu::Texture texture = m_context.getDevice().createTexture(desc);
+	if (!texture)
+	{
+		spdlog::error("WebGPUTextureArrayPool: Failed to create {} page with {} layers", label, layers);
+		return nullptr;
+	}
+
+	wgpu::TextureViewDescriptor viewDesc{};
+	viewDesc.format = desc.format;
+	viewDesc.dimension = wgpu::TextureViewDimension::_2DArray;
+	viewDesc.baseMipLevel = 0;
+	viewDesc.mipLevelCount = desc.mipLevelCount;
+	viewDesc.baseArrayLayer = 0;
+	viewDesc.arrayLayerCount = layers;
+	viewDesc.aspect = wgpu::TextureAspect::All;
+	wgpu::TextureView view = texture.createView(viewDesc);
+
+	spdlog::debug("WebGPUTextureArrayPool: Created {} page with {} layers", label, layers);
+	return std::make_shared<WebGPUTexture>(texture, view, desc, viewDesc);
+}
+
+bool WebGPUTextureArrayPool::growPage(const PageKey &key, WebGPUTextureArrayPage &page)
+{
+	const uint32_t layers = page.texture->getTextureDescriptor().size.depthOrArrayLayers;
+	auto grown = createPage(key, std::min(layers * 2, page.maxLayers));
+	if (!grown)
+		return false;
+
+	wgpu::CommandEncoder encoder = m_context.getDevice().createCommandEncoder();
+	for (uint32_t mip = 0; mip < key.mipLevelCount; ++mip)
+	{
+		wgpu::ImageCopyTexture src{};
+		src.texture = page.texture->getTexture();
+		src.mipLevel = mip;
+		src.origin = {0, 0, 0};
+		src.aspect = wgpu::TextureAspect::All;
+
+		wgpu::ImageCopyTexture dst{};
+		dst.texture = grown->getTexture();
+		dst.mipLevel = mip;
+		dst.origin = {0, 0, 0};
+		dst.aspect = wgpu::TextureAspect::All;
+
+		encoder.copyTextureToTexture(src, dst, {std::max(1u, key.width >> mip), std::max(1u, key.height >> mip), layers});
+	}
+	wgpu::CommandBuffer commands = encoder.finish();
+	m_context.getQueue().submit(1, &commands);
+
+	page.texture = std::move(grown);
+	return true;
+}
+
+void WebGPUTextureArrayPool::copyToLayer(const WebGPUTexture &source, const WebGPUTexture &page, uint32_t layer)
+{
+	// Queued mips must exist before they are copied into the page
+	auto &mipmaps = m_context.textureFactory().mipmapGenerator();
+	if (mipmaps.isPending(source.getTexture()))
+		mipmaps.flush();
+
+	wgpu::CommandEncoder encoder = m_context.getDevice().createCommandEncoder();
+	const auto &desc = source.getTextureDescriptor();
+	for (uint32_t mip = 0; mip < desc.mipLevelCount; ++mip)
+	{
+		wgpu::ImageCopyTexture src{};
+		src.texture = source.getTexture();
+		src.mipLevel = mip;
+		src.origin = {0, 0, 0};
+		src.aspect = wgpu::TextureAspect::All;
+
+		wgpu::ImageCopyTexture dst{};
+		dst.texture = page.getTexture();
+		dst.mipLevel = mip;
+		dst.origin = {0, 0, layer};
+		dst.aspect = wgpu::TextureAspect::All;
+
+		encoder.copyTextureToTexture(src, dst, {std::max(1u, desc.size.width >> mip), std::max(1u, desc.size.height >> mip), 1});
+	}
+	wgpu::CommandBuffer commands = encoder.finish();
+	m_context.getQueue().submit(1, &commands);
+}
+
+void WebGPUTextureArrayPool::prune()
+{
+	for (auto it = m_entries.begin(); it != m_entries.end();)
+	{
+		if (it->second.expired())
+			it = m_entries.erase(it);
+		else
+			++it;
+	}
+
+	// Pages nothing is packed in anymore; bind groups still using them keep them alive
+	for (auto it = m_pages.begin(); it != m_pages.end();)
+	{
+		auto &pages = it->second;
+		pages.erase(
+			std::remove_if(pages.begin(), pages.end(), [](const auto &page)
+			{
+				return std::all_of(page->layers.begin(), page->layers.end(), [](const auto &holder)
+				{
+					return holder.expired();
+				});
+			}),
+			pages.end()
+		);
+		it = pages.empty() ? m_pages.erase(it) : std::next(it);
+	}
+}
+
+} // namespace engine::rendering::webgpu
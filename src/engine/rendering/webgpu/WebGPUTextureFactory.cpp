@@ -5,10 +5,8 @@
 #include <vector>
 #include <spdlog/spdlog.h>
 
-#include "engine/rendering/ShaderRegistry.h"
 #include "engine/rendering/Texture.h"
 #include "engine/rendering/webgpu/WebGPUContext.h"
-#include "engine/rendering/webgpu/WebGPUSamplerFactory.h"
 
 #ifdef None
 #undef None
@@ -17,56 +15,10 @@
 namespace engine::rendering::webgpu
 {
 
-// Helper: Convert float32 to float16 (half precision)
-static uint16_t float32ToFloat16(float f)
-{
-	union {
-		uint32_t i;
-		float f;
-	} v;
-	v.f = f;
-	uint32_t x = v.i;
-
-	// Extract sign
-	uint32_t sign = (x >> 31) & 0x0001;
-	// Extract exponent
-	uint32_t exponent = (x >> 23) & 0x00FF;
-	// Extract mantissa
-	uint32_t mantissa = x & 0x007FFFFF;
-
-	// Check for special cases
-	if (exponent == 0xFF)
-	{
-		// Infinity or NaN
-		return (uint16_t)((sign << 15) | 0x7C00 | (mantissa != 0 ? 0x0200 : 0));
-	}
-	else if (exponent == 0)
-	{
-		// Zero or subnormal
-		return (uint16_t)(sign << 15);
-	}
-	else
-	{
-		// Normal number
-		exponent = exponent - 127 + 15;
-		if (exponent >= 31)
-		{
-			// Overflow to infinity
-			return (uint16_t)((sign << 15) | 0x7C00);
-		}
-		else if (exponent <= 0)
-		{
-			// Underflow to zero
-			return (uint16_t)(sign << 15);
-		}
-		// Round mantissa
-		mantissa = mantissa + 0x1000;
-		return (uint16_t)((sign << 15) | (exponent << 10) | ((mantissa >> 13) & 0x03FF));
-	}
-}
-
 WebGPUTextureFactory::WebGPUTextureFactory(WebGPUContext &context) :
-	BaseWebGPUFactory(context)
+	BaseWebGPUFactory(context),
+	m_arrayPool(context),
+	m_mipmapGenerator(context)
 {
 }
 
@@ -109,7 +61,7 @@ std::shared_ptr<WebGPUTexture> WebGPUTextureFactory::createFromColor(
 	desc.size.height = height;
 	desc.size.depthOrArrayLayers = 1;
 	desc.format = format;
-	desc.usage = wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::CopyDst;
+	desc.usage = wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::CopyDst | wgpu::TextureUsage::CopySrc; // CopySrc: texture array packing
 	desc.mipLevelCount = 1;
 	desc.sampleCount = 1;
 	desc.viewFormatCount = 0;
@@ -176,9 +128,18 @@ std::shared_ptr<WebGPUTexture> WebGPUTextureFactory::createFromHandleUncached(
 	// Determine color space
 	ColorSpace colorSpace = options.colorSpace.value_or(ColorSpace::sRGB);
 
+	// Cooked images carry their own mip chain; block-compressed ones also fix the format
+	const auto image = texture.getType() == Texture::Type::Image ? texture.getImage() : nullptr;
+	const bool compressed = image && image->isCompressed();
+	const bool precomputedMips = image && image->getMipLevelCount() > 1;
+
 	// Format
 	wgpu::TextureFormat format = options.format.value_or(wgpu::TextureFormat::Undefined);
-	if (format == wgpu::TextureFormat::Undefined)
+	if (compressed)
+	{
+		format = WebGPUTexture::mapBlockCompressionToGPU(image->getBlockCompression(), colorSpace);
+	}
+	else if (format == wgpu::TextureFormat::Undefined)
 	{
 		switch (texture.getType())
 		{
@@ -207,10 +168,13 @@ std::shared_ptr<WebGPUTexture> WebGPUTextureFactory::createFromHandleUncached(
 
 	// Mip levels
 	float maxDimension = std::floor(std::log2(std::max(texture.getWidth(), texture.getHeight())));
+	const bool generateMips = options.generateMipmaps && !compressed && !precomputedMips;
 	uint32_t mipLevelCount =
 		options.generateMipmaps
 			? 1 + static_cast<uint32_t>(maxDimension)
 			: 1;
+	if (compressed || precomputedMips)
+		mipLevelCount = image->getMipLevelCount();
 
 	// Usage
 	wgpu::TextureUsage usage = options.usage.value_or(wgpu::TextureUsage::None);
@@ -219,18 +183,12 @@ std::shared_ptr<WebGPUTexture> WebGPUTextureFactory::createFromHandleUncached(
 		switch (texture.getType())
 		{
 		case Texture::Type::Image:
-			// If mipmaps will be generated, we need RenderAttachment usage
-			// because each mip level is rendered to during generation
-			if (options.generateMipmaps && mipLevelCount > 1)
-			{
-				usage = static_cast<WGPUTextureUsage>(
-					WGPUTextureUsage_TextureBinding | WGPUTextureUsage_CopyDst | WGPUTextureUsage_RenderAttachment
-				);
-			}
-			else
-			{
-				usage = static_cast<WGPUTextureUsage>(WGPUTextureUsage_TextureBinding | WGPUTextureUsage_CopyDst);
-			}
+			// CopySrc lets the texture array pool copy images into its pages.
+			// Mip generation adds StorageBinding (compute downsampler) or
+			// RenderAttachment (blit fallback) depending on the format.
+			usage = static_cast<WGPUTextureUsage>(WGPUTextureUsage_TextureBinding | WGPUTextureUsage_CopyDst | WGPUTextureUsage_CopySrc);
+			if (generateMips && mipLevelCount > 1)
+				usage = usage | WebGPUMipmapGenerator::getRequiredUsage(format);
 			break;
 		case Texture::Type::RenderTarget:
 			usage = static_cast<WGPUTextureUsage>(
@@ -263,12 +221,12 @@ std::shared_ptr<WebGPUTexture> WebGPUTextureFactory::createFromHandleUncached(
 
 	wgpu::Texture gpuTexture = m_context.getDevice().createTexture(desc);
 
-	// Upload base level for images
+	// Upload base level (all levels for cooked images)
 	if (texture.getType() == Texture::Type::Image)
 		uploadTextureData(texture, gpuTexture);
 
-	// Generate mipmaps
-	if (options.generateMipmaps && mipLevelCount > 1)
+	// Queue mipmap generation, batched with all other textures until flushMipmaps()
+	if (generateMips && mipLevelCount > 1)
 		generateMipmaps(gpuTexture, format, texture.getWidth(), texture.getHeight(), mipLevelCount);
 
 	// Create default view
@@ -376,6 +334,60 @@ std::shared_ptr<WebGPUTexture> WebGPUTextureFactory::createFromDescriptors(
 	);
 }
 
+std::shared_ptr<WebGPUTexture> WebGPUTextureFactory::createFromHalfFloatMips(
+	uint32_t width,
+	uint32_t height,
+	wgpu::TextureFormat format,
+	const std::vector<std::vector<uint16_t>> &levels,
+	const char *label
+)
+{
+	assert(!levels.empty() && "At least one mip level is required");
+
+	wgpu::TextureDescriptor textureDesc{};
+	textureDesc.label = label;
+	textureDesc.dimension = wgpu::TextureDimension::_2D;
+	textureDesc.size = {width, height, 1};
+	textureDesc.format = format;
+	textureDesc.usage = wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::CopyDst;
+	textureDesc.mipLevelCount = static_cast<uint32_t>(levels.size());
+	textureDesc.sampleCount = 1;
+	textureDesc.viewFormatCount = 0;
+	textureDesc.viewFormats = nullptr;
+
+	wgpu::TextureViewDescriptor viewDesc{};
+	viewDesc.format = format;
+	viewDesc.dimension = wgpu::TextureViewDimension::_2D;
+	viewDesc.baseMipLevel = 0;
+	viewDesc.mipLevelCount = textureDesc.mipLevelCount;
+	viewDesc.baseArrayLayer = 0;
+	viewDesc.arrayLayerCount = 1;
+	viewDesc.aspect = wgpu::TextureAspect::All;
+
+	auto texture = createFromDescriptors(textureDesc, viewDesc);
+	const uint32_t bytesPerPixel = WebGPUTexture::getBytesPerPixel(format);
+	for (uint32_t level = 0; level < levels.size(); ++level)
+	{
+		const uint32_t levelWidth = std::max(1u, width >> level);
+		const uint32_t levelHeight = std::max(1u, height >> level);
+
+		wgpu::ImageCopyTexture dst{};
+		dst.texture = texture->getTexture();
+		dst.mipLevel = level;
+		dst.origin = {0, 0, 0};
+		dst.aspect = wgpu::TextureAspect::All;
+
+		wgpu::TextureDataLayout layout{};
+		layout.offset = 0;
+		layout.bytesPerRow = levelWidth * bytesPerPixel;
+		layout.rowsPerImage = levelHeight;
+
+		wgpu::Extent3D extent{levelWidth, levelHeight, 1};
+		m_context.getQueue().writeTexture(dst, levels[level].data(), levels[level].size() * sizeof(uint16_t), layout, extent);
+	}
+	return texture;
+}
+
 void WebGPUTextureFactory::uploadTextureData(const Texture &texture, wgpu::Texture &gpuTexture)
 {
 	if (!texture.getImage())
@@ -385,11 +397,16 @@ void WebGPUTextureFactory::uploadTextureData(const Texture &texture, wgpu::Textu
 	}
 
 	auto image = texture.getImage();
+	if (image->isCompressed() || image->getMipLevelCount() > 1)
+	{
+		uploadMipChain(*image, gpuTexture);
+		return;
+	}
+
 	const void *pixelData = nullptr;
 	size_t dataSize = 0;
-	std::vector<uint16_t> convertedData; // For float32 → float16 conversion
 
-	// Get pixel data based on format
+	// Get pixel data based on format; HDR images are already half floats, uploaded as-is
 	if (image->isLDR())
 	{
 		const auto &pixels = image->getPixels8();
@@ -398,17 +415,9 @@ void WebGPUTextureFactory::uploadTextureData(const Texture &texture, wgpu::Textu
 	}
 	else
 	{
-		const auto &pixels = image->getPixelsF();
-		
-		// HDR images are stored as float32 in CPU, but GPU texture is RGBA16Float
-		// Convert float32 → float16 to match GPU texture format
-		convertedData.reserve(pixels.size());
-		for (float f : pixels)
-		{
-			convertedData.push_back(float32ToFloat16(f));
-		}
-		pixelData = convertedData.data();
-		dataSize = convertedData.size() * sizeof(uint16_t);
+		const auto &pixels = image->getPixels16F();
+		pixelData = pixels.data();
+		dataSize = pixels.size() * sizeof(uint16_t);
 	}
 
 	wgpu::ImageCopyTexture dst{};
@@ -426,7 +435,7 @@ void WebGPUTextureFactory::uploadTextureData(const Texture &texture, wgpu::Textu
 	}
 	else
 	{
-		// HDR: converted to float16 (2 bytes per channel)
+		// HDR: half floats (2 bytes per channel)
 		layout.bytesPerRow = texture.getWidth() * texture.getChannels() * sizeof(uint16_t);
 	}
 	layout.rowsPerImage = texture.getHeight();
@@ -436,6 +445,48 @@ void WebGPUTextureFactory::uploadTextureData(const Texture &texture, wgpu::Textu
 	m_context.getQueue().writeTexture(dst, pixelData, dataSize, layout, extent);
 }
 
+void WebGPUTextureFactory::uploadMipChain(const engine::resources::Image &image, wgpu::Texture &gpuTexture)
+{
+	using engine::resources::BlockCompression;
+	const auto compression = image.getBlockCompression();
+
+	for (uint32_t level = 0; level < image.getMipLevelCount(); ++level)
+	{
+		const uint32_t width = std::max(1u, image.getWidth() >> level);
+		const uint32_t height = std::max(1u, image.getHeight() >> level);
+
+		wgpu::ImageCopyTexture dst{};
+		dst.texture = gpuTexture;
+		dst.mipLevel = level;
+		dst.origin = {0, 0, 0};
+		dst.aspect = wgpu::TextureAspect::All;
+
+		wgpu::TextureDataLayout layout{};
+		layout.offset = 0;
+		wgpu::Extent3D extent{width, height, 1};
+		const std::vector<uint8_t> *data = nullptr;
+
+		if (image.isCompressed())
+		{
+			// Rows are rows of 4x4 blocks; the copy extent covers whole blocks of small mips
+			const uint32_t blocksX = (width + 3) / 4;
+			const uint32_t blocksY = (height + 3) / 4;
+			data = &image.getCompressedLevel(level);
+			layout.bytesPerRow = blocksX * static_cast<uint32_t>(BlockCompression::getBlockBytes(compression));
+			layout.rowsPerImage = blocksY;
+			extent = {blocksX * 4, blocksY * 4, 1};
+		}
+		else
+		{
+			data = &image.getMipPixels8(level);
+			layout.bytesPerRow = width * image.getChannelCount();
+			layout.rowsPerImage = height;
+		}
+
+		m_context.getQueue().writeTexture(dst, data->data(), data->size(), layout, extent);
+	}
+}
+
 std::shared_ptr<WebGPUTexture> WebGPUTextureFactory::getWhiteTexture()
 {
 	if (!m_whiteTexture)
@@ -549,138 +600,12 @@ void WebGPUTextureFactory::generateMipmaps(
 	uint32_t mipLevelCount
 )
 {
-	if (!gpuTexture)
-	{
-		spdlog::error("Cannot generate mipmaps for invalid texture");
-		return;
-	}
-
-	if (mipLevelCount <= 1)
-	{
-		spdlog::warn("Texture has only 1 mip level, no mipmaps to generate");
-		return;
-	}
-
-	// Get or create mipmap pipeline for this format
-	auto mipmapPipeline = getOrCreateMipmapPipeline(format);
-	if (!mipmapPipeline || !mipmapPipeline->isValid())
-	{
-		spdlog::error("Failed to get/create mipmap pipeline for format {}", static_cast<int>(format));
-		return;
-	}
-
-	// Get shader info to access bind group layout
-	auto mipmapShader = m_context.shaderRegistry().getShader(shader::defaults ::MIPMAP_BLIT);
-	if (!mipmapShader || !mipmapShader->isValid())
-	{
-		spdlog::error("Failed to get mipmap shader for bind group layout");
-		return;
-	}
-
-	auto bindGroupLayouts = mipmapShader->getBindGroupLayoutVector();
-	if (bindGroupLayouts.empty())
-	{
-		spdlog::error("Mipmap shader has no bind group layouts");
-		return;
-	}
-
-	// Get mipmap sampler from factory
-	auto mipmapSampler = m_context.samplerFactory().getMipmapSampler();
-
-	wgpu::CommandEncoder encoder = m_context.getDevice().createCommandEncoder();
-
-	// Generate mipmaps by repeatedly blitting with linear filtering
-	for (uint32_t mipLevel = 1; mipLevel < mipLevelCount; ++mipLevel)
-	{
-		// Create views for source and destination mip levels
-		wgpu::TextureViewDescriptor srcViewDesc{};
-		srcViewDesc.baseMipLevel = mipLevel - 1;
-		srcViewDesc.mipLevelCount = 1;
-		srcViewDesc.baseArrayLayer = 0;
-		srcViewDesc.arrayLayerCount = 1;
-		srcViewDesc.aspect = wgpu::TextureAspect::All;
-		wgpu::TextureView srcView = gpuTexture.createView(srcViewDesc);
-
-		wgpu::TextureViewDescriptor dstViewDesc{};
-		dstViewDesc.baseMipLevel = mipLevel;
-		dstViewDesc.mipLevelCount = 1;
-		dstViewDesc.baseArrayLayer = 0;
-		dstViewDesc.arrayLayerCount = 1;
-		dstViewDesc.aspect = wgpu::TextureAspect::All;
-		wgpu::TextureView dstView = gpuTexture.createView(dstViewDesc);
-
-		// Create bind group for this mip level
-		std::vector<wgpu::BindGroupEntry> entries(2);
-		entries[0].binding = 0;
-		entries[0].textureView = srcView;
-		entries[1].binding = 1;
-		entries[1].sampler = mipmapSampler;
-
-		wgpu::BindGroupDescriptor bindGroupDesc{};
-		bindGroupDesc.layout = bindGroupLayouts[0]->getLayout();
-		bindGroupDesc.entryCount = entries.size();
-		bindGroupDesc.entries = entries.data();
-		wgpu::BindGroup bindGroup = m_context.getDevice().createBindGroup(bindGroupDesc);
-
-		// Set up render pass to blit from src to dst
-		wgpu::RenderPassColorAttachment colorAttachment{};
-		colorAttachment.view = dstView;
-		colorAttachment.loadOp = wgpu::LoadOp::Clear;
-		colorAttachment.storeOp = wgpu::StoreOp::Store;
-		colorAttachment.clearValue = {0.0, 0.0, 0.0, 0.0};
-
-		wgpu::RenderPassDescriptor renderPassDesc{};
-		renderPassDesc.colorAttachmentCount = 1;
-		renderPassDesc.colorAttachments = &colorAttachment;
-
-		wgpu::RenderPassEncoder renderPass = encoder.beginRenderPass(renderPassDesc);
-		renderPass.setPipeline(mipmapPipeline->getPipeline());
-		renderPass.setBindGroup(0, bindGroup, 0, nullptr);
-		renderPass.draw(3, 1, 0, 0); // Fullscreen triangle
-		renderPass.end();
-
-		bindGroup.release();
-		srcView.release();
-		dstView.release();
-	}
-
-	wgpu::CommandBuffer commands = encoder.finish();
-	m_context.getQueue().submit(commands);
-	commands.release();
-	encoder.release();
-
-	spdlog::debug("Generated {} mipmap levels for texture", mipLevelCount - 1);
+	m_mipmapGenerator.enqueue(gpuTexture, format, width, height, mipLevelCount);
 }
 
-std::shared_ptr<WebGPUPipeline> WebGPUTextureFactory::getOrCreateMipmapPipeline(wgpu::TextureFormat format)
+size_t WebGPUTextureFactory::flushMipmaps()
 {
-	// Get the mipmap blit shader from registry
-	auto mipmapShader = m_context.shaderRegistry().getShader(shader::defaults ::MIPMAP_BLIT);
-	if (!mipmapShader || !mipmapShader->isValid())
-	{
-		spdlog::error("Failed to get mipmap blit shader from registry");
-		return nullptr;
-	}
-
-	// Create render pipeline using the pipeline manager with the specific format
-	auto mipmapPipeline = m_context.pipelineManager().getOrCreatePipeline(
-		mipmapShader,					// shader
-		format,							// color format (specific to this texture)
-		wgpu::TextureFormat::Undefined, // no depth
-		engine::rendering::Topology::Type::Triangles,
-		wgpu::CullMode::None,
-		false,
-		1 // sample count
-	);
-
-	if (!mipmapPipeline || !mipmapPipeline->getPipeline())
-	{
-		spdlog::error("Failed to create mipmap pipeline for format {}", static_cast<int>(format));
-		return nullptr;
-	}
-	spdlog::debug("Created mipmap generation pipeline for format {}", static_cast<int>(format));
-
-	return mipmapPipeline;
+	return m_mipmapGenerator.flush();
 }
 
 } // namespace engine::rendering::webgpu
@@ -0,0 +1,374 @@
+#include "engine/resources/BlockCodec.h"
+#include "engine/core/Profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace engine::resources
+{
+
+namespace
+{
+using Block = std::array<std::array<uint8_t, 4>, 16>; ///< 4x4 texels, RGBA
+
+/** @brief Copy a 4x4 block, replicating the border for partial blocks at the right and bottom edge. */
+Block gatherBlock(const uint8_t *pixels, uint32_t width, uint32_t height, uint32_t channels, uint32_t blockX, uint32_t blockY)
+{
+	Block block{};
+	for (uint32_t y = 0; y < 4; ++y)
+	{
+		const uint32_t py = std::min(blockY * 4 + y, height - 1);
+		for (uint32_t x = 0; x < 4; ++x)
+		{
+			const uint32_t px = std::min(blockX * 4 + x, width - 1);
+			const uint8_t *src = pixels + (static_cast<size_t>(py) * width + px) * channels;
+			auto &texel = block[y * 4 + x];
+			texel = {0, 0, 0, 255};
+			for (uint32_t c = 0; c < std::min(channels, 4u); ++c)
+				texel[c] = src[c];
+		}
+	}
+	return block;
+}
+
+uint16_t packRgb565(const std::array<float, 3> &color)
+{
+	const auto quantize = [](float value, int maxValue)
+	{
+		return static_cast<uint16_t>(std::clamp(static_cast<int>(std::lround(value / 255.0f * maxValue)), 0, maxValue));
+	};
+	return static_cast<uint16_t>((quantize(color[0], 31) << 11) | (quantize(color[1], 63) << 5) | quantize(color[2], 31));
+}
+
+std::array<int, 3> unpackRgb565(uint16_t packed)
+{
+	const int r = (packed >> 11) & 31;
+	const int g = (packed >> 5) & 63;
+	const int b = packed & 31;
+	return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+/** @brief Encode the RGB of a block as a BC1 color block in four-color mode. */
+void encodeColorBlock(const Block &block, uint8_t *out)
+{
+	// Principal axis of the block colors by power iteration on the covariance matrix
+	std::array<float, 3> mean{0.0f, 0.0f, 0.0f};
+	for (const auto &texel : block)
+		for (int c = 0; c < 3; ++c)
+			mean[c] += texel[c] / 16.0f;
+
+	float cov[3][3] = {};
+	for (const auto &texel : block)
+	{
+		const float d[3] = {texel[0] - mean[0], texel[1] - mean[1], texel[2] - mean[2]};
+		for (int i = 0; i < 3; ++i)
+			for (int j = 0; j < 3; ++j)
+				cov[i][j] += d[i] * d[j];
+	}
+
+	std::array<float, 3> axis{1.0f, 1.0f, 1.0f};
+	for (int iteration = 0; iteration < 8; ++iteration)
+	{
+		std::array<float, 3> next{};
+		for (int i = 0; i < 3; ++i)
+			next[i] = cov[i][0] * axis[0] + cov[i][1] * axis[1] + cov[i][2] * axis[2];
+		const float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2]);
+		if (length < 1e-6f)
+			break;
+		axis = {next[0] / length, next[1] / length, next[2] / length};
+	}
+
+	float minT = 0.0f;
+	float maxT = 0.0f;
+	for (const auto &texel : block)
+	{
+		const float t = (texel[0] - mean[0]) * axis[0] + (texel[1] - mean[1]) * axis[1] + (texel[2] - mean[2]) * axis[2];
+		minT = std::min(minT, t);
+		maxT = std::max(maxT, t);
+	}
+
+	uint16_t color0 = packRgb565({mean[0] + axis[0] * maxT, mean[1] + axis[1] * maxT, mean[2] + axis[2] * maxT});
+	uint16_t color1 = packRgb565({mean[0] + axis[0] * minT, mean[1] + axis[1] * minT, mean[2] + axis[2] * minT});
+	if (color0 < color1)
+		std::swap(color0, color1);
+
+	uint32_t indices = 0;
+	if (color0 != color1)
+	{
+		const auto c0 = unpackRgb565(color0);
+		const auto c1 = unpackRgb565(color1);
+		std::array<std::array<int, 3>, 4> palette{c0, c1, {}, {}};
+		for (int c = 0; c < 3; ++c)
+		{
+			palette[2][c] = (2 * c0[c] + c1[c]) / 3;
+			palette[3][c] = (c0[c] + 2 * c1[c]) / 3;
+		}
+
+		for (uint32_t i = 0; i < 16; ++i)
+		{
+			uint32_t best = 0;
+			int bestDistance = std::numeric_limits<int>::max();
+			for (uint32_t p = 0; p < 4; ++p)
+			{
+				int distance = 0;
+				for (int c = 0; c < 3; ++c)
+				{
+					const int d = block[i][c] - palette[p][c];
+					distance += d * d;
+				}
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					best = p;
+				}
+			}
+			indices |= best << (2 * i);
+		}
+	}
+
+	out[0] = static_cast<uint8_t>(color0 & 0xFF);
+	out[1] = static_cast<uint8_t>(color0 >> 8);
+	out[2] = static_cast<uint8_t>(color1 & 0xFF);
+	out[3] = static_cast<uint8_t>(color1 >> 8);
+	for (int b = 0; b < 4; ++b)
+		out[4 + b] = static_cast<uint8_t>((indices >> (8 * b)) & 0xFF);
+}
+
+/** @brief Encode one channel of a block as a BC4 block (eight-value mode). */
+void encodeChannelBlock(const Block &block, uint32_t channel, uint8_t *out)
+{
+	uint8_t maxValue = 0;
+	uint8_t minValue = 255;
+	for (const auto &texel : block)
+	{
+		maxValue = std::max(maxValue, texel[channel]);
+		minValue = std::min(minValue, texel[channel]);
+	}
+
+	uint64_t indices = 0;
+	if (maxValue != minValue)
+	{
+		std::array<int, 8> palette{maxValue, minValue};
+		for (int i = 2; i < 8; ++i)
+			palette[i] = ((8 - i) * maxValue + (i - 1) * minValue) / 7;
+
+		for (uint32_t i = 0; i < 16; ++i)
+		{
+			uint64_t best = 0;
+			int bestDistance = std::numeric_limits<int>::max();
+			for (uint32_t p = 0; p < 8; ++p)
+			{
+				const int distance = std::abs(block[i][channel] - palette[p]);
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					best = p;
+				}
+			}
+			indices |= best << (3 * i);
+		}
+	}
+
+	out[0] = maxValue;
+	out[1] = minValue;
+	for (int b = 0; b < 6; ++b)
+		out[2 + b] = static_cast<uint8_t>((indices >> (8 * b)) & 0xFF);
+}
+
+/** @brief Decode a BC1 color block into RGBA. fourColorOnly is set for the color part of BC3. */
+void decodeColorBlock(const uint8_t *in, Block &block, bool fourColorOnly)
+{
+	const uint16_t color0 = static_cast<uint16_t>(in[0] | (in[1] << 8));
+	const uint16_t color1 = static_cast<uint16_t>(in[2] | (in[3] << 8));
+	const uint32_t indices = in[4] | (in[5] << 8) | (in[6] << 16) | (static_cast<uint32_t>(in[7]) << 24);
+
+	const auto c0 = unpackRgb565(color0);
+	const auto c1 = unpackRgb565(color1);
+	std::array<std::array<int, 4>, 4> palette{};
+	palette[0] = {c0[0], c0[1], c0[2], 255};
+	palette[1] = {c1[0], c1[1], c1[2], 255};
+	if (color0 > color1 || fourColorOnly)
+	{
+		for (int c = 0; c < 3; ++c)
+		{
+			palette[2][c] = (2 * c0[c] + c1[c]) / 3;
+			palette[3][c] = (c0[c] + 2 * c1[c]) / 3;
+		}
+		palette[2][3] = 255;
+		palette[3][3] = 255;
+	}
+	else
+	{
+		for (int c = 0; c < 3; ++c)
+			palette[2][c] = (c0[c] + c1[c]) / 2;
+		palette[2][3] = 255;
+		palette[3] = {0, 0, 0, 0};
+	}
+
+	for (uint32_t i = 0; i < 16; ++i)
+	{
+		const auto &color = palette[(indices >> (2 * i)) & 3u];
+		for (int c = 0; c < 4; ++c)
+			block[i][c] = static_cast<uint8_t>(color[c]);
+	}
+}
+
+/** @brief Decode a BC4 block into one channel of a block. */
+void decodeChannelBlock(const uint8_t *in, Block &block, uint32_t channel)
+{
+	const int value0 = in[0];
+	const int value1 = in[1];
+	uint64_t indices = 0;
+	for (int b = 0; b < 6; ++b)
+		indices |= static_cast<uint64_t>(in[2 + b]) << (8 * b);
+
+	std::array<int, 8> palette{value0, value1};
+	if (value0 > value1)
+	{
+		for (int i = 2; i < 8; ++i)
+			palette[i] = ((8 - i) * value0 + (i - 1) * value1) / 7;
+	}
+	else
+	{
+		for (int i = 2; i < 6; ++i)
+			palette[i] = ((6 - i) * value0 + (i - 1) * value1) / 5;
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+
+	for (uint32_t i = 0; i < 16; ++i)
+		block[i][channel] = static_cast<uint8_t>(palette[(indices >> (3 * i)) & 7u]);
+}
+} // namespace
+
+bool BlockCodec::canEncode(BlockCompression::Type compression)
+{
+	return canDecode(compression);
+}
+
+bool BlockCodec::canDecode(BlockCompression::Type compression)
+{
+	switch (compression)
+	{
+	case BlockCompression::Type::BC1_RGBA:
+	case BlockCompression::Type::BC3_RGBA:
+	case BlockCompression::Type::BC4_R:
+	case BlockCompression::Type::BC5_RG:
+		return true;
+	default:
+		return false;
+	}
+}
+
+std::vector<uint8_t> BlockCodec::encode(
+	BlockCompression::Type compression,
+	const uint8_t *pixels,
+	uint32_t width,
+	uint32_t height,
+	uint32_t channels
+)
+{
+	if (!canEncode(compression) || !pixels || width == 0 || height == 0)
+		return {};
+	if ((compression == BlockCompression::Type::BC1_RGBA || compression == BlockCompression::Type::BC3_RGBA) && channels < 4)
+		return {};
+	if (compression == BlockCompression::Type::BC5_RG && channels < 2)
+		return {};
+
+	ENGINE_PROFILE_SCOPE("BlockCodec::encode");
+	const uint32_t blocksX = (width + 3) / 4;
+	const uint32_t blocksY = (height + 3) / 4;
+	const uint32_t blockBytes = BlockCompression::getBlockBytes(compression);
+	std::vector<uint8_t> out(static_cast<size_t>(blocksX) * blocksY * blockBytes);
+
+	for (uint32_t by = 0; by < blocksY; ++by)
+	{
+		for (uint32_t bx = 0; bx < blocksX; ++bx)
+		{
+			const Block block = gatherBlock(pixels, width, height, channels, bx, by);
+			uint8_t *dst = out.data() + (static_cast<size_t>(by) * blocksX + bx) * blockBytes;
+			switch (compression)
+			{
+			case BlockCompression::Type::BC1_RGBA:
+				encodeColorBlock(block, dst);
+				break;
+			case BlockCompression::Type::BC3_RGBA:
+				encodeChannelBlock(block, 3, dst);
+				encodeColorBlock(block, dst + 8);
+				break;
+			case BlockCompression::Type::BC4_R:
+				encodeChannelBlock(block, 0, dst);
+				break;
+			case BlockCompression::Type::BC5_RG:
+				encodeChannelBlock(block, 0, dst);
+				encodeChannelBlock(block, 1, dst + 8);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+	return out;
+}
+
+std::optional<std::vector<uint8_t>> BlockCodec::decode(
+	BlockCompression::Type compression,
+	const std::vector<uint8_t> &blocks,
+	uint32_t width,
+	uint32_t height
+)
+{
+	if (!canDecode(compression) || blocks.size() < BlockCompression::getLevelSize(compression, width, height))
+		return std::nullopt;
+
+	ENGINE_PROFILE_SCOPE("BlockCodec::decode");
+	const uint32_t blocksX = (width + 3) / 4;
+	const uint32_t blocksY = (height + 3) / 4;
+	const uint32_t blockBytes = BlockCompression::getBlockBytes(compression);
+	const uint32_t channels = ImageFormat::getChannelCount(BlockCompression::getDecodedFormat(compression));
+	std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * channels);
+
+	for (uint32_t by = 0; by < blocksY; ++by)
+	{
+		for (uint32_t bx = 0; bx < blocksX; ++bx)
+		{
+			const uint8_t *src = blocks.data() + (static_cast<size_t>(by) * blocksX + bx) * blockBytes;
+			Block block{};
+			switch (compression)
+			{
+			case BlockCompression::Type::BC1_RGBA:
+				decodeColorBlock(src, block, false);
+				break;
+			case BlockCompression::Type::BC3_RGBA:
+				decodeColorBlock(src + 8, block, true);
+				decodeChannelBlock(src, block, 3);
+				break;
+			case BlockCompression::Type::BC4_R:
+				decodeChannelBlock(src, block, 0);
+				break;
+			case BlockCompression::Type::BC5_RG:
+				decodeChannelBlock(src, block, 0);
+				decodeChannelBlock(src + 8, block, 1);
+				break;
+			default:
+				break;
+			}
+
+			// Write back the texels inside the image (partial blocks at the edges are cropped)
+			for (uint32_t y = 0; y < 4 && by * 4 + y < height; ++y)
+			{
+				for (uint32_t x = 0; x < 4 && bx * 4 + x < width; ++x)
+				{
+					uint8_t *dst = pixels.data() + (static_cast<size_t>(by * 4 + y) * width + bx * 4 + x) * channels;
+					for (uint32_t c = 0; c < channels; ++c)
+						dst[c] = block[y * 4 + x][c];
+				}
+			}
+		}
+	}
+	return pixels;
+}
+
+} // namespace engine::resources
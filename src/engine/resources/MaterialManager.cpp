@@ -4,6 +4,8 @@
 #include <fstream>
 
 #include "engine/core/Handle.h"
+#include "engine/core/Hash.h"
+#include "engine/math/HalfFloat.h"
 #include "engine/resources/Image.h"
 
 namespace engine::resources
@@ -11,6 +13,7 @@ namespace engine::resources
 
 static engine::rendering::Texture::Handle loadTexture(
 	int textureIndex,
+	const std::string &slotName,
 	const std::vector<tinygltf::Texture> &textures,
 	const std::vector<tinygltf::Image> &images,
 	TextureManager &textureManager
@@ -27,45 +30,58 @@ static engine::rendering::Texture::Handle loadTexture(
 
 	const bool isHdr =
 		gltfImg.pixel_type == TINYGLTF_COMPONENT_TYPE_FLOAT;
-
-	const auto format = ImageFormat::formatFromChannels(
-		static_cast<uint32_t>(gltfImg.component),
-		isHdr
+	const auto sourceFormat = ImageFormat::formatFromChannels(static_cast<uint32_t>(gltfImg.component), isHdr);
+
+	// The same image used by several materials or model instances hashes the same: the image is
+	// only converted, stored and uploaded once per color space.
+	const uint64_t contentHash = TextureManager::computeContentHash(
+		sourceFormat,
+		static_cast<uint32_t>(gltfImg.width),
+		static_cast<uint32_t>(gltfImg.height),
+		gltfImg.image.data(),
+		gltfImg.image.size()
 	);
 
-	engine::resources::Image::Ptr image;
-
-	if (isHdr)
+	auto createImage = [&gltfImg, isHdr, sourceFormat]() -> engine::resources::Image::Ptr
 	{
-		const float *floatData = reinterpret_cast<const float *>(gltfImg.image.data());
-		const size_t floatCount = gltfImg.image.size() / sizeof(float);
-		std::vector<float> pixels(floatData, floatData + floatCount);
+		if (isHdr)
+		{
+			// Stored as half floats, RGB expanded to RGBA (there is no three-channel GPU format)
+			const float *floatData = reinterpret_cast<const float *>(gltfImg.image.data());
+			auto pixels = engine::math::HalfFloat::fromFloatImage(
+				floatData,
+				static_cast<uint32_t>(gltfImg.width),
+				static_cast<uint32_t>(gltfImg.height),
+				static_cast<uint32_t>(gltfImg.component)
+			);
+			const auto format = ImageFormat::formatFromChannels(gltfImg.component == 3 ? 4u : static_cast<uint32_t>(gltfImg.component), true);
+
+			return std::make_shared<engine::resources::Image>(
+				gltfImg.width,
+				gltfImg.height,
+				format,
+				std::move(pixels)
+			);
+		}
 
-		image = std::make_shared<engine::resources::Image>(
+		return std::make_shared<engine::resources::Image>(
 			gltfImg.width,
 			gltfImg.height,
-			format,
-			std::move(pixels)
-		);
-	}
-	else
-	{
-		image = std::make_shared<engine::resources::Image>(
-			gltfImg.width,
-			gltfImg.height,
-			format,
+			sourceFormat,
 			std::vector<uint8_t>(gltfImg.image.begin(), gltfImg.image.end())
 		);
-	}
+	};
 
 	using engine::core::unwrapOrHandle;
 
 	return unwrapOrHandle(
-		textureManager.createImageTexture(
-			std::move(image),
+		textureManager.getOrCreateImageTexture(
+			contentHash,
+			createImage,
 			gltfImg.uri.empty()
 				? std::optional<std::filesystem::path>{}
-				: std::optional<std::filesystem::path>{gltfImg.uri}
+				: std::optional<std::filesystem::path>{gltfImg.uri},
+			engine::rendering::defaultColorSpaceForSlot(slotName)
 		)
 	);
 }
@@ -141,50 +157,56 @@ MaterialManager::createMaterial(const tinyobj::material_t &objMat, const std::st
 
 	using engine::core::unwrapOrHandle;
 
+	// Cached per color space: the GPU texture is created in the color space of the slot
+	auto loadSlotTexture = [&](const std::string &name, const char *slotName)
+	{
+		return m_textureManager->createTextureFromFile(textureBasePath + name, false, engine::rendering::defaultColorSpaceForSlot(slotName));
+	};
+
 	// --- Textures ---
 	if (!objMat.diffuse_texname.empty())
 		mat->setDiffuseTexture(
-			unwrapOrHandle(m_textureManager->createTextureFromFile(textureBasePath + objMat.diffuse_texname))
+			unwrapOrHandle(loadSlotTexture(objMat.diffuse_texname, engine::rendering::MaterialTextureSlots::DIFFUSE))
 		);
 
 	if (!objMat.normal_texname.empty())
 		mat->setNormalTexture(
-			unwrapOrHandle(m_textureManager->createTextureFromFile(textureBasePath + objMat.normal_texname))
+			unwrapOrHandle(loadSlotTexture(objMat.normal_texname, engine::rendering::MaterialTextureSlots::NORMAL))
 		);
 
 	if (!objMat.ambient_texname.empty())
 		mat->setOcclusionTexture(
-			unwrapOrHandle(m_textureManager->createTextureFromFile(textureBasePath + objMat.ambient_texname))
+			unwrapOrHandle(loadSlotTexture(objMat.ambient_texname, engine::rendering::MaterialTextureSlots::OCCLUSION))
 		);
 
 	if (!objMat.emissive_texname.empty())
 		mat->setEmissiveTexture(
-			unwrapOrHandle(m_textureManager->createTextureFromFile(textureBasePath + objMat.emissive_texname))
+			unwrapOrHandle(loadSlotTexture(objMat.emissive_texname, engine::rendering::MaterialTextureSlots::EMISSIVE))
 		);
 
 	if (!objMat.metallic_texname.empty())
 		mat->setMetallicTexture(
-			unwrapOrHandle(m_textureManager->createTextureFromFile(textureBasePath + objMat.metallic_texname))
+			unwrapOrHandle(loadSlotTexture(objMat.metallic_texname, engine::rendering::MaterialTextureSlots::METALLIC))
 		);
 
 	if (!objMat.roughness_texname.empty())
 		mat->setRoughnessTexture(
-			unwrapOrHandle(m_textureManager->createTextureFromFile(textureBasePath + objMat.roughness_texname))
+			unwrapOrHandle(loadSlotTexture(objMat.roughness_texname, engine::rendering::MaterialTextureSlots::ROUGHNESS))
 		);
 
 	if (!objMat.bump_texname.empty())
 		mat->setBumpTexture(
-			unwrapOrHandle(m_textureManager->createTextureFromFile(textureBasePath + objMat.bump_texname))
+			unwrapOrHandle(loadSlotTexture(objMat.bump_texname, engine::rendering::MaterialTextureSlots::BUMP))
 		);
 
 	if (!objMat.displacement_texname.empty())
 		mat->setBumpTexture(
-			unwrapOrHandle(m_textureManager->createTextureFromFile(textureBasePath + objMat.displacement_texname))
+			unwrapOrHandle(loadSlotTexture(objMat.displacement_texname, engine::rendering::MaterialTextureSlots::BUMP))
 		);
 
 	if (!objMat.alpha_texname.empty())
 		mat->setAlphaTexture(
-			unwrapOrHandle(m_textureManager->createTextureFromFile(textureBasePath + objMat.alpha_texname))
+			unwrapOrHandle(loadSlotTexture(objMat.alpha_texname, engine::rendering::MaterialTextureSlots::ALPHA))
 		);
 
 	auto handleOpt = add(mat);
@@ -241,7 +263,7 @@ std::optional<MaterialManager::MaterialPtr> MaterialManager::createMaterial(
 	if (gltfMat.pbrMetallicRoughness.baseColorTexture.index >= 0)
 	{
 		mat->setDiffuseTexture(
-			loadTexture(gltfMat.pbrMetallicRoughness.baseColorTexture.index, textures, images, *m_textureManager)
+			loadTexture(gltfMat.pbrMetallicRoughness.baseColorTexture.index, engine::rendering::MaterialTextureSlots::DIFFUSE, textures, images, *m_textureManager)
 		);
 		features |= MaterialFeature::Flag::UsesBaseColorMap;
 	}
@@ -249,7 +271,7 @@ std::optional<MaterialManager::MaterialPtr> MaterialManager::createMaterial(
 	// Metallic-Roughness texture
 	if (gltfMat.pbrMetallicRoughness.metallicRoughnessTexture.index >= 0)
 	{
-		auto tex = loadTexture(gltfMat.pbrMetallicRoughness.metallicRoughnessTexture.index, textures, images, *m_textureManager);
+		auto tex = loadTexture(gltfMat.pbrMetallicRoughness.metallicRoughnessTexture.index, engine::rendering::MaterialTextureSlots::METALLIC, textures, images, *m_textureManager);
 		mat->setMetallicTexture(tex);
 		mat->setRoughnessTexture(tex);
 		features |= MaterialFeature::Flag::UsesMetallicRoughnessMap;
@@ -259,7 +281,7 @@ std::optional<MaterialManager::MaterialPtr> MaterialManager::createMaterial(
 	if (gltfMat.normalTexture.index >= 0)
 	{
 		mat->setNormalTexture(
-			loadTexture(gltfMat.normalTexture.index, textures, images, *m_textureManager)
+			loadTexture(gltfMat.normalTexture.index, engine::rendering::MaterialTextureSlots::NORMAL, textures, images, *m_textureManager)
 		);
 		features |= MaterialFeature::Flag::UsesNormalMap;
 	}
@@ -268,7 +290,7 @@ std::optional<MaterialManager::MaterialPtr> MaterialManager::createMaterial(
 	if (gltfMat.occlusionTexture.index >= 0)
 	{
 		mat->setOcclusionTexture(
-			loadTexture(gltfMat.occlusionTexture.index, textures, images, *m_textureManager)
+			loadTexture(gltfMat.occlusionTexture.index, engine::rendering::MaterialTextureSlots::OCCLUSION, textures, images, *m_textureManager)
 		);
 		features |= MaterialFeature::Flag::UsesOcclusionMap;
 	}
@@ -277,7 +299,7 @@ std::optional<MaterialManager::MaterialPtr> MaterialManager::createMaterial(
 	if (gltfMat.emissiveTexture.index >= 0)
 	{
 		mat->setEmissiveTexture(
-			loadTexture(gltfMat.emissiveTexture.index, textures, images, *m_textureManager)
+			loadTexture(gltfMat.emissiveTexture.index, engine::rendering::MaterialTextureSlots::EMISSIVE, textures, images, *m_textureManager)
 		);
 		features |= MaterialFeature::Flag::UsesEmissiveMap;
 	}
@@ -318,20 +340,15 @@ MaterialManager::MaterialFeature::Flag MaterialManager::applyTexturesAndGetFeatu
 			features |= MaterialFeature::Flag::UsesBaseColorMap;
 		else if (slotName == engine::rendering::MaterialTextureSlots::NORMAL)
 			features |= MaterialFeature::Flag::UsesNormalMap;
-		else if (slotName == engine::rendering::MaterialTextureSlots::OCCLUSION)
-			features |= MaterialFeature::Flag::UsesOcclusionMap;
+		else if (slotName == engine::rendering::MaterialTextureSlots::OCCLUSION
+				 || slotName == engine::rendering::MaterialTextureSlots::AMBIENT)
+			features |= MaterialFeature::Flag::UsesOcclusionMap; // PBR shader reads AO from the ambient slot
 		else if (slotName == engine::rendering::MaterialTextureSlots::EMISSIVE)
 			features |= MaterialFeature::Flag::UsesEmissiveMap;
 		else if (slotName == engine::rendering::MaterialTextureSlots::METALLIC)
 			features |= MaterialFeature::Flag::UsesMetallicMap;
 		else if (slotName == engine::rendering::MaterialTextureSlots::ROUGHNESS)
 			features |= MaterialFeature::Flag::UsesRoughnessMap;
-		else if (slotName == engine::rendering::MaterialTextureSlots::METALLIC)
-			features |= MaterialFeature::Flag::UsesMetallicMap;
-		else if (slotName == engine::rendering::MaterialTextureSlots::EMISSIVE)
-			features |= MaterialFeature::Flag::UsesEmissiveMap;
-		else if (slotName == engine::rendering::MaterialTextureSlots::OCCLUSION)
-			features |= MaterialFeature::Flag::UsesOcclusionMap;
 		// ToDo: Add more slots and corresponding features as needed
 	}
 
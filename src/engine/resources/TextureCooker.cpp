@@ -0,0 +1,215 @@
+#include "engine/resources/TextureCooker.h"
+#include "engine/core/Profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "engine/rendering/Material.h"
+#include "engine/resources/BlockCodec.h"
+
+namespace engine::resources
+{
+
+namespace
+{
+/** @brief sRGB to linear for every 8-bit value. */
+const std::array<float, 256> &srgbToLinearTable()
+{
+	static const std::array<float, 256> table = []
+	{
+		std::array<float, 256> values{};
+		for (int i = 0; i < 256; ++i)
+		{
+			const float c = i / 255.0f;
+			values[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+		}
+		return values;
+	}();
+	return table;
+}
+
+uint8_t linearToSrgb8(float value)
+{
+	const float c = std::clamp(value, 0.0f, 1.0f);
+	const float encoded = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+	return static_cast<uint8_t>(std::lround(encoded * 255.0f));
+}
+
+/** @brief 2x2 box-filtered half-size level; color channels of sRGB data are averaged in linear space. */
+std::vector<uint8_t> downsample(const std::vector<uint8_t> &src, uint32_t width, uint32_t height, uint32_t channels, bool srgb)
+{
+	const uint32_t dstWidth = std::max(1u, width / 2);
+	const uint32_t dstHeight = std::max(1u, height / 2);
+	const auto &toLinear = srgbToLinearTable();
+	std::vector<uint8_t> dst(static_cast<size_t>(dstWidth) * dstHeight * channels);
+
+	for (uint32_t y = 0; y < dstHeight; ++y)
+	{
+		const uint32_t y0 = std::min(2 * y, height - 1);
+		const uint32_t y1 = std::min(2 * y + 1, height - 1);
+		for (uint32_t x = 0; x < dstWidth; ++x)
+		{
+			const uint32_t x0 = std::min(2 * x, width - 1);
+			const uint32_t x1 = std::min(2 * x + 1, width - 1);
+			const uint8_t *p[4] = {
+				&src[(static_cast<size_t>(y0) * width + x0) * channels],
+				&src[(static_cast<size_t>(y0) * width + x1) * channels],
+				&src[(static_cast<size_t>(y1) * width + x0) * channels],
+				&src[(static_cast<size_t>(y1) * width + x1) * channels],
+			};
+			uint8_t *out = &dst[(static_cast<size_t>(y) * dstWidth + x) * channels];
+			for (uint32_t c = 0; c < channels; ++c)
+			{
+				// Alpha (4th channel) is linear even in sRGB images
+				if (srgb && c < 3 && channels >= 3)
+				{
+					const float sum = toLinear[p[0][c]] + toLinear[p[1][c]] + toLinear[p[2][c]] + toLinear[p[3][c]];
+					out[c] = linearToSrgb8(sum * 0.25f);
+				}
+				else
+				{
+					out[c] = static_cast<uint8_t>((p[0][c] + p[1][c] + p[2][c] + p[3][c] + 2) / 4);
+				}
+			}
+		}
+	}
+	return dst;
+}
+
+BlockCompression::Type chooseCompression(const std::vector<uint8_t> &pixels, uint32_t channels, bool normalMap)
+{
+	if (normalMap && channels >= 2)
+		return BlockCompression::Type::BC5_RG;
+	switch (channels)
+	{
+	case 1:
+		return BlockCompression::Type::BC4_R;
+	case 2:
+		return BlockCompression::Type::BC5_RG;
+	case 4:
+	{
+		for (size_t i = 3; i < pixels.size(); i += 4)
+		{
+			if (pixels[i] != 255)
+				return BlockCompression::Type::BC3_RGBA;
+		}
+		return BlockCompression::Type::BC1_RGBA;
+	}
+	default:
+		return BlockCompression::Type::None;
+	}
+}
+} // namespace
+
+std::optional<Image::Ptr> TextureCooker::cook(const Image &source, const TextureCookOptions &options)
+{
+	if (source.isEmpty() || source.isHDR() || source.isCompressed())
+	{
+		spdlog::error("TextureCooker: only uncompressed LDR images can be cooked");
+		return std::nullopt;
+	}
+
+	ENGINE_PROFILE_SCOPE("TextureCooker::cook");
+	const uint32_t width = source.getWidth();
+	const uint32_t height = source.getHeight();
+	uint32_t channels = source.getChannelCount();
+	std::vector<uint8_t> base = source.getPixels8();
+
+	// RGB is expanded to RGBA: there is no three-channel GPU format
+	if (channels == 3)
+	{
+		std::vector<uint8_t> rgba;
+		rgba.reserve(static_cast<size_t>(width) * height * 4);
+		for (size_t i = 0; i + 2 < base.size(); i += 3)
+			rgba.insert(rgba.end(), {base[i], base[i + 1], base[i + 2], 255});
+		base = std::move(rgba);
+		channels = 4;
+	}
+	const ImageFormat::Type format = ImageFormat::formatFromChannels(channels, false);
+
+	// Mip chain, each level box-filtered from the previous one
+	std::vector<std::vector<uint8_t>> levels;
+	levels.push_back(std::move(base));
+	if (options.generateMips)
+	{
+		const uint32_t levelCount = 1 + static_cast<uint32_t>(std::floor(std::log2(std::max(width, height))));
+		const bool srgb = options.srgb && !options.normalMap;
+		for (uint32_t level = 1; level < levelCount; ++level)
+		{
+			const uint32_t srcWidth = std::max(1u, width >> (level - 1));
+			const uint32_t srcHeight = std::max(1u, height >> (level - 1));
+			levels.push_back(downsample(levels.back(), srcWidth, srcHeight, channels, srgb));
+		}
+	}
+
+	BlockCompression::Type compression = BlockCompression::Type::None;
+	if (options.compress)
+	{
+		if (width % 4 == 0 && height % 4 == 0)
+			compression = chooseCompression(levels.front(), channels, options.normalMap);
+		else
+			spdlog::info("TextureCooker: {}x{} is not a multiple of 4, keeping RGBA8 with mips", width, height);
+	}
+
+	if (compression == BlockCompression::Type::None)
+	{
+		auto image = std::make_shared<Image>(width, height, format, std::move(levels.front()));
+		levels.erase(levels.begin());
+		image->setMipChain(std::move(levels));
+		return image;
+	}
+
+	std::vector<std::vector<uint8_t>> blocks;
+	blocks.reserve(levels.size());
+	for (uint32_t level = 0; level < levels.size(); ++level)
+	{
+		const uint32_t levelWidth = std::max(1u, width >> level);
+		const uint32_t levelHeight = std::max(1u, height >> level);
+		blocks.push_back(BlockCodec::encode(compression, levels[level].data(), levelWidth, levelHeight, channels));
+	}
+
+	spdlog::debug(
+		"TextureCooker: {}x{} cooked to {} with {} mips",
+		width,
+		height,
+		BlockCompression::toString(compression),
+		blocks.size()
+	);
+	return std::make_shared<Image>(width, height, compression, std::move(blocks));
+}
+
+TextureCookOptions TextureCooker::optionsForSlot(const std::string &slotName)
+{
+	using namespace engine::rendering;
+	TextureCookOptions options;
+	options.normalMap = slotName == MaterialTextureSlots::NORMAL;
+	options.srgb = !options.normalMap && defaultColorSpaceForSlot(slotName) == ColorSpace::sRGB;
+	return options;
+}
+
+std::filesystem::path TextureCooker::getCookedPath(const std::filesystem::path &source)
+{
+	std::filesystem::path cooked = source;
+	cooked += ".ktx2";
+	return cooked;
+}
+
+bool TextureCooker::isCookedUpToDate(const std::filesystem::path &source)
+{
+	std::error_code ec;
+	const auto cooked = getCookedPath(source);
+	if (!std::filesystem::exists(cooked, ec))
+		return false;
+
+	const auto cookedTime = std::filesystem::last_write_time(cooked, ec);
+	if (ec)
+		return false;
+	const auto sourceTime = std::filesystem::last_write_time(source, ec);
+	return ec || cookedTime >= sourceTime; // Source missing: the cooked file is all there is
+}
+
+} // namespace engine::resources
@@ -1,22 +1,26 @@
 #include "engine/resources/TextureManager.h"
+#include "engine/core/Hash.h"
 #include "engine/resources/Image.h"
 
+#include <spdlog/spdlog.h>
+
 namespace engine::resources
 {
 
 std::optional<TextureManager::TexturePtr> TextureManager::createImageTexture(
 	engine::resources::Image::Ptr image,
 	std::optional<std::filesystem::path> filePath,
-	bool renderTarget
+	bool renderTarget,
+	engine::rendering::ColorSpace colorSpace
 )
 {
 	if (image == nullptr)
 		return std::nullopt;
 
 	std::string key;
-	if (filePath.has_value())
+	if (filePath.has_value() && !filePath->empty())
 	{
-		key = filePath->string();
+		key = imageCacheKey(*filePath, colorSpace);
 
 		if (!key.empty())
 		{
@@ -114,16 +118,12 @@ std::optional<TextureManager::TexturePtr> TextureManager::createSurfaceTexture(
 
 std::optional<TextureManager::TexturePtr> TextureManager::createTextureFromFile(
 	const std::filesystem::path &filepath,
-	bool forceReload
+	bool forceReload,
+	engine::rendering::ColorSpace colorSpace
 )
 {
-	std::filesystem::path texturePath;
-	if (filepath.is_absolute())
-		texturePath = filepath;
-	else
-		texturePath = m_loader->getBasePath() / filepath;
-
-	std::string key = texturePath.string();
+	const std::filesystem::path texturePath = resolvePath(filepath);
+	std::string key = imageCacheKey(texturePath, colorSpace);
 
 	{
 		std::scoped_lock lock(m_mutex);
@@ -140,25 +140,35 @@ std::optional<TextureManager::TexturePtr> TextureManager::createTextureFromFile(
 		}
 	}
 
-	auto result = m_loader->load(texturePath);
+	std::optional<Image::Ptr> result;
+	if (m_useCookedTextures && TextureCooker::isCookedUpToDate(texturePath))
+	{
+		result = m_loader->load(TextureCooker::getCookedPath(texturePath));
+		if (!result)
+			spdlog::warn("Cooked texture for '{}' could not be loaded, using the source image", key);
+	}
+	if (!result)
+		result = m_loader->load(texturePath);
 	if (!result)
 		return std::nullopt;
 
-	auto texture = createImageTexture(result.value(), texturePath);
+	// Identical content under another path (copied files): share the existing texture
+	const uint64_t contentHash = computeContentHash(**result);
+	auto texture = getOrCreateImageTexture(contentHash, [&result]() { return *result; }, texturePath, colorSpace);
+	if (texture)
+	{
+		std::scoped_lock lock(m_mutex);
+		m_imageCache[key] = (*texture)->getHandle();
+	}
 	return texture;
 }
 
 std::optional<TextureManager::TexturePtr> TextureManager::getTextureByPath(
-	const std::filesystem::path &filepath
+	const std::filesystem::path &filepath,
+	engine::rendering::ColorSpace colorSpace
 ) const
 {
-	std::filesystem::path texturePath;
-	if (filepath.is_absolute())
-		texturePath = filepath;
-	else
-		texturePath = m_loader->getBasePath() / filepath;
-
-	std::string key = texturePath.string();
+	std::string key = imageCacheKey(resolvePath(filepath), colorSpace);
 
 	std::scoped_lock lock(m_mutex);
 	auto it = m_imageCache.find(key);
@@ -173,4 +183,147 @@ std::optional<TextureManager::TexturePtr> TextureManager::getTextureByPath(
 	return std::nullopt;
 }
 
+std::optional<TextureManager::TexturePtr> TextureManager::getOrCreateImageTexture(
+	uint64_t contentHash,
+	const std::function<engine::resources::Image::Ptr()> &createImage,
+	std::optional<path> filePath,
+	engine::rendering::ColorSpace colorSpace
+)
+{
+	// The GPU texture of a handle is created in the color space of its first use
+	const uint64_t key = engine::core::hashCombine(contentHash, static_cast<uint64_t>(colorSpace));
+
+	std::promise<std::optional<TexturePtr>> promise;
+	std::shared_future<std::optional<TexturePtr>> pending;
+	{
+		std::scoped_lock lock(m_mutex);
+		if (auto cached = findByContentHashLocked(key))
+		{
+			++m_deduplicatedCount;
+			return cached;
+		}
+		auto pendingIt = m_pendingContent.find(key);
+		if (pendingIt != m_pendingContent.end())
+		{
+			++m_deduplicatedCount;
+			pending = pendingIt->second;
+		}
+		else
+		{
+			// Claim the content: concurrent requests wait for this one instead of decoding again
+			m_pendingContent.emplace(key, promise.get_future().share());
+		}
+	}
+	if (pending.valid())
+		return pending.get();
+
+	std::optional<TexturePtr> texture;
+	try
+	{
+		if (auto image = createImage())
+			texture = createImageTexture(std::move(image), std::move(filePath), true, colorSpace);
+	}
+	catch (...)
+	{
+		{
+			std::scoped_lock lock(m_mutex);
+			m_pendingContent.erase(key);
+		}
+		promise.set_exception(std::current_exception());
+		throw;
+	}
+
+	{
+		std::scoped_lock lock(m_mutex);
+		if (texture)
+			m_contentCache[key] = (*texture)->getHandle();
+		m_pendingContent.erase(key);
+	}
+	promise.set_value(texture);
+	return texture;
+}
+
+uint64_t TextureManager::computeContentHash(ImageFormat::Type format, uint32_t width, uint32_t height, const void *data, size_t size)
+{
+	uint64_t hash = engine::core::xxHash64(data, size);
+	hash = engine::core::hashCombine(hash, static_cast<uint64_t>(format));
+	hash = engine::core::hashCombine(hash, (static_cast<uint64_t>(width) << 32) | height);
+	return hash;
+}
+
+uint64_t TextureManager::computeContentHash(const engine::resources::Image &image)
+{
+	if (image.isCompressed())
+	{
+		uint64_t hash = engine::core::hashCombine(0, static_cast<uint64_t>(image.getBlockCompression()));
+		for (uint32_t level = 0; level < image.getMipLevelCount(); ++level)
+		{
+			const auto &blocks = image.getCompressedLevel(level);
+			hash = engine::core::hashCombine(hash, computeContentHash(image.getFormat(), image.getWidth(), image.getHeight(), blocks.data(), blocks.size()));
+		}
+		return hash;
+	}
+	if (image.isHDR())
+	{
+		const auto &pixels = image.getPixels16F();
+		return computeContentHash(image.getFormat(), image.getWidth(), image.getHeight(), pixels.data(), pixels.size() * sizeof(uint16_t));
+	}
+
+	// Cooked mips derive from level 0, so level 0 and the mip count identify the image.
+	// Plain images hash like their raw pixels, so file and embedded copies match.
+	const auto &pixels = image.getPixels8();
+	const uint64_t hash = computeContentHash(image.getFormat(), image.getWidth(), image.getHeight(), pixels.data(), pixels.size());
+	return image.getMipLevelCount() > 1 ? engine::core::hashCombine(hash, image.getMipLevelCount()) : hash;
+}
+
+size_t TextureManager::getDeduplicatedCount() const
+{
+	std::scoped_lock lock(m_mutex);
+	return m_deduplicatedCount;
+}
+
+std::optional<TextureManager::TexturePtr> TextureManager::findByContentHashLocked(uint64_t contentHash) const
+{
+	auto it = m_contentCache.find(contentHash);
+	if (it == m_contentCache.end())
+		return std::nullopt;
+
+	// Access map directly to avoid deadlock (we already hold the mutex)
+	auto resIt = m_resources.find(it->second);
+	if (resIt != m_resources.end() && resIt->second)
+		return resIt->second;
+	return std::nullopt;
+}
+
+bool TextureManager::cookTextureFile(const path &filepath, const TextureCookOptions &options)
+{
+	const std::filesystem::path texturePath = resolvePath(filepath);
+	auto source = m_loader->load(texturePath);
+	if (!source)
+		return false;
+
+	auto cooked = TextureCooker::cook(**source, options);
+	if (!cooked)
+		return false;
+
+	return m_loader->saveAsKTX2(**cooked, TextureCooker::getCookedPath(texturePath), options.srgb && !options.normalMap);
+}
+
+bool TextureManager::cookTextureFile(const path &filepath, const std::string &slotName)
+{
+	return cookTextureFile(filepath, TextureCooker::optionsForSlot(slotName));
+}
+
+std::string TextureManager::imageCacheKey(const path &filepath, engine::rendering::ColorSpace colorSpace)
+{
+	return filepath.string() + (colorSpace == engine::rendering::ColorSpace::sRGB ? "#srgb" : "#linear");
+}
+
+TextureManager::path TextureManager::resolvePath(const path &filepath) const
+{
+	if (filepath.is_absolute())
+		return filepath;
+	return m_loader->getBasePath() / filepath;
+}
+
 } // namespace engine::resources
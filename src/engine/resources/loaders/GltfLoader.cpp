@@ -1,4 +1,5 @@
 #include "engine/resources/loaders/GltfLoader.h"
+#include "engine/core/Profiler.h"
 #include "engine/rendering/Mesh.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
@@ -247,6 +248,7 @@ std::optional<engine::resources::GltfGeometryData> GltfLoader::load(
 	std::optional<engine::math::CoordinateSystem::Cartesian> dstCoordSysOpt
 )
 {
+	ENGINE_PROFILE_SCOPE("GltfLoader::load");
 	auto srcCoordSys = srcCoordSysOpt.value_or(m_srcCoordSys);
 	auto dstCoordSys = dstCoordSysOpt.value_or(engine::math::CoordinateSystem::DEFAULT);
 	std::filesystem::path filePath = resolvePath(file);
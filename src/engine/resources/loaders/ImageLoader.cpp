@@ -1,11 +1,18 @@
 #include "engine/resources/loaders/ImageLoader.h"
+#include "engine/core/Profiler.h"
 
+#include <algorithm>
 #include <filesystem>
+#include <fstream>
 #include <memory>
 #include <optional>
 
 #include "engine/debug/Loggable.h"
+#include "engine/io/FileReader.h"
+#include "engine/math/HalfFloat.h"
+#include "engine/resources/BlockCodec.h"
 #include "engine/resources/Image.h"
+#include "engine/resources/loaders/Ktx2Codec.h"
 
 #include "stb_image.h"
 #include "stb_image_write.h"
@@ -18,6 +25,8 @@ namespace engine::resources::loaders
 	const auto fullPath = resolvePath(file);
 	logInfo("Loading image from '{}'", fullPath.string());
 
+	if (fullPath.extension() == ".ktx2")
+		return loadKTX2(fullPath);
 	if (isHDRImage(fullPath))
 		return loadHDR(fullPath);
 	else
@@ -32,6 +41,7 @@ bool ImageLoader::isHDRImage(const std::filesystem::path &path)
 
 std::optional<Image::Ptr> ImageLoader::loadHDR(const std::filesystem::path &fullPath)
 {
+	ENGINE_PROFILE_SCOPE("ImageLoader::loadHDR");
 	stbi_set_flip_vertically_on_load(false);
 
 	int width = 0, height = 0, channels = 0;
@@ -43,24 +53,15 @@ std::optional<Image::Ptr> ImageLoader::loadHDR(const std::filesystem::path &full
 		return std::nullopt;
 	}
 
-	std::vector<float> pixels;
-	pixels.reserve(static_cast<size_t>(width) * height * 4);
-
+	// Convert to half floats once (RGB expanded to RGBA in the same pass); the float data is dropped
+	std::vector<uint16_t> pixels = engine::math::HalfFloat::fromFloatImage(
+		data,
+		static_cast<uint32_t>(width),
+		static_cast<uint32_t>(height),
+		static_cast<uint32_t>(channels)
+	);
 	if (channels == 3)
-	{
-		for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i)
-		{
-			pixels.push_back(data[i * 3 + 0]);
-			pixels.push_back(data[i * 3 + 1]);
-			pixels.push_back(data[i * 3 + 2]);
-			pixels.push_back(1.0f);
-		}
 		channels = 4;
-	}
-	else
-	{
-		pixels.assign(data, data + static_cast<size_t>(width) * height * channels);
-	}
 
 	stbi_image_free(data);
 
@@ -70,6 +71,7 @@ std::optional<Image::Ptr> ImageLoader::loadHDR(const std::filesystem::path &full
 
 std::optional<Image::Ptr> ImageLoader::loadLDR(const std::filesystem::path &fullPath)
 {
+	ENGINE_PROFILE_SCOPE("ImageLoader::loadLDR");
 	stbi_set_flip_vertically_on_load(false);
 
 	int width = 0, height = 0, channels = 0;
@@ -107,6 +109,65 @@ std::optional<Image::Ptr> ImageLoader::loadLDR(const std::filesystem::path &full
 	return std::make_shared<Image>(width, height, format, std::move(pixels));
 }
 
+std::optional<Image::Ptr> ImageLoader::loadKTX2(const std::filesystem::path &fullPath)
+{
+	ENGINE_PROFILE_SCOPE("ImageLoader::loadKTX2");
+	auto data = engine::io::FileReader::loadBinary(fullPath.string());
+	if (!data)
+	{
+		logError("Failed to read KTX2 file '{}'", fullPath.string());
+		return std::nullopt;
+	}
+
+	std::string error;
+	auto decoded = Ktx2Codec::read(*data, error);
+	if (!decoded)
+	{
+		logError("Failed to load KTX2 file '{}': {}", fullPath.string(), error);
+		return std::nullopt;
+	}
+
+	auto image = decoded->image;
+	const auto compression = image->getBlockCompression();
+	if (!image->isCompressed() || isBlockCompressionSupported(compression))
+		return image;
+
+	// The GPU cannot sample this format: fall back to uncompressed data with the same mip chain
+	if (!BlockCodec::canDecode(compression))
+	{
+		logError("'{}' uses {}, which this device cannot sample and which cannot be decoded", fullPath.string(), BlockCompression::toString(compression));
+		return std::nullopt;
+	}
+
+	logInfo("Decoding {} texture '{}' (format not supported by the device)", BlockCompression::toString(compression), fullPath.string());
+	std::vector<std::vector<uint8_t>> levels;
+	for (uint32_t level = 0; level < image->getMipLevelCount(); ++level)
+	{
+		auto pixels = BlockCodec::decode(
+			compression,
+			image->getCompressedLevel(level),
+			std::max(1u, image->getWidth() >> level),
+			std::max(1u, image->getHeight() >> level)
+		);
+		if (!pixels)
+		{
+			logError("Failed to decode mip {} of '{}'", level, fullPath.string());
+			return std::nullopt;
+		}
+		levels.push_back(std::move(*pixels));
+	}
+
+	auto decodedImage = std::make_shared<Image>(image->getWidth(), image->getHeight(), image->getFormat(), std::move(levels.front()));
+	levels.erase(levels.begin());
+	decodedImage->setMipChain(std::move(levels));
+	return decodedImage;
+}
+
+bool ImageLoader::isBlockCompressionSupported(BlockCompression::Type compression) const
+{
+	return std::find(m_supportedBlockCompression.begin(), m_supportedBlockCompression.end(), compression) != m_supportedBlockCompression.end();
+}
+
 std::optional<Image::Ptr> ImageLoader::createEmpty(
 	uint32_t width,
 	uint32_t height,
@@ -117,7 +178,7 @@ std::optional<Image::Ptr> ImageLoader::createEmpty(
 
 	if (ImageFormat::isHDRFormat(imgFormat))
 	{
-		std::vector<float> pixels(width * height * ImageFormat::getChannelCount(imgFormat), 0.0f);
+		std::vector<uint16_t> pixels(width * height * ImageFormat::getChannelCount(imgFormat), 0); // 0 is +0.0 in half
 		return std::make_shared<Image>(width, height, imgFormat, std::move(pixels));
 	}
 	else
@@ -129,7 +190,7 @@ std::optional<Image::Ptr> ImageLoader::createEmpty(
 
 bool ImageLoader::saveAsPNG(const Image &image, const std::filesystem::path &filePath) const
 {
-	if (!image.isLDR())
+	if (!image.isLDR() || image.isCompressed())
 	{
 		logError("Only LDR images can be saved as PNG. Image format is not LDR.");
 		return false;
@@ -168,4 +229,26 @@ bool ImageLoader::saveAsPNG(const Image &image, const std::filesystem::path &fil
 	return true;
 }
 
+bool ImageLoader::saveAsKTX2(const Image &image, const std::filesystem::path &filePath, bool srgb) const
+{
+	const auto data = Ktx2Codec::write(image, srgb);
+	if (data.empty())
+	{
+		logError("Cannot store image of format {} as KTX2", ImageFormat::toString(image.getFormat()));
+		return false;
+	}
+	if (filePath.has_parent_path() && !std::filesystem::exists(std::filesystem::absolute(filePath.parent_path())))
+	{
+		std::filesystem::create_directories(std::filesystem::absolute(filePath.parent_path()));
+	}
+
+	std::ofstream file(filePath, std::ios::binary);
+	if (!file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size())))
+	{
+		logError("Failed to save KTX2 file '{}'", filePath.string());
+		return false;
+	}
+	return true;
+}
+
 } // namespace engine::resources::loaders
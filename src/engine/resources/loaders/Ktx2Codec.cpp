@@ -0,0 +1,354 @@
+#include "engine/resources/loaders/Ktx2Codec.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace engine::resources::loaders
+{
+
+namespace
+{
+constexpr std::array<uint8_t, 12> KTX2_IDENTIFIER = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+constexpr size_t HEADER_SIZE = 80;		 ///< Identifier, header and index up to the level index
+constexpr size_t LEVEL_ENTRY_SIZE = 24; ///< byteOffset, byteLength, uncompressedByteLength
+
+// Khronos Data Format color models and channel ids used in the descriptor
+constexpr uint8_t KHR_DF_MODEL_RGBSDA = 1;
+constexpr uint8_t KHR_DF_MODEL_BC1A = 128;
+constexpr uint8_t KHR_DF_MODEL_BC3 = 130;
+constexpr uint8_t KHR_DF_MODEL_BC4 = 131;
+constexpr uint8_t KHR_DF_MODEL_BC5 = 132;
+constexpr uint8_t KHR_DF_MODEL_BC7 = 134;
+constexpr uint8_t KHR_DF_MODEL_ETC2 = 161;
+constexpr uint8_t KHR_DF_MODEL_ASTC = 162;
+constexpr uint8_t KHR_DF_CHANNEL_ALPHA = 15;
+constexpr uint8_t KHR_DF_SAMPLE_DATATYPE_LINEAR = 0x10;
+
+struct VkFormatInfo
+{
+	uint32_t vkFormat;
+	BlockCompression::Type compression;
+	ImageFormat::Type format; ///< Uncompressed format (compressed: the decoded format)
+	bool srgb;
+};
+
+// Writers take the first match, so the preferred variant of a format comes first
+constexpr VkFormatInfo VK_FORMATS[] = {
+	{9, BlockCompression::Type::None, ImageFormat::Type::LDR_R8, false},	   // R8_UNORM
+	{15, BlockCompression::Type::None, ImageFormat::Type::LDR_R8, true},	   // R8_SRGB
+	{16, BlockCompression::Type::None, ImageFormat::Type::LDR_RG8, false},	   // R8G8_UNORM
+	{22, BlockCompression::Type::None, ImageFormat::Type::LDR_RG8, true},	   // R8G8_SRGB
+	{37, BlockCompression::Type::None, ImageFormat::Type::LDR_RGBA8, false},   // R8G8B8A8_UNORM
+	{43, BlockCompression::Type::None, ImageFormat::Type::LDR_RGBA8, true},	   // R8G8B8A8_SRGB
+	{133, BlockCompression::Type::BC1_RGBA, ImageFormat::Type::LDR_RGBA8, false}, // BC1_RGBA_UNORM_BLOCK
+	{134, BlockCompression::Type::BC1_RGBA, ImageFormat::Type::LDR_RGBA8, true},  // BC1_RGBA_SRGB_BLOCK
+	{131, BlockCompression::Type::BC1_RGBA, ImageFormat::Type::LDR_RGBA8, false}, // BC1_RGB_UNORM_BLOCK
+	{132, BlockCompression::Type::BC1_RGBA, ImageFormat::Type::LDR_RGBA8, true},  // BC1_RGB_SRGB_BLOCK
+	{137, BlockCompression::Type::BC3_RGBA, ImageFormat::Type::LDR_RGBA8, false}, // BC3_UNORM_BLOCK
+	{138, BlockCompression::Type::BC3_RGBA, ImageFormat::Type::LDR_RGBA8, true},  // BC3_SRGB_BLOCK
+	{139, BlockCompression::Type::BC4_R, ImageFormat::Type::LDR_R8, false},		  // BC4_UNORM_BLOCK
+	{141, BlockCompression::Type::BC5_RG, ImageFormat::Type::LDR_RG8, false},	  // BC5_UNORM_BLOCK
+	{145, BlockCompression::Type::BC7_RGBA, ImageFormat::Type::LDR_RGBA8, false}, // BC7_UNORM_BLOCK
+	{146, BlockCompression::Type::BC7_RGBA, ImageFormat::Type::LDR_RGBA8, true},  // BC7_SRGB_BLOCK
+	{147, BlockCompression::Type::ETC2_RGB8, ImageFormat::Type::LDR_RGBA8, false}, // ETC2_R8G8B8_UNORM_BLOCK
+	{148, BlockCompression::Type::ETC2_RGB8, ImageFormat::Type::LDR_RGBA8, true},  // ETC2_R8G8B8_SRGB_BLOCK
+	{151, BlockCompression::Type::ETC2_RGBA8, ImageFormat::Type::LDR_RGBA8, false}, // ETC2_R8G8B8A8_UNORM_BLOCK
+	{152, BlockCompression::Type::ETC2_RGBA8, ImageFormat::Type::LDR_RGBA8, true},  // ETC2_R8G8B8A8_SRGB_BLOCK
+	{157, BlockCompression::Type::ASTC_4x4, ImageFormat::Type::LDR_RGBA8, false},  // ASTC_4x4_UNORM_BLOCK
+	{158, BlockCompression::Type::ASTC_4x4, ImageFormat::Type::LDR_RGBA8, true},   // ASTC_4x4_SRGB_BLOCK
+};
+
+const VkFormatInfo *findByVkFormat(uint32_t vkFormat)
+{
+	for (const auto &info : VK_FORMATS)
+	{
+		if (info.vkFormat == vkFormat)
+			return &info;
+	}
+	return nullptr;
+}
+
+const VkFormatInfo *findForImage(BlockCompression::Type compression, ImageFormat::Type format, bool srgb)
+{
+	const VkFormatInfo *fallback = nullptr;
+	for (const auto &info : VK_FORMATS)
+	{
+		if (info.compression != compression || info.format != format)
+			continue;
+		if (info.srgb == srgb)
+			return &info;
+		if (!fallback)
+			fallback = &info; // e.g. BC4/BC5 have no sRGB variant
+	}
+	return fallback;
+}
+
+uint32_t read32(const uint8_t *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint64_t read64(const uint8_t *p)
+{
+	return read32(p) | (static_cast<uint64_t>(read32(p + 4)) << 32);
+}
+
+void write32(std::vector<uint8_t> &out, size_t offset, uint32_t value)
+{
+	for (int b = 0; b < 4; ++b)
+		out[offset + b] = static_cast<uint8_t>((value >> (8 * b)) & 0xFF);
+}
+
+void write64(std::vector<uint8_t> &out, size_t offset, uint64_t value)
+{
+	write32(out, offset, static_cast<uint32_t>(value & 0xFFFFFFFFu));
+	write32(out, offset + 4, static_cast<uint32_t>(value >> 32));
+}
+
+size_t alignUp(size_t value, size_t alignment)
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+/** @brief Basic data format descriptor (KDF 1.3) for the formats the writer produces. */
+std::vector<uint8_t> buildDataFormatDescriptor(const VkFormatInfo &info)
+{
+	struct Sample
+	{
+		uint16_t bitOffset;
+		uint8_t bitLength; ///< Length - 1
+		uint8_t channel;
+		uint32_t upper;
+	};
+	std::vector<Sample> samples;
+	uint8_t model = KHR_DF_MODEL_RGBSDA;
+	const uint8_t alphaFlags = KHR_DF_CHANNEL_ALPHA | (info.srgb ? KHR_DF_SAMPLE_DATATYPE_LINEAR : 0);
+
+	switch (info.compression)
+	{
+	case BlockCompression::Type::None:
+	{
+		const uint32_t channels = ImageFormat::getChannelCount(info.format);
+		for (uint32_t c = 0; c < channels; ++c)
+			samples.push_back({static_cast<uint16_t>(8 * c), 7, c == 3 ? alphaFlags : static_cast<uint8_t>(c), 255});
+		break;
+	}
+	case BlockCompression::Type::BC1_RGBA:
+		model = KHR_DF_MODEL_BC1A;
+		samples.push_back({0, 63, 0, 0xFFFFFFFFu});
+		break;
+	case BlockCompression::Type::BC3_RGBA:
+		model = KHR_DF_MODEL_BC3;
+		samples.push_back({0, 63, alphaFlags, 0xFFFFFFFFu});
+		samples.push_back({64, 63, 0, 0xFFFFFFFFu});
+		break;
+	case BlockCompression::Type::BC4_R:
+		model = KHR_DF_MODEL_BC4;
+		samples.push_back({0, 63, 0, 0xFFFFFFFFu});
+		break;
+	case BlockCompression::Type::BC5_RG:
+		model = KHR_DF_MODEL_BC5;
+		samples.push_back({0, 63, 0, 0xFFFFFFFFu});
+		samples.push_back({64, 63, 1, 0xFFFFFFFFu});
+		break;
+	case BlockCompression::Type::BC7_RGBA:
+		model = KHR_DF_MODEL_BC7;
+		samples.push_back({0, 127, 0, 0xFFFFFFFFu});
+		break;
+	case BlockCompression::Type::ETC2_RGB8:
+		model = KHR_DF_MODEL_ETC2;
+		samples.push_back({0, 63, 2, 0xFFFFFFFFu});
+		break;
+	case BlockCompression::Type::ETC2_RGBA8:
+		model = KHR_DF_MODEL_ETC2;
+		samples.push_back({0, 63, alphaFlags, 0xFFFFFFFFu});
+		samples.push_back({64, 63, 2, 0xFFFFFFFFu});
+		break;
+	case BlockCompression::Type::ASTC_4x4:
+		model = KHR_DF_MODEL_ASTC;
+		samples.push_back({0, 127, 0, 0xFFFFFFFFu});
+		break;
+	}
+
+	const uint32_t blockSize = 24 + 16 * static_cast<uint32_t>(samples.size());
+	std::vector<uint8_t> dfd(4 + blockSize, 0);
+	write32(dfd, 0, static_cast<uint32_t>(dfd.size()));
+	write32(dfd, 4, 0);						   // vendorId = Khronos, descriptorType = basic
+	write32(dfd, 8, 2u | (blockSize << 16));   // versionNumber = 2, descriptorBlockSize
+	dfd[12] = model;
+	dfd[13] = 1;					   // colorPrimaries = BT709
+	dfd[14] = info.srgb ? 2 : 1;	   // transferFunction = sRGB / linear
+	dfd[15] = 0;					   // flags = straight alpha
+	const bool compressed = info.compression != BlockCompression::Type::None;
+	dfd[16] = compressed ? 3 : 0;	   // texelBlockDimension (size - 1)
+	dfd[17] = compressed ? 3 : 0;
+	dfd[20] = static_cast<uint8_t>(compressed ? BlockCompression::getBlockBytes(info.compression) : ImageFormat::getChannelCount(info.format));
+
+	for (size_t i = 0; i < samples.size(); ++i)
+	{
+		const size_t offset = 28 + 16 * i;
+		dfd[offset + 0] = static_cast<uint8_t>(samples[i].bitOffset & 0xFF);
+		dfd[offset + 1] = static_cast<uint8_t>(samples[i].bitOffset >> 8);
+		dfd[offset + 2] = samples[i].bitLength;
+		dfd[offset + 3] = samples[i].channel;
+		write32(dfd, offset + 8, 0); // sampleLower
+		write32(dfd, offset + 12, samples[i].upper);
+	}
+	return dfd;
+}
+} // namespace
+
+bool Ktx2Codec::isKtx2(const std::vector<uint8_t> &data)
+{
+	return data.size() >= KTX2_IDENTIFIER.size() && std::equal(KTX2_IDENTIFIER.begin(), KTX2_IDENTIFIER.end(), data.begin());
+}
+
+std::optional<Ktx2Codec::Decoded> Ktx2Codec::read(const std::vector<uint8_t> &data, std::string &error)
+{
+	if (!isKtx2(data) || data.size() < HEADER_SIZE)
+	{
+		error = "not a KTX2 file";
+		return std::nullopt;
+	}
+
+	const uint8_t *header = data.data() + KTX2_IDENTIFIER.size();
+	const uint32_t vkFormat = read32(header + 0);
+	const uint32_t width = read32(header + 8);
+	const uint32_t height = read32(header + 12);
+	const uint32_t depth = read32(header + 16);
+	const uint32_t layerCount = read32(header + 20);
+	const uint32_t faceCount = read32(header + 24);
+	const uint32_t levelCount = std::max(read32(header + 28), 1u); // 0: mips to be generated at load
+	const uint32_t supercompression = read32(header + 32);
+
+	if (supercompression != 0)
+	{
+		error = "supercompressed (BasisLZ/Zstandard) KTX2 files are not supported";
+		return std::nullopt;
+	}
+	if (width == 0 || height == 0 || depth > 1 || layerCount > 1 || faceCount != 1)
+	{
+		error = "only single 2D textures are supported";
+		return std::nullopt;
+	}
+
+	const VkFormatInfo *info = findByVkFormat(vkFormat);
+	if (!info)
+	{
+		error = "unsupported vkFormat " + std::to_string(vkFormat);
+		return std::nullopt;
+	}
+	if (info->compression != BlockCompression::Type::None && (width % 4 != 0 || height % 4 != 0))
+	{
+		error = "block-compressed textures must be a multiple of 4 in size";
+		return std::nullopt;
+	}
+	if (levelCount > 1 + static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))))
+	{
+		error = "more mip levels than the size allows";
+		return std::nullopt;
+	}
+	if (data.size() < HEADER_SIZE + static_cast<size_t>(levelCount) * LEVEL_ENTRY_SIZE)
+	{
+		error = "truncated level index";
+		return std::nullopt;
+	}
+
+	std::vector<std::vector<uint8_t>> levels;
+	levels.reserve(levelCount);
+	for (uint32_t level = 0; level < levelCount; ++level)
+	{
+		const uint8_t *entry = data.data() + HEADER_SIZE + static_cast<size_t>(level) * LEVEL_ENTRY_SIZE;
+		const uint64_t offset = read64(entry);
+		const uint64_t length = read64(entry + 8);
+
+		const uint32_t levelWidth = std::max(1u, width >> level);
+		const uint32_t levelHeight = std::max(1u, height >> level);
+		const size_t expected = info->compression != BlockCompression::Type::None
+									? BlockCompression::getLevelSize(info->compression, levelWidth, levelHeight)
+									: static_cast<size_t>(levelWidth) * levelHeight * ImageFormat::getChannelCount(info->format);
+		if (length < expected || offset > data.size() || data.size() - offset < expected)
+		{
+			error = "mip level " + std::to_string(level) + " is truncated";
+			return std::nullopt;
+		}
+		levels.emplace_back(data.begin() + static_cast<std::ptrdiff_t>(offset), data.begin() + static_cast<std::ptrdiff_t>(offset + expected));
+	}
+
+	Decoded decoded;
+	decoded.srgb = info->srgb;
+	if (info->compression != BlockCompression::Type::None)
+	{
+		decoded.image = std::make_shared<Image>(width, height, info->compression, std::move(levels));
+	}
+	else
+	{
+		std::vector<uint8_t> base = std::move(levels.front());
+		levels.erase(levels.begin());
+		decoded.image = std::make_shared<Image>(width, height, info->format, std::move(base));
+		decoded.image->setMipChain(std::move(levels));
+	}
+	return decoded;
+}
+
+std::vector<uint8_t> Ktx2Codec::write(const Image &image, bool srgb)
+{
+	if (image.isEmpty() || image.isHDR())
+		return {};
+
+	const VkFormatInfo *info = findForImage(image.getBlockCompression(), image.getFormat(), srgb);
+	if (!info)
+		return {};
+
+	const uint32_t levelCount = image.getMipLevelCount();
+	const bool compressed = image.isCompressed();
+	const size_t alignment = compressed ? BlockCompression::getBlockBytes(info->compression) : 4;
+	const std::vector<uint8_t> dfd = buildDataFormatDescriptor(*info);
+
+	const size_t dfdOffset = HEADER_SIZE + static_cast<size_t>(levelCount) * LEVEL_ENTRY_SIZE;
+	size_t cursor = dfdOffset + dfd.size();
+
+	// Level data is stored smallest mip first
+	std::vector<size_t> levelOffsets(levelCount);
+	for (uint32_t level = levelCount; level-- > 0;)
+	{
+		const auto &levelData = compressed ? image.getCompressedLevel(level) : image.getMipPixels8(level);
+		cursor = alignUp(cursor, alignment);
+		levelOffsets[level] = cursor;
+		cursor += levelData.size();
+	}
+
+	std::vector<uint8_t> out(cursor, 0);
+	std::copy(KTX2_IDENTIFIER.begin(), KTX2_IDENTIFIER.end(), out.begin());
+	write32(out, 12, info->vkFormat);
+	write32(out, 16, 1); // typeSize
+	write32(out, 20, image.getWidth());
+	write32(out, 24, image.getHeight());
+	write32(out, 28, 0); // pixelDepth
+	write32(out, 32, 0); // layerCount
+	write32(out, 36, 1); // faceCount
+	write32(out, 40, levelCount);
+	write32(out, 44, 0); // supercompressionScheme
+	write32(out, 48, static_cast<uint32_t>(dfdOffset));
+	write32(out, 52, static_cast<uint32_t>(dfd.size()));
+	write32(out, 56, 0); // kvdByteOffset
+	write32(out, 60, 0); // kvdByteLength
+	write64(out, 64, 0); // sgdByteOffset
+	write64(out, 72, 0); // sgdByteLength
+
+	for (uint32_t level = 0; level < levelCount; ++level)
+	{
+		const auto &levelData = compressed ? image.getCompressedLevel(level) : image.getMipPixels8(level);
+		const size_t entry = HEADER_SIZE + static_cast<size_t>(level) * LEVEL_ENTRY_SIZE;
+		write64(out, entry, levelOffsets[level]);
+		write64(out, entry + 8, levelData.size());
+		write64(out, entry + 16, levelData.size());
+		std::memcpy(out.data() + levelOffsets[level], levelData.data(), levelData.size());
+	}
+	std::memcpy(out.data() + dfdOffset, dfd.data(), dfd.size());
+	return out;
+}
+
+} // namespace engine::resources::loaders
@@ -1,4 +1,5 @@
 #include "engine/resources/loaders/ObjLoader.h"
+#include "engine/core/Profiler.h"
 #include <filesystem>
 #include <unordered_map>
 
@@ -10,6 +11,7 @@ std::optional<ObjGeometryData> ObjLoader::load(
 	std::optional<engine::math::CoordinateSystem::Cartesian> dstCoordSysOpt
 )
 {
+	ENGINE_PROFILE_SCOPE("ObjLoader::load");
 	auto srcCoordSys = srcCoordSysOpt.value_or(m_srcCoordSys);
 	auto dstCoordSys = dstCoordSysOpt.value_or(engine::math::CoordinateSystem::DEFAULT);
 	std::filesystem::path filePath = resolvePath(file);
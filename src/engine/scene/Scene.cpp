@@ -1,7 +1,9 @@
 #include "engine/scene/Scene.h"
+#include "engine/core/Profiler.h"
 #include "engine/rendering/BindGroupDataProvider.h"
 #include "engine/scene/nodes/CameraNode.h"
 #include "engine/scene/nodes/LightNode.h"
+#include "engine/scene/nodes/PhysicsNode.h"
 #include "engine/scene/nodes/RenderNode.h"
 #include "engine/scene/nodes/UpdateNode.h"
 #include <algorithm>
@@ -23,6 +25,7 @@ Scene::Scene() : m_root(nullptr)
 
 void Scene::update(float deltaTime)
 {
+	ENGINE_PROFILE_SCOPE("Scene::update");
 	if (!m_root)
 		return;
 
@@ -56,6 +59,7 @@ void Scene::update(float deltaTime)
 
 void Scene::lateUpdate(float deltaTime)
 {
+	ENGINE_PROFILE_SCOPE("Scene::lateUpdate");
 	if (!m_root)
 		return;
 
@@ -87,8 +91,76 @@ void Scene::lateUpdate(float deltaTime)
 	processLateUpdateNodes(m_root, deltaTime);
 }
 
+void Scene::fixedUpdate(float fixedDeltaTime)
+{
+	ENGINE_PROFILE_SCOPE("Scene::fixedUpdate");
+	if (!m_root)
+		return;
+
+	// Process all PhysicsNodes in the scene graph
+	std::function<void(nodes::Node::Ptr, float)> processPhysicsNodes;
+	processPhysicsNodes = [&processPhysicsNodes](nodes::Node::Ptr node, float dt)
+	{
+		if (node->isEnabled())
+		{
+			if (node->isPhysics())
+			{
+				auto physicsNode = node->asPhysicsNode();
+				if (physicsNode)
+				{
+					physicsNode->beginFixedStep();
+					physicsNode->fixedUpdate(dt);
+					physicsNode->endFixedStep();
+				}
+			}
+
+			// Process children
+			for (const auto &child : node->getChildren())
+			{
+				processPhysicsNodes(child, dt);
+			}
+		}
+	};
+
+	// Start traversal from root
+	processPhysicsNodes(m_root, fixedDeltaTime);
+}
+
+void Scene::interpolatePhysics(float alpha)
+{
+	if (!m_root)
+		return;
+
+	// Blend all PhysicsNodes towards the current simulation state
+	std::function<void(nodes::Node::Ptr)> processPhysicsNodes;
+	processPhysicsNodes = [&processPhysicsNodes, alpha](nodes::Node::Ptr node)
+	{
+		if (node->isEnabled())
+		{
+			if (node->isPhysics())
+			{
+				auto physicsNode = node->asPhysicsNode();
+				if (physicsNode)
+				{
+					physicsNode->applyInterpolation(alpha);
+				}
+			}
+
+			// Process children
+			for (const auto &child : node->getChildren())
+			{
+				processPhysicsNodes(child);
+			}
+		}
+	};
+
+	// Start traversal from root
+	processPhysicsNodes(m_root);
+}
+
 void Scene::collectRenderData(engine::rendering::RenderCollector &collector)
 {
+	ENGINE_PROFILE_SCOPE("Scene::collectRenderData");
 	if (!m_root)
 		return;
 
@@ -121,6 +193,7 @@ void Scene::collectRenderData(engine::rendering::RenderCollector &collector)
 
 void Scene::collectDebugData()
 {
+	ENGINE_PROFILE_SCOPE("Scene::collectDebugData");
 	if (!m_root)
 		return;
 
@@ -150,6 +223,7 @@ void Scene::collectDebugData()
 
 void Scene::preRender()
 {
+	ENGINE_PROFILE_SCOPE("Scene::preRender");
 	if (!m_root)
 		return;
 
@@ -193,6 +267,7 @@ void Scene::preRender()
 
 void Scene::postRender()
 {
+	ENGINE_PROFILE_SCOPE("Scene::postRender");
 	if (!m_root)
 		return;
 
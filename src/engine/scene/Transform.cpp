@@ -12,7 +12,7 @@ Transform::~Transform() = default;
 void Transform::setLocalPosition(const glm::vec3 &position)
 {
 	m_localPosition = position;
-	markDirty();
+	markLocalChanged();
 }
 
 void Transform::setLocalRotation(const glm::quat &rotation)
@@ -25,20 +25,20 @@ void Transform::setLocalRotation(const glm::quat &rotation)
 	m_localRotationCache = rotation;
 	m_dirtyRotation = false;
 
-	markDirty();
+	markLocalChanged();
 }
 
 void Transform::setLocalEulerAngles(const glm::vec3 &euler)
 {
 	m_localEulerAngles = euler;
 	m_dirtyRotation = true; // Quaternion needs recomputation
-	markDirty();
+	markLocalChanged();
 }
 
 void Transform::setLocalScale(const glm::vec3 &scale)
 {
 	m_localScale = scale;
-	markDirty();
+	markLocalChanged();
 }
 
 const glm::vec3 &Transform::getLocalPosition() const
@@ -277,7 +277,7 @@ void Transform::rotate(const glm::vec3 &eulerDegrees, bool local)
 		m_localEulerAngles = glm::degrees(glm::eulerAngles(newRotation));
 		m_localRotationCache = newRotation;
 		m_dirtyRotation = false;
-		markDirty();
+		markLocalChanged();
 	}
 	else
 	{
@@ -294,14 +294,14 @@ void Transform::rotate(const glm::vec3 &eulerDegrees, bool local)
 			m_localEulerAngles = glm::degrees(glm::eulerAngles(newLocalRot));
 			m_localRotationCache = newLocalRot;
 			m_dirtyRotation = false;
-			markDirty();
+			markLocalChanged();
 		}
 		else
 		{
 			m_localEulerAngles = glm::degrees(glm::eulerAngles(newWorldRot));
 			m_localRotationCache = newWorldRot;
 			m_dirtyRotation = false;
-			markDirty();
+			markLocalChanged();
 		}
 	}
 }
@@ -341,7 +341,7 @@ void Transform::lookAt(const glm::vec3 &target, const glm::vec3 &worldUp)
 		m_dirtyRotation = false;
 	}
 
-	markDirty();
+	markLocalChanged();
 }
 
 void Transform::setParentInternal(Transform *parent, bool keepWorld)
@@ -372,7 +372,7 @@ void Transform::setParentInternal(Transform *parent, bool keepWorld)
 			glm::length(glm::vec3(local[2]))
 		);
 	}
-	markDirty();
+	markLocalChanged();
 }
 
 Transform *Transform::getParent() const
@@ -380,6 +380,12 @@ Transform *Transform::getParent() const
 	return m_parent;
 }
 
+void Transform::markLocalChanged()
+{
+	++m_localVersion;
+	markDirty();
+}
+
 void Transform::markDirty()
 {
 	m_dirtyLocal = true;
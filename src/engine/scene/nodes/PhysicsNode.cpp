@@ -0,0 +1,72 @@
+#include "engine/scene/nodes/PhysicsNode.h"
+
+#include <algorithm>
+
+namespace engine::scene::nodes
+{
+
+void PhysicsNode::beginFixedStep()
+{
+	if (!m_hasState || m_transform.getLocalVersion() != m_writtenVersion)
+	{
+		// First step or moved from outside the fixed step: adopt the transform as-is
+		m_currentState = captureState();
+		m_hasState = true;
+	}
+	else
+	{
+		// Undo any interpolated pose so fixedUpdate() continues from the simulation state
+		writeState(m_currentState);
+	}
+
+	m_previousState = m_currentState;
+}
+
+void PhysicsNode::endFixedStep()
+{
+	m_currentState = captureState();
+	m_writtenVersion = m_transform.getLocalVersion();
+}
+
+void PhysicsNode::applyInterpolation(float alpha)
+{
+	if (!m_hasState)
+		return;
+
+	if (m_transform.getLocalVersion() != m_writtenVersion)
+	{
+		// Teleported since the last step, don't blend across the jump
+		m_currentState = captureState();
+		m_previousState = m_currentState;
+		m_writtenVersion = m_transform.getLocalVersion();
+		return;
+	}
+
+	const float t = m_interpolationEnabled ? std::clamp(alpha, 0.0f, 1.0f) : 1.0f;
+
+	State blended;
+	blended.position = glm::mix(m_previousState.position, m_currentState.position, t);
+	blended.rotation = glm::slerp(m_previousState.rotation, m_currentState.rotation, t);
+	blended.scale = glm::mix(m_previousState.scale, m_currentState.scale, t);
+	writeState(blended);
+}
+
+PhysicsNode::State PhysicsNode::captureState() const
+{
+	return State{
+		m_transform.getLocalPosition(),
+		m_transform.getLocalRotation(),
+		m_transform.getLocalScale()
+	};
+}
+
+void PhysicsNode::writeState(const State &state)
+{
+	m_transform.setLocalPosition(state.position);
+	m_transform.setLocalRotation(state.rotation);
+	m_transform.setLocalScale(state.scale);
+	propagateTransformDirty();
+	m_writtenVersion = m_transform.getLocalVersion();
+}
+
+} // namespace engine::scene::nodes
@@ -0,0 +1,58 @@
+/**
+ * Profiler thread buffer test
+ *
+ * Events recorded on short-lived threads are collected, the buffers of exited threads are
+ * reused instead of piling up, and draining while a thread keeps recording is race-free
+ * (run under ThreadSanitizer to check the latter).
+ */
+#include "engine/core/Profiler.h"
+
+#include "TestHelpers.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace engine::core;
+
+int main()
+{
+	auto &profiler = Profiler::instance();
+	profiler.setEnabled(true);
+	profiler.reset();
+
+	// Threads started one after another share one recycled buffer
+	for (int i = 0; i < 32; ++i)
+	{
+		std::thread([]()
+					{ ProfileScope scope("ProfilerTest::shortLived"); })
+			.join();
+		profiler.endFrame();
+	}
+	ENGINE_CHECK(profiler.getThreadBufferCount() <= 2);
+
+	bool found = false;
+	for (const auto &stats : profiler.getSummary())
+		found = found || (stats.name == "ProfilerTest::shortLived" && stats.sampleCount == 32);
+	ENGINE_CHECK(found);
+
+	// Drain while a writer laps the ring
+	std::atomic<bool> stop{false};
+	std::thread writer([&]()
+					   {
+		while (!stop.load(std::memory_order_relaxed))
+			ProfileScope scope("ProfilerTest::writer"); });
+	for (int frame = 0; frame < 200; ++frame)
+		profiler.endFrame();
+	stop = true;
+	writer.join();
+	profiler.endFrame();
+
+	for (const auto &stats : profiler.getSummary())
+	{
+		if (stats.name == "ProfilerTest::writer")
+			ENGINE_CHECK(stats.sampleCount > 0 && stats.maxMs >= 0.0f);
+	}
+
+	return engine::tests::result();
+}
@@ -0,0 +1,61 @@
+/**
+ * ShadowAtlas allocation test
+ *
+ * Tiles keep their place while acquired every frame, are released when not acquired, and tiles
+ * of different owners never share a page.
+ */
+#include "engine/rendering/ShadowAtlas.h"
+
+#include "TestHelpers.h"
+
+using namespace engine::rendering;
+
+int main()
+{
+	ShadowAtlas atlas(2048, 256, 4);
+	bool allocated = false;
+
+	// Two owners with half-page tiles: each gets a page of its own
+	atlas.beginFrame();
+	const auto a = atlas.acquire(1, 1024, allocated, 1);
+	ENGINE_CHECK(a.has_value() && allocated);
+	const auto b = atlas.acquire(2, 1024, allocated, 2);
+	ENGINE_CHECK(b.has_value() && allocated);
+	atlas.endFrame();
+	ENGINE_REQUIRE(a && b);
+	ENGINE_CHECK(a->page != b->page);
+	ENGINE_CHECK(atlas.getPageCount() == 2);
+
+	// Same owner fills its own page first
+	atlas.beginFrame();
+	atlas.acquire(1, 1024, allocated, 1);
+	atlas.acquire(2, 1024, allocated, 2);
+	const auto c = atlas.acquire(3, 1024, allocated, 1);
+	atlas.endFrame();
+	ENGINE_REQUIRE(c.has_value());
+	ENGINE_CHECK(c->page == a->page);
+
+	// Tiles acquired every frame stay in place
+	for (int frame = 0; frame < 3; ++frame)
+	{
+		atlas.beginFrame();
+		ENGINE_CHECK(atlas.acquire(1, 1024, allocated, 1) == a && !allocated);
+		ENGINE_CHECK(atlas.acquire(2, 1024, allocated, 2) == b && !allocated);
+		atlas.endFrame();
+	}
+
+	// Keys not acquired are released; an emptied page can go to another owner
+	ENGINE_CHECK(atlas.getTileCount() == 2);
+	atlas.beginFrame();
+	atlas.acquire(2, 1024, allocated, 2);
+	atlas.endFrame();
+	ENGINE_CHECK(atlas.getTileCount() == 1);
+	atlas.beginFrame();
+	atlas.acquire(2, 1024, allocated, 2);
+	const auto d = atlas.acquire(4, 2048, allocated, 3);
+	atlas.endFrame();
+	ENGINE_REQUIRE(d.has_value());
+	ENGINE_CHECK(d->page == a->page);
+
+	return engine::tests::result();
+}
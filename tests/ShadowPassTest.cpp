@@ -0,0 +1,100 @@
+/**
+ * ShadowPass multi-camera caching test
+ *
+ * Renders the shadow of one spot light for two cameras per frame, the way the Renderer does.
+ * Both cameras' atlas tiles and cached signatures must survive across frames: after the first
+ * frame neither camera renders its shadow again, and the tiles keep their place.
+ */
+#include "engine/EngineMain.h"
+// ^ This has to be on top to define SDL_MAIN_HANDLED ^
+#include "engine/rendering/FrameCache.h"
+#include "engine/rendering/Light.h"
+#include "engine/rendering/RenderCollector.h"
+#include "engine/rendering/ShadowPass.h"
+#include "engine/rendering/ShadowRequest.h"
+
+#include "TestHelpers.h"
+
+#include <array>
+
+using namespace engine::rendering;
+
+int main(int, char **)
+{
+	engine::GameEngineOptions options;
+	options.headless = true;
+	options.windowWidth = 64;
+	options.windowHeight = 64;
+
+	engine::GameEngine engine;
+	ENGINE_REQUIRE(engine.initialize(options));
+
+	ShadowPass shadowPass(engine.getContext());
+	ENGINE_REQUIRE(shadowPass.initialize());
+	shadowPass.setScreenCoverageSizing(false);
+
+	// Half-page tiles: without per-camera pages both cameras would share page 0
+	SpotLight spot;
+	spot.castShadows = true;
+	spot.shadowMapSize = constants::SHADOW_ATLAS_SIZE / 2;
+	Light light{Light::LightData{spot}};
+
+	RenderCollector collector;
+	FrameCache frameCache;
+	frameCache.shadowRequests.emplace_back(&light, ShadowType::Spot, 0);
+
+	const uint64_t cameraIds[] = {1, 2};
+	for (uint64_t cameraId : cameraIds)
+	{
+		RenderTarget target{};
+		target.cameraId = cameraId;
+		target.viewMatrix = glm::mat4(1.0f);
+		target.projectionMatrix = glm::mat4(1.0f);
+		target.viewProjectionMatrix = glm::mat4(1.0f);
+		target.nearPlane = 0.1f;
+		target.farPlane = 100.0f;
+		frameCache.renderTargets[cameraId] = target;
+	}
+
+	std::array<size_t, 2> rendered{};
+	std::array<size_t, 2> cached{};
+	auto renderFrame = [&]()
+	{
+		shadowPass.setRenderCollector(&collector);
+		shadowPass.beginFrame();
+		for (size_t i = 0; i < 2; ++i)
+		{
+			shadowPass.setCameraId(cameraIds[i]);
+			shadowPass.render(frameCache);
+			rendered[i] = shadowPass.getLastRenderedShadowCount();
+			cached[i] = shadowPass.getLastCachedShadowCount();
+		}
+		shadowPass.endFrame();
+	};
+
+	renderFrame();
+	ENGINE_CHECK(rendered[0] == 1 && rendered[1] == 1);
+	ENGINE_CHECK(shadowPass.getAtlas().getTileCount() == 2);
+	const uint32_t pageCount = shadowPass.getAtlas().getPageCount();
+	ENGINE_CHECK(pageCount == 2);
+
+	for (int frame = 0; frame < 3; ++frame)
+	{
+		renderFrame();
+		ENGINE_CHECK(rendered[0] == 0 && rendered[1] == 0);
+		ENGINE_CHECK(cached[0] == 1 && cached[1] == 1);
+		ENGINE_CHECK(shadowPass.getAtlas().getTileCount() == 2);
+		ENGINE_CHECK(shadowPass.getAtlas().getPageCount() == pageCount);
+	}
+
+	// A camera that stops rendering releases its tile at the end of the frame
+	shadowPass.beginFrame();
+	shadowPass.setCameraId(cameraIds[0]);
+	shadowPass.render(frameCache);
+	ENGINE_CHECK(shadowPass.getLastCachedShadowCount() == 1);
+	shadowPass.endFrame();
+	ENGINE_CHECK(shadowPass.getAtlas().getTileCount() == 1);
+
+	shadowPass.cleanup();
+	return engine::tests::result();
+}
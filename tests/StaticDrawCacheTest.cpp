@@ -0,0 +1,105 @@
+/**
+ * StaticDrawCache bundle invalidation test
+ *
+ * Draws one static item until its packets are recorded into a render bundle, then changes the
+ * item's material. The next frame must recompile the packet and replay it directly instead of
+ * executing the stale bundle; the frame after that records a new bundle.
+ */
+#include "engine/EngineMain.h"
+// ^ This has to be on top to define SDL_MAIN_HANDLED ^
+#include "engine/rendering/FrameCache.h"
+#include "engine/rendering/Model.h"
+#include "engine/rendering/RenderCollector.h"
+#include "engine/rendering/StaticDrawCache.h"
+#include "engine/rendering/webgpu/WebGPUContext.h"
+#include "engine/rendering/webgpu/WebGPUDepthTextureFactory.h"
+#include "engine/rendering/webgpu/WebGPUMaterial.h"
+#include "engine/rendering/webgpu/WebGPURenderPassContext.h"
+#include "engine/rendering/webgpu/WebGPURenderPassFactory.h"
+#include "engine/rendering/webgpu/WebGPUTextureFactory.h"
+#include "engine/resources/ResourceManager.h"
+
+#include "TestHelpers.h"
+
+using namespace engine::rendering;
+
+int main(int, char **)
+{
+	engine::GameEngineOptions options;
+	options.headless = true;
+	options.windowWidth = 64;
+	options.windowHeight = 64;
+
+	engine::GameEngine engine;
+	ENGINE_REQUIRE(engine.initialize(options));
+	auto context = engine.getContext();
+	auto resources = engine.getResourceManager();
+
+	// One static triangle with a material of its own
+	std::vector<Vertex> vertices(3);
+	vertices[0].position = {0.0f, 0.0f, 0.0f};
+	vertices[1].position = {1.0f, 0.0f, 0.0f};
+	vertices[2].position = {0.0f, 1.0f, 0.0f};
+	auto mesh = resources->m_meshManager->createMesh(vertices, {0, 1, 2}, engine::math::AABB(), "StaticDrawCacheTest");
+	auto material = resources->m_materialManager->createPBRMaterial("StaticDrawCacheTest", PBRProperties{}, {});
+	ENGINE_REQUIRE(mesh.has_value() && material.has_value());
+
+	auto model = std::make_shared<Model>((*mesh)->getHandle(), "", "StaticDrawCacheTest");
+	model->addSubmesh(Submesh{0, 3, (*material)->getHandle()});
+	ENGINE_REQUIRE(resources->m_modelManager->add(model).has_value());
+
+	const uint64_t cameraId = 1;
+	RenderCollector collector;
+	collector.addModel(model->getHandle(), glm::mat4(1.0f), 0, 1, nullptr, true);
+
+	FrameCache frameCache;
+	const std::vector<size_t> visibleIndices{0};
+	ENGINE_REQUIRE(frameCache.prepareGPUResources(context, collector, visibleIndices));
+	ENGINE_REQUIRE(frameCache.gpuRenderItems[0].has_value() && frameCache.gpuRenderItems[0]->isStatic);
+
+	auto colorTexture = context->textureFactory().createRenderTarget(0, 64, 64);
+	auto depthTexture = context->depthTextureFactory().createDefault(64, 64);
+	auto passContext = context->renderPassFactory().create(colorTexture, depthTexture);
+	ENGINE_REQUIRE(passContext != nullptr);
+
+	StaticDrawCache cache(context);
+	std::vector<size_t> dynamicIndices;
+	auto drawFrame = [&]()
+	{
+		auto encoder = context->createCommandEncoder("StaticDrawCacheTest Encoder");
+		wgpu::RenderPassEncoder renderPass = passContext->begin(encoder);
+		cache.draw(renderPass, frameCache, passContext, cameraId, BindGroupSet{}, visibleIndices, dynamicIndices);
+		passContext->end(renderPass);
+		context->submitCommandEncoder(encoder, "StaticDrawCacheTest Commands");
+	};
+
+	// Frame 1 compiles, frame 2 records the bundle, frame 3 reuses it
+	drawFrame();
+	ENGINE_CHECK(cache.getLastCompileCount() == 1);
+	ENGINE_CHECK(dynamicIndices.empty());
+	drawFrame();
+	ENGINE_CHECK(cache.wasBundleRecorded());
+	drawFrame();
+	ENGINE_CHECK(cache.wasBundleUsed() && !cache.wasBundleRecorded());
+	ENGINE_REQUIRE(cache.getBundleRecordCount() == 1);
+
+	// Change the material after the bundle was recorded: the GPU material resyncs to a new version
+	PBRProperties properties;
+	properties.roughness = 0.9f;
+	(*material)->setProperties(properties);
+	auto &gpuMaterial = frameCache.gpuRenderItems[0]->gpuMaterial;
+	gpuMaterial->markSyncPending();
+	gpuMaterial->syncIfNeeded();
+
+	// The stale bundle must not be executed; the packet is replayed while the set settles
+	drawFrame();
+	ENGINE_CHECK(cache.getLastCompileCount() == 1);
+	ENGINE_CHECK(!cache.wasBundleUsed());
+
+	// Once stable again the bundle is recorded from the new packet
+	drawFrame();
+	ENGINE_CHECK(cache.wasBundleRecorded() && cache.wasBundleUsed());
+	ENGINE_CHECK(cache.getBundleRecordCount() == 2);
+
+	return engine::tests::result();
+}
@@ -0,0 +1,67 @@
+/**
+ * WebGPUSyncTracker registration test
+ *
+ * A dependent that unwatches a source it stopped reading from (a material swapping a texture)
+ * is no longer notified, and entries of destroyed dependents do not accumulate.
+ */
+#include "engine/core/Versioned.h"
+#include "engine/rendering/webgpu/WebGPUSyncObject.h"
+#include "engine/rendering/webgpu/WebGPUSyncTracker.h"
+
+#include "TestHelpers.h"
+
+#include <memory>
+#include <vector>
+
+using namespace engine::rendering::webgpu;
+
+namespace
+{
+struct Source : engine::core::Versioned
+{
+	void change() { incrementVersion(); }
+};
+
+struct Dependent : WebGPUSyncDependent
+{
+	int marks = 0;
+	void markSyncPending() override { ++marks; }
+};
+} // namespace
+
+int main()
+{
+	WebGPUSyncTracker tracker;
+	Source material;
+	Source oldTexture;
+	Source newTexture;
+	auto dependent = std::make_shared<Dependent>();
+
+	tracker.watch(material, dependent);
+	const auto oldToken = tracker.watch(oldTexture, dependent);
+	ENGINE_CHECK(tracker.getWatchedSourceCount() == 2);
+
+	// The material swaps its texture: the old one is unwatched, the new one watched
+	tracker.watch(newTexture, dependent);
+	tracker.unwatch(oldToken, dependent.get());
+	ENGINE_CHECK(tracker.getWatchedSourceCount() == 2);
+
+	oldTexture.change();
+	ENGINE_CHECK(tracker.processChanges() == 0);
+	ENGINE_CHECK(dependent->marks == 0);
+
+	newTexture.change();
+	ENGINE_CHECK(tracker.processChanges() == 1);
+	ENGINE_CHECK(dependent->marks == 1);
+
+	// Sources of destroyed dependents that never change again are pruned as the map grows
+	std::vector<Source> sources(1000);
+	for (auto &source : sources)
+	{
+		auto shortLived = std::make_shared<Dependent>();
+		tracker.watch(source, shortLived);
+	}
+	ENGINE_CHECK(tracker.getWatchedSourceCount() < 200);
+
+	return engine::tests::result();
+}
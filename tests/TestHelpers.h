@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdio>
+
+/**
+ * @file TestHelpers.h
+ * @brief Minimal check macros for the engine tests.
+ *
+ * Every test is a plain executable registered with CTest. A failed ENGINE_CHECK prints its
+ * location and marks the run as failed but keeps going, so one run reports every broken
+ * expectation; ENGINE_REQUIRE returns from main() for preconditions the rest depends on.
+ */
+namespace engine::tests
+{
+
+inline int &failureCount()
+{
+	static int count = 0;
+	return count;
+}
+
+/** @brief Exit code of the test: 0 if every check passed. */
+inline int result()
+{
+	if (failureCount() > 0)
+		std::fprintf(stderr, "%d check(s) failed\n", failureCount());
+	return failureCount() == 0 ? 0 : 1;
+}
+
+} // namespace engine::tests
+
+#define ENGINE_CHECK(expr)                                                                \
+	do                                                                                    \
+	{                                                                                     \
+		if (!(expr))                                                                      \
+		{                                                                                 \
+			std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr); \
+			++engine::tests::failureCount();                                              \
+		}                                                                                 \
+	} while (false)
+
+#define ENGINE_REQUIRE(expr)                                                                    \
+	do                                                                                          \
+	{                                                                                           \
+		if (!(expr))                                                                            \
+		{                                                                                       \
+			std::fprintf(stderr, "%s:%d: requirement failed: %s\n", __FILE__, __LINE__, #expr); \
+			return 1;                                                                           \
+		}                                                                                       \
+	} while (false)
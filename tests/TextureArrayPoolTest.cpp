@@ -0,0 +1,85 @@
+/**
+ * WebGPUTextureArrayPool growth and layer lifetime test
+ *
+ * Packs textures until the first page is full and checks that the page grows into a larger
+ * texture instead of reserving its whole budget up front. Layers stay packed under their key
+ * without the source, and a released layer is reused by the next texture.
+ */
+#include "engine/EngineMain.h"
+// ^ This has to be on top to define SDL_MAIN_HANDLED ^
+#include "engine/rendering/RenderingConstants.h"
+#include "engine/rendering/webgpu/WebGPUContext.h"
+#include "engine/rendering/webgpu/WebGPUTexture.h"
+#include "engine/rendering/webgpu/WebGPUTextureArrayPool.h"
+#include "engine/rendering/webgpu/WebGPUTextureFactory.h"
+
+#include "TestHelpers.h"
+
+using namespace engine::rendering;
+using namespace engine::rendering::webgpu;
+
+int main(int, char **)
+{
+	engine::GameEngineOptions options;
+	options.headless = true;
+	options.windowWidth = 64;
+	options.windowHeight = 64;
+
+	engine::GameEngine engine;
+	ENGINE_REQUIRE(engine.initialize(options));
+	auto context = engine.getContext();
+
+	WebGPUTextureArrayPool pool(*context);
+	auto source = context->textureFactory().getWhiteTexture();
+	ENGINE_REQUIRE(source != nullptr);
+
+	// The first page starts small
+	const uint32_t initialLayers = constants::MATERIAL_TEXTURE_ARRAY_INITIAL_LAYERS;
+	std::vector<std::shared_ptr<WebGPUTextureArrayLayer>> layers;
+	for (uint64_t key = 1; key <= initialLayers; ++key)
+	{
+		std::shared_ptr<WebGPUTexture> replaced;
+		layers.push_back(pool.pack(source, key, &replaced));
+		ENGINE_REQUIRE(layers.back() != nullptr);
+		ENGINE_CHECK(replaced == nullptr);
+	}
+	ENGINE_CHECK(pool.getPageCount() == 1);
+	auto firstTexture = layers[0]->getPageTexture();
+	ENGINE_CHECK(firstTexture->getTextureDescriptor().size.depthOrArrayLayers == initialLayers);
+
+	// One more grows the page; every layer now reports the larger texture
+	std::shared_ptr<WebGPUTexture> replaced;
+	layers.push_back(pool.pack(source, initialLayers + 1, &replaced));
+	ENGINE_REQUIRE(layers.back() != nullptr);
+	ENGINE_CHECK(replaced == firstTexture);
+	ENGINE_CHECK(pool.getPageCount() == 1);
+	ENGINE_CHECK(layers.back()->layer == initialLayers);
+	ENGINE_CHECK(layers[0]->getPageTexture() == layers.back()->getPageTexture());
+	ENGINE_CHECK(layers[0]->getPageTexture()->getTextureDescriptor().size.depthOrArrayLayers == initialLayers * 2);
+
+	// Packed layers are found by key without the source
+	ENGINE_CHECK(pool.find(1) == layers[0]);
+	ENGINE_CHECK(pool.pack(nullptr, 2) == layers[1]);
+	ENGINE_CHECK(pool.getPackedCount() == initialLayers + 1);
+
+	// Releasing a layer frees it for the next texture
+	const uint32_t freedLayer = layers[1]->layer;
+	layers[1].reset();
+	ENGINE_CHECK(pool.find(2) == nullptr);
+	auto reusedLayer = pool.pack(source, 100);
+	ENGINE_REQUIRE(reusedLayer != nullptr);
+	ENGINE_CHECK(reusedLayer->layer == freedLayer);
+	ENGINE_CHECK(pool.getPackedCount() == initialLayers + 1);
+
+	// With every layer released the page is filled again from its first layer
+	layers.clear();
+	reusedLayer.reset();
+	ENGINE_CHECK(pool.getPackedCount() == 0);
+	auto single = pool.pack(source, 200);
+	ENGINE_REQUIRE(single != nullptr);
+	ENGINE_CHECK(single->layer == 0);
+	ENGINE_CHECK(pool.getPageCount() == 1);
+
+	pool.cleanup();
+	return engine::tests::result();
+}
@@ -0,0 +1,49 @@
+/**
+ * TextureCooker slot options test
+ *
+ * Cook options follow the material slot: normal maps are cooked as linear BC5, color slots
+ * as sRGB BC1 and data slots as linear.
+ */
+#include "engine/rendering/Material.h"
+#include "engine/resources/TextureCooker.h"
+
+#include "TestHelpers.h"
+
+#include <vector>
+
+using namespace engine::resources;
+namespace slots = engine::rendering::MaterialTextureSlots;
+
+int main()
+{
+	const auto normal = TextureCooker::optionsForSlot(slots::NORMAL);
+	ENGINE_CHECK(normal.normalMap && !normal.srgb);
+
+	const auto diffuse = TextureCooker::optionsForSlot(slots::DIFFUSE);
+	ENGINE_CHECK(!diffuse.normalMap && diffuse.srgb);
+
+	const auto roughness = TextureCooker::optionsForSlot(slots::ROUGHNESS);
+	ENGINE_CHECK(!roughness.normalMap && !roughness.srgb);
+
+	// The same opaque RGB image cooks to BC5 in the normal slot and BC1 in the diffuse slot
+	const uint32_t size = 8;
+	std::vector<uint8_t> pixels(size * size * 3);
+	for (size_t i = 0; i < pixels.size(); i += 3)
+	{
+		pixels[i + 0] = 128;
+		pixels[i + 1] = static_cast<uint8_t>(i % 256);
+		pixels[i + 2] = 255;
+	}
+	Image source(size, size, ImageFormat::formatFromChannels(3, false), std::move(pixels));
+
+	auto normalMap = TextureCooker::cook(source, normal);
+	ENGINE_REQUIRE(normalMap.has_value());
+	ENGINE_CHECK((*normalMap)->getBlockCompression() == BlockCompression::Type::BC5_RG);
+	ENGINE_CHECK((*normalMap)->getMipLevelCount() == 4);
+
+	auto color = TextureCooker::cook(source, diffuse);
+	ENGINE_REQUIRE(color.has_value());
+	ENGINE_CHECK((*color)->getBlockCompression() == BlockCompression::Type::BC1_RGBA);
+
+	return engine::tests::result();
+}
@@ -0,0 +1,69 @@
+/**
+ * TextureManager content cache test
+ *
+ * Threads requesting the same content at once get one texture, decoded once. The same content
+ * requested for another color space gets a texture of its own.
+ */
+#include "engine/resources/TextureManager.h"
+
+#include "TestHelpers.h"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+using namespace engine::resources;
+using engine::rendering::ColorSpace;
+
+int main()
+{
+	TextureManager textureManager(std::make_shared<loaders::ImageLoader>(std::filesystem::current_path()));
+
+	std::atomic<int> decodeCount{0};
+	auto createImage = [&decodeCount]() -> Image::Ptr
+	{
+		++decodeCount;
+		// Slow decode: the other threads arrive while this one is still working
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		std::vector<uint8_t> pixels = {255, 0, 0, 255};
+		return std::make_shared<Image>(1u, 1u, ImageFormat::Type::LDR_RGBA8, std::move(pixels));
+	};
+
+	const uint64_t contentHash = 42;
+	const int threadCount = 8;
+	std::vector<TextureManager::TexturePtr> results(threadCount);
+	std::vector<std::thread> threads;
+	for (int i = 0; i < threadCount; ++i)
+	{
+		threads.emplace_back([&, i]()
+		{
+			auto texture = textureManager.getOrCreateImageTexture(contentHash, createImage);
+			if (texture)
+				results[i] = *texture;
+		});
+	}
+	for (auto &thread : threads)
+		thread.join();
+
+	ENGINE_CHECK(decodeCount == 1);
+	for (const auto &texture : results)
+		ENGINE_CHECK(texture != nullptr && texture == results[0]);
+	ENGINE_CHECK(textureManager.getDeduplicatedCount() == threadCount - 1);
+
+	// Same content in a linear slot: a separate texture
+	auto linear = textureManager.getOrCreateImageTexture(contentHash, createImage, std::nullopt, ColorSpace::Linear);
+	ENGINE_REQUIRE(linear.has_value());
+	ENGINE_CHECK(*linear != results[0]);
+	ENGINE_CHECK(decodeCount == 2);
+
+	// Both are cached under their own color space
+	auto srgbAgain = textureManager.getOrCreateImageTexture(contentHash, createImage, std::nullopt, ColorSpace::sRGB);
+	auto linearAgain = textureManager.getOrCreateImageTexture(contentHash, createImage, std::nullopt, ColorSpace::Linear);
+	ENGINE_CHECK(srgbAgain.has_value() && *srgbAgain == results[0]);
+	ENGINE_CHECK(linearAgain.has_value() && *linearAgain == *linear);
+	ENGINE_CHECK(decodeCount == 2);
+
+	return engine::tests::result();
+}
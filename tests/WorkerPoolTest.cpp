@@ -0,0 +1,83 @@
+/**
+ * WorkerPool / parallelFor test
+ *
+ * Every item is visited exactly once, by a pool with and without worker threads, from nested
+ * calls and from concurrent callers; small work stays on the calling thread.
+ */
+#include "engine/core/Parallel.h"
+#include "engine/core/WorkerPool.h"
+
+#include "TestHelpers.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace engine::core;
+
+namespace
+{
+bool visitsOnce(WorkerPool &pool, uint32_t count, uint32_t chunk)
+{
+	std::vector<std::atomic<int>> visits(count);
+	auto fn = [&](uint32_t first, uint32_t last)
+	{
+		for (uint32_t i = first; i < last; ++i)
+			visits[i].fetch_add(1, std::memory_order_relaxed);
+	};
+	pool.run(count, chunk, [](void *context, uint32_t first, uint32_t last)
+			 { (*static_cast<decltype(fn) *>(context))(first, last); }, &fn);
+
+	for (const auto &v : visits)
+	{
+		if (v.load() != 1)
+			return false;
+	}
+	return true;
+}
+} // namespace
+
+int main()
+{
+	WorkerPool inlinePool(0);
+	ENGINE_CHECK(visitsOnce(inlinePool, 1000, 7));
+
+	WorkerPool pool(4);
+	ENGINE_CHECK(pool.getThreadCount() == 4);
+	for (int repeat = 0; repeat < 100; ++repeat)
+		ENGINE_CHECK(visitsOnce(pool, 10000, 13));
+	ENGINE_CHECK(visitsOnce(pool, 3, 100));
+
+	// Below the threshold the range runs on the caller in one call
+	const auto caller = std::this_thread::get_id();
+	int calls = 0;
+	bool onCaller = true;
+	parallelFor(100, 10, 1000, [&](uint32_t first, uint32_t last)
+				{
+		++calls;
+		onCaller = onCaller && std::this_thread::get_id() == caller && first == 0 && last == 100; });
+	ENGINE_CHECK(calls == 1 && onCaller);
+
+	// Nested and concurrent parallelFor calls fall back to the calling thread instead of blocking
+	std::vector<std::atomic<int>> visits(4096);
+	auto nested = [&](uint32_t first, uint32_t last)
+	{
+		for (uint32_t i = first; i < last; ++i)
+		{
+			parallelFor(8, 8, 1, [&](uint32_t a, uint32_t b)
+						{ visits[i].fetch_add(static_cast<int>(b - a), std::memory_order_relaxed); });
+		}
+	};
+	std::thread other([&]()
+					  { parallelFor(2048, 2048, 1, [&](uint32_t first, uint32_t last)
+									{ nested(first, last); }); });
+	parallelFor(2048, 2048, 1, [&](uint32_t first, uint32_t last)
+				{ nested(first + 2048, last + 2048); });
+	other.join();
+	bool allVisited = true;
+	for (const auto &v : visits)
+		allVisited = allVisited && v.load() == 8;
+	ENGINE_CHECK(allVisited);
+
+	return engine::tests::result();
+}